@@ -43,18 +43,37 @@ let package = Package(
             path: "Sources/F53OSC",
             exclude: [
                 "F53OSC.h",
+                "F53OSCAddressIndex.h", "F53OSCAddressIndex.m",
                 "F53OSCBrowser.h", "F53OSCBrowser.m",
                 "F53OSCBundle.h", "F53OSCBundle.m", 
+                "F53OSCBundleBuilder.h", "F53OSCBundleBuilder.m",
                 "F53OSCClient.h", "F53OSCClient.m",
+                "F53OSCClientGroup.h", "F53OSCClientGroup.m",
+                "F53OSCConflationBuffer.h", "F53OSCConflationBuffer.m",
+                "F53OSCDatagramCipher.h", "F53OSCDatagramCipher.m",
+                "F53OSCDiscoveryBackend.h", "F53OSCDiscoveryBackend.m",
                 "F53OSCEncryptHandshake.h", "F53OSCEncryptHandshake.m",
+                "F53OSCEncryptSessionCache.h", "F53OSCEncryptSessionCache.m",
                 "F53OSCFoundationAdditions.h",
                 "F53OSCMessage.h", "F53OSCMessage.m",
+                "F53OSCMessageBatcher.h", "F53OSCMessageBatcher.m",
+                "F53OSCNativeUdpTransport.h", "F53OSCNativeUdpTransport.m",
+                "F53OSCOutboundQueue.h", "F53OSCOutboundQueue.m",
                 "F53OSCPacket.h", "F53OSCPacket.m",
                 "F53OSCParser.h", "F53OSCParser.m",
+                "F53OSCPatternCache.h", "F53OSCPatternCache.m",
+                "F53OSCPriorityScheduler.h", "F53OSCPriorityScheduler.m",
+                "F53OSCRateLimiter.h", "F53OSCRateLimiter.m",
+                "F53OSCReadFlowControl.h", "F53OSCReadFlowControl.m",
+                "F53OSCRealtimeRing.h", "F53OSCRealtimeRing.m",
+                "F53OSCReceiveBufferPool.h", "F53OSCReceiveBufferPool.m",
+                "F53OSCSchemaRegistry.h", "F53OSCSchemaRegistry.m",
                 "F53OSCServer.h", "F53OSCServer.m",
                 "F53OSCSocket.h", "F53OSCSocket.m",
                 "F53OSCTimeTag.h", "F53OSCTimeTag.m",
+                "F53OSCTransportEngine.h", "F53OSCTransportEngine.m",
                 "F53OSCValue.h", "F53OSCValue.m",
+                "F53OSCWire.h", "F53OSCWire.c",
                 "NSData+F53OSCBlob.h", "NSData+F53OSCBlob.m",
                 "NSDate+F53OSCTimeTag.h", "NSDate+F53OSCTimeTag.m",
                 "NSNumber+F53OSCNumber.h", "NSNumber+F53OSCNumber.m",
@@ -114,6 +114,20 @@ NS_ASSUME_NONNULL_BEGIN
     [self performSelectorOnMainThread:@selector(processMessage:) withObject:message waitUntilDone:NO];
 }
 
+///
+///  Implementing this lets the server hand over everything from a read at once, so there is one hop to the main thread per batch.
+///
+- (void)takeMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    [self performSelectorOnMainThread:@selector(processMessages:) withObject:messages waitUntilDone:NO];
+}
+
+- (void)processMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    for ( F53OSCMessage *message in messages )
+        [self processMessage:message];
+}
+
 - (void)processMessage:(F53OSCMessage *)message
 {
     // log all received messages
@@ -36,24 +36,62 @@
 
 #if F53OSC_BUILT_AS_FRAMEWORK
 #import <F53OSC/F53OSCBrowser.h>
+#import <F53OSC/F53OSCDiscoveryBackend.h>
 #import <F53OSC/F53OSCEncryptHandshake.h>
+#import <F53OSC/F53OSCEncryptSessionCache.h>
+#import <F53OSC/F53OSCDatagramCipher.h>
 #import <F53OSC/F53OSCParser.h>
+#import <F53OSC/F53OSCWire.h>
+#import <F53OSC/F53OSCSchemaRegistry.h>
+#import <F53OSC/F53OSCPatternCache.h>
+#import <F53OSC/F53OSCAddressIndex.h>
 #import <F53OSC/F53OSCSocket.h>
 #import <F53OSC/F53OSCPacket.h>
 #import <F53OSC/F53OSCMessage.h>
+#import <F53OSC/F53OSCMessageBatcher.h>
+#import <F53OSC/F53OSCConflationBuffer.h>
+#import <F53OSC/F53OSCPriorityScheduler.h>
+#import <F53OSC/F53OSCReadFlowControl.h>
 #import <F53OSC/F53OSCBundle.h>
+#import <F53OSC/F53OSCBundleBuilder.h>
 #import <F53OSC/F53OSCClient.h>
+#import <F53OSC/F53OSCClientGroup.h>
+#import <F53OSC/F53OSCTransportEngine.h>
+#import <F53OSC/F53OSCOutboundQueue.h>
+#import <F53OSC/F53OSCNativeUdpTransport.h>
+#import <F53OSC/F53OSCReceiveBufferPool.h>
+#import <F53OSC/F53OSCRealtimeRing.h>
 #import <F53OSC/F53OSCServer.h>
+#import <F53OSC/F53OSCRateLimiter.h>
 #import <F53OSC/F53OSCTimeTag.h>
 #else
 #import "F53OSCBrowser.h"
+#import "F53OSCDiscoveryBackend.h"
 #import "F53OSCEncryptHandshake.h"
+#import "F53OSCEncryptSessionCache.h"
+#import "F53OSCDatagramCipher.h"
 #import "F53OSCParser.h"
+#import "F53OSCWire.h"
+#import "F53OSCSchemaRegistry.h"
+#import "F53OSCPatternCache.h"
+#import "F53OSCAddressIndex.h"
 #import "F53OSCSocket.h"
 #import "F53OSCPacket.h"
 #import "F53OSCMessage.h"
+#import "F53OSCMessageBatcher.h"
+#import "F53OSCConflationBuffer.h"
+#import "F53OSCPriorityScheduler.h"
+#import "F53OSCReadFlowControl.h"
 #import "F53OSCBundle.h"
+#import "F53OSCBundleBuilder.h"
 #import "F53OSCClient.h"
+#import "F53OSCClientGroup.h"
+#import "F53OSCTransportEngine.h"
+#import "F53OSCOutboundQueue.h"
+#import "F53OSCNativeUdpTransport.h"
+#import "F53OSCReceiveBufferPool.h"
+#import "F53OSCRealtimeRing.h"
 #import "F53OSCServer.h"
+#import "F53OSCRateLimiter.h"
 #import "F53OSCTimeTag.h"
 #endif
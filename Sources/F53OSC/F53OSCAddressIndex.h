@@ -0,0 +1,77 @@
+//
+//  F53OSCAddressIndex.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import <stdbool.h>
+
+//
+//  F53OSCAddressIndex selects objects from a large collection by matching their OSC addresses against an OSC
+//  address pattern, as `filteredArrayUsingPredicate:` with `+[F53OSCServer predicateForAttribute:matchingOSCPattern:]`
+//  does, but without KVC or regular expressions per object.
+//
+//  Each object's address is read once, through `addressKeyPath`, when it is added. Addresses are kept sorted
+//  component by component, so all addresses that share a pattern's literal prefix, e.g. "/cue/" in "/cue/*/level",
+//  are found with a binary search and nothing outside that range is examined. The remaining candidates are
+//  matched in place; when there are at least `parallelThreshold` of them, they are matched in parallel chunks
+//  with `dispatch_apply`. A pattern without wildcards costs only the binary search.
+//
+//  Objects may be added and removed one at a time without rebuilding the index. If an object's address changes,
+//  remove it and add it again. All methods are thread-safe.
+//
+//  Patterns support '*', '?', '[...]' (with '!' negation and '-' ranges), and '{...,...}'. '*' and '?' do not match '/'.
+//
+//  Example usage:
+//  F53OSCAddressIndex *index = [[F53OSCAddressIndex alloc] initWithObjects:cues addressKeyPath:@"oscAddress"];
+//  NSArray *cuesToFire = [index objectsMatchingPattern:message.addressPattern];
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Matches a NUL-terminated OSC address pattern against `addressLength` bytes of an address.
+FOUNDATION_EXPORT bool F53OSCPatternMatchesAddress( const char *pattern, const char *address, size_t addressLength );
+
+@interface F53OSCAddressIndex : NSObject
+
+- (instancetype) init NS_UNAVAILABLE;
+- (instancetype) initWithAddressKeyPath:(NSString *)addressKeyPath;
+- (instancetype) initWithObjects:(NSArray *)objects addressKeyPath:(NSString *)addressKeyPath NS_DESIGNATED_INITIALIZER;
+
+@property (readonly, copy) NSString *addressKeyPath;
+@property (assign) NSUInteger parallelThreshold;    // default 4096 candidates; fewer are matched on the calling thread
+@property (readonly) NSUInteger count;
+
+- (void) addObject:(id)object;                      // objects whose address is not a string are ignored
+- (void) addObjects:(NSArray *)objects;
+- (void) removeObject:(id)object;                   // compared by identity
+- (void) removeAllObjects;
+
+// Objects are returned in component order of their addresses, and in the order they were added for equal addresses.
+- (NSArray *) objectsMatchingPattern:(NSString *)pattern;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,453 @@
+//
+//  F53OSCAddressIndex.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCAddressIndex.h"
+
+#import <stdlib.h>
+#import <string.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53OSC_ADDRESS_INDEX_CHUNKS_PER_CPU     4
+
+typedef struct
+{
+    char        *address;   // NUL-terminated copy
+    size_t      length;
+    const void  *object;    // retained
+} F53OSCAddressIndexEntry;
+
+#pragma mark - Matching
+
+bool F53OSCPatternMatchesAddress( const char *pattern, const char *address, size_t addressLength )
+{
+    const char *addressEnd = address + addressLength;
+    while ( *pattern )
+    {
+        if ( *pattern == '*' )
+        {
+            pattern++;
+            for ( const char *rest = address; ; rest++ )
+            {
+                if ( F53OSCPatternMatchesAddress( pattern, rest, (size_t)( addressEnd - rest ) ) )
+                    return true;
+                if ( rest == addressEnd || *rest == '/' )
+                    return false;
+            }
+        }
+        
+        if ( *pattern == '{' )
+        {
+            const char *close = strchr( pattern, '}' );
+            if ( close == NULL )
+                return false;
+            
+            // Try each comma-separated alternative in turn.
+            const char *alternative = pattern + 1;
+            while ( alternative <= close )
+            {
+                const char *end = alternative;
+                while ( end < close && *end != ',' )
+                    end++;
+                size_t length = (size_t)( end - alternative );
+                if ( length <= (size_t)( addressEnd - address ) && memcmp( alternative, address, length ) == 0 &&
+                    F53OSCPatternMatchesAddress( close + 1, address + length, (size_t)( addressEnd - address ) - length ) )
+                    return true;
+                alternative = end + 1;
+            }
+            return false;
+        }
+        
+        if ( address == addressEnd )
+            return false;
+        
+        char c = *address;
+        if ( *pattern == '?' )
+        {
+            if ( c == '/' )
+                return false;
+            pattern++;
+        }
+        else if ( *pattern == '[' )
+        {
+            const char *close = strchr( pattern, ']' );
+            if ( close == NULL )
+                return false;
+            
+            const char *member = pattern + 1;
+            bool negated = ( *member == '!' );
+            if ( negated )
+                member++;
+            
+            bool found = false;
+            while ( member < close )
+            {
+                if ( member + 2 < close && member[1] == '-' )
+                {
+                    if ( c >= member[0] && c <= member[2] )
+                        found = true;
+                    member += 3;
+                }
+                else
+                {
+                    if ( c == *member )
+                        found = true;
+                    member++;
+                }
+            }
+            if ( found == negated )
+                return false;
+            pattern = close + 1;
+        }
+        else
+        {
+            if ( c != *pattern )
+                return false;
+            pattern++;
+        }
+        address++;
+    }
+    return ( address == addressEnd );
+}
+
+// Orders addresses component by component: '/' sorts before every other byte, so "/cue/1/go" comes before "/cue/10".
+// Only the first `prefixLength` bytes of `address` are compared if it is longer, so that every address starting with
+// `prefix` compares equal to it.
+static int F53OSCAddressIndexCompare( const char *address, size_t length, const char *prefix, size_t prefixLength )
+{
+    size_t commonLength = MIN( length, prefixLength );
+    for ( size_t i = 0; i < commonLength; i++ )
+    {
+        if ( address[i] == prefix[i] )
+            continue;
+        if ( address[i] == '/' )
+            return -1;
+        if ( prefix[i] == '/' )
+            return 1;
+        return ( (uint8_t)address[i] < (uint8_t)prefix[i] ? -1 : 1 );
+    }
+    return ( length < prefixLength ? -1 : 0 );
+}
+
+static int F53OSCAddressIndexCompareEntries( const F53OSCAddressIndexEntry *a, const F53OSCAddressIndexEntry *b )
+{
+    int result = F53OSCAddressIndexCompare( a->address, a->length, b->address, b->length );
+    if ( result == 0 && a->length > b->length )
+        return 1;
+    return result;
+}
+
+
+@interface F53OSCAddressIndex ()
+{
+    F53OSCAddressIndexEntry *_entries;
+    size_t                  _count;
+    size_t                  _capacity;
+}
+
+- (BOOL) makeEntry:(F53OSCAddressIndexEntry *)entry forObject:(id)object;
+- (void) reserveCapacity:(size_t)capacity;
+- (size_t) lowerBoundOfPrefix:(const char *)prefix length:(size_t)prefixLength;
+- (size_t) upperBoundOfPrefix:(const char *)prefix length:(size_t)prefixLength;
+- (void) removeEntryAtIndex:(size_t)index;
+
+@end
+
+
+@implementation F53OSCAddressIndex
+
+- (instancetype) initWithAddressKeyPath:(NSString *)addressKeyPath
+{
+    return [self initWithObjects:@[] addressKeyPath:addressKeyPath];
+}
+
+- (instancetype) initWithObjects:(NSArray *)objects addressKeyPath:(NSString *)addressKeyPath
+{
+    self = [super init];
+    if ( self )
+    {
+        _addressKeyPath = [addressKeyPath copy];
+        _entries = NULL;
+        _count = 0;
+        _capacity = 0;
+        self.parallelThreshold = 4096;
+        [self addObjects:objects];
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    for ( size_t index = 0; index < _count; index++ )
+    {
+        free( _entries[index].address );
+        CFBridgingRelease( _entries[index].object );
+    }
+    free( _entries );
+}
+
+- (NSUInteger) count
+{
+    @synchronized( self )
+    {
+        return _count;
+    }
+}
+
+#pragma mark - Adding and removing
+
+- (BOOL) makeEntry:(F53OSCAddressIndexEntry *)entry forObject:(id)object
+{
+    id address = [object valueForKeyPath:self.addressKeyPath];
+    if ( ![address isKindOfClass:[NSString class]] )
+        return NO;
+    
+    const char *bytes = [(NSString *)address UTF8String];
+    entry->length = strlen( bytes );
+    entry->address = strdup( bytes );
+    entry->object = CFBridgingRetain( object );
+    return YES;
+}
+
+// Called while synchronized.
+- (void) reserveCapacity:(size_t)capacity
+{
+    if ( capacity <= _capacity )
+        return;
+    
+    size_t newCapacity = MAX( _capacity * 2, 64 );
+    while ( newCapacity < capacity )
+        newCapacity *= 2;
+    _entries = reallocf( _entries, newCapacity * sizeof( F53OSCAddressIndexEntry ) );
+    _capacity = newCapacity;
+}
+
+- (void) addObject:(id)object
+{
+    F53OSCAddressIndexEntry entry;
+    if ( ![self makeEntry:&entry forObject:object] )
+        return;
+    
+    @synchronized( self )
+    {
+        [self reserveCapacity:_count + 1];
+        
+        // After every equal address, so objects at one address stay in the order they were added.
+        size_t index = 0;
+        size_t high = _count;
+        while ( index < high )
+        {
+            size_t middle = index + ( high - index ) / 2;
+            if ( F53OSCAddressIndexCompareEntries( &_entries[middle], &entry ) <= 0 )
+                index = middle + 1;
+            else
+                high = middle;
+        }
+        
+        memmove( &_entries[index + 1], &_entries[index], ( _count - index ) * sizeof( F53OSCAddressIndexEntry ) );
+        _entries[index] = entry;
+        _count++;
+    }
+}
+
+- (void) addObjects:(NSArray *)objects
+{
+    if ( objects.count == 0 )
+        return;
+    
+    // Appended, then sorted with a stable sort, so adding many objects costs one sort rather than a move per object.
+    F53OSCAddressIndexEntry *newEntries = malloc( objects.count * sizeof( F53OSCAddressIndexEntry ) );
+    size_t newCount = 0;
+    for ( id object in objects )
+    {
+        if ( [self makeEntry:&newEntries[newCount] forObject:object] )
+            newCount++;
+    }
+    
+    @synchronized( self )
+    {
+        [self reserveCapacity:_count + newCount];
+        memcpy( &_entries[_count], newEntries, newCount * sizeof( F53OSCAddressIndexEntry ) );
+        _count += newCount;
+        mergesort_b( _entries, _count, sizeof( F53OSCAddressIndexEntry ), ^int( const void *a, const void *b ) {
+            return F53OSCAddressIndexCompareEntries( a, b );
+        } );
+    }
+    
+    free( newEntries );
+}
+
+- (void) removeObject:(id)object
+{
+    const void *objectPointer = (__bridge const void *)object;
+    id address = [object valueForKeyPath:self.addressKeyPath];
+    
+    @synchronized( self )
+    {
+        // Look where the object's address says it is, then everywhere, in case its address changed.
+        if ( [address isKindOfClass:[NSString class]] )
+        {
+            const char *bytes = [(NSString *)address UTF8String];
+            size_t length = strlen( bytes );
+            size_t end = [self upperBoundOfPrefix:bytes length:length];
+            for ( size_t index = [self lowerBoundOfPrefix:bytes length:length]; index < end; index++ )
+            {
+                if ( _entries[index].object == objectPointer && _entries[index].length == length )
+                {
+                    [self removeEntryAtIndex:index];
+                    return;
+                }
+            }
+        }
+        
+        for ( size_t index = 0; index < _count; index++ )
+        {
+            if ( _entries[index].object == objectPointer )
+            {
+                [self removeEntryAtIndex:index];
+                return;
+            }
+        }
+    }
+}
+
+// Called while synchronized.
+- (void) removeEntryAtIndex:(size_t)index
+{
+    free( _entries[index].address );
+    CFBridgingRelease( _entries[index].object );
+    memmove( &_entries[index], &_entries[index + 1], ( _count - index - 1 ) * sizeof( F53OSCAddressIndexEntry ) );
+    _count--;
+}
+
+- (void) removeAllObjects
+{
+    @synchronized( self )
+    {
+        for ( size_t index = 0; index < _count; index++ )
+        {
+            free( _entries[index].address );
+            CFBridgingRelease( _entries[index].object );
+        }
+        _count = 0;
+    }
+}
+
+#pragma mark - Filtering
+
+// Called while synchronized. The first entry that does not sort before addresses starting with `prefix`.
+- (size_t) lowerBoundOfPrefix:(const char *)prefix length:(size_t)prefixLength
+{
+    size_t low = 0;
+    size_t high = _count;
+    while ( low < high )
+    {
+        size_t middle = low + ( high - low ) / 2;
+        if ( F53OSCAddressIndexCompare( _entries[middle].address, _entries[middle].length, prefix, prefixLength ) < 0 )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+// Called while synchronized. The first entry that sorts after addresses starting with `prefix`.
+- (size_t) upperBoundOfPrefix:(const char *)prefix length:(size_t)prefixLength
+{
+    size_t low = 0;
+    size_t high = _count;
+    while ( low < high )
+    {
+        size_t middle = low + ( high - low ) / 2;
+        if ( F53OSCAddressIndexCompare( _entries[middle].address, _entries[middle].length, prefix, prefixLength ) <= 0 )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+- (NSArray *) objectsMatchingPattern:(NSString *)pattern
+{
+    const char *patternBytes = [pattern UTF8String];
+    size_t prefixLength = strcspn( patternBytes, "*?[{" );
+    BOOL isLiteral = ( patternBytes[prefixLength] == '\0' );
+    const char *remainingPattern = patternBytes + prefixLength;
+    
+    NSMutableArray *matches = [NSMutableArray array];
+    @synchronized( self )
+    {
+        // Only addresses that start with the pattern's literal prefix can match.
+        size_t start = [self lowerBoundOfPrefix:patternBytes length:prefixLength];
+        size_t end = [self upperBoundOfPrefix:patternBytes length:prefixLength];
+        size_t candidateCount = end - start;
+        const F53OSCAddressIndexEntry *candidates = _entries + start;
+        
+        if ( isLiteral )
+        {
+            // Equal addresses sort first within the prefix's range.
+            for ( size_t i = 0; i < candidateCount && candidates[i].length == prefixLength; i++ )
+                [matches addObject:(__bridge id)candidates[i].object];
+        }
+        else if ( candidateCount < self.parallelThreshold )
+        {
+            for ( size_t i = 0; i < candidateCount; i++ )
+            {
+                if ( F53OSCPatternMatchesAddress( remainingPattern, candidates[i].address + prefixLength, candidates[i].length - prefixLength ) )
+                    [matches addObject:(__bridge id)candidates[i].object];
+            }
+        }
+        else
+        {
+            // Each chunk marks its own candidates, which are then collected in order.
+            bool *matched = calloc( candidateCount, sizeof( bool ) );
+            size_t chunkCount = (size_t)[NSProcessInfo processInfo].activeProcessorCount * F53OSC_ADDRESS_INDEX_CHUNKS_PER_CPU;
+            size_t chunkLength = ( candidateCount + chunkCount - 1 ) / chunkCount;
+            dispatch_apply( chunkCount, DISPATCH_APPLY_AUTO, ^( size_t chunk ) {
+                size_t chunkEnd = MIN( ( chunk + 1 ) * chunkLength, candidateCount );
+                for ( size_t i = chunk * chunkLength; i < chunkEnd; i++ )
+                    matched[i] = F53OSCPatternMatchesAddress( remainingPattern, candidates[i].address + prefixLength, candidates[i].length - prefixLength );
+            } );
+            
+            for ( size_t i = 0; i < candidateCount; i++ )
+            {
+                if ( matched[i] )
+                    [matches addObject:(__bridge id)candidates[i].object];
+            }
+            free( matched );
+        }
+    }
+    return matches;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -28,10 +28,17 @@
 //  Browses a given domain for a given service type.
 //  Creates an F53OSCClientRecord for each host found advertising that service.
 //  Retains the client record until the service stops advertising or browser is stopped.
+//
+//  Services are found with Bonjour, or with `discoveryBackend` if set, and up to `maxConcurrentResolves` of them are
+//  resolved at once. Resolved addresses are cached for `resolvedAddressLifetime`, across restarts, so that a service
+//  that reappears within it is added right away. It is resolved again in the background, and its client record is
+//  updated if it has moved. A service that is removed while browsing leaves the cache.
 
 #import <Foundation/Foundation.h>
 
+@class F53OSCDiscoveredService;
 @protocol F53OSCBrowserDelegate;
+@protocol F53OSCDiscoveryBackend;
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -42,6 +49,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic)                   BOOL useTCP; // default NO
 @property (nonatomic, copy)             NSArray<NSString *> *hostAddresses;
 @property (nonatomic, strong, nullable) NSNetService *netService;
+@property (nonatomic, strong, nullable) F53OSCDiscoveredService *discoveredService;
 
 @end
 
@@ -52,16 +60,24 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly)         BOOL running;
 @property (nonatomic)                   BOOL useTCP;
 @property (nonatomic)                   BOOL resolveIPv6Addresses; // default NO
+@property (nonatomic)                   NSUInteger maxConcurrentResolves;       // default 16; 0 means no limit
+@property (nonatomic)                   NSTimeInterval resolveTimeout;          // default 5
+@property (nonatomic)                   NSTimeInterval resolvedAddressLifetime; // default 120, the TTL of mDNS address records; 0 disables the cache
+@property (nonatomic, readonly)         NSUInteger resolveCount;                // resolutions started
+@property (nonatomic, readonly)         NSUInteger resolvedAddressCacheHitCount; // services added from the cache before they resolve
 
 // NOTE: changing these properties while the browser is running restarts the browser
 @property (nonatomic, copy)             NSString *domain;       // default "local."
 @property (nonatomic, copy)             NSString *serviceType;  // default "", must be set before starting browser
+@property (nonatomic, strong, nullable) id<F53OSCDiscoveryBackend> discoveryBackend; // default nil (Bonjour)
 
 @property (nonatomic, weak)             id<F53OSCBrowserDelegate> delegate;
 
 - (void)start NS_REQUIRES_SUPER;
 - (void)stop NS_REQUIRES_SUPER;
 
+- (void)removeAllResolvedAddresses;
+
 @end
 
 
@@ -72,6 +88,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 @optional
 - (BOOL)browser:(F53OSCBrowser *)browser shouldAcceptNetService:(NSNetService *)netService;
+- (BOOL)browser:(F53OSCBrowser *)browser shouldAcceptDiscoveredService:(F53OSCDiscoveredService *)service; // called instead of `browser:shouldAcceptNetService:` if implemented
 
 @end
 
@@ -31,6 +31,8 @@
 
 #import "F53OSCBrowser.h"
 
+#import "F53OSCDiscoveryBackend.h"
+
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
@@ -63,29 +65,65 @@ NS_ASSUME_NONNULL_BEGIN
     copy.useTCP = self.useTCP;
     copy.hostAddresses = [self.hostAddresses copyWithZone:zone];
     copy.netService = self.netService;
+    copy.discoveredService = self.discoveredService;
     return copy;
 }
 
 @end
 
 
-@interface F53OSCBrowser () <NSNetServiceBrowserDelegate, NSNetServiceDelegate>
+// The port and socket addresses a service last resolved to, until `expirationTime` on the monotonic clock.
+@interface F53OSCResolvedAddresses : NSObject
+
+@property (nonatomic, assign)   NSInteger port;
+@property (nonatomic, copy)     NSArray<NSData *> *addresses;
+@property (nonatomic, assign)   NSTimeInterval expirationTime;
+
+@end
+
+@implementation F53OSCResolvedAddresses
+@end
+
+
+@interface F53OSCBrowser () <NSNetServiceBrowserDelegate, NSNetServiceDelegate, F53OSCDiscoveryBackendDelegate>
 
 @property (assign, readwrite)                   BOOL running;
+@property (nonatomic, assign, readwrite)        NSUInteger resolveCount;
+@property (nonatomic, assign, readwrite)        NSUInteger resolvedAddressCacheHitCount;
 
 @property (nonatomic, strong, nullable)         NSNetServiceBrowser *netServiceDomainsBrowser;
 @property (nonatomic, strong, nullable)         NSNetServiceBrowser *netServiceBrowser;
-@property (nonatomic, strong)                   NSMutableArray<NSNetService *> *unresolvedNetServices;
 
-@property (nonatomic, strong)                   NSMutableArray<F53OSCClientRecord *> *mutableClientRecords;
+// Services found but not yet resolved, by key; those waiting for a resolve slot are also in `pendingServiceKeys`, in
+// the order found, and those resolving are in `resolvingServiceKeys`.
+@property (nonatomic, strong)                   NSMutableDictionary<NSString *, F53OSCDiscoveredService *> *unresolvedServices;
+@property (nonatomic, strong)                   NSMutableOrderedSet<NSString *> *pendingServiceKeys;
+@property (nonatomic, strong)                   NSMutableSet<NSString *> *resolvingServiceKeys;
+@property (nonatomic, strong)                   NSMutableDictionary<NSString *, F53OSCResolvedAddresses *> *resolvedAddresses;
+
+@property (nonatomic, strong)                   NSMutableOrderedSet<F53OSCClientRecord *> *mutableClientRecords;
+@property (nonatomic, strong)                   NSMutableDictionary<NSString *, F53OSCClientRecord *> *clientRecordsByServiceKey;
+@property (nonatomic, strong)                   NSMutableDictionary<NSString *, NSMutableArray<F53OSCClientRecord *> *> *clientRecordsByHostPort; // in the order added
 
 - (void)setNeedsBeginResolvingNetServices;
 - (void)beginResolvingNetServices;
 
+- (void)addDiscoveredService:(F53OSCDiscoveredService *)service;
+- (void)removeDiscoveredServiceWithKey:(NSString *)key;
+- (void)finishResolvingService:(F53OSCDiscoveredService *)service;
+- (void)failResolvingService:(F53OSCDiscoveredService *)service error:(id)error;
+
 - (nullable F53OSCClientRecord *)clientRecordForHost:(NSString *)host port:(UInt16)port;
 - (nullable F53OSCClientRecord *)clientRecordForNetService:(NSNetService *)netService;
+- (void)addClientRecordForResolvedService:(F53OSCDiscoveredService *)service;
+- (void)updateClientRecord:(F53OSCClientRecord *)clientRecord forResolvedService:(F53OSCDiscoveredService *)service;
+- (void)removeClientRecord:(F53OSCClientRecord *)clientRecord;
+- (nullable NSArray<NSString *> *)hostAddressesForResolvedService:(F53OSCDiscoveredService *)service;
+- (void)addClientRecordToHostPortIndex:(F53OSCClientRecord *)clientRecord;
+- (void)removeClientRecordFromHostPortIndex:(F53OSCClientRecord *)clientRecord;
 
 + (nullable NSString *)IPAddressFromData:(NSData *)data resolveIPv6Addresses:(BOOL)resolveIPv6Addresses;
++ (NSString *)keyForHost:(NSString *)host port:(UInt16)port;
 
 @end
 
@@ -101,12 +139,22 @@ NS_ASSUME_NONNULL_BEGIN
         self.serviceType = @"";
         self.useTCP = YES;
         self.resolveIPv6Addresses = NO;
+        self.maxConcurrentResolves = 16;
+        self.resolveTimeout = 5.0;
+        self.resolvedAddressLifetime = 120.0;
+        self.discoveryBackend = nil;
         
         self.running = NO;
         self.netServiceBrowser = nil;
         
-        self.unresolvedNetServices = [NSMutableArray array];
-        self.mutableClientRecords = [NSMutableArray array];
+        self.unresolvedServices = [NSMutableDictionary dictionary];
+        self.pendingServiceKeys = [NSMutableOrderedSet orderedSet];
+        self.resolvingServiceKeys = [NSMutableSet set];
+        self.resolvedAddresses = [NSMutableDictionary dictionary];
+        
+        self.mutableClientRecords = [NSMutableOrderedSet orderedSet];
+        self.clientRecordsByServiceKey = [NSMutableDictionary dictionary];
+        self.clientRecordsByHostPort = [NSMutableDictionary dictionary];
     }
     return self;
 }
@@ -120,7 +168,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSArray<F53OSCClientRecord *> *)clientRecords
 {
-    return self.mutableClientRecords.copy;
+    return self.mutableClientRecords.array.copy;
 }
 
 - (void)setDomain:(NSString *)domain
@@ -174,6 +222,21 @@ NS_ASSUME_NONNULL_BEGIN
     }
 }
 
+- (void)setDiscoveryBackend:(nullable id<F53OSCDiscoveryBackend>)discoveryBackend
+{
+    if ( _discoveryBackend != discoveryBackend )
+    {
+        BOOL wasRunning = self.running;
+        if ( wasRunning )
+            [self stop];
+        
+        _discoveryBackend = discoveryBackend;
+        
+        if ( wasRunning )
+            [self start];
+    }
+}
+
 #pragma mark -
 
 - (void)start
@@ -193,6 +256,23 @@ NS_ASSUME_NONNULL_BEGIN
     if ( self.serviceType.length == 0 )
         return;
     
+    // Drop addresses that expired while stopped.
+    NSTimeInterval now = [NSProcessInfo processInfo].systemUptime;
+    for ( NSString *aKey in self.resolvedAddresses.allKeys )
+    {
+        if ( self.resolvedAddresses[aKey].expirationTime <= now )
+            [self.resolvedAddresses removeObjectForKey:aKey];
+    }
+    
+    id<F53OSCDiscoveryBackend> discoveryBackend = self.discoveryBackend;
+    if ( discoveryBackend )
+    {
+        self.running = YES;
+        discoveryBackend.delegate = self;
+        [discoveryBackend startSearchingForServicesOfType:self.serviceType inDomain:self.domain];
+        return;
+    }
+    
     // Create Bonjour browser to find available domains
     self.netServiceDomainsBrowser = [[NSNetServiceBrowser alloc] init];
     self.netServiceDomainsBrowser.delegate = self;
@@ -221,68 +301,302 @@ NS_ASSUME_NONNULL_BEGIN
     [self.netServiceBrowser stop];
     self.netServiceBrowser.delegate = nil;
     self.netServiceBrowser = nil;
+    
+    [self.discoveryBackend stop];
+    self.discoveryBackend.delegate = nil;
+    
+    // Stop resolving; resolved addresses stay cached for the next start.
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(beginResolvingNetServices) object:nil];
+    for ( F53OSCDiscoveredService *aService in self.unresolvedServices.allValues )
+    {
+        [aService.netService stop];
+        aService.netService.delegate = nil;
+    }
+    [self.unresolvedServices removeAllObjects];
+    [self.pendingServiceKeys removeAllObjects];
+    [self.resolvingServiceKeys removeAllObjects];
 
     // Stop/remove all clients
-    NSArray<F53OSCClientRecord *> *clientRecords = self.mutableClientRecords.copy;
+    NSArray<F53OSCClientRecord *> *clientRecords = self.mutableClientRecords.array.copy;
     for ( F53OSCClientRecord *aClientRecord in clientRecords )
     {
         aClientRecord.netService = nil;
         
-        [self.mutableClientRecords removeObject:aClientRecord];
+        [self removeClientRecord:aClientRecord];
         [self.delegate browser:self didRemoveClientRecord:aClientRecord];
     }
 }
 
+- (void)removeAllResolvedAddresses
+{
+    [self.resolvedAddresses removeAllObjects];
+}
+
 #pragma mark -
 
 - (void)setNeedsBeginResolvingNetServices
 {
     // this method may be called many times in rapid succession by an NSNetService delegate callback (e.g. if `moreComing` is YES)
-    // - so we cancel previous perform requests to ensure each service begins resolving only once
+    // - so we cancel previous perform requests and begin resolving once per pass of the run loop
+    // - each service is queued only once, so there is no need to wait for the rest of a batch to arrive
     [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(beginResolvingNetServices) object:nil];
-    [self performSelector:@selector(beginResolvingNetServices) withObject:nil afterDelay:0.5];
+    [self performSelector:@selector(beginResolvingNetServices) withObject:nil afterDelay:0.0];
 }
 
 - (void)beginResolvingNetServices
 {
-    NSArray<NSNetService *> *netServices = [self.unresolvedNetServices copy];
-    for ( NSNetService *aService in netServices )
+    // Services resolve concurrently, up to the limit; each one that finishes makes room for the next.
+    NSUInteger maxConcurrentResolves = ( self.maxConcurrentResolves ? self.maxConcurrentResolves : NSUIntegerMax );
+    while ( self.pendingServiceKeys.count && self.resolvingServiceKeys.count < maxConcurrentResolves )
     {
-        if ( aService.addresses.count )
+        NSString *key = self.pendingServiceKeys.firstObject;
+        [self.pendingServiceKeys removeObjectAtIndex:0];
+        
+        F53OSCDiscoveredService *service = self.unresolvedServices[key];
+        if ( !service )
             continue;
         
-        [aService resolveWithTimeout:5.0];
+        [self.resolvingServiceKeys addObject:key];
+        self.resolveCount++;
+        
+        id<F53OSCDiscoveryBackend> discoveryBackend = self.discoveryBackend;
+        if ( discoveryBackend )
+            [discoveryBackend resolveService:service timeout:self.resolveTimeout];
+        else
+            [service.netService resolveWithTimeout:self.resolveTimeout];
     }
 }
 
-#pragma mark - Clients
+#pragma mark - Services
 
-- (nullable F53OSCClientRecord *)clientRecordForHost:(NSString *)host port:(UInt16)port
+- (void)addDiscoveredService:(F53OSCDiscoveredService *)service
 {
-    for ( F53OSCClientRecord *aClientRecord in self.mutableClientRecords )
+    NSString *key = service.key;
+    if ( self.clientRecordsByServiceKey[key] || self.unresolvedServices[key] )
+        return;
+    
+    // A service seen recently is added right away, from the addresses it last resolved to. It is still resolved again
+    // in the background, in case it has moved since; `finishResolvingService:` then updates its record.
+    F53OSCResolvedAddresses *resolvedAddresses = self.resolvedAddresses[key];
+    if ( resolvedAddresses && resolvedAddresses.expirationTime > [NSProcessInfo processInfo].systemUptime )
     {
-        if ( aClientRecord.port != port )
-            continue;
-        
-        for ( NSString *aHostAddress in aClientRecord.hostAddresses )
+        self.resolvedAddressCacheHitCount++;
+        service.port = resolvedAddresses.port;
+        service.addresses = resolvedAddresses.addresses;
+        [self addClientRecordForResolvedService:service];
+    }
+    else
+    {
+        [self.resolvedAddresses removeObjectForKey:key];
+    }
+    
+    self.unresolvedServices[key] = service;
+    [self.pendingServiceKeys addObject:key];
+    [self setNeedsBeginResolvingNetServices];
+}
+
+- (void)removeDiscoveredServiceWithKey:(NSString *)key
+{
+    F53OSCDiscoveredService *unresolvedService = self.unresolvedServices[key];
+    if ( unresolvedService )
+    {
+        if ( [self.resolvingServiceKeys containsObject:key] )
         {
-            if ( [aHostAddress isEqualToString:host] && aClientRecord.port == port )
-                return aClientRecord;
+            [self.discoveryBackend cancelResolvingService:unresolvedService];
+            [unresolvedService.netService stop];
+            [self.resolvingServiceKeys removeObject:key];
+            [self setNeedsBeginResolvingNetServices];
         }
+        unresolvedService.netService.delegate = nil;
+        [self.unresolvedServices removeObjectForKey:key];
+        [self.pendingServiceKeys removeObject:key];
     }
     
-    return nil;
+    // A service that comes back may not be where it was.
+    [self.resolvedAddresses removeObjectForKey:key];
+    
+    F53OSCClientRecord *clientRecord = self.clientRecordsByServiceKey[key];
+    if ( !clientRecord )
+        return;
+    
+    [self removeClientRecord:clientRecord];
+    [self.delegate browser:self didRemoveClientRecord:clientRecord];
+}
+
+- (void)finishResolvingService:(F53OSCDiscoveredService *)service
+{
+    NSString *key = service.key;
+    if ( [self.resolvingServiceKeys containsObject:key] )
+    {
+        [self.resolvingServiceKeys removeObject:key];
+        [self setNeedsBeginResolvingNetServices];
+    }
+    [self.unresolvedServices removeObjectForKey:key];
+    [self.pendingServiceKeys removeObject:key];
+    
+    // Once resolved, we can remove the net service from our local records.
+    // (The client record will still hold on to it, though.)
+    service.netService.delegate = nil;
+    
+    NSTimeInterval resolvedAddressLifetime = self.resolvedAddressLifetime;
+    if ( resolvedAddressLifetime > 0.0 && service.port >= 0 && service.addresses.count )
+    {
+        F53OSCResolvedAddresses *resolvedAddresses = [[F53OSCResolvedAddresses alloc] init];
+        resolvedAddresses.port = service.port;
+        resolvedAddresses.addresses = service.addresses;
+        resolvedAddresses.expirationTime = [NSProcessInfo processInfo].systemUptime + resolvedAddressLifetime;
+        self.resolvedAddresses[key] = resolvedAddresses;
+    }
+    
+    F53OSCClientRecord *clientRecord = self.clientRecordsByServiceKey[key];
+    if ( clientRecord )
+        [self updateClientRecord:clientRecord forResolvedService:service];
+    else
+        [self addClientRecordForResolvedService:service];
+}
+
+- (void)failResolvingService:(F53OSCDiscoveredService *)service error:(id)error
+{
+    NSString *key = service.key;
+    if ( [self.resolvingServiceKeys containsObject:key] )
+    {
+        [self.resolvingServiceKeys removeObject:key];
+        [self setNeedsBeginResolvingNetServices];
+    }
+    [self.unresolvedServices removeObjectForKey:key];
+    [self.pendingServiceKeys removeObject:key];
+    
+    [service.netService stop];
+    service.netService.delegate = nil;
+    
+    NSLog( @"[browser] Error: Failed to resolve service: %@ - %@", ( service.netService ?: service ), error );
+}
+
+#pragma mark - Clients
+
+- (nullable F53OSCClientRecord *)clientRecordForHost:(NSString *)host port:(UInt16)port
+{
+    return self.clientRecordsByHostPort[[F53OSCBrowser keyForHost:host port:port]].firstObject;
 }
 
 - (nullable F53OSCClientRecord *)clientRecordForNetService:(NSNetService *)netService
 {
-    for ( F53OSCClientRecord *aClientRecord in self.mutableClientRecords )
+    NSString *key = [F53OSCDiscoveredService keyForServiceWithName:netService.name type:netService.type domain:netService.domain];
+    return self.clientRecordsByServiceKey[key];
+}
+
+- (void)addClientRecordForResolvedService:(F53OSCDiscoveredService *)service
+{
+    NSString *key = service.key;
+    if ( self.clientRecordsByServiceKey[key] )
+        return;
+    
+    // Allow delegate to deny connecting to this service
+    if ( [self.delegate respondsToSelector:@selector(browser:shouldAcceptDiscoveredService:)] )
+    {
+        if ( [self.delegate browser:self shouldAcceptDiscoveredService:service] == NO )
+            return;
+    }
+    else if ( service.netService && [self.delegate respondsToSelector:@selector(browser:shouldAcceptNetService:)] &&
+             [self.delegate browser:self shouldAcceptNetService:(NSNetService * _Nonnull)service.netService] == NO )
     {
-        if ( [aClientRecord.netService isEqual:netService] )
-            return aClientRecord;
+        return;
     }
     
-    return nil;
+    NSArray<NSString *> *hostAddresses = [self hostAddressesForResolvedService:service];
+    if ( !hostAddresses )
+        return;
+    
+    F53OSCClientRecord *clientRecord = [F53OSCClientRecord new];
+    clientRecord.port = service.port;
+    clientRecord.useTCP = self.useTCP;
+    clientRecord.hostAddresses = hostAddresses;
+    clientRecord.netService = service.netService;
+    clientRecord.discoveredService = service;
+    
+#if DEBUG_BROWSER
+    NSLog( @"[browser] adding client: %@", clientRecord );
+#endif
+    
+    [self.mutableClientRecords addObject:clientRecord];
+    self.clientRecordsByServiceKey[key] = clientRecord;
+    [self addClientRecordToHostPortIndex:clientRecord];
+    
+    [self.delegate browser:self didAddClientRecord:clientRecord];
+}
+
+// A record added from cached addresses is brought up to date once its service resolves again. The record is kept, so
+// that delegates holding on to it see the new addresses.
+- (void)updateClientRecord:(F53OSCClientRecord *)clientRecord forResolvedService:(F53OSCDiscoveredService *)service
+{
+    NSArray<NSString *> *hostAddresses = [self hostAddressesForResolvedService:service];
+    if ( !hostAddresses )
+        return;
+    
+    if ( clientRecord.port == service.port && [clientRecord.hostAddresses isEqualToArray:hostAddresses] )
+        return;
+    
+#if DEBUG_BROWSER
+    NSLog( @"[browser] updating client: %@ to %@ port %ld", clientRecord, hostAddresses, (long)service.port );
+#endif
+    
+    [self removeClientRecordFromHostPortIndex:clientRecord];
+    clientRecord.port = service.port;
+    clientRecord.hostAddresses = hostAddresses;
+    [self addClientRecordToHostPortIndex:clientRecord];
+}
+
+- (void)removeClientRecord:(F53OSCClientRecord *)clientRecord
+{
+    [self.mutableClientRecords removeObject:clientRecord];
+    
+    NSString *key = clientRecord.discoveredService.key;
+    if ( key && self.clientRecordsByServiceKey[key] == clientRecord )
+        [self.clientRecordsByServiceKey removeObjectForKey:key];
+    
+    [self removeClientRecordFromHostPortIndex:clientRecord];
+}
+
+// Returns nil if the service has no port, or no addresses a client can use.
+- (nullable NSArray<NSString *> *)hostAddressesForResolvedService:(F53OSCDiscoveredService *)service
+{
+    NSInteger port = service.port;
+    if ( port < 0 || port > UINT16_MAX ) // -1 = not resolved
+        return nil;
+    
+    NSMutableArray<NSString *> *hostAddresses = [NSMutableArray arrayWithCapacity:service.addresses.count];
+    for ( NSData *aAddress in service.addresses )
+    {
+        NSString *host = [F53OSCBrowser IPAddressFromData:aAddress resolveIPv6Addresses:self.resolveIPv6Addresses];
+        if ( host )
+            [hostAddresses addObject:host];
+    }
+    return ( hostAddresses.count ? hostAddresses.copy : nil );
+}
+
+- (void)addClientRecordToHostPortIndex:(F53OSCClientRecord *)clientRecord
+{
+    for ( NSString *aHostAddress in clientRecord.hostAddresses )
+    {
+        NSString *hostPortKey = [F53OSCBrowser keyForHost:aHostAddress port:clientRecord.port];
+        NSMutableArray<F53OSCClientRecord *> *clientRecords = self.clientRecordsByHostPort[hostPortKey];
+        if ( clientRecords )
+            [clientRecords addObject:clientRecord];
+        else
+            self.clientRecordsByHostPort[hostPortKey] = [NSMutableArray arrayWithObject:clientRecord];
+    }
+}
+
+- (void)removeClientRecordFromHostPortIndex:(F53OSCClientRecord *)clientRecord
+{
+    for ( NSString *aHostAddress in clientRecord.hostAddresses )
+    {
+        NSString *hostPortKey = [F53OSCBrowser keyForHost:aHostAddress port:clientRecord.port];
+        NSMutableArray<F53OSCClientRecord *> *clientRecords = self.clientRecordsByHostPort[hostPortKey];
+        [clientRecords removeObjectIdenticalTo:clientRecord];
+        if ( clientRecords && !clientRecords.count )
+            [self.clientRecordsByHostPort removeObjectForKey:hostPortKey];
+    }
 }
 
 #pragma mark - NSNetServiceBrowserDelegate
@@ -360,11 +674,10 @@ NS_ASSUME_NONNULL_BEGIN
 #endif
     
     netService.delegate = self;
-    [self.unresolvedNetServices addObject:netService];
     
     // this may be called many times, especially when `moreComing` is YES
-    // - so we coalesce delegate callbacks using our "setNeedsNotify..." method
-    [self setNeedsBeginResolvingNetServices];
+    // - so we coalesce resolving using our "setNeedsBegin..." method
+    [self addDiscoveredService:[[F53OSCDiscoveredService alloc] initWithNetService:netService]];
 }
 
 - (void)netServiceBrowser:(NSNetServiceBrowser *)aNetServiceBrowser didRemoveService:(NSNetService *)netService moreComing:(BOOL)moreComing
@@ -373,12 +686,7 @@ NS_ASSUME_NONNULL_BEGIN
     NSLog( @"[browser] netServiceBrowser:didRemoveService: %@ moreComing: %@", netService, ( moreComing ? @"YES" : @"NO" ) );
 #endif
     
-    F53OSCClientRecord *clientRecord = [self clientRecordForNetService:netService];
-    if ( !clientRecord )
-        return;
-    
-    [self.mutableClientRecords removeObject:clientRecord];
-    [self.delegate browser:self didRemoveClientRecord:clientRecord];
+    [self removeDiscoveredServiceWithKey:[F53OSCDiscoveredService keyForServiceWithName:netService.name type:netService.type domain:netService.domain]];
 }
 
 #pragma mark - NSNetServiceDelegate
@@ -392,42 +700,14 @@ NS_ASSUME_NONNULL_BEGIN
     NSAssert( [NSThread isMainThread], @"[browser] netServiceDidResolveAddress: is not thread-safe and expects to be called on the main thread." );
 #endif
     
-    // Allow delegate to deny connecting to this service
-    if ( [self.delegate respondsToSelector:@selector(browser:shouldAcceptNetService:)] &&
-        [self.delegate browser:self shouldAcceptNetService:netService] == NO )
-        return;
-    
-    NSInteger port = netService.port;
-    if ( port < 0 ) // -1 = not resolved
-        return;
+    NSString *key = [F53OSCDiscoveredService keyForServiceWithName:netService.name type:netService.type domain:netService.domain];
+    F53OSCDiscoveredService *service = self.unresolvedServices[key];
+    if ( !service )
+        service = [[F53OSCDiscoveredService alloc] initWithNetService:netService];
     
-    NSMutableArray<NSString *> *hostAddresses = [NSMutableArray arrayWithCapacity:netService.addresses.count];
-    for ( NSData *aAddress in netService.addresses )
-    {
-        NSString *host = [F53OSCBrowser IPAddressFromData:aAddress resolveIPv6Addresses:self.resolveIPv6Addresses];
-        if ( host )
-            [hostAddresses addObject:host];
-    }
-    if ( !hostAddresses.count )
-        return;
-    
-    F53OSCClientRecord *clientRecord = [F53OSCClientRecord new];
-    clientRecord.port = port;
-    clientRecord.useTCP = self.useTCP;
-    clientRecord.hostAddresses = hostAddresses.copy;
-    clientRecord.netService = netService;
-    
-    // Once resolved, we can remove the net service from our local records.
-    // (The client record will still hold on to it, though.)
-    netService.delegate = nil;
-    [self.unresolvedNetServices removeObject:netService];
-    
-#if DEBUG_BROWSER
-    NSLog( @"[browser] adding client: %@", client );
-#endif
-    
-    [self.mutableClientRecords addObject:clientRecord];
-    [self.delegate browser:self didAddClientRecord:clientRecord];
+    service.port = netService.port;
+    service.addresses = netService.addresses ?: @[];
+    [self finishResolvingService:service];
 }
 
 - (void)netService:(NSNetService *)netService didNotResolve:(NSDictionary<NSString *, NSNumber *> *)error
@@ -436,15 +716,56 @@ NS_ASSUME_NONNULL_BEGIN
     NSAssert( [NSThread isMainThread], @"[browser] netService:didNotResolve: is not thread-safe and expects to be called on the main thread." );
 #endif
     
-    [netService stop];
-    netService.delegate = nil;
-    [self.unresolvedNetServices removeObject:netService];
+    NSString *key = [F53OSCDiscoveredService keyForServiceWithName:netService.name type:netService.type domain:netService.domain];
+    F53OSCDiscoveredService *service = self.unresolvedServices[key];
+    if ( !service )
+        service = [[F53OSCDiscoveredService alloc] initWithNetService:netService];
     
-    NSLog( @"[browser] Error: Failed to resolve service: %@ - %@", netService, error );
+    [self failResolvingService:service error:error];
+}
+
+#pragma mark - F53OSCDiscoveryBackendDelegate
+
+- (void)discoveryBackend:(id<F53OSCDiscoveryBackend>)backend didFindService:(F53OSCDiscoveredService *)service
+{
+    if ( backend != self.discoveryBackend || !self.running )
+        return;
+    
+    [self addDiscoveredService:service];
+}
+
+- (void)discoveryBackend:(id<F53OSCDiscoveryBackend>)backend didRemoveService:(F53OSCDiscoveredService *)service
+{
+    if ( backend != self.discoveryBackend || !self.running )
+        return;
+    
+    [self removeDiscoveredServiceWithKey:service.key];
+}
+
+- (void)discoveryBackend:(id<F53OSCDiscoveryBackend>)backend didResolveService:(F53OSCDiscoveredService *)service
+{
+    if ( backend != self.discoveryBackend || !self.unresolvedServices[service.key] )
+        return;
+    
+    [self finishResolvingService:service];
+}
+
+- (void)discoveryBackend:(id<F53OSCDiscoveryBackend>)backend didNotResolveService:(F53OSCDiscoveredService *)service error:(NSError *)error
+{
+    if ( backend != self.discoveryBackend || !self.unresolvedServices[service.key] )
+        return;
+    
+    [self failResolvingService:service error:error];
 }
 
 #pragma mark - Utility
 
+// Hosts are bracketed, so that IPv6 addresses can not run into the port.
++ (NSString *)keyForHost:(NSString *)host port:(UInt16)port
+{
+    return [NSString stringWithFormat:@"[%@]:%hu", host, port];
+}
+
 + (nullable NSString *)IPAddressFromData:(NSData *)data resolveIPv6Addresses:(BOOL)resolveIPv6Addresses
 {
     typedef union {
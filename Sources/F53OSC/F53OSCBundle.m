@@ -31,7 +31,7 @@
 #import "F53OSCBundle.h"
 
 #import "F53OSCTimeTag.h"
-#import "F53OSCFoundationAdditions.h"
+#import "F53OSCWire.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -100,14 +100,28 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSData *) packetData
 {
-    NSMutableData *result = [[@"#bundle" oscStringData] mutableCopy];
+    NSMutableData *result = [NSMutableData data];
+    [self appendPacketDataToData:result];
+    return result;
+}
+
+- (void) appendPacketDataToData:(NSMutableData *)data
+{
+    NSArray<NSData *> *elements = self.elements;
+    NSUInteger size = 16; // "#bundle" + time tag
+    for ( NSData *element in elements )
+        size += F53OSCWireBlobSize( element.length );
     
-    [result appendData:[self.timeTag oscTimeTagData]];
+    NSUInteger offset = data.length;
+    [data increaseLengthBy:size];
     
-    for ( NSData *element in self.elements )
-        [result appendData:[element oscBlobData]];
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit( &writer, (uint8_t *)data.mutableBytes + offset, size );
+    F53OSCWireWriteBundleHeader( &writer, self.timeTag.wireValue );
     
-    return result;
+    // Each element is written as an OSC blob (int32 size followed by the element bytes) directly into `data`.
+    for ( NSData *element in elements )
+        F53OSCWireWriteBlob( &writer, element.bytes, element.length );
 }
 
 - (nullable NSString *) asQSC
@@ -0,0 +1,87 @@
+//
+//  F53OSCBundleBuilder.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCPacket.h>
+#else
+#import "F53OSCPacket.h"
+#endif
+
+@class F53OSCTimeTag;
+
+//
+//  F53OSCBundleBuilder encodes messages and nested bundles directly into a single output buffer.
+//  Element sizes are reserved up front and written in place once each element is complete,
+//  so no per-element NSData is created and nothing is copied a second time.
+//
+//  When `maxPacketSize` is set, a logical batch is split at top-level element boundaries into
+//  as many bundles as needed so that each one fits in a single UDP datagram.
+//
+//  Example usage:
+//  F53OSCBundleBuilder *builder = [F53OSCBundleBuilder builderWithTimeTag:[F53OSCTimeTag immediateTimeTag]];
+//  builder.maxPacketSize = F53OSCEthernetUDPPayloadSize;
+//  [builder addPacket:message1];
+//  [builder beginBundleWithTimeTag:timeTag];
+//  [builder addPacket:message2];
+//  [builder endBundle];
+//  for ( NSData *packet in [builder finish] )
+//      ...
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT const NSUInteger F53OSCEthernetUDPPayloadSize; // 1472 bytes: 1500 byte Ethernet MTU less IPv4 and UDP headers
+
+@interface F53OSCBundleBuilder : NSObject
+
++ (F53OSCBundleBuilder *) builderWithTimeTag:(F53OSCTimeTag *)timeTag;
+
+// Convenience: encodes `packets` into one or more bundles, each no larger than `maxPacketSize` (0 for no limit).
++ (NSArray<NSData *> *) bundleDataWithPackets:(NSArray<F53OSCPacket *> *)packets
+                                      timeTag:(F53OSCTimeTag *)timeTag
+                                maxPacketSize:(NSUInteger)maxPacketSize;
+
+@property (strong) F53OSCTimeTag *timeTag;              // time tag of each top-level bundle, default immediate
+@property (nonatomic, assign) NSUInteger maxPacketSize; // default 0 (no limit)
+@property (nonatomic, readonly) NSUInteger bundleCount; // number of top-level bundles produced so far, including the one in progress
+@property (nonatomic, readonly) NSUInteger length;      // length of the top-level bundle in progress
+@property (nonatomic, readonly) NSUInteger elementCount; // number of top-level elements in the bundle in progress
+
+- (void) addPacket:(F53OSCPacket *)packet; // F53OSCMessage or F53OSCBundle
+- (void) addPacketData:(NSData *)packetData; // already-encoded message or bundle; data that is not a multiple of 4 bytes is rejected
+
+- (void) beginBundleWithTimeTag:(F53OSCTimeTag *)timeTag;
+- (void) endBundle;
+
+- (NSArray<NSData *> *) takeCompletedBundles; // returns bundles already closed by splitting, leaving the bundle in progress in place
+- (NSArray<NSData *> *) finish; // closes any open nested bundles and returns the encoded top-level bundles; the builder is then reset
+- (void) reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,254 @@
+//
+//  F53OSCBundleBuilder.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCBundleBuilder.h"
+
+#import "F53OSCTimeTag.h"
+#import "F53OSCWire.h"
+#import "F53OSCFoundationAdditions.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+const NSUInteger F53OSCEthernetUDPPayloadSize = 1472;
+
+#define F53_OSC_BUNDLE_HEADER_LENGTH    16  // "#bundle\0" + 8 byte time tag
+
+@interface F53OSCBundleBuilder ()
+
+@property (strong) NSMutableArray<NSData *> *completedBundles;
+@property (strong, nullable) NSMutableData *buffer;                 // top-level bundle in progress
+@property (strong) NSMutableArray<NSNumber *> *openBundleOffsets;   // offsets of the size fields of open nested bundles
+@property (assign) NSUInteger topLevelElementCount;
+
+@end
+
+@implementation F53OSCBundleBuilder
+
++ (F53OSCBundleBuilder *) builderWithTimeTag:(F53OSCTimeTag *)timeTag
+{
+    F53OSCBundleBuilder *builder = [F53OSCBundleBuilder new];
+    builder.timeTag = timeTag;
+    return builder;
+}
+
++ (NSArray<NSData *> *) bundleDataWithPackets:(NSArray<F53OSCPacket *> *)packets
+                                      timeTag:(F53OSCTimeTag *)timeTag
+                                maxPacketSize:(NSUInteger)maxPacketSize
+{
+    F53OSCBundleBuilder *builder = [F53OSCBundleBuilder builderWithTimeTag:timeTag];
+    builder.maxPacketSize = maxPacketSize;
+    for ( F53OSCPacket *packet in packets )
+        [builder addPacket:packet];
+    return [builder finish];
+}
+
+- (instancetype) init
+{
+    self = [super init];
+    if ( self )
+    {
+        self.timeTag = [F53OSCTimeTag immediateTimeTag];
+        self.maxPacketSize = 0;
+        self.completedBundles = [NSMutableArray array];
+        self.buffer = nil;
+        self.openBundleOffsets = [NSMutableArray array];
+        self.topLevelElementCount = 0;
+    }
+    return self;
+}
+
+- (NSUInteger) bundleCount
+{
+    return self.completedBundles.count + ( self.buffer ? 1 : 0 );
+}
+
+- (NSUInteger) length
+{
+    return self.buffer.length;
+}
+
+- (NSUInteger) elementCount
+{
+    return ( self.buffer ? self.topLevelElementCount : 0 );
+}
+
+#pragma mark - building
+
+- (void) addPacket:(F53OSCPacket *)packet
+{
+    NSMutableData *buffer = [self currentBuffer];
+    NSUInteger sizeOffset = [self reserveSizeInBuffer:buffer];
+    [packet appendPacketDataToData:buffer];
+    [self writeSizeAtOffset:sizeOffset];
+
+    if ( self.openBundleOffsets.count == 0 )
+        [self didAppendTopLevelElementAtOffset:sizeOffset];
+}
+
+- (void) addPacketData:(NSData *)packetData
+{
+    // Encoded OSC packets are always a multiple of 4 bytes. Padding anything else would count toward its size.
+    if ( packetData.length == 0 || packetData.length % 4 != 0 )
+    {
+        NSLog( @"Error: F53OSCBundleBuilder can not add packet data of length %lu; OSC packets are a non-zero multiple of 4 bytes.", (unsigned long)packetData.length );
+        return;
+    }
+    
+    NSMutableData *buffer = [self currentBuffer];
+    NSUInteger sizeOffset = buffer.length;
+    [packetData appendOSCBlobDataToData:buffer];
+
+    if ( self.openBundleOffsets.count == 0 )
+        [self didAppendTopLevelElementAtOffset:sizeOffset];
+}
+
+- (void) beginBundleWithTimeTag:(F53OSCTimeTag *)timeTag
+{
+    NSMutableData *buffer = [self currentBuffer];
+    NSUInteger sizeOffset = [self reserveSizeInBuffer:buffer];
+    [self appendBundleHeaderWithTimeTag:timeTag toData:buffer];
+    [self.openBundleOffsets addObject:@( sizeOffset )];
+}
+
+- (void) endBundle
+{
+    NSNumber *offset = self.openBundleOffsets.lastObject;
+    if ( offset == nil )
+    {
+        NSLog( @"Error: F53OSCBundleBuilder endBundle called without a matching beginBundleWithTimeTag:." );
+        return;
+    }
+
+    [self.openBundleOffsets removeLastObject];
+    [self writeSizeAtOffset:offset.unsignedIntegerValue];
+
+    if ( self.openBundleOffsets.count == 0 )
+        [self didAppendTopLevelElementAtOffset:offset.unsignedIntegerValue];
+}
+
+- (NSArray<NSData *> *) takeCompletedBundles
+{
+    NSArray<NSData *> *result = [self.completedBundles copy];
+    [self.completedBundles removeAllObjects];
+    return result;
+}
+
+- (NSArray<NSData *> *) finish
+{
+    if ( self.openBundleOffsets.count )
+        NSLog( @"Warning: F53OSCBundleBuilder closing %lu unterminated nested bundle(s).", (unsigned long)self.openBundleOffsets.count );
+    while ( self.openBundleOffsets.count )
+        [self endBundle];
+
+    if ( self.buffer )
+        [self.completedBundles addObject:(NSData * _Nonnull)self.buffer];
+
+    NSArray<NSData *> *result = [self.completedBundles copy];
+    [self reset];
+    return result;
+}
+
+- (void) reset
+{
+    [self.completedBundles removeAllObjects];
+    [self.openBundleOffsets removeAllObjects];
+    self.buffer = nil;
+    self.topLevelElementCount = 0;
+}
+
+#pragma mark - private
+
+- (NSMutableData *) currentBuffer
+{
+    if ( !self.buffer )
+    {
+        NSUInteger capacity = ( self.maxPacketSize ? self.maxPacketSize : 512 );
+        NSMutableData *buffer = [NSMutableData dataWithCapacity:capacity];
+        [self appendBundleHeaderWithTimeTag:self.timeTag toData:buffer];
+        self.buffer = buffer;
+        self.topLevelElementCount = 0;
+    }
+    return (NSMutableData * _Nonnull)self.buffer;
+}
+
+- (void) appendBundleHeaderWithTimeTag:(F53OSCTimeTag *)timeTag toData:(NSMutableData *)data
+{
+    NSUInteger offset = data.length;
+    [data increaseLengthBy:F53_OSC_BUNDLE_HEADER_LENGTH];
+    
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit( &writer, (uint8_t *)data.mutableBytes + offset, F53_OSC_BUNDLE_HEADER_LENGTH );
+    F53OSCWireWriteBundleHeader( &writer, timeTag.wireValue );
+}
+
+- (NSUInteger) reserveSizeInBuffer:(NSMutableData *)buffer
+{
+    NSUInteger offset = buffer.length;
+    [buffer increaseLengthBy:sizeof( UInt32 )];
+    return offset;
+}
+
+- (void) writeSizeAtOffset:(NSUInteger)offset
+{
+    NSMutableData *buffer = (NSMutableData * _Nonnull)self.buffer;
+    UInt32 size = (UInt32)( buffer.length - offset - sizeof( UInt32 ) );
+    size = OSSwapHostToBigInt32( size );
+    memcpy( (char *)buffer.mutableBytes + offset, &size, sizeof( UInt32 ) );
+}
+
+- (void) didAppendTopLevelElementAtOffset:(NSUInteger)offset
+{
+    self.topLevelElementCount++;
+
+    NSMutableData *buffer = (NSMutableData * _Nonnull)self.buffer;
+    if ( self.maxPacketSize == 0 || buffer.length <= self.maxPacketSize )
+        return;
+
+    if ( self.topLevelElementCount > 1 )
+    {
+        // The element just written does not fit. Close out the bundle before it and start a new bundle with it.
+        NSData *element = [buffer subdataWithRange:NSMakeRange( offset, buffer.length - offset )];
+        [buffer setLength:offset];
+        [self.completedBundles addObject:buffer];
+        self.buffer = nil;
+
+        buffer = [self currentBuffer];
+        [buffer appendData:element];
+        self.topLevelElementCount = 1;
+    }
+
+    if ( buffer.length > self.maxPacketSize )
+        NSLog( @"Warning: F53OSCBundleBuilder element of %lu bytes does not fit within maxPacketSize %lu.", (unsigned long)( buffer.length - F53_OSC_BUNDLE_HEADER_LENGTH ), (unsigned long)self.maxPacketSize );
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
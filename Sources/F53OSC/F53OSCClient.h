@@ -36,6 +36,12 @@
 #import "F53OSCMessage.h"
 #endif
 
+@class F53OSCConflationBuffer;
+@class F53OSCEncryptSessionCache;
+@class F53OSCOutboundQueue;
+@class F53OSCPriorityScheduler;
+@class F53OSCReadFlowControl;
+@class F53OSCTransportEngine;
 
 @protocol F53OSCClientDelegate;
 
@@ -48,6 +54,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, weak)                     id<F53OSCClientDelegate> delegate;
 @property (nonatomic, strong, null_resettable)  dispatch_queue_t socketDelegateQueue; // defaults to main queue
+@property (nonatomic, strong, null_resettable)  dispatch_queue_t delegateCallbackQueue; // defaults to main queue; see F53OSCClientDelegate
 @property (nonatomic, copy, nullable)           NSString *interface;
 @property (nonatomic, copy, nullable)           NSString *host;     // default "localhost"
 @property (nonatomic, assign)                   UInt16 port;        // default 53000
@@ -55,12 +62,33 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign)                   BOOL useTcp;        // default NO
 @property (nonatomic, assign)                   NSTimeInterval tcpTimeout; // default -1 (no timeout)
 @property (nonatomic, assign)                   NSUInteger readChunkSize;  // default 0 (no partial reads)
+@property (nonatomic, assign)                   UInt8 multicastTTL;        // default 1 (local network only); applies when `host` is a multicast group
+@property (nonatomic, assign)                   BOOL multicastLoopback;    // default YES; applies when `host` is a multicast group
+@property (nonatomic, copy, nullable)           F53OSCSocketOptions *socketOptions; // default nil; applied to the client's own socket, not to a transport engine's shared sockets
+@property (nonatomic, assign)                   NSTimeInterval coalescingInterval;  // default 0 (disabled)
+@property (nonatomic, assign)                   NSUInteger coalescingMaxPacketSize; // default F53OSCEthernetUDPPayloadSize
+@property (nonatomic, assign)                   NSUInteger maxMessageBatchSize;     // default 0 (no limit); applies when the delegate implements `takeMessages:`
+@property (nonatomic, assign)                   NSTimeInterval messageBatchLatency; // default 0 (deliver at the end of each read)
+@property (strong, nullable)                    F53OSCConflationBuffer *conflationBuffer; // default nil; when set, messages reach the delegate through it
+@property (strong, nullable)                    F53OSCPriorityScheduler *priorityScheduler; // default nil; when set, messages reach the delegate in lane priority order
+@property (strong, nullable)                    F53OSCReadFlowControl *readFlowControl; // default nil; when set, TCP reads pause while too many received messages are undelivered
+@property (strong, nullable)                    F53OSCTransportEngine *transportEngine; // default nil; when set, the client sends through the engine's shared sockets and queues
+@property (strong, nullable)                    F53OSCOutboundQueue *outboundQueue; // default nil; when set, TCP packets sent while disconnected are held, framed, until the connection is made
+@property (strong, nullable)                    F53OSCEncryptSessionCache *encryptionSessionCache; // default nil; when set, encrypted reconnects resume the last session the server issued a ticket for
+@property (assign)                              BOOL udpEncryptionEnabled;              // default NO; when set, `connectEncryptedWithKeyPair:` runs the encryption handshake over UDP too, and datagrams are sealed once the server approves
+@property (nonatomic, assign)                   BOOL reconnectsAutomatically;           // default NO; TCP reconnects with exponential backoff after a connection fails or drops
+@property (nonatomic, assign)                   NSTimeInterval reconnectMinimumDelay;   // default 0.25
+@property (nonatomic, assign)                   NSTimeInterval reconnectMaximumDelay;   // default 8
+@property (readonly)                            NSUInteger reconnectAttemptCount;
+@property (readonly)                            NSUInteger reconnectCount;              // attempts that connected
 @property (nonatomic, strong, nullable)         id userData;
 @property (nonatomic, copy)                     NSDictionary<NSString *, id> *state;
 @property (nonatomic, readonly)                 NSString *title;
 @property (nonatomic, readonly)                 BOOL isValid;
 @property (nonatomic, readonly)                 BOOL isConnected;
 @property (nonatomic, readonly)                 BOOL hostIsLocal;
+@property (nonatomic, readonly)                 BOOL hostIsMulticast; // UDP sends to a multicast group, out of `interface` if set
+@property (nonatomic, readonly)                 BOOL isEncrypting;
 
 - (BOOL) connect;   // NOTE: returns NO if internal F53OSCSocket uses TCP and is already connected
 - (BOOL) connectEncryptedWithKeyPair:(NSData *)keyPair;
@@ -68,14 +96,25 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void) sendPacket:(F53OSCPacket *)packet;
 
+// Sends an already-encoded OSC message or bundle, flushing any gathered packets first; it is never gathered itself.
+// `slipFramedData`, if given, must be `data` already SLIP framed. TCP clients that are not encrypting write it as is,
+// so a packet sent to many clients is only framed once. See F53OSCClientGroup.
+- (void) sendPacketData:(NSData *)data slipFramedData:(nullable NSData *)slipFramedData;
+
+// When `coalescingInterval` is greater than 0, packets passed to `sendPacket:` are gathered into "#bundle" packets
+// with an immediate time tag rather than each being sent on its own. A bundle is sent once it reaches
+// `coalescingMaxPacketSize`, once `coalescingInterval` has elapsed since its first packet was gathered, or on `flush`.
+// F53OSC control messages are never gathered; they flush any gathered packets first so send order is kept.
+- (void) flush;
+
 @end
 
 @protocol F53OSCClientDelegate <F53OSCPacketDestination>
 
-@optional // All called on the main thread.
+@optional // All called asynchronously on the client's `delegateCallbackQueue`.
 - (void) clientDidConnect:(F53OSCClient *)client;
 - (void) clientDidDisconnect:(F53OSCClient *)client;
-- (void) client:(F53OSCClient *)client didReadData:(NSUInteger)lengthOfCurrentRead;
+- (void) client:(F53OSCClient *)client didReadData:(NSUInteger)lengthOfCurrentRead; // coalesced; reports the latest length when several reads happen before it runs
 
 @end
 
@@ -30,9 +30,27 @@
 
 #import "F53OSCClient.h"
 
+#if __has_include(<F53OSC/F53OSC-Swift.h>) // F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSC-Swift.h>
+#elif SWIFT_PACKAGE // Swift Package Manager
+@import F53OSCEncrypt;
+#endif
 #import "F53OSCParser.h"
 #import "F53OSCEncryptHandshake.h"
-
+#import "F53OSCEncryptSessionCache.h"
+#import "F53OSCBundle.h"
+#import "F53OSCBundleBuilder.h"
+#import "F53OSCConflationBuffer.h"
+#import "F53OSCDatagramCipher.h"
+#import "F53OSCMessageBatcher.h"
+#import "F53OSCOutboundQueue.h"
+#import "F53OSCPriorityScheduler.h"
+#import "F53OSCReadFlowControl.h"
+#import "F53OSCTimeTag.h"
+#import "F53OSCTransportEngine.h"
+
+#define F53OSCClientUdpHandshakeAttempts        4
+#define F53OSCClientUdpHandshakeRetryInterval   1.0 // seconds
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -42,8 +60,44 @@ NS_ASSUME_NONNULL_BEGIN
 @property (strong, nullable)    NSMutableData *readData;
 @property (strong, nullable)    NSMutableDictionary<NSString *, id> *readState;
 
+@property (strong, nullable)    F53OSCBundleBuilder *coalescingBuilder;
+@property (strong, nullable)    F53OSCPacket *coalescedPacket;  // the only packet gathered so far, sent as-is if nothing joins it
+@property (assign)              NSUInteger coalescingGeneration; // invalidates pending flush timers
+@property (strong)              NSObject *sendLock;             // held from taking gathered packets until they are sent, so later sends can not overtake them
+
+@property (strong)              F53OSCMessageBatcher *messageBatcher;
+
+@property (assign)              BOOL readNotificationPending;   // at most one `client:didReadData:` is queued at a time
+@property (assign)              NSUInteger pendingReadLength;
+
+@property (strong, nullable)    NSData *engineAddress;          // shared with other clients of the engine that send to the same destination
+@property (assign)              NSUInteger engineAddressGeneration;
+
+@property (assign)              BOOL disconnectRequested;       // suppresses automatic reconnects until the next `connect`
+@property (assign)              BOOL reconnectPending;          // a reconnect is scheduled, so sends do not connect early
+@property (assign)              BOOL reconnecting;              // the current connection attempt is a reconnect
+@property (assign)              NSUInteger reconnectGeneration; // invalidates scheduled reconnects
+@property (assign)              NSTimeInterval nextReconnectDelay;
+@property (assign)              NSUInteger totalReconnectAttemptCount;
+@property (assign)              NSUInteger totalReconnectCount;
+
+@property (strong, nullable)    NSData *encryptionPeerKey;      // the server's public key, from the last full handshake
+@property (assign)              BOOL resumingEncryption;        // a resumed session awaits the server's ticket or rejection
+@property (assign)              NSUInteger udpHandshakeGeneration; // invalidates scheduled UDP handshake requests
+
 - (void) destroySocket;
 - (void) createSocket;
+- (nullable id<F53OSCPacketDestination>) destinationForRead;
+- (void) readFromSocket:(GCDAsyncSocket *)sock tag:(long)tag;
+- (void) performDelegateCallback:(dispatch_block_t)block;
+- (void) connectForSend;
+- (BOOL) queuePacket:(nullable F53OSCPacket *)packet orData:(nullable NSData *)data slipFramedData:(nullable NSData *)slipFramedData;
+- (void) flushOutboundQueue;
+- (void) scheduleReconnect;
+- (BOOL) sendsThroughTransportEngine;
+- (void) sendDataThroughTransportEngine:(nullable NSData *)data;
+- (BOOL) resumeEncryption;
+- (void) requestUdpEncryptionWithAttemptsRemaining:(NSUInteger)attemptsRemaining generation:(NSUInteger)generation;
 
 @end
 
@@ -60,6 +114,7 @@ NS_ASSUME_NONNULL_BEGIN
     if ( self )
     {
         _socketDelegateQueue = dispatch_get_main_queue();
+        _delegateCallbackQueue = dispatch_get_main_queue();
         self.delegate = nil;
         self.interface = nil;
         self.host = @"localhost";
@@ -68,6 +123,20 @@ NS_ASSUME_NONNULL_BEGIN
         self.useTcp = NO;
         self.tcpTimeout = -1;   // no timeout
         self.readChunkSize = 0; // no partial reads
+        self.multicastTTL = 1;  // local network only
+        self.multicastLoopback = YES;
+        self.socketOptions = nil;
+        self.encryptionSessionCache = nil;
+        self.udpEncryptionEnabled = NO;
+        self.reconnectsAutomatically = NO;
+        self.reconnectMinimumDelay = 0.25;
+        self.reconnectMaximumDelay = 8.0;
+        self.coalescingInterval = 0; // no coalescing
+        self.coalescingMaxPacketSize = F53OSCEthernetUDPPayloadSize;
+        self.sendLock = [[NSObject alloc] init];
+        self.maxMessageBatchSize = 0;   // no limit
+        self.messageBatchLatency = 0;   // deliver at the end of each read
+        self.messageBatcher = [[F53OSCMessageBatcher alloc] initWithQueue:dispatch_get_main_queue()];
         self.userData = nil;
         self.socket = nil;
         self.readData = [NSMutableData data];
@@ -101,6 +170,7 @@ NS_ASSUME_NONNULL_BEGIN
     if ( self )
     {
         _socketDelegateQueue = dispatch_get_main_queue();
+        _delegateCallbackQueue = dispatch_get_main_queue();
         self.delegate = nil;
         self.interface = [coder decodeObjectOfClass:[NSString class] forKey:@"interface"];
         self.host = [coder decodeObjectOfClass:[NSString class] forKey:@"host"];
@@ -109,6 +179,19 @@ NS_ASSUME_NONNULL_BEGIN
         self.useTcp = [[coder decodeObjectOfClass:[NSNumber class] forKey:@"useTcp"] boolValue];
         self.tcpTimeout = [[coder decodeObjectOfClass:[NSNumber class] forKey:@"tcpTimeout"] doubleValue];
         self.readChunkSize = [[coder decodeObjectOfClass:[NSNumber class] forKey:@"readChunkSize"] unsignedIntegerValue];
+        self.multicastTTL = 1;
+        self.multicastLoopback = YES;
+        self.socketOptions = nil;
+        self.udpEncryptionEnabled = NO;
+        self.reconnectsAutomatically = NO;
+        self.reconnectMinimumDelay = 0.25;
+        self.reconnectMaximumDelay = 8.0;
+        self.coalescingInterval = 0;
+        self.coalescingMaxPacketSize = F53OSCEthernetUDPPayloadSize;
+        self.sendLock = [[NSObject alloc] init];
+        self.maxMessageBatchSize = 0;
+        self.messageBatchLatency = 0;
+        self.messageBatcher = [[F53OSCMessageBatcher alloc] initWithQueue:dispatch_get_main_queue()];
         self.userData = [coder decodeObjectOfClass:[NSObject class] forKey:@"userData"];
         self.socket = nil;
         self.readData = [NSMutableData data];
@@ -140,6 +223,17 @@ NS_ASSUME_NONNULL_BEGIN
         [self createSocket];
 }
 
+- (void) setDelegateCallbackQueue:(nullable dispatch_queue_t)queue
+{
+    if ( !queue )
+        queue = dispatch_get_main_queue();
+    
+    @synchronized( self )
+    {
+        _delegateCallbackQueue = queue;
+    }
+}
+
 - (void) destroySocket
 {
     self.readState[@"socket"] = nil;
@@ -158,7 +252,9 @@ NS_ASSUME_NONNULL_BEGIN
 
     if ( self.useTcp )
     {
-        GCDAsyncSocket *tcpSocket = [[GCDAsyncSocket alloc] initWithDelegate:self delegateQueue:self.socketDelegateQueue];
+        // With a transport engine, the socket's internal work runs on one of the engine's workers instead of a queue of its own.
+        dispatch_queue_t socketQueue = [self.transportEngine nextTcpWorkerQueue];
+        GCDAsyncSocket *tcpSocket = [[GCDAsyncSocket alloc] initWithDelegate:self delegateQueue:self.socketDelegateQueue socketQueue:socketQueue];
         socket = [F53OSCSocket socketWithTcpSocket:tcpSocket];
         self.readState[@"socket"] = socket;
     }
@@ -171,6 +267,9 @@ NS_ASSUME_NONNULL_BEGIN
     socket.IPv6Enabled = self.isIPv6Enabled;
     socket.host = self.host;
     socket.port = self.port;
+    socket.multicastTTL = self.multicastTTL;
+    socket.multicastLoopback = self.multicastLoopback;
+    socket.options = self.socketOptions;
 
     self.socket = socket;
 }
@@ -197,18 +296,55 @@ NS_ASSUME_NONNULL_BEGIN
     _hostIsLocal = ( !_host.length ||
                     [_host isEqualToString:@"localhost"] ||
                     [_host isEqualToString:@"127.0.0.1"] );
+    _hostIsMulticast = [F53OSCSocket isMulticastAddress:_host];
+    self.engineAddress = nil;
 }
 
 - (void) setPort:(UInt16)port
 {
     _port = port;
     self.socket.port = _port;
+    self.engineAddress = nil;
+}
+
+- (void) setMulticastTTL:(UInt8)multicastTTL
+{
+    _multicastTTL = multicastTTL;
+    self.socket.multicastTTL = _multicastTTL;
+}
+
+- (void) setMulticastLoopback:(BOOL)multicastLoopback
+{
+    _multicastLoopback = multicastLoopback;
+    self.socket.multicastLoopback = _multicastLoopback;
+}
+
+- (void) setSocketOptions:(nullable F53OSCSocketOptions *)socketOptions
+{
+    _socketOptions = [socketOptions copy];
+    self.socket.options = _socketOptions;
 }
 
 - (void) setIPv6Enabled:(BOOL)IPv6Enabled
 {
     _IPv6Enabled = IPv6Enabled;
     self.socket.IPv6Enabled = _IPv6Enabled;
+    self.engineAddress = nil;
+}
+
+- (void) setTransportEngine:(nullable F53OSCTransportEngine *)transportEngine
+{
+    if ( _transportEngine == transportEngine )
+        return;
+    
+    [self flush];
+    [self destroySocket];
+    
+    @synchronized( self )
+    {
+        _transportEngine = transportEngine;
+        self.engineAddress = nil;
+    }
 }
 
 - (void) setUseTcp:(BOOL)flag
@@ -229,6 +365,17 @@ NS_ASSUME_NONNULL_BEGIN
     _tcpTimeout = tcpTimeout;
 }
 
+- (void) setCoalescingInterval:(NSTimeInterval)coalescingInterval
+{
+    if ( coalescingInterval < 0.0 )
+        coalescingInterval = 0.0;
+
+    _coalescingInterval = coalescingInterval;
+
+    if ( _coalescingInterval == 0.0 )
+        [self flush];
+}
+
 - (void) setUserData:(nullable id)userData
 {
     if ( userData == [NSNull null] )
@@ -277,11 +424,40 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (BOOL) isConnected
 {
+    if ( [self sendsThroughTransportEngine] )
+        return YES; // like any UDP socket
+    
     return [self.socket isConnected];
 }
 
+- (BOOL) isEncrypting
+{
+    return self.socket.isEncrypting;
+}
+
+- (NSUInteger) reconnectAttemptCount
+{
+    @synchronized( self )
+    {
+        return self.totalReconnectAttemptCount;
+    }
+}
+
+- (NSUInteger) reconnectCount
+{
+    @synchronized( self )
+    {
+        return self.totalReconnectCount;
+    }
+}
+
 - (BOOL) connect
 {
+    if ( [self sendsThroughTransportEngine] )
+        return YES;
+    
+    self.disconnectRequested = NO;
+    
     if ( !self.socket )
         [self createSocket]; // should always create a socket
     if ( !self.socket )
@@ -298,34 +474,388 @@ NS_ASSUME_NONNULL_BEGIN
     if ( !self.socket )
         return NO;
 
-    return [self.socket connect];
+    if ( !self.socket.isUdpSocket || !self.udpEncryptionEnabled || [self sendsThroughTransportEngine] )
+        return [self.socket connect];
+    
+    // UDP has no connection to confirm, so the handshake starts right away. The socket stays bound from the first send,
+    // so replies from the server reach it.
+    F53OSCSocket *socket = (F53OSCSocket * _Nonnull)self.socket;
+    @synchronized( socket )
+    {
+        socket.isEncrypting = NO;
+        socket.datagramCipher = nil;
+    }
+    self.udpHandshakeGeneration++;
+    [self requestUdpEncryptionWithAttemptsRemaining:F53OSCClientUdpHandshakeAttempts - 1 generation:self.udpHandshakeGeneration];
+    
+    NSError *error = nil;
+    if ( ![socket.udpSocket beginReceiving:&error] )
+    {
+        NSLog( @"Error: %@ unable to receive UDP encryption handshake replies - %@", self, [error localizedDescription] );
+        return NO;
+    }
+    return YES;
 }
 
 - (void) disconnect
 {
+    @synchronized( self )
+    {
+        self.disconnectRequested = YES;
+        self.reconnectPending = NO;
+        self.reconnecting = NO;
+        self.reconnectGeneration++;
+    }
+    
+    [self flush];
     [self.socket disconnect];
+    if ( self.socket.isUdpSocket )
+    {
+        // UDP sessions end here, since there is no connection to close.
+        self.udpHandshakeGeneration++;
+        F53OSCSocket *socket = (F53OSCSocket * _Nonnull)self.socket;
+        @synchronized( socket )
+        {
+            socket.isEncrypting = NO;
+            socket.datagramCipher = nil;
+        }
+    }
     [self.readData setData:[NSData data]];
     self.readState[@"dangling_ESC"] = @NO;
 }
 
 - (void) sendPacket:(F53OSCPacket *)packet
 {
-    [self connect];
+    [self connectForSend];
+    
+    @synchronized( self.sendLock )
+    {
+        if ( self.coalescingInterval > 0.0 && [self canCoalescePacket:packet] )
+        {
+            [self coalescePacket:packet];
+            return;
+        }
+        
+        // Anything gathered before this packet must go out first.
+        [self flush];
+        
+#if F53_OSC_CLIENT_DEBUG
+        NSLog( @"%@ sending packet: %@", self, packet );
+#endif
+        
+        if ( [self sendsThroughTransportEngine] )
+        {
+            [self sendDataThroughTransportEngine:[packet packetData]];
+        }
+        else if ( [self queuePacket:packet orData:nil slipFramedData:nil] )
+        {
+            return;
+        }
+        else if ( self.socket )
+        {
+            [self.socket sendPacket:packet];
+        }
+        else
+        {
+            NSLog( @"Error: F53OSCClient could not send data; no socket available." );
+        }
+    }
+}
+
+- (void) flush
+{
+    NSArray<NSData *> *bundles = nil;
+    F53OSCPacket *singlePacket = nil;
+    
+    @synchronized( self.sendLock )
+    {
+        @synchronized( self )
+        {
+            if ( !self.coalescingBuilder )
+                return;
+            
+            self.coalescingGeneration++;
+            singlePacket = self.coalescedPacket;
+            bundles = [self.coalescingBuilder finish];
+            self.coalescedPacket = nil;
+            
+            // A lone packet does not need the overhead of a bundle.
+            if ( singlePacket && bundles.count == 1 )
+                bundles = nil;
+            else
+                singlePacket = nil;
+        }
+        
+        if ( singlePacket )
+            [self sendCoalescedData:nil orPacket:singlePacket];
+        for ( NSData *bundle in bundles )
+            [self sendCoalescedData:bundle orPacket:nil];
+    }
+}
+
+#pragma mark - coalescing
+
+- (BOOL) canCoalescePacket:(F53OSCPacket *)packet
+{
+    if ( [packet isKindOfClass:[F53OSCBundle class]] )
+        return YES;
+    
+    if ( [packet isKindOfClass:[F53OSCMessage class]] )
+        return [((F53OSCMessage *)packet).addressPattern hasPrefix:@"/"]; // F53OSC control messages are always sent immediately
+    
+    return NO;
+}
+
+- (void) coalescePacket:(F53OSCPacket *)packet
+{
+    NSArray<NSData *> *completedBundles = nil;
+    NSUInteger generationToSchedule = 0;
+    
+    // Called with `sendLock` held, so that completed bundles are sent before anything after them.
+    @synchronized( self )
+    {
+        if ( !self.coalescingBuilder )
+            self.coalescingBuilder = [F53OSCBundleBuilder builderWithTimeTag:[F53OSCTimeTag immediateTimeTag]];
+        
+        F53OSCBundleBuilder *builder = (F53OSCBundleBuilder * _Nonnull)self.coalescingBuilder;
+        BOOL wasEmpty = ( builder.elementCount == 0 );
+        builder.maxPacketSize = self.coalescingMaxPacketSize;
+        [builder addPacket:packet];
+        
+        // Flush on size: bundles that filled up are sent right away.
+        completedBundles = [builder takeCompletedBundles];
+        if ( builder.maxPacketSize && builder.length >= builder.maxPacketSize )
+            completedBundles = [completedBundles arrayByAddingObjectsFromArray:[builder finish]];
+        
+        self.coalescedPacket = ( builder.elementCount == 1 ? packet : nil );
+        
+        // Flush on timer: measured from the first packet gathered into the bundle in progress.
+        if ( builder.elementCount && ( wasEmpty || completedBundles.count ) )
+        {
+            self.coalescingGeneration++;
+            generationToSchedule = self.coalescingGeneration;
+        }
+    }
     
+    for ( NSData *bundle in completedBundles )
+        [self sendCoalescedData:bundle orPacket:nil];
+    
+    if ( generationToSchedule )
+    {
+        __weak typeof(self) weakSelf = self;
+        dispatch_time_t when = dispatch_time( DISPATCH_TIME_NOW, (int64_t)( self.coalescingInterval * NSEC_PER_SEC ) );
+        dispatch_after( when, dispatch_get_global_queue( QOS_CLASS_USER_INITIATED, 0 ), ^{
+            [weakSelf flushIfGeneration:generationToSchedule];
+        });
+    }
+}
+
+- (void) flushIfGeneration:(NSUInteger)generation
+{
+    @synchronized( self )
+    {
+        if ( self.coalescingGeneration != generation )
+            return;
+    }
+    
+    [self flush];
+}
+
+- (void) sendPacketData:(NSData *)data slipFramedData:(nullable NSData *)slipFramedData
+{
+    [self connectForSend];
+    
+    @synchronized( self.sendLock )
+    {
+        // Anything gathered before this packet must go out first.
+        [self flush];
+        
+#if F53_OSC_CLIENT_DEBUG
+        NSLog( @"%@ sending packet data of length %lu", self, (unsigned long)data.length );
+#endif
+        
+        if ( [self sendsThroughTransportEngine] )
+            [self sendDataThroughTransportEngine:data];
+        else if ( [self queuePacket:nil orData:data slipFramedData:slipFramedData] )
+            return;
+        else if ( self.socket )
+            [self.socket sendPacketData:data slipFramedData:slipFramedData];
+        else
+            NSLog( @"Error: F53OSCClient could not send data; no socket available." );
+    }
+}
+
+- (void) sendCoalescedData:(nullable NSData *)data orPacket:(nullable F53OSCPacket *)packet
+{
 #if F53_OSC_CLIENT_DEBUG
-    NSLog( @"%@ sending packet: %@", self, packet );
+    NSLog( @"%@ sending coalesced packet: %@", self, ( packet ? packet : data ) );
 #endif
     
-    if ( self.socket )
+    if ( [self sendsThroughTransportEngine] )
     {
-        [self.socket sendPacket:packet];
+        [self sendDataThroughTransportEngine:( packet ? [packet packetData] : data )];
+        return;
     }
-    else
+    
+    if ( !self.socket )
     {
         NSLog( @"Error: F53OSCClient could not send data; no socket available." );
+        return;
+    }
+    
+    if ( [self queuePacket:packet orData:data slipFramedData:nil] )
+        return;
+    
+    if ( packet )
+        [self.socket sendPacket:packet];
+    else if ( data )
+        [self.socket sendPacketData:data];
+}
+
+#pragma mark - reconnecting
+
+// While a reconnect is scheduled, sends wait for it rather than connecting early and defeating the backoff.
+- (void) connectForSend
+{
+    if ( self.reconnectPending )
+        return;
+    
+    [self connect];
+}
+
+// Holds TCP sends made while disconnected in the outbound queue, already framed. Once anything is queued,
+// later sends queue behind it until the queue is flushed, so that they keep their order.
+// Encrypted connections are not queued; their encryption is negotiated again on each connection.
+- (BOOL) queuePacket:(nullable F53OSCPacket *)packet orData:(nullable NSData *)data slipFramedData:(nullable NSData *)slipFramedData
+{
+    F53OSCOutboundQueue *outboundQueue = self.outboundQueue;
+    F53OSCSocket *socket = self.socket;
+    if ( !outboundQueue || !self.useTcp || !socket || socket.encrypter )
+        return NO;
+    
+    @synchronized( outboundQueue )
+    {
+        if ( socket.isConnected && outboundQueue.count == 0 )
+            return NO;
+        
+        if ( packet )
+            data = [packet packetData];
+        if ( data.length == 0 )
+            return YES;
+        
+        if ( socket.tcpDataFraming == F53TCPDataFramingSLIP )
+            data = ( slipFramedData ? slipFramedData : [F53OSCSocket slipFramedData:(NSData * _Nonnull)data] );
+        
+        [outboundQueue enqueueData:(NSData * _Nonnull)data];
+        return YES;
+    }
+}
+
+// Writes everything queued while disconnected in one write.
+- (void) flushOutboundQueue
+{
+    F53OSCOutboundQueue *outboundQueue = self.outboundQueue;
+    if ( !outboundQueue )
+        return;
+    
+    @synchronized( outboundQueue )
+    {
+        NSData *queuedData = [outboundQueue takeQueuedData];
+        if ( queuedData == nil )
+            return;
+        
+#if F53_OSC_CLIENT_DEBUG
+        NSLog( @"%@ flushing %lu queued bytes", self, (unsigned long)queuedData.length );
+#endif
+        
+        // The queued data is already framed, so it is written as is.
+        [self.socket sendPacketData:queuedData slipFramedData:queuedData];
+    }
+}
+
+- (void) scheduleReconnect
+{
+    NSTimeInterval delay;
+    NSUInteger generation;
+    
+    @synchronized( self )
+    {
+        if ( !self.reconnectsAutomatically || !self.useTcp || self.disconnectRequested || self.reconnectPending )
+            return;
+        
+        delay = MAX( self.nextReconnectDelay, self.reconnectMinimumDelay );
+        self.nextReconnectDelay = MIN( delay * 2.0, MAX( self.reconnectMaximumDelay, self.reconnectMinimumDelay ) );
+        self.reconnectPending = YES;
+        generation = ++self.reconnectGeneration;
+    }
+    
+#if F53_OSC_CLIENT_DEBUG
+    NSLog( @"%@ reconnecting in %.3f seconds", self, delay );
+#endif
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_time_t when = dispatch_time( DISPATCH_TIME_NOW, (int64_t)( delay * NSEC_PER_SEC ) );
+    dispatch_after( when, self.socketDelegateQueue, ^{
+        F53OSCClient *strongSelf = weakSelf;
+        if ( !strongSelf )
+            return;
+        
+        @synchronized( strongSelf )
+        {
+            if ( strongSelf.reconnectGeneration != generation )
+                return;
+            
+            strongSelf.reconnectPending = NO;
+            strongSelf.reconnecting = YES;
+            strongSelf.totalReconnectAttemptCount++;
+        }
+        
+        // A failed attempt ends in `socketDidDisconnect:withError:`, which schedules the next one.
+        if ( ![strongSelf connect] && !strongSelf.isConnected )
+            [strongSelf scheduleReconnect];
+    });
+}
+
+#pragma mark - transport engine
+
+// UDP clients send through the engine unless they need a socket of their own: multicast sends apply per-socket
+// options, and a socket created for encryption is kept.
+- (BOOL) sendsThroughTransportEngine
+{
+    return ( self.transportEngine && !self.useTcp && !self.hostIsMulticast && !self.socket );
+}
+
+- (void) sendDataThroughTransportEngine:(nullable NSData *)data
+{
+    F53OSCTransportEngine *engine = self.transportEngine;
+    if ( engine == nil || data.length == 0 )
+        return;
+    
+    NSData *address = nil;
+    @synchronized( self )
+    {
+        if ( self.engineAddressGeneration == engine.addressGeneration )
+            address = self.engineAddress;
+    }
+    
+    NSString *host = self.host;
+    if ( address == nil && host )
+    {
+        NSUInteger generation = engine.addressGeneration;
+        address = [engine addressForHost:(NSString * _Nonnull)host port:self.port preferIPv6:self.isIPv6Enabled];
+        @synchronized( self )
+        {
+            self.engineAddress = address;
+            self.engineAddressGeneration = generation;
+        }
     }
+    
+    // An unresolved destination is counted by the engine, which has already logged the failed lookup.
+    [engine sendDatagram:data toAddress:address interface:self.interface];
 }
 
+#pragma mark -
+
 - (void) handleF53OSCControlMessage:(F53OSCMessage *)message
 {
     if ( self.socket.encrypter && [F53OSCEncryptHandshake isEncryptHandshakeMessage:message] )
@@ -335,10 +865,66 @@ NS_ASSUME_NONNULL_BEGIN
         {
             if ( handshake.lastProcessedMessage == F53OSCEncryptionHandshakeMessageApprove )
             {
+                self.encryptionPeerKey = handshake.peerKey;
+                
+                // Over UDP, approvals of repeated requests may arrive after the first. Each one carries the salt the server
+                // chose last, so each is taken, but the session starts only once.
+                BOOL startsSession = YES;
+                if ( self.socket.isUdpSocket )
+                {
+                    self.udpHandshakeGeneration++;
+                    startsSession = ( self.socket.datagramCipher == nil );
+                    if ( startsSession )
+                        self.socket.datagramCipher = [[F53OSCDatagramCipher alloc] initWithEncrypter:(F53OSCEncrypt * _Nonnull)self.socket.encrypter initiator:YES];
+                }
+                
                 F53OSCMessage *beginMessage = [handshake beginEncryptionMessage];
                 [self sendPacket:beginMessage];
-                self.socket.isEncrypting = YES;
-                [self tellDelegateDidConnect];
+                
+                if ( self.resumingEncryption )
+                {
+                    // After a rejected resumption, packets held since connecting are sent again, ahead of any new ones.
+                    self.resumingEncryption = NO;
+                    F53OSCSocket *socket = (F53OSCSocket * _Nonnull)self.socket;
+                    @synchronized( socket )
+                    {
+                        NSArray<NSData *> *heldPacketData = [socket endHoldingPackets];
+                        socket.isEncrypting = YES;
+                        for ( NSData *data in heldPacketData )
+                            [socket sendPacketData:data];
+                    }
+                }
+                else if ( startsSession )
+                {
+                    self.socket.isEncrypting = YES;
+                    [self tellDelegateDidConnect];
+                }
+            }
+            else if ( handshake.lastProcessedMessage == F53OSCEncryptionHandshakeMessageTicket )
+            {
+                // A ticket confirms a resumed session, so held packets are no longer needed.
+                if ( self.resumingEncryption )
+                {
+                    self.resumingEncryption = NO;
+                    [self.socket endHoldingPackets];
+                }
+                
+                NSData *peerKey = self.encryptionPeerKey;
+                NSData *ticket = handshake.ticket;
+                if ( peerKey && ticket )
+                    [self.encryptionSessionCache storeSessionForPeerKey:peerKey ticket:ticket lifetime:handshake.ticketLifetime encrypter:(F53OSCEncrypt * _Nonnull)self.socket.encrypter];
+            }
+            else if ( handshake.lastProcessedMessage == F53OSCEncryptionHandshakeMessageRejectResumption && self.resumingEncryption )
+            {
+                // Packets sent since connecting were dropped by the server; hold any more until a full handshake agrees a new session.
+                F53OSCSocket *socket = (F53OSCSocket * _Nonnull)self.socket;
+                @synchronized( socket )
+                {
+                    socket.isEncrypting = NO;
+                }
+                F53OSCMessage *requestMessage = [handshake requestEncryptionMessage];
+                if ( requestMessage )
+                    [self sendPacket:requestMessage];
             }
             else
             {
@@ -352,6 +938,70 @@ NS_ASSUME_NONNULL_BEGIN
     }
 }
 
+// Resumes the session cached for the server, if any, sending encrypted packets right away rather than after a full
+// handshake. Packets are held until the server confirms the session with a new ticket, in case it rejects it.
+- (BOOL) resumeEncryption
+{
+    F53OSCEncryptSessionCache *sessionCache = self.encryptionSessionCache;
+    NSData *peerKey = self.encryptionPeerKey;
+    F53OSCSocket *socket = self.socket;
+    if ( !sessionCache || !peerKey || !socket.encrypter )
+        return NO;
+    
+    // The session stays in the cache until it is about to be used, so that a session this connection can not resume
+    // is still there for one that can.
+    F53OSCEncryptSession *session = [sessionCache sessionForPeerKey:(NSData * _Nonnull)peerKey];
+    if ( !session )
+        return NO;
+    
+    // A session agreed with another key pair can not be resumed.
+    NSData *keyPairData = socket.encrypter.keyPairData;
+    if ( !keyPairData || ![session.encrypter.keyPairData isEqualToData:(NSData * _Nonnull)keyPairData] )
+        return NO;
+    
+    F53OSCEncryptHandshake *handshake = [F53OSCEncryptHandshake handshakeWithEncrypter:session.encrypter];
+    F53OSCMessage *resumeMessage = [handshake resumeEncryptionMessageWithTicket:session.ticket];
+    if ( !resumeMessage )
+        return NO;
+    
+    // Tickets are single use; another client sharing the cache may have taken this one in the meantime.
+    if ( [sessionCache takeSessionForPeerKey:(NSData * _Nonnull)peerKey] != session )
+        return NO;
+    
+    socket.encrypter = session.encrypter;
+    [self sendPacket:resumeMessage];
+    
+    self.resumingEncryption = YES;
+    @synchronized( socket )
+    {
+        [socket beginHoldingPackets];
+        socket.isEncrypting = YES;
+    }
+    return YES;
+}
+
+// UDP has no connection to confirm, so the request is repeated until the server approves it.
+- (void) requestUdpEncryptionWithAttemptsRemaining:(NSUInteger)attemptsRemaining generation:(NSUInteger)generation
+{
+    if ( generation != self.udpHandshakeGeneration || !self.socket.encrypter )
+        return;
+    
+    F53OSCEncryptHandshake *handshake = [F53OSCEncryptHandshake handshakeWithEncrypter:(F53OSCEncrypt * _Nonnull)self.socket.encrypter];
+    F53OSCMessage *requestMessage = [handshake requestEncryptionMessage];
+    if ( !requestMessage )
+        return;
+    
+    [self.socket sendPacket:requestMessage];
+    if ( attemptsRemaining == 0 )
+        return;
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_time_t when = dispatch_time( DISPATCH_TIME_NOW, (int64_t)( F53OSCClientUdpHandshakeRetryInterval * NSEC_PER_SEC ) );
+    dispatch_after( when, self.socketDelegateQueue, ^{
+        [weakSelf requestUdpEncryptionWithAttemptsRemaining:attemptsRemaining - 1 generation:generation];
+    });
+}
+
 #pragma mark - GCDAsyncSocketDelegate
 
 - (nullable dispatch_queue_t) newSocketQueueForConnectionFromAddress:(NSData *)address onSocket:(GCDAsyncSocket *)sock
@@ -370,13 +1020,33 @@ NS_ASSUME_NONNULL_BEGIN
     NSLog( @"client socket %p didConnectToHost %@:%hu", sock, host, port );
 #endif
 
-    if ( self.readChunkSize )
-        [sock readDataWithTimeout:self.tcpTimeout buffer:nil bufferOffset:0 maxLength:self.readChunkSize tag:0];
-    else
-        [sock readDataWithTimeout:self.tcpTimeout tag:0];
+    [self readFromSocket:sock tag:0];
+    
+    // The connected socket only exists from here on.
+    NSError *error = nil;
+    if ( ![self.socket applyOptions:&error] )
+        NSLog( @"Warning: %@ unable to apply socket options - %@", self, [error localizedDescription] );
+
+    @synchronized( self )
+    {
+        self.nextReconnectDelay = self.reconnectMinimumDelay;
+        if ( self.reconnecting )
+        {
+            self.reconnecting = NO;
+            self.totalReconnectCount++;
+        }
+    }
+    
+    [self flushOutboundQueue];
 
     if ( self.socket.encrypter )
     {
+        if ( [self resumeEncryption] )
+        {
+            [self tellDelegateDidConnect];
+            return;
+        }
+        
         F53OSCEncryptHandshake *handshake = [F53OSCEncryptHandshake handshakeWithEncrypter:self.socket.encrypter];
         F53OSCMessage *requestMessage = [handshake requestEncryptionMessage];
         if ( requestMessage )
@@ -394,15 +1064,60 @@ NS_ASSUME_NONNULL_BEGIN
 {
     if ( [self.delegate respondsToSelector:@selector(clientDidConnect:)] )
     {
-        dispatch_block_t block = ^{
+        [self performDelegateCallback:^{
             [self.delegate clientDidConnect:self];
-        };
-        
-        if ( [NSThread isMainThread] )
-            block();
-        else
-            dispatch_async( dispatch_get_main_queue(), block );
+        }];
+    }
+}
+
+- (void) performDelegateCallback:(dispatch_block_t)block
+{
+    dispatch_queue_t queue = self.delegateCallbackQueue;
+    if ( queue == dispatch_get_main_queue() && [NSThread isMainThread] )
+        block();
+    else
+        dispatch_async( queue, block );
+}
+
+// Messages go through the conflation buffer and then the priority scheduler, whichever are set. Otherwise delegates
+// that take batches receive messages through the batcher; call `-endRead` on it once the read is parsed.
+// With read flow control, the whole chain is wrapped so that messages are counted on the way in and out.
+- (nullable id<F53OSCPacketDestination>) destinationForRead
+{
+    id<F53OSCClientDelegate> delegate = self.delegate;
+    
+    id<F53OSCPacketDestination> delivery = delegate;
+    F53OSCReadFlowControl *readFlowControl = self.readFlowControl;
+    if ( readFlowControl )
+        delivery = [readFlowControl outletForOwner:self toDestination:delegate];
+    
+    id<F53OSCPacketDestination> destination = delivery;
+    F53OSCPriorityScheduler *priorityScheduler = self.priorityScheduler;
+    F53OSCConflationBuffer *conflationBuffer = self.conflationBuffer;
+    if ( priorityScheduler )
+    {
+        priorityScheduler.destination = destination;
+        destination = priorityScheduler;
+    }
+    if ( conflationBuffer )
+    {
+        conflationBuffer.destination = destination;
+        destination = conflationBuffer;
+    }
+    
+    if ( !priorityScheduler && !conflationBuffer && [delegate respondsToSelector:@selector(takeMessages:)] )
+    {
+        self.messageBatcher.destination = delivery;
+        self.messageBatcher.queue = self.socketDelegateQueue;
+        self.messageBatcher.maxBatchSize = self.maxMessageBatchSize;
+        self.messageBatcher.maxLatency = self.messageBatchLatency;
+        destination = self.messageBatcher;
     }
+    
+    if ( readFlowControl )
+        return [readFlowControl inletForOwner:self toDestination:destination];
+    
+    return destination;
 }
 
 - (void) socket:(GCDAsyncSocket *)sock didReadData:(NSData *)data withTag:(long)tag
@@ -411,31 +1126,53 @@ NS_ASSUME_NONNULL_BEGIN
     NSLog( @"client socket %p didReadData of length %lu. tag : %lu", sock, [data length], tag );
 #endif
 
-    [F53OSCParser translateSlipData:data toData:self.readData withState:self.readState destination:self.delegate controlHandler:self];
+    [F53OSCParser translateSlipData:data toData:self.readData withState:self.readState destination:[self destinationForRead] controlHandler:self];
+    [self.messageBatcher endRead];
 
     if ( self.readChunkSize )
-    {
         [self tellDelegateDidRead];
+    
+    // Leave the next read to the flow control while too many received messages are undelivered.
+    F53OSCReadFlowControl *readFlowControl = self.readFlowControl;
+    if ( readFlowControl && [readFlowControl shouldPauseReadsFromSocket:self.socket resumeHandler:^{
+        [self readFromSocket:sock tag:tag];
+    }] )
+        return;
+    
+    [self readFromSocket:sock tag:tag];
+}
+
+- (void) readFromSocket:(GCDAsyncSocket *)sock tag:(long)tag
+{
+    if ( self.readChunkSize )
         [sock readDataWithTimeout:self.tcpTimeout buffer:nil bufferOffset:0 maxLength:self.readChunkSize tag:tag];
-    }
     else
-    {
         [sock readDataWithTimeout:self.tcpTimeout tag:tag];
-    }
 }
 
 - (void) tellDelegateDidRead
 {
     if ( [self.delegate respondsToSelector:@selector(client:didReadData:)] )
     {
-        NSUInteger lengthOfCurrentRead = self.readData.length;
-        dispatch_block_t block = ^{
+        // Never wait on the delegate: a busy UI must not stall the socket queue. If a notification is
+        // already queued it just picks up the latest length when it runs.
+        @synchronized( self )
+        {
+            self.pendingReadLength = self.readData.length;
+            if ( self.readNotificationPending )
+                return;
+            self.readNotificationPending = YES;
+        }
+        
+        [self performDelegateCallback:^{
+            NSUInteger lengthOfCurrentRead;
+            @synchronized( self )
+            {
+                lengthOfCurrentRead = self.pendingReadLength;
+                self.readNotificationPending = NO;
+            }
             [self.delegate client:self didReadData:lengthOfCurrentRead];
-        };
-        if ( [NSThread isMainThread] )
-            block();
-        else
-            dispatch_sync( dispatch_get_main_queue(), block ); // synchronous so GUI updates don't lag reality
+        }];
     }
 }
 
@@ -478,15 +1215,9 @@ NS_ASSUME_NONNULL_BEGIN
     NSLog( @"client socket %p didCloseReadStream", sock );
 #endif
     
-    dispatch_block_t block = ^{
-        [self.readData setData:[NSData data]];
-        self.readState[@"dangling_ESC"] = @NO;
-    };
-    
-    if ( [NSThread isMainThread] )
-        block();
-    else
-        dispatch_async( dispatch_get_main_queue(), block );
+    // Read buffers belong to the socket delegate queue, which is where we are now.
+    [self.readData setData:[NSData data]];
+    self.readState[@"dangling_ESC"] = @NO;
 }
 
 - (void) socketDidDisconnect:(GCDAsyncSocket *)sock withError:(nullable NSError *)err
@@ -496,19 +1227,23 @@ NS_ASSUME_NONNULL_BEGIN
 #endif
 
     self.socket.isEncrypting = NO;
+    self.resumingEncryption = NO;
+    [self.socket endHoldingPackets];
+    [self.readFlowControl removeSocket:self.socket];
     
-    dispatch_block_t block = ^{
-        [self.readData setData:[NSData data]];
-        self.readState[@"dangling_ESC"] = @NO;
-        
-        if ( [self.delegate respondsToSelector:@selector(clientDidDisconnect:)] )
+    [self.readData setData:[NSData data]];
+    self.readState[@"dangling_ESC"] = @NO;
+    
+    if ( [self.delegate respondsToSelector:@selector(clientDidDisconnect:)] )
+    {
+        [self performDelegateCallback:^{
             [self.delegate clientDidDisconnect:self];
-    };
+        }];
+    }
     
-    if ( [NSThread isMainThread] )
-        block();
-    else
-        dispatch_async( dispatch_get_main_queue(), block );
+    // Sockets that were replaced or destroyed do not reconnect.
+    if ( sock == self.socket.tcpSocket )
+        [self scheduleReconnect];
 }
 
 - (void) socketDidSecure:(GCDAsyncSocket *)sock
@@ -541,6 +1276,24 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void) udpSocket:(GCDAsyncUdpSocket *)sock didReceiveData:(NSData *)data fromAddress:(NSData *)address withFilterContext:(nullable id)filterContext
 {
+    // Only encrypting UDP clients receive, from the server they ran the handshake with.
+    F53OSCSocket *socket = self.socket;
+    if ( sock != socket.udpSocket || !socket.encrypter )
+        return;
+    
+    BOOL wasEncrypted = NO;
+    if ( data.length && ((const char *)data.bytes)[0] == '*' )
+    {
+        NSData *clearData = [socket.datagramCipher openDatagram:data];
+        if ( clearData == nil )
+            return;
+        
+        data = clearData;
+        wasEncrypted = YES;
+    }
+    
+    [F53OSCParser processOscData:data forDestination:[self destinationForRead] replyToSocket:(F53OSCSocket * _Nonnull)socket controlHandler:self wasEncrypted:wasEncrypted];
+    [self.messageBatcher endRead];
 }
 
 - (void) udpSocketDidClose:(GCDAsyncUdpSocket *)sock withError:(nullable NSError *)error
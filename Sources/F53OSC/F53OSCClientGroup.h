@@ -0,0 +1,85 @@
+//
+//  F53OSCClientGroup.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCClient.h>
+#import <F53OSC/F53OSCTransportEngine.h>
+#else
+#import "F53OSCClient.h"
+#import "F53OSCTransportEngine.h"
+#endif
+
+//
+//  F53OSCClientGroup sends the same packets to many F53OSCClients at once, encoding each packet only once.
+//
+//  - UDP members that are not encrypting share one socket per interface, and receive the encoded bytes at a
+//    destination address resolved once per host and port, so each member costs a single datagram send.
+//  - TCP members that are not encrypting share one SLIP frame of the packet, written as is to each connection.
+//  - Encrypting members have the shared encoding encrypted and framed for them individually.
+//
+//  Members keep their own settings and can still be used on their own. Packets sent through the group bypass
+//  a member's coalescing, though anything it has gathered is flushed first so its send order is kept.
+//  UDP destinations are resolved and cached by `transportEngine`, outside the group's lock, so a slow lookup for
+//  one member does not hold up other threads using the group. Hosts that fail to resolve are looked up again after
+//  the engine's `failedLookupRetryInterval`; call `invalidateResolvedAddresses` after DNS changes.
+//
+//  Example usage:
+//  F53OSCClientGroup *group = [[F53OSCClientGroup alloc] init];
+//  for ( F53OSCClient *client in consoles )
+//      [group addClient:client];
+//  [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:@[ @"running" ]]];
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCClientGroup : NSObject
+
+@property (readonly) NSArray<F53OSCClient *> *clients;
+@property (readonly) NSUInteger count;
+
+@property (strong) F53OSCTransportEngine *transportEngine;  // resolves UDP destinations; default an engine of the group's own
+
+@property (readonly) NSUInteger encodedPacketCount;     // packets encoded by `sendPacket:`
+@property (readonly) NSUInteger sharedDatagramCount;    // UDP sends from a shared socket
+@property (readonly) NSUInteger sharedFrameCount;       // TCP writes of a shared SLIP frame
+@property (readonly) NSUInteger individualSendCount;    // sends encrypted for a single member
+@property (readonly) NSUInteger unresolvedSendCount;    // UDP sends skipped because the host could not be resolved
+
+- (void) addClient:(F53OSCClient *)client;
+- (void) removeClient:(F53OSCClient *)client;
+- (void) removeAllClients;
+- (BOOL) containsClient:(F53OSCClient *)client;
+
+- (void) sendPacket:(F53OSCPacket *)packet;
+- (void) sendPacketData:(NSData *)data; // already-encoded OSC message or bundle
+
+- (void) invalidateResolvedAddresses;
+
+@end
+
+NS_ASSUME_NONNULL_END
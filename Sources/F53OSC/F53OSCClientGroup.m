@@ -0,0 +1,284 @@
+//
+//  F53OSCClientGroup.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCClientGroup.h"
+
+#import "F53OSCPacket.h"
+#import "F53OSCSocket.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCClientGroup ()
+
+@property (strong) NSMutableArray<F53OSCClient *> *members;
+@property (strong) NSMutableDictionary<NSString *, GCDAsyncUdpSocket *> *udpSocketsByInterface;   // "" is the default interface
+@property (assign) NSUInteger totalEncodedPacketCount;
+@property (assign) NSUInteger totalSharedDatagramCount;
+@property (assign) NSUInteger totalSharedFrameCount;
+@property (assign) NSUInteger totalIndividualSendCount;
+@property (assign) NSUInteger totalUnresolvedSendCount;
+
+- (nullable GCDAsyncUdpSocket *) udpSocketForInterface:(nullable NSString *)interface;
+- (nullable NSData *) addressForClient:(F53OSCClient *)client;
+
+@end
+
+
+@implementation F53OSCClientGroup
+
+- (instancetype) init
+{
+    self = [super init];
+    if ( self )
+    {
+        self.members = [NSMutableArray array];
+        self.udpSocketsByInterface = [NSMutableDictionary dictionary];
+        self.transportEngine = [[F53OSCTransportEngine alloc] init];
+        self.totalEncodedPacketCount = 0;
+        self.totalSharedDatagramCount = 0;
+        self.totalSharedFrameCount = 0;
+        self.totalIndividualSendCount = 0;
+        self.totalUnresolvedSendCount = 0;
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    for ( GCDAsyncUdpSocket *udpSocket in self.udpSocketsByInterface.allValues )
+        [udpSocket closeAfterSending];
+}
+
+- (NSArray<F53OSCClient *> *) clients
+{
+    @synchronized( self )
+    {
+        return [self.members copy];
+    }
+}
+
+- (NSUInteger) count
+{
+    @synchronized( self )
+    {
+        return self.members.count;
+    }
+}
+
+- (NSUInteger) encodedPacketCount
+{
+    @synchronized( self )
+    {
+        return self.totalEncodedPacketCount;
+    }
+}
+
+- (NSUInteger) sharedDatagramCount
+{
+    @synchronized( self )
+    {
+        return self.totalSharedDatagramCount;
+    }
+}
+
+- (NSUInteger) sharedFrameCount
+{
+    @synchronized( self )
+    {
+        return self.totalSharedFrameCount;
+    }
+}
+
+- (NSUInteger) individualSendCount
+{
+    @synchronized( self )
+    {
+        return self.totalIndividualSendCount;
+    }
+}
+
+- (NSUInteger) unresolvedSendCount
+{
+    @synchronized( self )
+    {
+        return self.totalUnresolvedSendCount;
+    }
+}
+
+#pragma mark - members
+
+- (void) addClient:(F53OSCClient *)client
+{
+    @synchronized( self )
+    {
+        if ( [self.members indexOfObjectIdenticalTo:client] == NSNotFound )
+            [self.members addObject:client];
+    }
+}
+
+- (void) removeClient:(F53OSCClient *)client
+{
+    @synchronized( self )
+    {
+        [self.members removeObjectIdenticalTo:client];
+    }
+}
+
+- (void) removeAllClients
+{
+    @synchronized( self )
+    {
+        [self.members removeAllObjects];
+    }
+}
+
+- (BOOL) containsClient:(F53OSCClient *)client
+{
+    @synchronized( self )
+    {
+        return ( [self.members indexOfObjectIdenticalTo:client] != NSNotFound );
+    }
+}
+
+- (void) invalidateResolvedAddresses
+{
+    [self.transportEngine invalidateResolvedAddresses];
+}
+
+#pragma mark - sending
+
+- (void) sendPacket:(F53OSCPacket *)packet
+{
+    NSData *data = [packet packetData];
+    if ( data == nil )
+        return;
+    
+    @synchronized( self )
+    {
+        self.totalEncodedPacketCount++;
+    }
+    
+    [self sendPacketData:data];
+}
+
+- (void) sendPacketData:(NSData *)data
+{
+    if ( data.length == 0 )
+        return;
+    
+    NSArray<F53OSCClient *> *clients = self.clients;
+    NSData *slipFramedData = nil;
+    
+    for ( F53OSCClient *client in clients )
+    {
+        if ( client.isEncrypting )
+        {
+            [client sendPacketData:data slipFramedData:nil];
+            @synchronized( self )
+            {
+                self.totalIndividualSendCount++;
+            }
+        }
+        else if ( client.useTcp )
+        {
+            // Framed on first use so that groups without TCP members never pay for it.
+            if ( slipFramedData == nil )
+                slipFramedData = [F53OSCSocket slipFramedData:data];
+            [client sendPacketData:data slipFramedData:slipFramedData];
+            @synchronized( self )
+            {
+                self.totalSharedFrameCount++;
+            }
+        }
+        else
+        {
+            NSData *address = [self addressForClient:client];
+            @synchronized( self )
+            {
+                GCDAsyncUdpSocket *udpSocket = ( address ? [self udpSocketForInterface:client.interface] : nil );
+                if ( udpSocket == nil )
+                {
+                    self.totalUnresolvedSendCount++;
+                    continue;
+                }
+                
+                [udpSocket sendData:data toAddress:(NSData * _Nonnull)address withTimeout:-1 tag:0];
+                self.totalSharedDatagramCount++;
+            }
+        }
+    }
+}
+
+// Must be called while synchronized.
+- (nullable GCDAsyncUdpSocket *) udpSocketForInterface:(nullable NSString *)interface
+{
+    NSString *key = ( interface ? interface : @"" );
+    GCDAsyncUdpSocket *udpSocket = self.udpSocketsByInterface[key];
+    if ( udpSocket )
+        return udpSocket;
+    
+    udpSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    
+    NSError *error = nil;
+    if ( interface.length )
+    {
+        // Port 0 means that the OS should choose a random ephemeral port for this socket.
+        if ( ![udpSocket bindToPort:0 interface:interface error:&error] )
+        {
+            NSLog( @"Warning: F53OSCClientGroup unable to bind interface %@ - %@", interface, [error localizedDescription] );
+            return nil;
+        }
+    }
+    
+    // Match F53OSCSocket, which allows members to address a broadcast destination.
+    if ( ![udpSocket enableBroadcast:YES error:&error] )
+    {
+        NSString *errString = error ? [error localizedDescription] : @"(unknown error)";
+        NSLog( @"Warning: F53OSCClientGroup unable to enable UDP broadcast - %@", errString );
+    }
+    
+    self.udpSocketsByInterface[key] = udpSocket;
+    return udpSocket;
+}
+
+// Not called while synchronized, since it may block on a host lookup.
+- (nullable NSData *) addressForClient:(F53OSCClient *)client
+{
+    NSString *host = client.host;
+    if ( host.length == 0 )
+        return nil;
+    
+    return [self.transportEngine addressForHost:(NSString * _Nonnull)host port:client.port preferIPv6:client.isIPv6Enabled];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
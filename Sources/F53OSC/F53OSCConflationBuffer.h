@@ -0,0 +1,80 @@
+//
+//  F53OSCConflationBuffer.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCMessage.h>
+#else
+#import "F53OSCMessage.h"
+#endif
+
+//
+//  F53OSCConflationBuffer sits between F53OSCParser and a destination that may fall behind.
+//  Messages to registered addresses are conflated: only the newest message for each key is kept
+//  until the destination drains the buffer, so stale fader levels or meter values are never delivered.
+//  A key is the address, optionally followed by a number of leading arguments, e.g. the channel
+//  number in "/fader ,if 3 0.5". A registered address takes precedence over prefixes, and otherwise
+//  the longest matching prefix decides. All other messages are discrete and are delivered in full, in order.
+//  Replaced messages are passed to the destination's `didDropMessages:` if it implements it.
+//
+//  Bundles received through `takeBundleMessages:timeTag:` are discrete: they keep their place in the delivery
+//  order and are passed on whole, with their time tag, if the destination implements that method too.
+//
+//  Messages are delivered asynchronously on `deliveryQueue`, to `takeMessages:` if the destination
+//  implements it or else to `takeMessage:`. At most one drain is queued at a time, so the work done
+//  per received message stays constant however far behind the destination gets.
+//
+//  A buffer has a single destination, which F53OSCServer and F53OSCClient point at their own delegate as they
+//  read, so each buffer should be set on only one server or client.
+//
+//  Example usage:
+//  F53OSCConflationBuffer *conflation = [[F53OSCConflationBuffer alloc] init];
+//  [conflation conflateAddress:@"/meter" keyArgumentCount:1];
+//  [conflation conflateAddressesWithPrefix:@"/fader/" keyArgumentCount:0];
+//  server.conflationBuffer = conflation;
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCConflationBuffer : NSObject <F53OSCPacketDestination>
+
+- (instancetype) initWithDeliveryQueue:(dispatch_queue_t)queue;
+
+@property (nonatomic, weak, nullable)   id<F53OSCPacketDestination> destination;
+@property (nonatomic, strong)           dispatch_queue_t deliveryQueue; // default main queue
+@property (readonly)                    NSUInteger pendingCount;        // messages waiting to be delivered
+@property (readonly)                    NSUInteger conflatedCount;      // messages replaced by a newer one before delivery
+
+- (void) conflateAddress:(NSString *)address keyArgumentCount:(NSUInteger)keyArgumentCount;
+- (void) conflateAddressesWithPrefix:(NSString *)prefix keyArgumentCount:(NSUInteger)keyArgumentCount;
+- (void) removeAllConflatedAddresses;
+
+- (BOOL) conflatesAddress:(NSString *)address;
+
+@end
+
+NS_ASSUME_NONNULL_END
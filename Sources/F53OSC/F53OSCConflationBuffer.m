@@ -0,0 +1,355 @@
+//
+//  F53OSCConflationBuffer.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCConflationBuffer.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53_OSC_CONFLATION_NOT_CONFLATED    NSNotFound
+
+// One slot in the delivery order. A conflated slot gives up its message when a newer one for the same key arrives.
+// A bundle fills a single discrete slot, so it is delivered whole and its messages are never conflated.
+@interface F53OSCConflationEntry : NSObject
+@property (strong, nullable) F53OSCMessage *message;
+@property (copy, nullable) NSString *key;
+@property (copy, nullable) NSArray<F53OSCMessage *> *bundleMessages;
+@property (strong, nullable) F53OSCTimeTag *bundleTimeTag;
+@end
+
+@implementation F53OSCConflationEntry
+@end
+
+
+@interface F53OSCConflationBuffer ()
+
+@property (strong) NSMutableDictionary<NSString *, NSNumber *> *addressKeyArgumentCounts;  // exact address -> leading arguments in key
+@property (strong) NSMutableDictionary<NSString *, NSNumber *> *prefixKeyArgumentCounts;   // address prefix -> leading arguments in key
+@property (strong) NSMutableArray<F53OSCConflationEntry *> *entries;                        // delivery order, including superseded slots
+@property (strong) NSMutableDictionary<NSString *, F53OSCConflationEntry *> *entriesByKey;  // newest pending slot for each conflation key
+@property (assign) NSUInteger livePendingCount;
+@property (assign) NSUInteger totalConflatedCount;
+@property (assign) BOOL drainScheduled;
+
+- (NSUInteger) keyArgumentCountForAddress:(NSString *)address;
+- (nullable NSString *) conflationKeyForMessage:(F53OSCMessage *)message;
+- (void) addEntry:(F53OSCConflationEntry *)entry;
+- (void) deliverMessages:(NSArray<F53OSCMessage *> *)messages;
+- (void) drain;
+
+@end
+
+
+@implementation F53OSCConflationBuffer
+
+- (instancetype) init
+{
+    return [self initWithDeliveryQueue:dispatch_get_main_queue()];
+}
+
+- (instancetype) initWithDeliveryQueue:(dispatch_queue_t)queue
+{
+    self = [super init];
+    if ( self )
+    {
+        self.destination = nil;
+        self.deliveryQueue = queue;
+        self.addressKeyArgumentCounts = [NSMutableDictionary dictionary];
+        self.prefixKeyArgumentCounts = [NSMutableDictionary dictionary];
+        self.entries = [NSMutableArray array];
+        self.entriesByKey = [NSMutableDictionary dictionary];
+        self.livePendingCount = 0;
+        self.totalConflatedCount = 0;
+        self.drainScheduled = NO;
+    }
+    return self;
+}
+
+- (NSUInteger) pendingCount
+{
+    @synchronized( self )
+    {
+        return self.livePendingCount;
+    }
+}
+
+- (NSUInteger) conflatedCount
+{
+    @synchronized( self )
+    {
+        return self.totalConflatedCount;
+    }
+}
+
+- (void) conflateAddress:(NSString *)address keyArgumentCount:(NSUInteger)keyArgumentCount
+{
+    @synchronized( self )
+    {
+        self.addressKeyArgumentCounts[address] = @(keyArgumentCount);
+    }
+}
+
+- (void) conflateAddressesWithPrefix:(NSString *)prefix keyArgumentCount:(NSUInteger)keyArgumentCount
+{
+    if ( prefix.length == 0 )
+    {
+        NSLog( @"Error: F53OSCConflationBuffer requires a non-empty address prefix." );
+        return;
+    }
+    
+    @synchronized( self )
+    {
+        self.prefixKeyArgumentCounts[prefix] = @(keyArgumentCount);
+    }
+}
+
+- (void) removeAllConflatedAddresses
+{
+    @synchronized( self )
+    {
+        [self.addressKeyArgumentCounts removeAllObjects];
+        [self.prefixKeyArgumentCounts removeAllObjects];
+    }
+}
+
+- (BOOL) conflatesAddress:(NSString *)address
+{
+    @synchronized( self )
+    {
+        return ( [self keyArgumentCountForAddress:address] != F53_OSC_CONFLATION_NOT_CONFLATED );
+    }
+}
+
+#pragma mark - conflation keys
+
+// Must be called while synchronized.
+- (NSUInteger) keyArgumentCountForAddress:(NSString *)address
+{
+    NSNumber *count = self.addressKeyArgumentCounts[address];
+    if ( count )
+        return count.unsignedIntegerValue;
+    
+    // The longest matching prefix wins, so "/mix/ch/" can be keyed differently from the rest of "/mix/".
+    NSUInteger matchLength = 0;
+    for ( NSString *prefix in self.prefixKeyArgumentCounts )
+    {
+        if ( prefix.length > matchLength && [address hasPrefix:prefix] )
+        {
+            count = self.prefixKeyArgumentCounts[prefix];
+            matchLength = prefix.length;
+        }
+    }
+    if ( count )
+        return count.unsignedIntegerValue;
+    
+    return F53_OSC_CONFLATION_NOT_CONFLATED;
+}
+
+// Must be called while synchronized. Returns nil for discrete messages.
+- (nullable NSString *) conflationKeyForMessage:(F53OSCMessage *)message
+{
+    NSString *address = message.addressPattern;
+    NSUInteger keyArgumentCount = [self keyArgumentCountForAddress:address];
+    if ( keyArgumentCount == F53_OSC_CONFLATION_NOT_CONFLATED )
+        return nil;
+    
+    if ( keyArgumentCount == 0 )
+        return address;
+    
+    // A message without enough arguments to build its key cannot be conflated safely.
+    NSArray *arguments = message.arguments;
+    if ( arguments.count < keyArgumentCount )
+        return nil;
+    
+    // Each key argument carries its type tag, since an int 1 and a float 1.0 describe the same NSNumber.
+    NSString *typeTags = message.typeTagString;
+    NSMutableString *key = [NSMutableString stringWithString:address];
+    for ( NSUInteger i = 0; i < keyArgumentCount; i++ )
+    {
+        unichar tag = ( i + 1 < typeTags.length ? [typeTags characterAtIndex:i + 1] : '?' );
+        [key appendFormat:@"\x1f%C%@", tag, arguments[i]]; // unit separator cannot appear in an OSC address
+    }
+    return key;
+}
+
+#pragma mark - F53OSCPacketDestination
+
+- (void) takeMessage:(nullable F53OSCMessage *)message
+{
+    if ( message == nil )
+        return;
+    
+    F53OSCConflationEntry *entry = [[F53OSCConflationEntry alloc] init];
+    entry.message = message;
+    [self addEntry:entry];
+}
+
+- (void) takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    if ( messages.count == 0 )
+        return;
+    
+    F53OSCConflationEntry *entry = [[F53OSCConflationEntry alloc] init];
+    entry.bundleMessages = messages;
+    entry.bundleTimeTag = timeTag;
+    [self addEntry:entry];
+}
+
+- (BOOL) respondsToSelector:(SEL)aSelector
+{
+    // Bundles only take the whole-bundle path when the real destination asked for it.
+    if ( aSelector == @selector(takeBundleMessages:timeTag:) )
+        return [self.destination respondsToSelector:aSelector];
+    
+    return [super respondsToSelector:aSelector];
+}
+
+#pragma mark - draining
+
+- (void) addEntry:(F53OSCConflationEntry *)entry
+{
+    BOOL scheduleDrain = NO;
+    F53OSCMessage *staleMessage = nil;
+    
+    @synchronized( self )
+    {
+        if ( entry.message )
+            entry.key = [self conflationKeyForMessage:(F53OSCMessage * _Nonnull)entry.message];
+        
+        if ( entry.key )
+        {
+            // The newest value takes the newest position, so it still follows any discrete message received before it.
+            F53OSCConflationEntry *staleEntry = self.entriesByKey[(NSString * _Nonnull)entry.key];
+            if ( staleEntry )
+            {
+                staleMessage = staleEntry.message;
+                staleEntry.message = nil;
+                self.livePendingCount--;
+                self.totalConflatedCount++;
+            }
+            self.entriesByKey[(NSString * _Nonnull)entry.key] = entry;
+        }
+        
+        [self.entries addObject:entry];
+        self.livePendingCount += ( entry.bundleMessages ? entry.bundleMessages.count : 1 );
+        
+        // Superseded slots cost nothing to deliver but would otherwise pile up while the destination is behind.
+        if ( self.entries.count > 2 * self.livePendingCount + 64 )
+        {
+            NSIndexSet *emptySlots = [self.entries indexesOfObjectsPassingTest:^BOOL(F53OSCConflationEntry *obj, NSUInteger idx, BOOL *stop) {
+                return ( obj.message == nil && obj.bundleMessages == nil );
+            }];
+            [self.entries removeObjectsAtIndexes:emptySlots];
+        }
+        
+        if ( !self.drainScheduled )
+        {
+            self.drainScheduled = YES;
+            scheduleDrain = YES;
+        }
+    }
+    
+    if ( staleMessage )
+    {
+        id<F53OSCPacketDestination> destination = self.destination;
+        if ( [destination respondsToSelector:@selector(didDropMessages:)] )
+            [destination didDropMessages:@[ (F53OSCMessage * _Nonnull)staleMessage ]];
+    }
+    
+    if ( scheduleDrain )
+    {
+        dispatch_async( self.deliveryQueue, ^{
+            [self drain];
+        });
+    }
+}
+
+- (void) deliverMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    if ( messages.count == 0 )
+        return;
+    
+    id<F53OSCPacketDestination> destination = self.destination;
+    if ( [destination respondsToSelector:@selector(takeMessages:)] )
+    {
+        [destination takeMessages:messages];
+    }
+    else
+    {
+        for ( F53OSCMessage *message in messages )
+            [destination takeMessage:message];
+    }
+}
+
+- (void) drain
+{
+    NSArray<F53OSCConflationEntry *> *entries;
+    
+    @synchronized( self )
+    {
+        self.drainScheduled = NO;
+        
+        // Once detached from entriesByKey, these slots can no longer be superseded.
+        entries = self.entries;
+        self.entries = [NSMutableArray array];
+        [self.entriesByKey removeAllObjects];
+        self.livePendingCount = 0;
+    }
+    
+    id<F53OSCPacketDestination> destination = self.destination;
+    BOOL takesBundles = [destination respondsToSelector:@selector(takeBundleMessages:timeTag:)];
+    
+    // Messages either side of a bundle go out in separate calls so the bundle keeps its place.
+    NSMutableArray<F53OSCMessage *> *messages = [NSMutableArray arrayWithCapacity:entries.count];
+    for ( F53OSCConflationEntry *entry in entries )
+    {
+        if ( entry.message )
+        {
+            [messages addObject:(F53OSCMessage * _Nonnull)entry.message];
+        }
+        else if ( entry.bundleMessages && takesBundles )
+        {
+            [self deliverMessages:messages];
+            messages = [NSMutableArray array];
+            
+            [destination takeBundleMessages:(NSArray<F53OSCMessage *> * _Nonnull)entry.bundleMessages
+                                    timeTag:(F53OSCTimeTag * _Nonnull)entry.bundleTimeTag];
+        }
+        else if ( entry.bundleMessages )
+        {
+            [messages addObjectsFromArray:(NSArray<F53OSCMessage *> * _Nonnull)entry.bundleMessages];
+        }
+    }
+    [self deliverMessages:messages];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,75 @@
+//
+//  F53OSCDatagramCipher.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+@class F53OSCEncrypt;
+
+//
+//  F53OSCDatagramCipher seals and opens the datagrams of an encrypted UDP session. Each datagram is sealed on its own
+//  with ChaChaPoly, using the session key agreed by F53OSCEncryptHandshake and a nonce made of the sending end and a
+//  counter, and is sent as '*' followed by the nonce, ciphertext, and tag, like encrypted TCP packets.
+//
+//  Received datagrams pass through a sliding-window replay filter on their counter: a datagram is accepted once, in
+//  any order, as long as it is no more than `F53OSCDatagramCipherReplayWindow` behind the newest one accepted. The
+//  filter is only updated once a datagram has been authenticated, so forged datagrams can not disturb it.
+//
+//  The end that requested encryption is the initiator, and the initiator flag keeps the two ends' nonces apart. The
+//  responder counts from zero. The initiator counts from the current time in microseconds, because a server answers a
+//  repeated request for a confirmed session with the same key: a peer that handshakes again from the same port then
+//  carries on above its earlier counters, so it neither repeats a nonce nor has its datagrams taken for replays.
+//
+//  F53OSCClient and F53OSCServer set up a cipher for each encrypted UDP session.
+//
+//  Example usage:
+//  F53OSCDatagramCipher *cipher = [[F53OSCDatagramCipher alloc] initWithEncrypter:encrypter initiator:YES];
+//  NSData *datagram = [cipher sealPacketData:message.packetData];
+//  NSData *packetData = [peerCipher openDatagram:datagram]; // nil if forged, replayed, or too old
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53OSCDatagramCipherReplayWindow    1984    // counters; the filter keeps 2048 bits, of which one word is slack
+
+@interface F53OSCDatagramCipher : NSObject
+
+@property (readonly, strong) F53OSCEncrypt *encrypter;
+@property (readonly) BOOL initiator;
+
+@property (readonly) NSUInteger sealedCount;
+@property (readonly) NSUInteger openedCount;
+@property (readonly) NSUInteger replayedCount;      // duplicates, and datagrams too far behind the newest
+@property (readonly) NSUInteger failedCount;        // malformed, from the wrong end, or failed to authenticate
+
+- (instancetype) init NS_UNAVAILABLE;
+- (instancetype) initWithEncrypter:(F53OSCEncrypt *)encrypter initiator:(BOOL)initiator NS_DESIGNATED_INITIALIZER;
+
+- (nullable NSData *) sealPacketData:(NSData *)data; // returns nil if the encrypter has no key
+- (nullable NSData *) openDatagram:(NSData *)datagram; // returns the clear packet data
+
+@end
+
+NS_ASSUME_NONNULL_END
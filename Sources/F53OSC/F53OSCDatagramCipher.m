@@ -0,0 +1,256 @@
+//
+//  F53OSCDatagramCipher.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCDatagramCipher.h"
+
+#if __has_include(<F53OSC/F53OSC-Swift.h>) // F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSC-Swift.h>
+#elif SWIFT_PACKAGE // Swift Package Manager
+@import F53OSCEncrypt;
+#endif
+
+#import <libkern/OSByteOrder.h>
+#import <string.h>
+#import <sys/time.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define REPLAY_WINDOW_BITS      2048
+#define REPLAY_WORD_BITS        64
+#define REPLAY_WINDOW_WORDS     ( REPLAY_WINDOW_BITS / REPLAY_WORD_BITS )
+
+#define NONCE_LENGTH            12      // 4 byte sender, 8 byte counter
+#define TAG_LENGTH              16
+
+_Static_assert( F53OSCDatagramCipherReplayWindow == REPLAY_WINDOW_BITS - REPLAY_WORD_BITS, "The replay window leaves one word of slack" );
+
+// Counters are kept plus one, so that a zero `top` means that nothing has been accepted yet.
+typedef struct
+{
+    uint64_t    top;
+    uint64_t    bitmap[REPLAY_WINDOW_WORDS];
+} F53OSCReplayWindow;
+
+static bool F53OSCReplayWindowCheck( const F53OSCReplayWindow *window, uint64_t counter )
+{
+    if ( counter == UINT64_MAX )
+        return false;
+    
+    counter++;
+    if ( counter > window->top )
+        return true;
+    if ( window->top - counter >= F53OSCDatagramCipherReplayWindow )
+        return false;
+    
+    uint64_t word = ( counter / REPLAY_WORD_BITS ) % REPLAY_WINDOW_WORDS;
+    return ( ( window->bitmap[word] >> ( counter % REPLAY_WORD_BITS ) ) & 1 ) == 0;
+}
+
+static bool F53OSCReplayWindowAccept( F53OSCReplayWindow *window, uint64_t counter )
+{
+    if ( !F53OSCReplayWindowCheck( window, counter ) )
+        return false;
+    
+    counter++;
+    if ( counter > window->top )
+    {
+        // Words the window slides past are cleared for reuse.
+        uint64_t currentWord = window->top / REPLAY_WORD_BITS;
+        uint64_t wordsToClear = counter / REPLAY_WORD_BITS - currentWord;
+        if ( wordsToClear > REPLAY_WINDOW_WORDS )
+            wordsToClear = REPLAY_WINDOW_WORDS;
+        for ( uint64_t i = 1; i <= wordsToClear; i++ )
+            window->bitmap[( currentWord + i ) % REPLAY_WINDOW_WORDS] = 0;
+        window->top = counter;
+    }
+    
+    window->bitmap[( counter / REPLAY_WORD_BITS ) % REPLAY_WINDOW_WORDS] |= ( 1ULL << ( counter % REPLAY_WORD_BITS ) );
+    return true;
+}
+
+
+@interface F53OSCDatagramCipher ()
+{
+    F53OSCReplayWindow _replayWindow;
+}
+
+@property (assign) uint64_t nextCounter;
+@property (assign) NSUInteger totalSealedCount;
+@property (assign) NSUInteger totalOpenedCount;
+@property (assign) NSUInteger totalReplayedCount;
+@property (assign) NSUInteger totalFailedCount;
+
+@end
+
+@implementation F53OSCDatagramCipher
+
+- (instancetype) initWithEncrypter:(F53OSCEncrypt *)encrypter initiator:(BOOL)initiator
+{
+    self = [super init];
+    if ( self )
+    {
+        _encrypter = encrypter;
+        _initiator = initiator;
+        memset( &_replayWindow, 0, sizeof( _replayWindow ) );
+        
+        if ( initiator )
+        {
+            struct timeval now;
+            gettimeofday( &now, NULL );
+            self.nextCounter = (uint64_t)now.tv_sec * USEC_PER_SEC + (uint64_t)now.tv_usec;
+        }
+    }
+    return self;
+}
+
+- (NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ %p %@ sealed: %lu opened: %lu>", NSStringFromClass( [self class] ), self, ( self.initiator ? @"initiator" : @"responder" ),
+            (unsigned long)self.sealedCount, (unsigned long)self.openedCount];
+}
+
+- (NSUInteger) sealedCount
+{
+    @synchronized( self )
+    {
+        return self.totalSealedCount;
+    }
+}
+
+- (NSUInteger) openedCount
+{
+    @synchronized( self )
+    {
+        return self.totalOpenedCount;
+    }
+}
+
+- (NSUInteger) replayedCount
+{
+    @synchronized( self )
+    {
+        return self.totalReplayedCount;
+    }
+}
+
+- (NSUInteger) failedCount
+{
+    @synchronized( self )
+    {
+        return self.totalFailedCount;
+    }
+}
+
+#pragma mark -
+
+- (nullable NSData *) sealPacketData:(NSData *)data
+{
+    uint64_t counter;
+    @synchronized( self )
+    {
+        counter = self.nextCounter++;
+    }
+    
+    uint32_t sender = ( self.initiator ? 0 : 1 );
+    NSData *sealed = [self.encrypter encryptDataWithClearData:data sender:sender counter:counter];
+    if ( sealed == nil )
+        return nil;
+    
+    NSMutableData *datagram = [NSMutableData dataWithCapacity:1 + sealed.length];
+    [datagram appendBytes:"*" length:1];
+    [datagram appendData:sealed];
+    
+    @synchronized( self )
+    {
+        self.totalSealedCount++;
+    }
+    return datagram;
+}
+
+- (nullable NSData *) openDatagram:(NSData *)datagram
+{
+    const uint8_t *bytes = datagram.bytes;
+    if ( datagram.length < 1 + NONCE_LENGTH + TAG_LENGTH || bytes[0] != '*' )
+    {
+        @synchronized( self )
+        {
+            self.totalFailedCount++;
+        }
+        return nil;
+    }
+    
+    // Datagrams from this end, e.g. reflected back, are rejected along with malformed ones.
+    uint32_t sender = OSReadBigInt32( bytes, 1 );
+    uint64_t counter = OSReadBigInt64( bytes, 5 );
+    uint32_t expectedSender = ( self.initiator ? 1 : 0 );
+    
+    @synchronized( self )
+    {
+        if ( sender != expectedSender )
+        {
+            self.totalFailedCount++;
+            return nil;
+        }
+        
+        // Replays are turned away before the cost of decrypting them.
+        if ( !F53OSCReplayWindowCheck( &_replayWindow, counter ) )
+        {
+            self.totalReplayedCount++;
+            return nil;
+        }
+    }
+    
+    NSData *sealed = [datagram subdataWithRange:NSMakeRange( 1, datagram.length - 1 )];
+    NSData *clearData = [self.encrypter decryptDataWithEncryptedData:sealed];
+    
+    @synchronized( self )
+    {
+        if ( clearData == nil )
+        {
+            self.totalFailedCount++;
+            return nil;
+        }
+        
+        // Checked again: the same datagram may have been opened on another thread meanwhile.
+        if ( !F53OSCReplayWindowAccept( &_replayWindow, counter ) )
+        {
+            self.totalReplayedCount++;
+            return nil;
+        }
+        
+        self.totalOpenedCount++;
+    }
+    return clearData;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
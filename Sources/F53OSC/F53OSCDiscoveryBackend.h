@@ -0,0 +1,115 @@
+//
+//  F53OSCDiscoveryBackend.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+@protocol F53OSCDiscoveryBackendDelegate;
+
+//
+//  A discovery backend finds and resolves the services an F53OSCBrowser turns into client records. The browser uses
+//  Bonjour unless it is given another backend in `discoveryBackend`.
+//
+//  The browser starts and stops searching, and asks for services to be resolved, several at a time. A backend reports
+//  found and removed services, and the outcome of each resolution, to its delegate on the main queue.
+//
+//  F53OSCLocalDiscoveryBackend stands in for Bonjour where mDNS is unavailable or unwanted, e.g. in tests. Its services
+//  are published in-process, one at a time or from a JSON file, and each resolution may take a set delay.
+//
+//  Example usage:
+//  F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+//  [backend publishServiceWithName:@"Stage Left" type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[ @"127.0.0.1" ]];
+//  browser.discoveryBackend = backend;
+//  browser.serviceType = @"_osc._udp.";
+//  [browser start];
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCDiscoveredService : NSObject
+
++ (NSString *) keyForServiceWithName:(NSString *)name type:(NSString *)type domain:(NSString *)domain;
+
+- (instancetype) init NS_UNAVAILABLE;
+- (instancetype) initWithName:(NSString *)name type:(NSString *)type domain:(NSString *)domain NS_DESIGNATED_INITIALIZER;
+- (instancetype) initWithNetService:(NSNetService *)netService;
+
+@property (nonatomic, readonly, copy)   NSString *name;
+@property (nonatomic, readonly, copy)   NSString *type;
+@property (nonatomic, readonly, copy)   NSString *domain;
+@property (nonatomic, readonly, copy)   NSString *key;              // identifies the service; see `+keyForServiceWithName:type:domain:`
+@property (nonatomic, assign)           NSInteger port;             // default -1 (not resolved)
+@property (nonatomic, copy)             NSArray<NSData *> *addresses; // sockaddr structures, like NSNetService
+@property (nonatomic, strong, nullable) NSNetService *netService;   // set for services found by Bonjour
+
+@end
+
+
+@protocol F53OSCDiscoveryBackend <NSObject>
+
+@property (nonatomic, weak, nullable) id<F53OSCDiscoveryBackendDelegate> delegate;
+
+- (void) startSearchingForServicesOfType:(NSString *)type inDomain:(NSString *)domain;
+- (void) stop;
+
+// Reports the outcome with `discoveryBackend:didResolveService:` or `discoveryBackend:didNotResolveService:error:`.
+- (void) resolveService:(F53OSCDiscoveredService *)service timeout:(NSTimeInterval)timeout;
+- (void) cancelResolvingService:(F53OSCDiscoveredService *)service;
+
+@end
+
+
+@protocol F53OSCDiscoveryBackendDelegate <NSObject>
+
+- (void) discoveryBackend:(id<F53OSCDiscoveryBackend>)backend didFindService:(F53OSCDiscoveredService *)service;
+- (void) discoveryBackend:(id<F53OSCDiscoveryBackend>)backend didRemoveService:(F53OSCDiscoveredService *)service;
+- (void) discoveryBackend:(id<F53OSCDiscoveryBackend>)backend didResolveService:(F53OSCDiscoveredService *)service; // with `port` and `addresses` set
+- (void) discoveryBackend:(id<F53OSCDiscoveryBackend>)backend didNotResolveService:(F53OSCDiscoveredService *)service error:(NSError *)error;
+
+@end
+
+
+@interface F53OSCLocalDiscoveryBackend : NSObject <F53OSCDiscoveryBackend>
+
+@property (nonatomic, weak, nullable) id<F53OSCDiscoveryBackendDelegate> delegate;
+
+@property (assign)              NSTimeInterval resolveDelay;    // default 0; how long each resolution takes
+@property (readonly)            BOOL searching;
+@property (readonly)            NSUInteger resolveCount;        // resolutions started
+@property (readonly)            NSUInteger maxResolvingCount;   // the most resolutions in progress at once
+
+// Services are reported to the delegate while searching for their type and domain. Publishing a service again
+// replaces it; host addresses are IPv4 or IPv6 literals.
+- (void) publishServiceWithName:(NSString *)name type:(NSString *)type domain:(NSString *)domain port:(UInt16)port hostAddresses:(NSArray<NSString *> *)hostAddresses;
+- (void) unpublishServiceWithName:(NSString *)name type:(NSString *)type domain:(NSString *)domain;
+- (void) unpublishAllServices;
+
+// Publishes each service in a JSON array of objects with "name", "type", "domain" (default "local."), "port", and
+// "hostAddresses". Returns NO, publishing nothing, if the file can not be read or any entry is malformed.
+- (BOOL) publishServicesFromFileAtURL:(NSURL *)url error:(NSError **)outError;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,343 @@
+//
+//  F53OSCDiscoveryBackend.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCDiscoveryBackend.h"
+
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+static NSString *const F53OSCDiscoveryErrorDomain = @"F53OSCDiscoveryErrorDomain";
+
+// Service types and domains are compared without their trailing dot, so "_osc._udp" finds "_osc._udp.".
+static NSString *F53OSCDiscoveryTrimmedName( NSString *name )
+{
+    if ( [name hasSuffix:@"."] )
+        return [name substringToIndex:name.length - 1];
+    return name;
+}
+
+@implementation F53OSCDiscoveredService
+
++ (NSString *) keyForServiceWithName:(NSString *)name type:(NSString *)type domain:(NSString *)domain
+{
+    return [NSString stringWithFormat:@"%@\n%@\n%@", name, F53OSCDiscoveryTrimmedName( type ), F53OSCDiscoveryTrimmedName( domain )];
+}
+
+- (instancetype) initWithName:(NSString *)name type:(NSString *)type domain:(NSString *)domain
+{
+    self = [super init];
+    if ( self )
+    {
+        _name = [name copy];
+        _type = [type copy];
+        _domain = [domain copy];
+        _key = [[F53OSCDiscoveredService keyForServiceWithName:name type:type domain:domain] copy];
+        self.port = -1;
+        self.addresses = @[];
+        self.netService = nil;
+    }
+    return self;
+}
+
+- (instancetype) initWithNetService:(NSNetService *)netService
+{
+    self = [self initWithName:netService.name type:netService.type domain:netService.domain];
+    if ( self )
+    {
+        self.netService = netService;
+    }
+    return self;
+}
+
+- (NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ %p \"%@\" %@%@ port: %ld>", NSStringFromClass( [self class] ), self, self.name, self.type, self.domain, (long)self.port];
+}
+
+@end
+
+
+@interface F53OSCLocalDiscoveryBackend ()
+
+@property (assign, readwrite)   BOOL searching;
+@property (copy, nullable)      NSString *searchType;
+@property (copy, nullable)      NSString *searchDomain;
+@property (strong)              NSMutableDictionary<NSString *, F53OSCDiscoveredService *> *publishedServices; // resolved, by key
+@property (strong)              NSMutableDictionary<NSString *, NSNumber *> *resolvingServices; // resolution number, by key
+@property (assign, readwrite)   NSUInteger resolveCount;
+@property (assign, readwrite)   NSUInteger maxResolvingCount;
+
+- (BOOL) isSearchingForService:(F53OSCDiscoveredService *)service;
+- (void) reportFoundService:(F53OSCDiscoveredService *)publishedService;
+- (void) reportRemovedService:(F53OSCDiscoveredService *)publishedService;
+
++ (nullable NSData *) addressDataForHost:(NSString *)host port:(UInt16)port;
+
+@end
+
+
+@implementation F53OSCLocalDiscoveryBackend
+
+- (instancetype) init
+{
+    self = [super init];
+    if ( self )
+    {
+        self.delegate = nil;
+        self.resolveDelay = 0;
+        self.searching = NO;
+        self.publishedServices = [NSMutableDictionary dictionary];
+        self.resolvingServices = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - F53OSCDiscoveryBackend
+
+- (void) startSearchingForServicesOfType:(NSString *)type inDomain:(NSString *)domain
+{
+    [self stop];
+    
+    self.searchType = F53OSCDiscoveryTrimmedName( type );
+    self.searchDomain = F53OSCDiscoveryTrimmedName( domain );
+    self.searching = YES;
+    
+    for ( F53OSCDiscoveredService *aService in self.publishedServices.allValues )
+    {
+        if ( [self isSearchingForService:aService] )
+            [self reportFoundService:aService];
+    }
+}
+
+- (void) stop
+{
+    self.searching = NO;
+    self.searchType = nil;
+    self.searchDomain = nil;
+    [self.resolvingServices removeAllObjects];
+}
+
+- (void) resolveService:(F53OSCDiscoveredService *)service timeout:(NSTimeInterval)timeout
+{
+    NSString *key = service.key;
+    NSNumber *resolution = @( ++self.resolveCount );
+    self.resolvingServices[key] = resolution;
+    self.maxResolvingCount = MAX( self.maxResolvingCount, self.resolvingServices.count );
+    
+    NSTimeInterval delay = self.resolveDelay;
+    BOOL timesOut = ( timeout > 0 && delay > timeout );
+    if ( timesOut )
+        delay = timeout;
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_after( dispatch_time( DISPATCH_TIME_NOW, (int64_t)( delay * NSEC_PER_SEC ) ), dispatch_get_main_queue(), ^{
+        F53OSCLocalDiscoveryBackend *strongSelf = weakSelf;
+        if ( !strongSelf )
+            return;
+        
+        // Cancelled, or superseded by a later resolution of the same service.
+        if ( ![strongSelf.resolvingServices[key] isEqualToNumber:resolution] )
+            return;
+        [strongSelf.resolvingServices removeObjectForKey:key];
+        
+        F53OSCDiscoveredService *publishedService = strongSelf.publishedServices[key];
+        if ( timesOut || !publishedService )
+        {
+            NSString *description = ( timesOut ? @"Resolving the service timed out." : @"The service is not published." );
+            NSError *error = [NSError errorWithDomain:F53OSCDiscoveryErrorDomain code:-1 userInfo:@{ NSLocalizedDescriptionKey : description }];
+            [strongSelf.delegate discoveryBackend:strongSelf didNotResolveService:service error:error];
+            return;
+        }
+        
+        service.port = publishedService.port;
+        service.addresses = publishedService.addresses;
+        [strongSelf.delegate discoveryBackend:strongSelf didResolveService:service];
+    });
+}
+
+- (void) cancelResolvingService:(F53OSCDiscoveredService *)service
+{
+    [self.resolvingServices removeObjectForKey:service.key];
+}
+
+#pragma mark - Publishing
+
+- (void) publishServiceWithName:(NSString *)name type:(NSString *)type domain:(NSString *)domain port:(UInt16)port hostAddresses:(NSArray<NSString *> *)hostAddresses
+{
+    F53OSCDiscoveredService *service = [[F53OSCDiscoveredService alloc] initWithName:name type:type domain:domain];
+    service.port = port;
+    
+    NSMutableArray<NSData *> *addresses = [NSMutableArray arrayWithCapacity:hostAddresses.count];
+    for ( NSString *aHost in hostAddresses )
+    {
+        NSData *address = [F53OSCLocalDiscoveryBackend addressDataForHost:aHost port:port];
+        if ( address )
+            [addresses addObject:address];
+        else
+            NSLog( @"Warning: %@ ignoring host address \"%@\" of service \"%@\"; it is not an IP address.", self, aHost, name );
+    }
+    service.addresses = addresses;
+    
+    F53OSCDiscoveredService *replacedService = self.publishedServices[service.key];
+    self.publishedServices[service.key] = service;
+    
+    if ( replacedService && [self isSearchingForService:replacedService] )
+        [self reportRemovedService:replacedService];
+    if ( [self isSearchingForService:service] )
+        [self reportFoundService:service];
+}
+
+- (void) unpublishServiceWithName:(NSString *)name type:(NSString *)type domain:(NSString *)domain
+{
+    NSString *key = [F53OSCDiscoveredService keyForServiceWithName:name type:type domain:domain];
+    F53OSCDiscoveredService *service = self.publishedServices[key];
+    if ( !service )
+        return;
+    
+    [self.publishedServices removeObjectForKey:key];
+    if ( [self isSearchingForService:service] )
+        [self reportRemovedService:service];
+}
+
+- (void) unpublishAllServices
+{
+    for ( F53OSCDiscoveredService *aService in self.publishedServices.allValues )
+        [self unpublishServiceWithName:aService.name type:aService.type domain:aService.domain];
+}
+
+- (BOOL) publishServicesFromFileAtURL:(NSURL *)url error:(NSError **)outError
+{
+    NSData *data = [NSData dataWithContentsOfURL:url options:0 error:outError];
+    if ( !data )
+        return NO;
+    
+    id entries = [NSJSONSerialization JSONObjectWithData:data options:0 error:outError];
+    if ( !entries )
+        return NO;
+    
+    // Every entry is checked before any is published.
+    BOOL valid = [entries isKindOfClass:[NSArray class]];
+    for ( id anEntry in ( valid ? entries : @[] ) )
+    {
+        valid = ( [anEntry isKindOfClass:[NSDictionary class]] &&
+                 [anEntry[@"name"] isKindOfClass:[NSString class]] &&
+                 [anEntry[@"type"] isKindOfClass:[NSString class]] &&
+                 ( !anEntry[@"domain"] || [anEntry[@"domain"] isKindOfClass:[NSString class]] ) &&
+                 [anEntry[@"port"] isKindOfClass:[NSNumber class]] &&
+                 [anEntry[@"port"] integerValue] > 0 && [anEntry[@"port"] integerValue] <= UINT16_MAX &&
+                 [anEntry[@"hostAddresses"] isKindOfClass:[NSArray class]] );
+        for ( id aHost in ( valid ? anEntry[@"hostAddresses"] : @[] ) )
+            valid = ( valid && [aHost isKindOfClass:[NSString class]] );
+        if ( !valid )
+            break;
+    }
+    
+    if ( !valid )
+    {
+        if ( outError )
+            *outError = [NSError errorWithDomain:F53OSCDiscoveryErrorDomain code:-1 userInfo:@{ NSLocalizedDescriptionKey : [NSString stringWithFormat:@"%@ is not a JSON array of services.", url.lastPathComponent] }];
+        return NO;
+    }
+    
+    for ( NSDictionary<NSString *, id> *anEntry in entries )
+    {
+        [self publishServiceWithName:anEntry[@"name"]
+                                type:anEntry[@"type"]
+                              domain:( anEntry[@"domain"] ?: @"local." )
+                                port:[anEntry[@"port"] unsignedShortValue]
+                       hostAddresses:anEntry[@"hostAddresses"]];
+    }
+    return YES;
+}
+
+#pragma mark -
+
+- (BOOL) isSearchingForService:(F53OSCDiscoveredService *)service
+{
+    return ( self.searching &&
+            [F53OSCDiscoveryTrimmedName( service.type ) isEqualToString:(NSString * _Nonnull)self.searchType] &&
+            [F53OSCDiscoveryTrimmedName( service.domain ) isEqualToString:(NSString * _Nonnull)self.searchDomain] );
+}
+
+// Reported services are unresolved copies, as Bonjour reports them.
+- (void) reportFoundService:(F53OSCDiscoveredService *)publishedService
+{
+    F53OSCDiscoveredService *service = [[F53OSCDiscoveredService alloc] initWithName:publishedService.name type:publishedService.type domain:publishedService.domain];
+    __weak typeof(self) weakSelf = self;
+    dispatch_async( dispatch_get_main_queue(), ^{
+        F53OSCLocalDiscoveryBackend *strongSelf = weakSelf;
+        if ( strongSelf && [strongSelf isSearchingForService:service] )
+            [strongSelf.delegate discoveryBackend:strongSelf didFindService:service];
+    });
+}
+
+- (void) reportRemovedService:(F53OSCDiscoveredService *)publishedService
+{
+    F53OSCDiscoveredService *service = [[F53OSCDiscoveredService alloc] initWithName:publishedService.name type:publishedService.type domain:publishedService.domain];
+    [self.resolvingServices removeObjectForKey:service.key];
+    __weak typeof(self) weakSelf = self;
+    dispatch_async( dispatch_get_main_queue(), ^{
+        F53OSCLocalDiscoveryBackend *strongSelf = weakSelf;
+        if ( strongSelf && [strongSelf isSearchingForService:service] )
+            [strongSelf.delegate discoveryBackend:strongSelf didRemoveService:service];
+    });
+}
+
++ (nullable NSData *) addressDataForHost:(NSString *)host port:(UInt16)port
+{
+    struct sockaddr_in ipv4;
+    memset( &ipv4, 0, sizeof( ipv4 ) );
+    if ( inet_pton( AF_INET, host.UTF8String, &ipv4.sin_addr ) == 1 )
+    {
+        ipv4.sin_len = sizeof( ipv4 );
+        ipv4.sin_family = AF_INET;
+        ipv4.sin_port = htons( port );
+        return [NSData dataWithBytes:&ipv4 length:sizeof( ipv4 )];
+    }
+    
+    struct sockaddr_in6 ipv6;
+    memset( &ipv6, 0, sizeof( ipv6 ) );
+    if ( inet_pton( AF_INET6, host.UTF8String, &ipv6.sin6_addr ) == 1 )
+    {
+        ipv6.sin6_len = sizeof( ipv6 );
+        ipv6.sin6_family = AF_INET6;
+        ipv6.sin6_port = htons( port );
+        return [NSData dataWithBytes:&ipv6 length:sizeof( ipv6 )];
+    }
+    
+    return nil;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -142,6 +142,40 @@ import OSLog
         return nil
     }
 
+    /// Encrypt a datagram with a nonce made of `sender` and `counter` rather than a random one, so that the receiver
+    /// can reject replayed datagrams by their counter. Each sender and counter pair must be used only once per key.
+    /// Note that beginEncrypting() must be called before this.
+    /// @param clearData clear text data to be encrypted
+    /// @param sender identifies the end that sends, so that both ends can count from zero with the same key
+    /// @param counter the datagram's sequence number
+    /// returns encrypted data, starting with the 12 byte nonce: the sender, then the counter, both big-endian
+    @objc public func encryptData(clearData: Data, sender: UInt32, counter: UInt64) -> Data?
+    {
+        if let symkey = self.symmetricKey
+        {
+            do
+            {
+                var nonceData = Data()
+                var bigEndianSender = sender.bigEndian
+                var bigEndianCounter = counter.bigEndian
+                nonceData.append(Data(bytes: &bigEndianSender, count: 4))
+                nonceData.append(Data(bytes: &bigEndianCounter, count: 8))
+                let nonce = try ChaChaPoly.Nonce(data: nonceData)
+                let encryptedData = try ChaChaPoly.seal(clearData, using: symkey, nonce: nonce)
+                return encryptedData.combined
+            }
+            catch
+            {
+                logger.error("Error encrypting data")
+            }
+        }
+        else
+        {
+            logger.error("Error: trying to encrypt data when no key is set")
+        }
+        return nil
+    }
+
     /// Decrypt some data.
     /// Note that beginEncrypting() must be called before this.
     /// @param encryptedData encrypted data to be decrypted
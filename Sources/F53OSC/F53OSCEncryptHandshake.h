@@ -43,6 +43,9 @@ typedef NS_ENUM(NSUInteger, F53OSCEncryptionHandshakeMessage)
     F53OSCEncryptionHandshakeMessageRequest,
     F53OSCEncryptionHandshakeMessageApprove,
     F53OSCEncryptionHandshakeMessageBegin,
+    F53OSCEncryptionHandshakeMessageResume,
+    F53OSCEncryptionHandshakeMessageTicket,
+    F53OSCEncryptionHandshakeMessageRejectResumption,
 };
 
 @interface F53OSCEncryptHandshake : NSObject
@@ -50,12 +53,19 @@ typedef NS_ENUM(NSUInteger, F53OSCEncryptionHandshakeMessage)
 @property (readonly) BOOL handshakeComplete;
 @property (nullable, readonly) NSData *peerKey; // Peer's public key
 @property (readonly) F53OSCEncryptionHandshakeMessage lastProcessedMessage; // Indicated which message was last processed
+@property (nullable, readonly) NSData *ticket; // Session ticket from a resume or ticket message
+@property (nullable, readonly) NSData *ticketProof; // Ticket encrypted with the session key, from a resume message
+@property (readonly) NSTimeInterval ticketLifetime; // Seconds the ticket from a ticket message is valid for
 
 + (instancetype) handshakeWithEncrypter:(F53OSCEncrypt *)encrypter;
 + (BOOL) isEncryptHandshakeMessage:(F53OSCMessage *)message;
++ (nullable NSData *) requestedPeerKeyForMessage:(F53OSCMessage *)message; // the peer key of a request message; nil for any other message
 - (nullable F53OSCMessage *) requestEncryptionMessage;
 - (nullable F53OSCMessage *) approveEncryptionMessage;
 - (F53OSCMessage *) beginEncryptionMessage;
+- (nullable F53OSCMessage *) resumeEncryptionMessageWithTicket:(NSData *)ticket; // the encrypter must hold the ticket's session key
+- (F53OSCMessage *) encryptionTicketMessageWithTicket:(NSData *)ticket lifetime:(NSTimeInterval)lifetime;
+- (F53OSCMessage *) rejectResumptionMessage;
 - (BOOL) processHandshakeMessage:(F53OSCMessage *)message;
 
 + (int)protocolVersion;
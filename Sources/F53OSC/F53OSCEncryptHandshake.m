@@ -43,6 +43,9 @@ NS_ASSUME_NONNULL_BEGIN
 static NSString *const kRequestEncryptionAddress = @"!requestEncryption";
 static NSString *const kApproveEncryptionAddress = @"!approveEncryption";
 static NSString *const kBeginEncryptionAddress = @"!beginEncryption";
+static NSString *const kResumeEncryptionAddress = @"!resumeEncryption";
+static NSString *const kEncryptionTicketAddress = @"!encryptionTicket";
+static NSString *const kRejectResumptionAddress = @"!rejectResumption";
 
 
 @interface F53OSCEncryptHandshake ()
@@ -52,6 +55,9 @@ static NSString *const kBeginEncryptionAddress = @"!beginEncryption";
 @property (assign, readwrite) BOOL handshakeComplete;
 @property (strong, nullable, readwrite) NSData *peerKey; // Peer's public key
 @property (assign, readwrite) F53OSCEncryptionHandshakeMessage lastProcessedMessage; // Indicated which message was last processed
+@property (strong, nullable, readwrite) NSData *ticket;
+@property (strong, nullable, readwrite) NSData *ticketProof;
+@property (assign, readwrite) NSTimeInterval ticketLifetime;
 
 @end
 
@@ -61,11 +67,23 @@ static NSString *const kBeginEncryptionAddress = @"!beginEncryption";
 {
     if ( [message.addressPattern isEqualToString:kRequestEncryptionAddress] ||
          [message.addressPattern isEqualToString:kApproveEncryptionAddress] ||
-         [message.addressPattern isEqualToString:kBeginEncryptionAddress] )
+         [message.addressPattern isEqualToString:kBeginEncryptionAddress] ||
+         [message.addressPattern isEqualToString:kResumeEncryptionAddress] ||
+         [message.addressPattern isEqualToString:kEncryptionTicketAddress] ||
+         [message.addressPattern isEqualToString:kRejectResumptionAddress] )
         return YES;
     return NO;
 }
 
++ (nullable NSData *) requestedPeerKeyForMessage:(F53OSCMessage *)message
+{
+    if ( ![message.addressPattern isEqualToString:kRequestEncryptionAddress] || message.arguments.count < 2 )
+        return nil;
+    if ( ![message.arguments[1] isKindOfClass:[NSData class]] )
+        return nil;
+    return message.arguments[1];
+}
+
 + (instancetype) handshakeWithEncrypter:(F53OSCEncrypt *)encrypter
 {
     F53OSCEncryptHandshake *handshake = [[F53OSCEncryptHandshake alloc] init];
@@ -134,6 +152,60 @@ static NSString *const kBeginEncryptionAddress = @"!beginEncryption";
     return message;
 }
 
+/// Resume arguments:
+/// 1: Handshake protocol version
+/// 2: Key pair data
+/// 3: Ticket data
+/// 4: Ticket data encrypted with the session key, as proof of holding it
+- (nullable F53OSCMessage *) resumeEncryptionMessageWithTicket:(NSData *)ticket
+{
+    NSData *pubKey = self.encrypter.publicKeyData;
+    NSData *proof = [self.encrypter encryptDataWithClearData:ticket];
+    if ( pubKey && proof )
+    {
+        NSArray<id> *args = @[@(F53OSCHandshakeProtocolVersion),
+                              pubKey,
+                              ticket,
+                              proof
+        ];
+        F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:kResumeEncryptionAddress arguments:args];
+        return message;
+    }
+    else
+    {
+        if ( !pubKey )
+            NSLog(@"Error: F53OSC cannot create resume encryption message if public key is missing");
+        else
+            NSLog(@"Error: F53OSC cannot create resume encryption message without a session key");
+        return nil;
+    }
+}
+
+/// Ticket arguments:
+/// 1: Handshake protocol version
+/// 2: Ticket data
+/// 3: Ticket lifetime in seconds
+- (F53OSCMessage *) encryptionTicketMessageWithTicket:(NSData *)ticket lifetime:(NSTimeInterval)lifetime
+{
+    NSArray<id> *args = @[@(F53OSCHandshakeProtocolVersion),
+                          ticket,
+                          @((float)lifetime)
+    ];
+
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:kEncryptionTicketAddress arguments:args];
+    return message;
+}
+
+/// Reject resumption arguments:
+/// 1: Handshake protocol version
+- (F53OSCMessage *) rejectResumptionMessage
+{
+    NSArray<id> *args = @[@(F53OSCHandshakeProtocolVersion)];
+
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:kRejectResumptionAddress arguments:args];
+    return message;
+}
+
 /// Returns NO on failure
 - (BOOL) processHandshakeMessage:(F53OSCMessage *)message
 {
@@ -206,6 +278,56 @@ static NSString *const kBeginEncryptionAddress = @"!beginEncryption";
         self.lastProcessedMessage = F53OSCEncryptionHandshakeMessageBegin;
         return YES;
     }
+    else if ( [message.addressPattern isEqualToString:kResumeEncryptionAddress] )
+    {
+        if ( message.arguments.count < 4 )
+        {
+            NSLog(@"Error: F53OSC resumeEncryption message has too few arguments: %lu", (unsigned long)message.arguments.count);
+            return NO;
+        }
+        if ( ![message.arguments[1] isKindOfClass:[NSData class]] ||
+             ![message.arguments[2] isKindOfClass:[NSData class]] ||
+             ![message.arguments[3] isKindOfClass:[NSData class]] )
+        {
+            NSLog(@"Error: F53OSC resumeEncryption peer key, ticket, or proof argument is not data");
+            return NO;
+        }
+
+        // The session itself is looked up by the receiver, in its F53OSCEncryptSessionCache.
+        self.peerKey = message.arguments[1];
+        self.ticket = message.arguments[2];
+        self.ticketProof = message.arguments[3];
+        self.lastProcessedMessage = F53OSCEncryptionHandshakeMessageResume;
+        return YES;
+    }
+    else if ( [message.addressPattern isEqualToString:kEncryptionTicketAddress] )
+    {
+        if ( message.arguments.count < 3 )
+        {
+            NSLog(@"Error: F53OSC encryptionTicket message has too few arguments: %lu", (unsigned long)message.arguments.count);
+            return NO;
+        }
+        if ( ![message.arguments[1] isKindOfClass:[NSData class]] )
+        {
+            NSLog(@"Error: F53OSC encryptionTicket ticket argument is not data");
+            return NO;
+        }
+        if ( ![message.arguments[2] isKindOfClass:[NSNumber class]] )
+        {
+            NSLog(@"Error: F53OSC encryptionTicket lifetime argument is not a number");
+            return NO;
+        }
+
+        self.ticket = message.arguments[1];
+        self.ticketLifetime = [message.arguments[2] doubleValue];
+        self.lastProcessedMessage = F53OSCEncryptionHandshakeMessageTicket;
+        return YES;
+    }
+    else if ( [message.addressPattern isEqualToString:kRejectResumptionAddress] )
+    {
+        self.lastProcessedMessage = F53OSCEncryptionHandshakeMessageRejectResumption;
+        return YES;
+    }
     NSLog(@"F53OSC received unknown encryption handshake message: %@", message.addressPattern);
     return NO;
 }
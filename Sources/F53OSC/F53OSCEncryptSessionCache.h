@@ -0,0 +1,101 @@
+//
+//  F53OSCEncryptSessionCache.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+@class F53OSCEncrypt;
+
+//
+//  F53OSCEncryptSessionCache keeps the encryption sessions agreed by earlier handshakes, indexed by the peer's public
+//  key, so that a reconnecting peer can resume one instead of repeating the key agreement.
+//
+//  A server issues a random ticket for each session when its handshake completes and sends it to the client,
+//  encrypted. A reconnecting client presents the ticket in `!resumeEncryption`, along with the ticket encrypted with
+//  the session's key as proof that it holds the key, and sends encrypted packets right away, without waiting for a
+//  reply. The server approves by sending a new ticket, or rejects the resumption, in which case the client runs a full
+//  handshake and sends its packets again.
+//
+//  Sessions are single use: taking one removes it from the cache, so a recorded resumption can not be replayed.
+//  Sessions expire after `lifetime` seconds, measured on a monotonic clock. A ticket or proof that does not match
+//  leaves the session in place, so that a forged resumption can not revoke it.
+//
+//  A server keeps the sessions it issues in its `encryptionSessionCache`, and a client keeps the tickets it is issued
+//  in its own. One cache may be shared by many clients, or by many servers.
+//
+//  Example usage:
+//  server.encryptionSessionCache = [[F53OSCEncryptSessionCache alloc] init];
+//  client.encryptionSessionCache = [[F53OSCEncryptSessionCache alloc] init];
+//  [client connectEncryptedWithKeyPair:keyPair]; // resumes the last session after the first handshake
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53OSCEncryptSessionTicketLength    16
+
+@interface F53OSCEncryptSession : NSObject
+
+@property (readonly, copy) NSData *peerKey;
+@property (readonly, copy) NSData *ticket;
+@property (readonly, strong) F53OSCEncrypt *encrypter;     // holds the key agreed for the session
+@property (readonly) NSTimeInterval expirationTime;         // seconds on a monotonic clock
+
+- (instancetype) init NS_UNAVAILABLE;
+- (instancetype) initWithPeerKey:(NSData *)peerKey ticket:(NSData *)ticket encrypter:(F53OSCEncrypt *)encrypter expirationTime:(NSTimeInterval)expirationTime NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+@interface F53OSCEncryptSessionCache : NSObject
+
+@property (assign) NSTimeInterval lifetime;         // default 3600 seconds
+@property (assign) NSUInteger maxSessionCount;      // default 256; the session closest to expiring makes room for a new one
+
+@property (readonly) NSUInteger count;
+@property (readonly) NSUInteger resumedCount;       // sessions taken for resumption
+@property (readonly) NSUInteger rejectedCount;      // resumptions refused for an unknown, expired, or already used ticket, or a bad proof
+
+// Servers: stores a new session with a random ticket, replacing any earlier session for `peerKey`.
+- (F53OSCEncryptSession *) issueSessionForPeerKey:(NSData *)peerKey encrypter:(F53OSCEncrypt *)encrypter;
+
+// Clients: stores a ticket issued by the server whose public key is `peerKey`. `lifetime` is limited to the cache's own.
+- (void) storeSessionForPeerKey:(NSData *)peerKey ticket:(NSData *)ticket lifetime:(NSTimeInterval)lifetime encrypter:(F53OSCEncrypt *)encrypter;
+
+// Clients: returns the unexpired session for `peerKey`, if any, leaving it in the cache.
+- (nullable F53OSCEncryptSession *) sessionForPeerKey:(NSData *)peerKey;
+
+// Clients: removes and returns the unexpired session for `peerKey`, if any.
+- (nullable F53OSCEncryptSession *) takeSessionForPeerKey:(NSData *)peerKey;
+
+// Servers: removes and returns the unexpired session for `peerKey` if `ticket` matches it and `proof` is `ticket`
+// encrypted with the session's key.
+- (nullable F53OSCEncryptSession *) takeSessionForPeerKey:(NSData *)peerKey ticket:(NSData *)ticket proof:(NSData *)proof;
+
+- (void) removeSessionForPeerKey:(NSData *)peerKey;
+- (void) removeAllSessions;
+
+@end
+
+NS_ASSUME_NONNULL_END
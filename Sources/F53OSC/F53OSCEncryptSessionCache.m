@@ -0,0 +1,268 @@
+//
+//  F53OSCEncryptSessionCache.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCEncryptSessionCache.h"
+
+#if __has_include(<F53OSC/F53OSC-Swift.h>) // F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSC-Swift.h>
+#elif SWIFT_PACKAGE // Swift Package Manager
+@import F53OSCEncrypt;
+#endif
+
+#import <stdlib.h>
+#import <string.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - F53OSCEncryptSession
+
+@implementation F53OSCEncryptSession
+
+- (instancetype) initWithPeerKey:(NSData *)peerKey ticket:(NSData *)ticket encrypter:(F53OSCEncrypt *)encrypter expirationTime:(NSTimeInterval)expirationTime
+{
+    self = [super init];
+    if ( self )
+    {
+        _peerKey = [peerKey copy];
+        _ticket = [ticket copy];
+        _encrypter = encrypter;
+        _expirationTime = expirationTime;
+    }
+    return self;
+}
+
+- (NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ %p expires in %.0f s>", NSStringFromClass( [self class] ), self, self.expirationTime - [NSProcessInfo processInfo].systemUptime];
+}
+
+@end
+
+
+#pragma mark - F53OSCEncryptSessionCache
+
+@interface F53OSCEncryptSessionCache ()
+
+@property (strong) NSMutableDictionary<NSData *, F53OSCEncryptSession *> *sessions;
+@property (assign) NSUInteger totalResumedCount;
+@property (assign) NSUInteger totalRejectedCount;
+
+- (void) addSession:(F53OSCEncryptSession *)session;
+- (void) removeExpiredSessionsAtTime:(NSTimeInterval)now;
+
+@end
+
+@implementation F53OSCEncryptSessionCache
+
+- (instancetype) init
+{
+    self = [super init];
+    if ( self )
+    {
+        self.lifetime = 3600.0;
+        self.maxSessionCount = 256;
+        self.sessions = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSUInteger) count
+{
+    @synchronized( self )
+    {
+        return self.sessions.count;
+    }
+}
+
+- (NSUInteger) resumedCount
+{
+    @synchronized( self )
+    {
+        return self.totalResumedCount;
+    }
+}
+
+- (NSUInteger) rejectedCount
+{
+    @synchronized( self )
+    {
+        return self.totalRejectedCount;
+    }
+}
+
+#pragma mark -
+
+- (F53OSCEncryptSession *) issueSessionForPeerKey:(NSData *)peerKey encrypter:(F53OSCEncrypt *)encrypter
+{
+    uint8_t ticketBytes[F53OSCEncryptSessionTicketLength];
+    arc4random_buf( ticketBytes, sizeof( ticketBytes ) );
+    NSData *ticket = [NSData dataWithBytes:ticketBytes length:sizeof( ticketBytes )];
+    
+    NSTimeInterval expirationTime = [NSProcessInfo processInfo].systemUptime + self.lifetime;
+    F53OSCEncryptSession *session = [[F53OSCEncryptSession alloc] initWithPeerKey:peerKey ticket:ticket encrypter:encrypter expirationTime:expirationTime];
+    [self addSession:session];
+    return session;
+}
+
+- (void) storeSessionForPeerKey:(NSData *)peerKey ticket:(NSData *)ticket lifetime:(NSTimeInterval)lifetime encrypter:(F53OSCEncrypt *)encrypter
+{
+    if ( ticket.length == 0 || lifetime <= 0 )
+        return;
+    
+    NSTimeInterval expirationTime = [NSProcessInfo processInfo].systemUptime + MIN( lifetime, self.lifetime );
+    [self addSession:[[F53OSCEncryptSession alloc] initWithPeerKey:peerKey ticket:ticket encrypter:encrypter expirationTime:expirationTime]];
+}
+
+- (nullable F53OSCEncryptSession *) sessionForPeerKey:(NSData *)peerKey
+{
+    @synchronized( self )
+    {
+        F53OSCEncryptSession *session = self.sessions[peerKey];
+        if ( session == nil || session.expirationTime <= [NSProcessInfo processInfo].systemUptime )
+            return nil;
+        
+        return session;
+    }
+}
+
+- (nullable F53OSCEncryptSession *) takeSessionForPeerKey:(NSData *)peerKey
+{
+    @synchronized( self )
+    {
+        F53OSCEncryptSession *session = self.sessions[peerKey];
+        if ( session == nil )
+            return nil;
+        
+        [self.sessions removeObjectForKey:peerKey];
+        if ( session.expirationTime <= [NSProcessInfo processInfo].systemUptime )
+            return nil;
+        
+        self.totalResumedCount++;
+        return session;
+    }
+}
+
+- (nullable F53OSCEncryptSession *) takeSessionForPeerKey:(NSData *)peerKey ticket:(NSData *)ticket proof:(NSData *)proof
+{
+    F53OSCEncryptSession *session = nil;
+    @synchronized( self )
+    {
+        session = self.sessions[peerKey];
+        if ( session && session.expirationTime <= [NSProcessInfo processInfo].systemUptime )
+        {
+            [self.sessions removeObjectForKey:peerKey];
+            session = nil;
+        }
+        
+        // Tickets are compared in constant time.
+        if ( session == nil || ticket.length != session.ticket.length || timingsafe_bcmp( ticket.bytes, session.ticket.bytes, ticket.length ) != 0 )
+        {
+            self.totalRejectedCount++;
+            return nil;
+        }
+    }
+    
+    // The proof is checked outside the lock; decrypting it is the only costly step of a resumption.
+    NSData *decryptedProof = ( proof.length ? [session.encrypter decryptDataWithEncryptedData:proof] : nil );
+    BOOL proven = ( decryptedProof.length == ticket.length && timingsafe_bcmp( decryptedProof.bytes, ticket.bytes, ticket.length ) == 0 );
+    
+    @synchronized( self )
+    {
+        // Only the first of several concurrent resumptions with the same ticket gets the session.
+        if ( !proven || self.sessions[peerKey] != session )
+        {
+            self.totalRejectedCount++;
+            return nil;
+        }
+        
+        [self.sessions removeObjectForKey:peerKey];
+        self.totalResumedCount++;
+        return session;
+    }
+}
+
+- (void) removeSessionForPeerKey:(NSData *)peerKey
+{
+    @synchronized( self )
+    {
+        [self.sessions removeObjectForKey:peerKey];
+    }
+}
+
+- (void) removeAllSessions
+{
+    @synchronized( self )
+    {
+        [self.sessions removeAllObjects];
+    }
+}
+
+#pragma mark -
+
+- (void) addSession:(F53OSCEncryptSession *)session
+{
+    @synchronized( self )
+    {
+        [self.sessions removeObjectForKey:session.peerKey];
+        
+        NSUInteger maxSessionCount = self.maxSessionCount;
+        if ( maxSessionCount && self.sessions.count >= maxSessionCount )
+            [self removeExpiredSessionsAtTime:[NSProcessInfo processInfo].systemUptime];
+        
+        while ( maxSessionCount && self.sessions.count >= maxSessionCount )
+        {
+            F53OSCEncryptSession *soonest = nil;
+            for ( F53OSCEncryptSession *candidate in self.sessions.objectEnumerator )
+            {
+                if ( soonest == nil || candidate.expirationTime < soonest.expirationTime )
+                    soonest = candidate;
+            }
+            [self.sessions removeObjectForKey:soonest.peerKey];
+        }
+        
+        self.sessions[session.peerKey] = session;
+    }
+}
+
+// Call only while synchronized on self.
+- (void) removeExpiredSessionsAtTime:(NSTimeInterval)now
+{
+    NSMutableArray<NSData *> *expiredKeys = [NSMutableArray array];
+    [self.sessions enumerateKeysAndObjectsUsingBlock:^( NSData *peerKey, F53OSCEncryptSession *session, BOOL *stop ) {
+        if ( session.expirationTime <= now )
+            [expiredKeys addObject:peerKey];
+    }];
+    [self.sessions removeObjectsForKeys:expiredKeys];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
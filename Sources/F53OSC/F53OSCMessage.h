@@ -34,6 +34,8 @@
 #import "F53OSCFoundationAdditions.h"
 #endif
 
+@class F53OSCTimeTag;
+
 //
 //  Example usage:
 //  F53OSCMessage *msg = [F53OSCMessage messageWithAddressPattern:@"/address/of/thing"
@@ -84,6 +86,22 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)takeMessage:(nullable F53OSCMessage *)message;
 
+@optional
+
+// If implemented, each received OSC bundle is delivered in a single call with its time tag and all of its messages,
+// including those of nested bundles, in the order they appear. `takeMessage:` is not called for those messages.
+// A bundle that fails to parse is dropped as a whole so the destination never sees part of one.
+- (void)takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag;
+
+// If implemented, F53OSCServer and F53OSCClient deliver received messages in batches rather than with one `takeMessage:`
+// call each. A batch holds everything parsed from one read, or from several reads when a batch latency is configured,
+// in the order received. Bundles still go to `takeBundleMessages:timeTag:` if that is implemented too.
+- (void)takeMessages:(NSArray<F53OSCMessage *> *)messages;
+
+// If implemented, destinations that hold messages before passing them on, such as F53OSCConflationBuffer and
+// F53OSCPriorityScheduler, report here the messages they discard without delivering.
+- (void)didDropMessages:(NSArray<F53OSCMessage *> *)messages;
+
 @end
 
 @protocol F53OSCControlHandler <NSObject>
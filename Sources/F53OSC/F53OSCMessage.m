@@ -33,6 +33,7 @@
 #import "F53OSCMessage.h"
 
 #import "F53OSCServer.h"
+#import "F53OSCWire.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -82,6 +83,14 @@ NSString * const QUOTE_CHAR_TOKEN_RIGHT_DOUBLE = @"⍄"; // RIGHT DOUBLE QUOTATI
 
 @end
 
+
+static void F53OSCMessageWriteString( F53OSCWireWriter *writer, NSString *string )
+{
+    const char *bytes = [string UTF8String];
+    F53OSCWireWriteString( writer, bytes, ( bytes ? [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding] : 0 ) );
+}
+
+
 @implementation F53OSCMessage
 
 static NSCharacterSet *LEGAL_ADDRESS_CHARACTERS = nil;
@@ -514,19 +523,49 @@ static NSNumberFormatter *NUMBER_FORMATTER = nil;
 
 - (NSData *) packetData
 {
-    NSMutableData *result = [[self.addressPattern oscStringData] mutableCopy];
+    NSMutableData *result = [NSMutableData data];
+    [self appendPacketDataToData:result];
+    return result;
+}
+
+- (void) appendPacketDataToData:(NSMutableData *)result
+{
+    // Size everything first so that `result` grows once, then encode in place.
+    NSString *addressPattern = self.addressPattern;
+    NSString *typeTagString = self.typeTagString;
+    NSArray<id> *arguments = self.arguments;
     
-    [result appendData:[self.typeTagString oscStringData]];
+    NSUInteger size = F53OSCWireStringSize( [addressPattern lengthOfBytesUsingEncoding:NSUTF8StringEncoding] );
+    size += F53OSCWireStringSize( [typeTagString lengthOfBytesUsingEncoding:NSUTF8StringEncoding] );
+    for ( id obj in arguments )
+    {
+        if ( [obj isKindOfClass:[NSString class]] )
+            size += F53OSCWireStringSize( [(NSString *)obj lengthOfBytesUsingEncoding:NSUTF8StringEncoding] );
+        else if ( [obj isKindOfClass:[NSData class]] )
+            size += F53OSCWireBlobSize( [(NSData *)obj length] );
+        else if ( [obj isKindOfClass:[NSNumber class]] )
+            size += sizeof( SInt32 );
+    }
+    
+    NSUInteger offset = result.length;
+    [result increaseLengthBy:size];
+    
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit( &writer, (uint8_t *)result.mutableBytes + offset, size );
+    
+    F53OSCMessageWriteString( &writer, addressPattern );
+    
+    F53OSCMessageWriteString( &writer, typeTagString );
     
-    for ( id obj in self.arguments )
+    for ( id obj in arguments )
     {
         if ( [obj isKindOfClass:[NSString class]] )
         {
-            [result appendData:[(NSString *)obj oscStringData]]; // 's'
+            F53OSCMessageWriteString( &writer, (NSString *)obj ); // 's'
         }
         else if ( [obj isKindOfClass:[NSData class]] )
         {
-            [result appendData:[(NSData *)obj oscBlobData]]; // 'b'
+            F53OSCWireWriteBlob( &writer, [(NSData *)obj bytes], [(NSData *)obj length] ); // 'b'
         }
         else if ( [obj isKindOfClass:[NSNumber class]] )
         {
@@ -543,19 +582,17 @@ static NSNumberFormatter *NUMBER_FORMATTER = nil;
                 case kCFNumberLongType:
                 case kCFNumberLongLongType:
                 case kCFNumberCFIndexType: // aka signed long
-                case kCFNumberNSIntegerType: {
-                    SInt32 intValue = [(NSNumber *)obj oscIntValue]; // 'i'
-                    [result appendBytes:&intValue length:sizeof( SInt32 )];
-                } break;
+                case kCFNumberNSIntegerType:
+                    F53OSCWireWriteInt32( &writer, (SInt32)[(NSNumber *)obj integerValue] ); // 'i'
+                    break;
 
                 case kCFNumberFloat32Type:
                 case kCFNumberFloat64Type:
                 case kCFNumberFloatType:
                 case kCFNumberDoubleType:
-                case kCFNumberCGFloatType: {
-                    SInt32 intValue = [(NSNumber *)obj oscFloatValue]; // 'f'
-                    [result appendBytes:&intValue length:sizeof( SInt32 )];
-                } break;
+                case kCFNumberCGFloatType:
+                    F53OSCWireWriteFloat32( &writer, [(NSNumber *)obj floatValue] ); // 'f'
+                    break;
 
 #if !F53OSC_EXHAUSTIVE_SWITCH_ENABLED // see F53OSC.h
                 default:
@@ -570,7 +607,8 @@ static NSNumberFormatter *NUMBER_FORMATTER = nil;
         }
     }
     
-    return result;
+    // Drop anything sized but not written, e.g. a number of an unrecognized type.
+    [result setLength:offset + writer.length];
 }
 
 - (NSString *) asQSC
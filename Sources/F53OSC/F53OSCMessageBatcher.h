@@ -0,0 +1,61 @@
+//
+//  F53OSCMessageBatcher.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCMessage.h>
+#else
+#import "F53OSCMessage.h"
+#endif
+
+//
+//  F53OSCMessageBatcher sits between F53OSCParser and a destination that implements `takeMessages:`.
+//  It gathers the messages parsed from each read and hands them on in a single call, so a destination
+//  that hops to another queue pays for one hop per batch rather than one per message.
+//
+//  All methods are expected to be called on `queue`, which is also where batches are delivered.
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCMessageBatcher : NSObject <F53OSCPacketDestination>
+
+- (instancetype) initWithQueue:(dispatch_queue_t)queue;
+
+@property (nonatomic, weak, nullable)   id<F53OSCPacketDestination> destination;
+@property (nonatomic, strong)           dispatch_queue_t queue;
+@property (nonatomic, assign)           NSUInteger maxBatchSize;    // default 0 (no limit)
+@property (nonatomic, assign)           NSTimeInterval maxLatency;  // default 0 (deliver at the end of each read)
+@property (nonatomic, readonly)         NSUInteger pendingCount;
+
+// Call once everything from a read has been parsed. Delivers now, or within `maxLatency` if that is set.
+- (void) endRead;
+- (void) flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,155 @@
+//
+//  F53OSCMessageBatcher.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCMessageBatcher.h"
+
+#import "F53OSCTimeTag.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCMessageBatcher ()
+
+@property (strong) NSMutableArray<F53OSCMessage *> *pendingMessages;
+@property (assign) BOOL flushScheduled;
+
+- (void) deliverPendingMessages;
+
+@end
+
+
+@implementation F53OSCMessageBatcher
+
+- (instancetype) init
+{
+    return [self initWithQueue:dispatch_get_main_queue()];
+}
+
+- (instancetype) initWithQueue:(dispatch_queue_t)queue
+{
+    self = [super init];
+    if ( self )
+    {
+        self.destination = nil;
+        self.queue = queue;
+        self.maxBatchSize = 0;  // no limit
+        self.maxLatency = 0;    // deliver at the end of each read
+        self.pendingMessages = [NSMutableArray array];
+        self.flushScheduled = NO;
+    }
+    return self;
+}
+
+- (NSUInteger) pendingCount
+{
+    return self.pendingMessages.count;
+}
+
+- (BOOL) respondsToSelector:(SEL)aSelector
+{
+    // Bundles only take the whole-bundle path when the real destination asked for it.
+    if ( aSelector == @selector(takeBundleMessages:timeTag:) )
+        return [self.destination respondsToSelector:aSelector];
+    
+    return [super respondsToSelector:aSelector];
+}
+
+- (void) endRead
+{
+    if ( self.pendingMessages.count == 0 )
+        return;
+    
+    if ( self.maxLatency <= 0.0 )
+    {
+        [self deliverPendingMessages];
+        return;
+    }
+    
+    if ( self.flushScheduled )
+        return;
+    
+    self.flushScheduled = YES;
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_time_t when = dispatch_time( DISPATCH_TIME_NOW, (int64_t)( self.maxLatency * NSEC_PER_SEC ) );
+    dispatch_after( when, self.queue, ^{
+        [weakSelf flush];
+    });
+}
+
+- (void) flush
+{
+    self.flushScheduled = NO;
+    [self deliverPendingMessages];
+}
+
+- (void) deliverPendingMessages
+{
+    if ( self.pendingMessages.count == 0 )
+        return;
+    
+    NSArray<F53OSCMessage *> *messages = self.pendingMessages;
+    self.pendingMessages = [NSMutableArray arrayWithCapacity:messages.count];
+    
+    id<F53OSCPacketDestination> destination = self.destination;
+    if ( [destination respondsToSelector:@selector(takeMessages:)] )
+    {
+        [destination takeMessages:messages];
+    }
+    else
+    {
+        for ( F53OSCMessage *message in messages )
+            [destination takeMessage:message];
+    }
+}
+
+#pragma mark - F53OSCPacketDestination
+
+- (void) takeMessage:(nullable F53OSCMessage *)message
+{
+    if ( message == nil )
+        return;
+    
+    [self.pendingMessages addObject:(F53OSCMessage * _Nonnull)message];
+    
+    if ( self.maxBatchSize && self.pendingMessages.count >= self.maxBatchSize )
+        [self deliverPendingMessages];
+}
+
+- (void) takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    // Anything received before this bundle goes first so delivery order is kept.
+    [self deliverPendingMessages];
+    [self.destination takeBundleMessages:messages timeTag:timeTag];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
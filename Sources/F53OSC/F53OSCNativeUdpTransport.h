@@ -0,0 +1,107 @@
+//
+//  F53OSCNativeUdpTransport.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import <netinet/in.h>
+#import <sys/socket.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCReceiveBufferPool.h>
+#import <F53OSC/F53OSCSocket.h>
+#else
+#import "F53OSCReceiveBufferPool.h"
+#import "F53OSCSocket.h"
+#endif
+
+//
+//  F53OSCNativeUdpTransport receives UDP datagrams on a plain BSD socket watched by a dispatch read source,
+//  which Darwin implements with kqueue. When the socket becomes readable, the source handler drains it on
+//  the target queue and hands each datagram straight to the receive handler. There is no intermediate socket
+//  queue, so a datagram costs no dispatch hop or block copy on its way to the parser, and a burst of datagrams
+//  is read in one wakeup.
+//
+//  Datagrams land in buffers from a F53OSCReceiveBufferPool of up to `receiveBufferCount` buffers, and are parsed
+//  in place: the NSData passed to the handler wraps its pool buffer, which goes back to the pool once that data is
+//  deallocated. The sender's address is passed inline on the stack. In steady state a datagram therefore costs no
+//  buffer allocation at all; if every buffer is still in use, datagrams are copied instead.
+//
+//  F53OSCServer uses it when `udpTransport` is F53OSCServerUdpTransportNative.
+//
+//  Example usage:
+//  F53OSCNativeUdpTransport *transport = [[F53OSCNativeUdpTransport alloc] initWithQueue:queue receiveHandler:^( NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp ) {
+//      [F53OSCParser processOscData:data forDestination:destination replyToSocket:replySocket controlHandler:nil wasEncrypted:NO receivedTimestamp:timestamp];
+//  }];
+//  [transport listenOnPort:9000 IPv6Enabled:NO error:&error];
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+// A sender's sockaddr, held inline so that it can be passed without allocating.
+typedef struct
+{
+    union
+    {
+        struct sockaddr     sa;
+        struct sockaddr_in  in4;
+        struct sockaddr_in6 in6;
+    } addr;
+    socklen_t length;
+} F53OSCSocketAddress;
+
+FOUNDATION_EXPORT NSString * _Nullable F53OSCSocketAddressHost( const F53OSCSocketAddress *address );
+FOUNDATION_EXPORT UInt16 F53OSCSocketAddressPort( const F53OSCSocketAddress *address );
+
+// `data` holds the datagram, possibly in a pool buffer that is reused after the data is deallocated.
+// `address` is only valid for the duration of the call. `timestamp` is the kernel's receive time in seconds since 1970,
+// or 0 unless `socketOptions` enables `receiveTimestamps`.
+typedef void (^F53OSCNativeUdpReceiveHandler)( NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp );
+
+@interface F53OSCNativeUdpTransport : NSObject
+
+- (instancetype) init NS_UNAVAILABLE;
+- (instancetype) initWithQueue:(dispatch_queue_t)queue receiveHandler:(F53OSCNativeUdpReceiveHandler)receiveHandler NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) dispatch_queue_t queue;
+@property (assign) NSUInteger maxDatagramsPerWakeup;    // default 64; bounds how long one wakeup can hold the queue
+@property (assign) NSUInteger receiveBufferCount;       // default 16; takes effect on the next listen; 0 copies every datagram
+@property (copy, nullable) F53OSCSocketOptions *socketOptions; // default nil; takes effect on the next listen
+@property (readonly) BOOL isListening;
+@property (readonly) UInt16 localPort;
+
+@property (readonly) NSUInteger receivedDatagramCount;
+@property (readonly) NSUInteger wakeupCount;            // read source events; datagrams per wakeup shows how well bursts are batched
+@property (readonly) NSUInteger pooledReceiveCount;     // datagrams parsed in place from a pool buffer
+@property (readonly) NSUInteger copiedReceiveCount;     // datagrams copied because no pool buffer was free
+@property (strong, readonly, nullable) F53OSCReceiveBufferPool *receiveBufferPool; // while listening; its `slabCount` is the number of buffer allocations so far
+
+// With IPv6 enabled, one dual-stack socket receives both IPv4 and IPv6 datagrams.
+- (BOOL) listenOnPort:(UInt16)port IPv6Enabled:(BOOL)IPv6Enabled error:(out NSError **)outError;
+- (void) stopListening;
+
+@end
+
+NS_ASSUME_NONNULL_END
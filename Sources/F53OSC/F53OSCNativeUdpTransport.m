@@ -0,0 +1,390 @@
+//
+//  F53OSCNativeUdpTransport.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCNativeUdpTransport.h"
+
+#import <arpa/inet.h>
+#import <errno.h>
+#import <fcntl.h>
+#import <netinet/in.h>
+#import <unistd.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53OSC_NATIVE_UDP_BUFFER_SIZE       65535   // largest UDP payload
+#define F53OSC_NATIVE_UDP_BUFFERS_PER_SLAB  8
+
+NSString * _Nullable F53OSCSocketAddressHost( const F53OSCSocketAddress *address )
+{
+    char host[INET6_ADDRSTRLEN];
+    const char *result = NULL;
+    if ( address->addr.sa.sa_family == AF_INET && address->length >= sizeof( struct sockaddr_in ) )
+        result = inet_ntop( AF_INET, &address->addr.in4.sin_addr, host, sizeof( host ) );
+    else if ( address->addr.sa.sa_family == AF_INET6 && address->length >= sizeof( struct sockaddr_in6 ) )
+        result = inet_ntop( AF_INET6, &address->addr.in6.sin6_addr, host, sizeof( host ) );
+    
+    return ( result ? [NSString stringWithUTF8String:result] : nil );
+}
+
+UInt16 F53OSCSocketAddressPort( const F53OSCSocketAddress *address )
+{
+    if ( address->addr.sa.sa_family == AF_INET && address->length >= sizeof( struct sockaddr_in ) )
+        return ntohs( address->addr.in4.sin_port );
+    else if ( address->addr.sa.sa_family == AF_INET6 && address->length >= sizeof( struct sockaddr_in6 ) )
+        return ntohs( address->addr.in6.sin6_port );
+    return 0;
+}
+
+
+#pragma mark - F53OSCNativeUdpTransport
+
+@interface F53OSCNativeUdpTransport ()
+
+@property (nonatomic, strong, readwrite) dispatch_queue_t queue;
+@property (strong) F53OSCNativeUdpReceiveHandler receiveHandler;
+@property (strong, nullable) dispatch_source_t readSource;
+@property (strong, readwrite, nullable) F53OSCReceiveBufferPool *receiveBufferPool;
+@property (assign) UInt16 boundPort;
+@property (assign) NSUInteger totalReceivedDatagramCount;
+@property (assign) NSUInteger totalWakeupCount;
+@property (assign) NSUInteger totalPooledReceiveCount;
+@property (assign) NSUInteger totalCopiedReceiveCount;
+
+- (void) readAvailableDatagramsFromSocket:(int)fd
+                                  buffer:(void *)buffer
+                                    pool:(nullable F53OSCReceiveBufferPool *)pool
+                         readsTimestamps:(BOOL)readsTimestamps;
+- (NSError *) errorWithCode:(int)code description:(NSString *)description;
+
+@end
+
+
+@implementation F53OSCNativeUdpTransport
+
+- (instancetype) initWithQueue:(dispatch_queue_t)queue receiveHandler:(F53OSCNativeUdpReceiveHandler)receiveHandler
+{
+    self = [super init];
+    if ( self )
+    {
+        self.queue = queue;
+        self.receiveHandler = receiveHandler;
+        self.maxDatagramsPerWakeup = 64;
+        self.receiveBufferCount = 16;
+        self.socketOptions = nil;
+        self.readSource = nil;
+        self.receiveBufferPool = nil;
+        self.boundPort = 0;
+        self.totalReceivedDatagramCount = 0;
+        self.totalWakeupCount = 0;
+        self.totalPooledReceiveCount = 0;
+        self.totalCopiedReceiveCount = 0;
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    [self stopListening];
+}
+
+- (BOOL) isListening
+{
+    @synchronized( self )
+    {
+        return ( self.readSource != nil );
+    }
+}
+
+- (UInt16) localPort
+{
+    @synchronized( self )
+    {
+        return self.boundPort;
+    }
+}
+
+- (NSUInteger) receivedDatagramCount
+{
+    @synchronized( self )
+    {
+        return self.totalReceivedDatagramCount;
+    }
+}
+
+- (NSUInteger) wakeupCount
+{
+    @synchronized( self )
+    {
+        return self.totalWakeupCount;
+    }
+}
+
+- (NSUInteger) pooledReceiveCount
+{
+    @synchronized( self )
+    {
+        return self.totalPooledReceiveCount;
+    }
+}
+
+- (NSUInteger) copiedReceiveCount
+{
+    @synchronized( self )
+    {
+        return self.totalCopiedReceiveCount;
+    }
+}
+
+#pragma mark -
+
+- (BOOL) listenOnPort:(UInt16)port IPv6Enabled:(BOOL)IPv6Enabled error:(out NSError **)outError
+{
+    if ( self.isListening )
+    {
+        if ( outError != NULL )
+            *outError = [self errorWithCode:EALREADY description:@"Already listening."];
+        return NO;
+    }
+    
+    int family = ( IPv6Enabled ? AF_INET6 : AF_INET );
+    int fd = socket( family, SOCK_DGRAM, IPPROTO_UDP );
+    if ( fd == -1 )
+    {
+        if ( outError != NULL )
+            *outError = [self errorWithCode:errno description:@"Unable to create socket."];
+        return NO;
+    }
+    
+    int on = 1;
+    int off = 0;
+    setsockopt( fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof( on ) );
+    setsockopt( fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof( on ) );
+    if ( IPv6Enabled )
+        setsockopt( fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof( off ) );
+    
+    int status;
+    if ( IPv6Enabled )
+    {
+        struct sockaddr_in6 address6 = { 0 };
+        address6.sin6_len = sizeof( address6 );
+        address6.sin6_family = AF_INET6;
+        address6.sin6_port = htons( port );
+        address6.sin6_addr = in6addr_any;
+        status = bind( fd, (const struct sockaddr *)&address6, sizeof( address6 ) );
+    }
+    else
+    {
+        struct sockaddr_in address4 = { 0 };
+        address4.sin_len = sizeof( address4 );
+        address4.sin_family = AF_INET;
+        address4.sin_port = htons( port );
+        address4.sin_addr.s_addr = htonl( INADDR_ANY );
+        status = bind( fd, (const struct sockaddr *)&address4, sizeof( address4 ) );
+    }
+    
+    if ( status == -1 || fcntl( fd, F_SETFL, O_NONBLOCK ) == -1 )
+    {
+        int code = errno;
+        close( fd );
+        if ( outError != NULL )
+            *outError = [self errorWithCode:code description:[NSString stringWithFormat:@"Unable to bind UDP port %hu.", port]];
+        return NO;
+    }
+    
+    struct sockaddr_storage bound = { 0 };
+    socklen_t boundLength = sizeof( bound );
+    UInt16 localPort = port;
+    if ( getsockname( fd, (struct sockaddr *)&bound, &boundLength ) == 0 )
+        localPort = ntohs( bound.ss_family == AF_INET6 ? ((struct sockaddr_in6 *)&bound)->sin6_port : ((struct sockaddr_in *)&bound)->sin_port );
+    
+    F53OSCSocketOptions *socketOptions = self.socketOptions;
+    NSError *optionsError = nil;
+    if ( socketOptions && ![socketOptions applyToSocket:fd error:&optionsError] )
+        NSLog( @"Warning: %@ unable to apply socket options %@ - %@", self, socketOptions, [optionsError localizedDescription] );
+    BOOL readsTimestamps = socketOptions.receiveTimestamps;
+    
+    // Without a pool, or once all of its buffers are in use, datagrams are read into this buffer and copied.
+    void *buffer = malloc( F53OSC_NATIVE_UDP_BUFFER_SIZE );
+    if ( buffer == NULL )
+    {
+        close( fd );
+        if ( outError != NULL )
+            *outError = [self errorWithCode:ENOMEM description:@"Unable to allocate receive buffer."];
+        return NO;
+    }
+    
+    // Slabs are allocated as the first datagrams arrive, and outlive the pool while any of their buffers are still wrapped.
+    F53OSCReceiveBufferPool *pool = nil;
+    NSUInteger receiveBufferCount = self.receiveBufferCount;
+    if ( receiveBufferCount )
+        pool = [[F53OSCReceiveBufferPool alloc] initWithBufferSize:F53OSC_NATIVE_UDP_BUFFER_SIZE
+                                                    buffersPerSlab:MIN( receiveBufferCount, (NSUInteger)F53OSC_NATIVE_UDP_BUFFERS_PER_SLAB )
+                                                    maxBufferCount:receiveBufferCount];
+    
+    dispatch_source_t readSource = dispatch_source_create( DISPATCH_SOURCE_TYPE_READ, (uintptr_t)fd, 0, self.queue );
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler( readSource, ^{
+        [weakSelf readAvailableDatagramsFromSocket:fd buffer:buffer pool:pool readsTimestamps:readsTimestamps];
+    });
+    dispatch_source_set_cancel_handler( readSource, ^{
+        close( fd );
+        free( buffer );
+    });
+    
+    @synchronized( self )
+    {
+        self.readSource = readSource;
+        self.receiveBufferPool = pool;
+        self.boundPort = localPort;
+    }
+    dispatch_resume( readSource );
+    return YES;
+}
+
+- (void) stopListening
+{
+    dispatch_source_t readSource;
+    @synchronized( self )
+    {
+        readSource = self.readSource;
+        self.readSource = nil;
+        self.receiveBufferPool = nil;
+        self.boundPort = 0;
+    }
+    
+    if ( readSource )
+        dispatch_source_cancel( readSource );
+}
+
+// Called on `queue`. Reads until the socket would block or the per-wakeup limit is reached; any datagrams left
+// over keep the source readable, so the rest are read on the next wakeup after other work on the queue has run.
+- (void) readAvailableDatagramsFromSocket:(int)fd
+                                  buffer:(void *)buffer
+                                    pool:(nullable F53OSCReceiveBufferPool *)pool
+                         readsTimestamps:(BOOL)readsTimestamps
+{
+    NSUInteger maxDatagrams = MAX( self.maxDatagramsPerWakeup, (NSUInteger)1 );
+    NSUInteger datagramCount = 0;
+    NSUInteger pooledCount = 0;
+    NSUInteger copiedCount = 0;
+    F53OSCNativeUdpReceiveHandler receiveHandler = self.receiveHandler;
+    
+    while ( datagramCount < maxDatagrams )
+    {
+        void *poolBuffer = [pool takeBuffer];
+        void *target = ( poolBuffer ? poolBuffer : buffer );
+        
+        F53OSCSocketAddress source;
+        source.length = sizeof( source.addr );
+        ssize_t length;
+        NSTimeInterval timestamp = 0;
+        if ( readsTimestamps )
+        {
+            // The kernel's receive time arrives as SO_TIMESTAMP control data.
+            struct iovec vector = { target, F53OSC_NATIVE_UDP_BUFFER_SIZE };
+            UInt8 control[CMSG_SPACE( sizeof( struct timeval ) )];
+            struct msghdr header = { 0 };
+            header.msg_name = &source.addr;
+            header.msg_namelen = source.length;
+            header.msg_iov = &vector;
+            header.msg_iovlen = 1;
+            header.msg_control = control;
+            header.msg_controllen = sizeof( control );
+            length = recvmsg( fd, &header, 0 );
+            source.length = header.msg_namelen;
+            
+            for ( struct cmsghdr *message = CMSG_FIRSTHDR( &header ); length > 0 && message; message = CMSG_NXTHDR( &header, message ) )
+            {
+                if ( message->cmsg_level == SOL_SOCKET && message->cmsg_type == SCM_TIMESTAMP )
+                {
+                    struct timeval received;
+                    memcpy( &received, CMSG_DATA( message ), sizeof( received ) );
+                    timestamp = (NSTimeInterval)received.tv_sec + (NSTimeInterval)received.tv_usec / 1000000.0;
+                }
+            }
+        }
+        else
+        {
+            length = recvfrom( fd, target, F53OSC_NATIVE_UDP_BUFFER_SIZE, 0, &source.addr.sa, &source.length );
+        }
+        if ( length <= 0 )
+        {
+            int error = errno;
+            if ( poolBuffer )
+                [pool returnBuffer:poolBuffer];
+            if ( length == 0 )
+            {
+                datagramCount++;
+                continue;
+            }
+            if ( error == EINTR )
+                continue;
+            break; // EAGAIN: drained
+        }
+        
+        datagramCount++;
+        
+        // Parsed messages may keep references into the data, so a pool buffer stays in use until the data is deallocated.
+        NSData *data;
+        if ( poolBuffer )
+        {
+            data = [pool dataWithBuffer:poolBuffer length:(NSUInteger)length];
+            pooledCount++;
+        }
+        else
+        {
+            data = [NSData dataWithBytes:buffer length:(NSUInteger)length];
+            copiedCount++;
+        }
+        
+        receiveHandler( data, &source, timestamp );
+    }
+    
+    @synchronized( self )
+    {
+        self.totalWakeupCount++;
+        self.totalReceivedDatagramCount += datagramCount;
+        self.totalPooledReceiveCount += pooledCount;
+        self.totalCopiedReceiveCount += copiedCount;
+    }
+}
+
+- (NSError *) errorWithCode:(int)code description:(NSString *)description
+{
+    NSString *reason = [NSString stringWithUTF8String:strerror( code )];
+    return [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:@{ NSLocalizedDescriptionKey : description,
+                                                                             NSLocalizedFailureReasonErrorKey : ( reason ? reason : @"" ) }];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
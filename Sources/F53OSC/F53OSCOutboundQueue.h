@@ -0,0 +1,74 @@
+//
+//  F53OSCOutboundQueue.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+//
+//  F53OSCOutboundQueue holds packets that are already encoded and framed for a TCP connection while it is down,
+//  so that they can be written in order, in a single write, once it is back. Entries are kept as the exact bytes
+//  to write, so nothing is encoded twice.
+//
+//  The queue is bounded by `maxPacketCount` and `maxByteCount`; when full, `dropPolicy` decides whether the oldest
+//  entries make room or the new entry is refused. Entries older than `maxAge` are stale and are dropped instead of
+//  being sent late, e.g. a cue GO that should not fire several seconds after it was triggered.
+//
+//  F53OSCClient uses its `outboundQueue` for TCP packets sent while it is not connected.
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM( NSInteger, F53OSCOutboundQueueDropPolicy ) {
+    F53OSCOutboundQueueDropOldest = 0, // make room by dropping the oldest entries
+    F53OSCOutboundQueueDropNewest,     // refuse new entries while full
+};
+
+@interface F53OSCOutboundQueue : NSObject
+
+@property (assign) NSUInteger maxPacketCount;                   // default 256; 0 means no limit
+@property (assign) NSUInteger maxByteCount;                     // default 0 (no limit)
+@property (assign) NSTimeInterval maxAge;                       // default 0 (entries never go stale)
+@property (assign) F53OSCOutboundQueueDropPolicy dropPolicy;    // default F53OSCOutboundQueueDropOldest
+
+@property (readonly) NSUInteger count;
+@property (readonly) NSUInteger byteCount;
+
+@property (readonly) NSUInteger enqueuedCount;      // entries accepted
+@property (readonly) NSUInteger flushedCount;       // entries handed out by `takeQueuedData`
+@property (readonly) NSUInteger overflowDropCount;  // entries dropped, or refused, because the queue was full
+@property (readonly) NSUInteger staleDropCount;     // entries dropped because they were older than `maxAge`
+
+- (BOOL) enqueueData:(NSData *)data; // returns NO if the entry was refused
+- (BOOL) enqueueData:(NSData *)data atTime:(NSTimeInterval)now; // `now` is seconds on a monotonic clock
+
+// Removes every entry and returns those that are not stale, joined in order, or nil if there are none.
+- (nullable NSData *) takeQueuedData;
+- (nullable NSData *) takeQueuedDataAtTime:(NSTimeInterval)now;
+
+- (void) removeAllData;
+
+@end
+
+NS_ASSUME_NONNULL_END
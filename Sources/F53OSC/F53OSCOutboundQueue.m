@@ -0,0 +1,243 @@
+//
+//  F53OSCOutboundQueue.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCOutboundQueue.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCOutboundQueue ()
+
+@property (strong) NSMutableArray<NSData *> *entries;
+@property (strong) NSMutableArray<NSNumber *> *enqueueTimes; // parallel to `entries`
+@property (assign) NSUInteger queuedByteCount;
+@property (assign) NSUInteger totalEnqueuedCount;
+@property (assign) NSUInteger totalFlushedCount;
+@property (assign) NSUInteger totalOverflowDropCount;
+@property (assign) NSUInteger totalStaleDropCount;
+
+- (void) removeOldestEntry;
+- (void) dropStaleEntriesAtTime:(NSTimeInterval)now;
+
+@end
+
+
+@implementation F53OSCOutboundQueue
+
+- (instancetype) init
+{
+    self = [super init];
+    if ( self )
+    {
+        self.maxPacketCount = 256;
+        self.maxByteCount = 0;      // no limit
+        self.maxAge = 0;            // never stale
+        self.dropPolicy = F53OSCOutboundQueueDropOldest;
+        self.entries = [NSMutableArray array];
+        self.enqueueTimes = [NSMutableArray array];
+        self.queuedByteCount = 0;
+        self.totalEnqueuedCount = 0;
+        self.totalFlushedCount = 0;
+        self.totalOverflowDropCount = 0;
+        self.totalStaleDropCount = 0;
+    }
+    return self;
+}
+
+- (NSUInteger) count
+{
+    @synchronized( self )
+    {
+        return self.entries.count;
+    }
+}
+
+- (NSUInteger) byteCount
+{
+    @synchronized( self )
+    {
+        return self.queuedByteCount;
+    }
+}
+
+- (NSUInteger) enqueuedCount
+{
+    @synchronized( self )
+    {
+        return self.totalEnqueuedCount;
+    }
+}
+
+- (NSUInteger) flushedCount
+{
+    @synchronized( self )
+    {
+        return self.totalFlushedCount;
+    }
+}
+
+- (NSUInteger) overflowDropCount
+{
+    @synchronized( self )
+    {
+        return self.totalOverflowDropCount;
+    }
+}
+
+- (NSUInteger) staleDropCount
+{
+    @synchronized( self )
+    {
+        return self.totalStaleDropCount;
+    }
+}
+
+#pragma mark -
+
+- (BOOL) enqueueData:(NSData *)data
+{
+    return [self enqueueData:data atTime:[NSProcessInfo processInfo].systemUptime];
+}
+
+- (BOOL) enqueueData:(NSData *)data atTime:(NSTimeInterval)now
+{
+    if ( data.length == 0 )
+        return NO;
+    
+    @synchronized( self )
+    {
+        // Stale entries would be dropped at the next flush anyway, so they should not take room from this one.
+        [self dropStaleEntriesAtTime:now];
+        
+        NSUInteger maxPacketCount = self.maxPacketCount;
+        NSUInteger maxByteCount = self.maxByteCount;
+        if ( maxByteCount && data.length > maxByteCount )
+        {
+            self.totalOverflowDropCount++;
+            return NO;
+        }
+        
+        BOOL (^isFull)(void) = ^BOOL{
+            return ( ( maxPacketCount && self.entries.count >= maxPacketCount ) ||
+                     ( maxByteCount && self.queuedByteCount + data.length > maxByteCount ) );
+        };
+        
+        if ( isFull() )
+        {
+            if ( self.dropPolicy == F53OSCOutboundQueueDropNewest )
+            {
+                self.totalOverflowDropCount++;
+                return NO;
+            }
+            
+            while ( self.entries.count && isFull() )
+            {
+                [self removeOldestEntry];
+                self.totalOverflowDropCount++;
+            }
+        }
+        
+        [self.entries addObject:[data copy]];
+        [self.enqueueTimes addObject:@( now )];
+        self.queuedByteCount += data.length;
+        self.totalEnqueuedCount++;
+        return YES;
+    }
+}
+
+- (nullable NSData *) takeQueuedData
+{
+    return [self takeQueuedDataAtTime:[NSProcessInfo processInfo].systemUptime];
+}
+
+- (nullable NSData *) takeQueuedDataAtTime:(NSTimeInterval)now
+{
+    NSArray<NSData *> *entries = nil;
+    NSUInteger length = 0;
+    
+    @synchronized( self )
+    {
+        [self dropStaleEntriesAtTime:now];
+        
+        entries = [self.entries copy];
+        length = self.queuedByteCount;
+        [self.entries removeAllObjects];
+        [self.enqueueTimes removeAllObjects];
+        self.queuedByteCount = 0;
+        self.totalFlushedCount += entries.count;
+    }
+    
+    if ( entries.count == 0 )
+        return nil;
+    if ( entries.count == 1 )
+        return entries.firstObject;
+    
+    NSMutableData *data = [NSMutableData dataWithCapacity:length];
+    for ( NSData *entry in entries )
+        [data appendData:entry];
+    return data;
+}
+
+- (void) removeAllData
+{
+    @synchronized( self )
+    {
+        [self.entries removeAllObjects];
+        [self.enqueueTimes removeAllObjects];
+        self.queuedByteCount = 0;
+    }
+}
+
+// Must be called while synchronized.
+- (void) removeOldestEntry
+{
+    self.queuedByteCount -= self.entries.firstObject.length;
+    [self.entries removeObjectAtIndex:0];
+    [self.enqueueTimes removeObjectAtIndex:0];
+}
+
+// Must be called while synchronized.
+- (void) dropStaleEntriesAtTime:(NSTimeInterval)now
+{
+    NSTimeInterval maxAge = self.maxAge;
+    if ( maxAge <= 0 )
+        return;
+    
+    // Entries are in enqueue order, so the stale ones are all at the front.
+    while ( self.enqueueTimes.count && now - self.enqueueTimes.firstObject.doubleValue > maxAge )
+    {
+        [self removeOldestEntry];
+        self.totalStaleDropCount++;
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -38,8 +38,10 @@ NS_ASSUME_NONNULL_BEGIN
 @interface F53OSCPacket : NSObject <NSCopying>
 
 @property (strong, nullable) F53OSCSocket *replySocket; // If this message was received from a client, this is the socket to use to reply.
+@property (assign) NSTimeInterval receivedTimestamp;    // The kernel's receive time, in seconds since 1970, when the receiving socket's options enable `receiveTimestamps`; otherwise 0.
 
 - (nullable NSData *) packetData;
+- (void) appendPacketDataToData:(NSMutableData *)data; // Encodes directly into `data`. Subclasses override to avoid building an intermediate NSData.
 - (nullable NSString *) asQSC;
 
 @end
@@ -39,6 +39,7 @@ NS_ASSUME_NONNULL_BEGIN
 {
     F53OSCPacket *copy = [[self class] allocWithZone:zone];
     copy.replySocket = self.replySocket;
+    copy.receivedTimestamp = self.receivedTimestamp;
     return copy;
 }
 
@@ -48,6 +49,13 @@ NS_ASSUME_NONNULL_BEGIN
     return nil;
 }
 
+- (void) appendPacketDataToData:(NSMutableData *)data
+{
+    NSData *packetData = [self packetData];
+    if ( packetData )
+        [data appendData:packetData];
+}
+
 - (nullable NSString *) asQSC
 {
     // Defined by subclasses.
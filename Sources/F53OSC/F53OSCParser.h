@@ -27,6 +27,7 @@
 #import <Foundation/Foundation.h>
 
 @class F53OSCMessage;
+@class F53OSCSchemaRegistry;
 @class F53OSCSocket;
 @protocol F53OSCPacketDestination;
 @protocol F53OSCControlHandler;
@@ -34,12 +35,19 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+FOUNDATION_EXPORT const NSUInteger F53OSCParserMaxBundleDepth; // bundles nested deeper than this are rejected
+
 @interface F53OSCParser : NSObject
 
 + (nullable F53OSCMessage *) parseOscMessageData:(NSData *)data;
 
 + (void) processOscData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket controlHandler:(nullable id<F53OSCControlHandler>)controlHandler wasEncrypted:(BOOL)wasEncrypted;
++ (void) processOscData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket controlHandler:(nullable id<F53OSCControlHandler>)controlHandler wasEncrypted:(BOOL)wasEncrypted
+      receivedTimestamp:(NSTimeInterval)receivedTimestamp; // sets `receivedTimestamp` on every parsed packet
++ (void) processOscData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket controlHandler:(nullable id<F53OSCControlHandler>)controlHandler wasEncrypted:(BOOL)wasEncrypted
+      receivedTimestamp:(NSTimeInterval)receivedTimestamp schemaRegistry:(nullable F53OSCSchemaRegistry *)schemaRegistry; // messages the registry handles or rejects never reach `destination`
 
+// A F53OSCSchemaRegistry in `state` under "schemaRegistry" is used for every frame.
 + (void) translateSlipData:(NSData *)slipData toData:(NSMutableData *)data withState:(NSMutableDictionary<NSString *, id> *)state destination:(id<F53OSCPacketDestination>)destination
     controlHandler:(nullable id<F53OSCControlHandler>)controlHandler;
 
@@ -36,7 +36,10 @@
 @import F53OSCEncrypt;
 #endif
 #import "F53OSCMessage.h"
+#import "F53OSCSchemaRegistry.h"
 #import "F53OSCSocket.h"
+#import "F53OSCTimeTag.h"
+#import "F53OSCWire.h"
 #import "F53OSCFoundationAdditions.h"
 
 
@@ -47,94 +50,140 @@ NS_ASSUME_NONNULL_BEGIN
 #define ESC_END         0334    /* ESC ESC_END means END data byte */
 #define ESC_ESC         0335    /* ESC ESC_ESC means ESC data byte */
 
+#define F53_OSC_MAX_BUNDLE_DEPTH    16
+
+const NSUInteger F53OSCParserMaxBundleDepth = F53_OSC_MAX_BUNDLE_DEPTH;
+
 @interface F53OSCParser (Private)
 
-+ (void) processMessageData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket;
-+ (void) processBundleData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket;
++ (void) processMessageData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket receivedTimestamp:(NSTimeInterval)receivedTimestamp schemaRegistry:(nullable F53OSCSchemaRegistry *)schemaRegistry;
++ (void) processBundleData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket receivedTimestamp:(NSTimeInterval)receivedTimestamp schemaRegistry:(nullable F53OSCSchemaRegistry *)schemaRegistry;
++ (BOOL) collectMessagesFromBundleData:(NSData *)data intoArray:(NSMutableArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag * _Nullable __autoreleasing * _Nullable)timeTag replyToSocket:(F53OSCSocket *)socket receivedTimestamp:(NSTimeInterval)receivedTimestamp
+        schemaRegistry:(nullable F53OSCSchemaRegistry *)schemaRegistry;
++ (BOOL) readBundle:(F53OSCWireBundle *)bundle fromBytes:(const void *)bytes length:(NSUInteger)length;
 
 @end
 
 @implementation F53OSCParser (Private)
 
-+ (void) processMessageData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket
++ (void) processMessageData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket receivedTimestamp:(NSTimeInterval)receivedTimestamp schemaRegistry:(nullable F53OSCSchemaRegistry *)schemaRegistry
 {
+    if ( schemaRegistry && [schemaRegistry handleMessageBytes:data.bytes length:data.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:receivedTimestamp replySocket:socket] != F53OSCSchemaUnregistered )
+        return;
+    
     F53OSCMessage *inbound = [self parseOscMessageData:data];
     if ( inbound == nil )
         return;
     
     inbound.replySocket = socket;
+    inbound.receivedTimestamp = receivedTimestamp;
     [destination takeMessage:(F53OSCMessage * _Nonnull)inbound];
 }
 
-+ (void) processBundleData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket;
++ (void) processBundleData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket receivedTimestamp:(NSTimeInterval)receivedTimestamp schemaRegistry:(nullable F53OSCSchemaRegistry *)schemaRegistry
 {
-    NSUInteger length = [data length];
-    const char *buffer = [data bytes];
+    BOOL takesBundles = [destination respondsToSelector:@selector(takeBundleMessages:timeTag:)];
     
-    NSUInteger lengthOfRemainingBuffer = length;
-    NSUInteger bytesRead = 0;
-    NSString *bundlePrefix = [NSString stringWithOSCStringBytes:buffer maxLength:lengthOfRemainingBuffer bytesRead:&bytesRead];
-    if ( bundlePrefix == nil || bytesRead == 0 || bytesRead > length )
+    NSMutableArray<F53OSCMessage *> *messages = [NSMutableArray array];
+    F53OSCTimeTag *timeTag = nil;
+    BOOL isValid = [self collectMessagesFromBundleData:data intoArray:messages timeTag:( takesBundles ? &timeTag : NULL ) replyToSocket:socket receivedTimestamp:receivedTimestamp
+                                    schemaRegistry:schemaRegistry];
+    
+    if ( takesBundles )
     {
-        NSLog( @"Error: Unable to parse OSC bundle prefix." );
+        if ( isValid && messages.count )
+            [destination takeBundleMessages:messages timeTag:( timeTag ? timeTag : [F53OSCTimeTag immediateTimeTag] )];
         return;
     }
     
-    if ( [bundlePrefix isEqualToString:@"#bundle"] )
+    // Without bundle delivery, messages that parsed before any error are still delivered one at a time.
+    for ( F53OSCMessage *message in messages )
+        [destination takeMessage:message];
+}
+
++ (BOOL) collectMessagesFromBundleData:(NSData *)data intoArray:(NSMutableArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag * _Nullable __autoreleasing * _Nullable)timeTag replyToSocket:(F53OSCSocket *)socket receivedTimestamp:(NSTimeInterval)receivedTimestamp
+        schemaRegistry:(nullable F53OSCSchemaRegistry *)schemaRegistry
+{
+    // Nested bundles are walked with an explicit stack rather than by recursion, so hostile input can neither
+    // exhaust the thread's stack nor cost an NSData wrapper per nested bundle.
+    F53OSCWireBundle stack[F53_OSC_MAX_BUNDLE_DEPTH];
+    NSUInteger depth = 0;
+    
+    if ( ![self readBundle:&stack[0] fromBytes:[data bytes] length:[data length]] )
+        return NO;
+    if ( timeTag )
+        *timeTag = [F53OSCTimeTag timeTagWithWireValue:stack[0].timeTag];
+    depth++;
+    
+    while ( depth > 0 )
     {
-        buffer += bytesRead;
-        lengthOfRemainingBuffer -= bytesRead;
+        const void *elementBytes = NULL;
+        size_t elementLength = 0;
+        F53OSCWireElementStatus status = F53OSCWireBundleNextElement( &stack[depth - 1], &elementBytes, &elementLength );
+        if ( status == F53OSCWireElementsEnd )
+        {
+            depth--; // finished this bundle; resume the one enclosing it
+            continue;
+        }
+        
+        if ( status == F53OSCWireElementTruncated )
+        {
+            NSLog( @"Error: A message in the OSC bundle claimed to be larger than the bundle itself." );
+            return NO;
+        }
         
-        if ( lengthOfRemainingBuffer > 8 )
+        const char *element = elementBytes;
+        if ( elementLength > 0 && element[0] == '/' ) // OSC message
         {
-            //F53OSCTimeTag *timetag = [F53OSCTimeTag timeTagWithOSCTimeBytes:buffer];
-            buffer += 8; // We're not currently using the time tag so we just skip it.
-            lengthOfRemainingBuffer -= 8;
+            // Messages the registry decodes or rejects are not parsed into F53OSCMessages.
+            if ( schemaRegistry && [schemaRegistry handleMessageBytes:element length:elementLength timeTag:stack[depth - 1].timeTag receivedTimestamp:receivedTimestamp replySocket:socket] != F53OSCSchemaUnregistered )
+                continue;
             
-            while ( lengthOfRemainingBuffer > sizeof( UInt32 ) )
+            F53OSCMessage *inbound = [self parseOscMessageData:[NSData dataWithBytesNoCopy:(void *)element length:elementLength freeWhenDone:NO]];
+            if ( inbound == nil )
+                continue;
+            
+            inbound.replySocket = socket;
+            inbound.receivedTimestamp = receivedTimestamp;
+            [messages addObject:(F53OSCMessage * _Nonnull)inbound];
+        }
+        else if ( elementLength > 0 && element[0] == '#' ) // OSC bundle
+        {
+            if ( depth == F53_OSC_MAX_BUNDLE_DEPTH )
             {
-                UInt32 elementLength = *((UInt32 *)buffer);
-                elementLength = OSSwapBigToHostInt32( elementLength );
-                buffer += sizeof( UInt32 );
-                lengthOfRemainingBuffer -= sizeof( UInt32 );
-                
-                if ( elementLength > lengthOfRemainingBuffer )
-                {
-                    NSLog( @"Error: A message in the OSC bundle claimed to be larger than the bundle itself." );
-                    return;
-                }
-                
-                if ( buffer[0] == '/' ) // OSC message
-                {
-                    [self processMessageData:[NSData dataWithBytesNoCopy:(void *)buffer length:elementLength freeWhenDone:NO]
-                              forDestination:destination
-                               replyToSocket:socket];
-                }
-                else if ( buffer[0] == '#' ) // OSC bundle
-                {
-                    [self processBundleData:[NSData dataWithBytesNoCopy:(void *)buffer length:elementLength freeWhenDone:NO]
-                             forDestination:destination
-                              replyToSocket:socket];
-                }
-                else
-                {
-                    NSLog( @"Error: Bundle contained unrecognized OSC message of length %u.", (unsigned int)elementLength );
-                    return;
-                }
-                
-                buffer += elementLength;
-                lengthOfRemainingBuffer -= elementLength;
+                NSLog( @"Error: OSC bundle is nested more than %lu levels deep.", (unsigned long)F53OSCParserMaxBundleDepth );
+                return NO;
             }
+            
+            if ( ![self readBundle:&stack[depth] fromBytes:element length:elementLength] )
+                return NO;
+            depth++;
         }
         else
         {
-            NSLog( @"Warning: Received an empty OSC bundle message." );
+            NSLog( @"Error: Bundle contained unrecognized OSC message of length %u.", (unsigned int)elementLength );
+            return NO;
         }
     }
-    else
+    
+    return YES;
+}
+
++ (BOOL) readBundle:(F53OSCWireBundle *)bundle fromBytes:(const void *)bytes length:(NSUInteger)length
+{
+    if ( !F53OSCWireReadBundle( bytes, length, bundle ) )
     {
-        NSLog( @"Error: Received an invalid OSC bundle message." );
+        if ( length < 8 )
+            NSLog( @"Error: Unable to parse OSC bundle prefix." );
+        else
+            NSLog( @"Error: Received an invalid OSC bundle message." );
+        return NO;
     }
+    
+    if ( F53OSCWireReaderRemaining( &bundle->elements ) == 0 )
+        NSLog( @"Warning: Received an empty OSC bundle message." );
+    
+    return YES;
 }
 
 @end
@@ -143,161 +192,131 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (nullable F53OSCMessage *) parseOscMessageData:(NSData *)data
 {
-    NSUInteger length = [data length];
-    const char *buffer = [data bytes];
+    F53OSCWireMessage wireMessage;
+    if ( !F53OSCWireReadMessage( [data bytes], [data length], &wireMessage ) )
+    {
+        if ( wireMessage.arguments.offset == 0 )
+            NSLog( @"Error: Unable to parse OSC method address." );
+        else
+            NSLog( @"Error: Unable to parse type tag for OSC method %s", wireMessage.address );
+        return nil;
+    }
     
-    NSUInteger lengthOfRemainingBuffer = length;
-    NSUInteger bytesRead = 0;
-    NSString *addressPattern = [NSString stringWithOSCStringBytes:buffer maxLength:lengthOfRemainingBuffer bytesRead:&bytesRead];
-    if ( addressPattern == nil || bytesRead == 0 || bytesRead > length )
+    NSString *addressPattern = [[NSString alloc] initWithBytes:wireMessage.address length:wireMessage.addressLength encoding:NSUTF8StringEncoding];
+    if ( addressPattern == nil )
     {
         NSLog( @"Error: Unable to parse OSC method address." );
         return nil;
     }
     
-    buffer += bytesRead;
-    lengthOfRemainingBuffer -= bytesRead;
+    BOOL debugIncomingOSC = [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"];
+    if ( debugIncomingOSC )
+    {
+        NSLog( @"Incoming OSC message:" );
+        NSLog( @"  %@", addressPattern );
+        if ( wireMessage.argumentCount > 0 )
+            NSLog( @"  arguments:" );
+    }
     
-    NSMutableArray<id> *args = [NSMutableArray array];
-    BOOL hasArguments = (lengthOfRemainingBuffer > 0);
-    if ( hasArguments && buffer[0] == ',' )
+    NSMutableArray<id> *args = [NSMutableArray arrayWithCapacity:wireMessage.argumentCount];
+    F53OSCWireArgument argument;
+    F53OSCWireArgumentStatus status;
+    while ( ( status = F53OSCWireMessageNextArgument( &wireMessage, &argument ) ) == F53OSCWireArgumentRead )
     {
-        NSString *typeTag = [NSString stringWithOSCStringBytes:buffer maxLength:lengthOfRemainingBuffer bytesRead:&bytesRead];
-        if ( typeTag == nil )
-        {
-            NSLog( @"Error: Unable to parse type tag for OSC method %@", addressPattern );
-            return nil;
-        }
-        buffer += bytesRead;
-        lengthOfRemainingBuffer -= bytesRead;
-        
-        if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
+        switch ( argument.type )
         {
-            NSLog( @"Incoming OSC message:" );
-            NSLog( @"  %@", addressPattern );
-        }
-        
-        NSInteger numArgs = [typeTag length] - 1;
-        if ( numArgs > 0 )
-        {
-            if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                NSLog( @"  arguments:" );
-            
-            for ( int i = 1; i < numArgs + 1; i++ )
+            case 's':
             {
-                NSString *stringArg = nil;
-                NSData *dataArg = nil;
-                NSNumber *numberArg = nil;
-                
-                char type = [typeTag characterAtIndex:i]; // (index starts at 1 because first char is ",")
-                switch ( type )
+                NSString *stringArg = [[NSString alloc] initWithBytes:argument.value.data.bytes length:argument.value.data.length encoding:NSUTF8StringEncoding];
+                if ( stringArg == nil )
                 {
-                    case 's':
-                        bytesRead = 0; // reset
-                        stringArg = [NSString stringWithOSCStringBytes:buffer maxLength:lengthOfRemainingBuffer bytesRead:&bytesRead];
-                        if ( stringArg != nil )
-                        {
-                            [args addObject:stringArg];
-                            buffer += bytesRead;
-                            lengthOfRemainingBuffer -= bytesRead;
-                            
-                            if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                                NSLog( @"    string: \"%@\"", stringArg );
-                        }
-                        else
-                        {
-                            NSLog( @"Error: Unable to parse string argument for OSC method %@", addressPattern );
-                            return nil;
-                        }
-                        break;
-                    case 'b':
-                        bytesRead = 0; // reset
-                        dataArg = [NSData dataWithOSCBlobBytes:buffer maxLength:lengthOfRemainingBuffer bytesRead:&bytesRead];
-                        if ( dataArg != nil )
-                        {
-                            [args addObject:dataArg];
-                            buffer += bytesRead;
-                            lengthOfRemainingBuffer -= bytesRead;
-                            
-                            if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                                NSLog( @"    blob: %@", dataArg );
-                        }
-                        else
-                        {
-                            NSLog( @"Error: Unable to parse blob argument for OSC method %@", addressPattern );
-                            return nil;
-                        }
-                        break;
-                    case 'i':
-                        numberArg = [NSNumber numberWithOSCIntBytes:buffer maxLength:lengthOfRemainingBuffer];
-                        if ( numberArg != nil )
-                        {
-                            [args addObject:numberArg];
-                            buffer += 4;
-                            lengthOfRemainingBuffer -= 4;
-                            
-                            if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                                NSLog( @"    int: %@", numberArg );
-                        }
-                        else
-                        {
-                            NSLog( @"Error: Unable to parse int argument for OSC method %@", addressPattern );
-                            return nil;
-                        }
-                        break;
-                    case 'f':
-                        numberArg = [NSNumber numberWithOSCFloatBytes:buffer maxLength:lengthOfRemainingBuffer];
-                        if ( numberArg != nil )
-                        {
-                            [args addObject:numberArg];
-                            buffer += 4;
-                            lengthOfRemainingBuffer -= 4;
-                            
-                            if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                                NSLog( @"    float: %@", numberArg );
-                        }
-                        else
-                        {
-                            NSLog( @"Error: Unable to parse float argument for OSC method %@", addressPattern );
-                            return nil;
-                        }
-                        break;
-                    case 'T':
-                        [args addObject:[F53OSCValue oscTrue]]; // no data - do not advance the buffer
-                        
-                        if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                            NSLog( @"    TRUE" );
-                        break;
-                    case 'F':
-                        [args addObject:[F53OSCValue oscFalse]]; // no data - do not advance the buffer
-                        
-                        if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                            NSLog( @"    FALSE" );
-                        break;
-                    case 'N':
-                        [args addObject:[F53OSCValue oscNull]]; // no data - do not advance the buffer
-                        
-                        if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                            NSLog( @"    NULL" );
-                        break;
-                    case 'I':
-                        [args addObject:[F53OSCValue oscImpulse]]; // no data - do not advance the buffer
-                        
-                        if ( [[NSUserDefaults standardUserDefaults] boolForKey:@"debugIncomingOSC"] )
-                            NSLog( @"    IMPLUSE" );
-                        break;
-                    default:
-                        NSLog( @"Error: Unrecognized type '%c' found in type tag for OSC method %@", type, addressPattern );
-                        return nil;
+                    NSLog( @"Error: Unable to parse string argument for OSC method %@", addressPattern );
+                    return nil;
                 }
+                [args addObject:stringArg];
+                
+                if ( debugIncomingOSC )
+                    NSLog( @"    string: \"%@\"", stringArg );
+                break;
             }
+            case 'b':
+            {
+                NSData *dataArg = [NSData dataWithBytes:argument.value.data.bytes length:argument.value.data.length];
+                [args addObject:dataArg];
+                
+                if ( debugIncomingOSC )
+                    NSLog( @"    blob: %@", dataArg );
+                break;
+            }
+            case 'i':
+                [args addObject:[NSNumber numberWithInteger:argument.value.i]];
+                
+                if ( debugIncomingOSC )
+                    NSLog( @"    int: %d", argument.value.i );
+                break;
+            case 'f':
+                [args addObject:[NSNumber numberWithFloat:argument.value.f]];
+                
+                if ( debugIncomingOSC )
+                    NSLog( @"    float: %g", argument.value.f );
+                break;
+            case 'T':
+                [args addObject:[F53OSCValue oscTrue]]; // no data - the reader does not advance
+                
+                if ( debugIncomingOSC )
+                    NSLog( @"    TRUE" );
+                break;
+            case 'F':
+                [args addObject:[F53OSCValue oscFalse]];
+                
+                if ( debugIncomingOSC )
+                    NSLog( @"    FALSE" );
+                break;
+            case 'N':
+                [args addObject:[F53OSCValue oscNull]];
+                
+                if ( debugIncomingOSC )
+                    NSLog( @"    NULL" );
+                break;
+            case 'I':
+                [args addObject:[F53OSCValue oscImpulse]];
+                
+                if ( debugIncomingOSC )
+                    NSLog( @"    IMPLUSE" );
+                break;
         }
     }
     
+    char type = ( wireMessage.nextArgument < wireMessage.argumentCount ? wireMessage.typeTags[wireMessage.nextArgument] : 0 );
+    switch ( status )
+    {
+        case F53OSCWireArgumentRead:
+        case F53OSCWireArgumentsEnd:
+            break;
+        case F53OSCWireArgumentTruncated:
+            NSLog( @"Error: Unable to parse %@ argument for OSC method %@", ( type == 's' ? @"string" : type == 'b' ? @"blob" : type == 'i' ? @"int" : @"float" ), addressPattern );
+            return nil;
+        case F53OSCWireArgumentUnknownType:
+            NSLog( @"Error: Unrecognized type '%c' found in type tag for OSC method %@", type, addressPattern );
+            return nil;
+    }
+    
     return [F53OSCMessage messageWithAddressPattern:addressPattern arguments:args replySocket:nil];
 }
 
 + (void) processOscData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket controlHandler:(nullable id<F53OSCControlHandler>)controlHandler wasEncrypted:(BOOL)wasEncrypted
+{
+    [self processOscData:data forDestination:destination replyToSocket:socket controlHandler:controlHandler wasEncrypted:wasEncrypted receivedTimestamp:0];
+}
+
++ (void) processOscData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket controlHandler:(nullable id<F53OSCControlHandler>)controlHandler wasEncrypted:(BOOL)wasEncrypted
+      receivedTimestamp:(NSTimeInterval)receivedTimestamp
+{
+    [self processOscData:data forDestination:destination replyToSocket:socket controlHandler:controlHandler wasEncrypted:wasEncrypted receivedTimestamp:receivedTimestamp schemaRegistry:nil];
+}
+
++ (void) processOscData:(NSData *)data forDestination:(id<F53OSCPacketDestination>)destination replyToSocket:(F53OSCSocket *)socket controlHandler:(nullable id<F53OSCControlHandler>)controlHandler wasEncrypted:(BOOL)wasEncrypted
+      receivedTimestamp:(NSTimeInterval)receivedTimestamp schemaRegistry:(nullable F53OSCSchemaRegistry *)schemaRegistry
 {
     if ( data == nil || destination == nil )
         return;
@@ -320,7 +339,7 @@ NS_ASSUME_NONNULL_BEGIN
             NSData *encryptedData = [data subdataWithRange:NSMakeRange(1, length-1)];
             NSData *decryptedData = [socket.encrypter decryptDataWithEncryptedData:encryptedData];
             if ( decryptedData )
-                [F53OSCParser processOscData:decryptedData forDestination:destination replyToSocket:socket controlHandler:controlHandler wasEncrypted:YES];
+                [F53OSCParser processOscData:decryptedData forDestination:destination replyToSocket:socket controlHandler:controlHandler wasEncrypted:YES receivedTimestamp:receivedTimestamp schemaRegistry:schemaRegistry];
             else
                 NSLog(@"Error: failed to decrypt OSC data");
         }
@@ -338,11 +357,11 @@ NS_ASSUME_NONNULL_BEGIN
         }
         if ( buffer[0] == '/' ) // OSC message
         {
-            [self processMessageData:data forDestination:destination replyToSocket:socket];
+            [self processMessageData:data forDestination:destination replyToSocket:socket receivedTimestamp:receivedTimestamp schemaRegistry:schemaRegistry];
         }
         else if ( buffer[0] == '#' ) // OSC bundle
         {
-            [self processBundleData:data forDestination:destination replyToSocket:socket];
+            [self processBundleData:data forDestination:destination replyToSocket:socket receivedTimestamp:receivedTimestamp schemaRegistry:schemaRegistry];
         }
         else if ( buffer[0] == '!' ) // F53OSC control message
         {
@@ -350,6 +369,7 @@ NS_ASSUME_NONNULL_BEGIN
             if ( inbound == nil )
                 return;
             inbound.replySocket = socket;
+            inbound.receivedTimestamp = receivedTimestamp;
             if ( controlHandler )
                 [controlHandler handleF53OSCControlMessage:inbound];
             else
@@ -377,7 +397,9 @@ NS_ASSUME_NONNULL_BEGIN
         return;
     }
     
+    F53OSCSchemaRegistry *schemaRegistry = [state objectForKey:@"schemaRegistry"]; // set by the owner
     BOOL dangling_ESC = [[state objectForKey:@"dangling_ESC"] boolValue];
+    BOOL dropping_frame = [[state objectForKey:@"dropping_frame"] boolValue]; // set by the owner to discard bytes up to the next END
     
     Byte end[1] = {END};
     Byte esc[1] = {ESC};
@@ -386,7 +408,15 @@ NS_ASSUME_NONNULL_BEGIN
     const Byte *buffer = [slipData bytes];
     for ( NSUInteger index = 0; index < length; index++ )
     {
-        if ( dangling_ESC )
+        if ( dropping_frame )
+        {
+            if ( buffer[index] == END )
+            {
+                dropping_frame = NO;
+                [state setObject:@NO forKey:@"dropping_frame"];
+            }
+        }
+        else if ( dangling_ESC )
         {
             dangling_ESC = NO;
             [state setObject:@NO forKey:@"dangling_ESC"];
@@ -401,7 +431,8 @@ NS_ASSUME_NONNULL_BEGIN
         {
             // The data is now a complete message.
             //NSLog( @"socket %p dispatching OSC data of length %lu", sock, [data length] );
-            [F53OSCParser processOscData:[NSData dataWithData:data] forDestination:destination replyToSocket:socket controlHandler:controlHandler wasEncrypted:NO];
+            [F53OSCParser processOscData:[NSData dataWithData:data] forDestination:destination replyToSocket:socket controlHandler:controlHandler wasEncrypted:NO receivedTimestamp:0
+                          schemaRegistry:schemaRegistry];
             [data setData:[NSData data]];
         }
         else if ( buffer[index] == ESC )
@@ -0,0 +1,89 @@
+//
+//  F53OSCPatternCache.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+//
+//  F53OSCPatternCache resolves incoming OSC address patterns to the objects registered at the addresses they
+//  match, and remembers the result. An application registers its targets, e.g. cues or mixer channels, under
+//  their addresses; `targetsMatchingPattern:` then returns every target whose address matches a pattern such as
+//  "/cue/*/level" or "/mixer/{1,2,3}/mute", using the same matching as
+//  `+[F53OSCServer predicateForAttribute:matchingOSCPattern:]`.
+//
+//  Resolved patterns are kept in a least-recently-used cache of at most `capacity` entries, so a pattern that
+//  peers send over and over costs one hash lookup after the first time. Every change to the registered
+//  addresses advances `generation`, and cached results from an earlier generation are resolved again the next
+//  time they are used rather than returned stale. Patterns longer than `maxPatternLength` are resolved but never
+//  cached, so hostile traffic can not grow the cache's memory beyond `capacity` entries of bounded size.
+//
+//  Patterns without wildcards are looked up directly and cached like any other. All methods are thread-safe;
+//  patterns are resolved while the cache is locked.
+//
+//  Example usage:
+//  F53OSCPatternCache *cache = [[F53OSCPatternCache alloc] init];
+//  [cache addTarget:channel1 forAddress:@"/mixer/1/mute"];
+//  [cache addTarget:channel2 forAddress:@"/mixer/2/mute"];
+//
+//  // in `takeMessage:`
+//  for ( MixerChannel *channel in [cache targetsMatchingPattern:message.addressPattern] )
+//      [channel toggleMute];
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCPatternCache : NSObject
+
+- (instancetype) init; // 1024 entries
+- (instancetype) initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+@property (readonly) NSUInteger capacity;
+@property (assign) NSUInteger maxPatternLength;     // default 1024 characters
+
+// Each change advances `generation`. A target may be registered at several addresses, and an address may hold several targets.
+- (void) addTarget:(id)target forAddress:(NSString *)address;
+- (void) removeTarget:(id)target forAddress:(NSString *)address;
+- (void) removeAllTargetsForAddress:(NSString *)address;
+- (void) removeAllTargets;
+- (void) invalidate; // advances `generation` without changing the addresses, e.g. after targets have changed in ways the cache can not see
+
+@property (readonly) uint64_t generation;
+@property (readonly) NSUInteger addressCount;
+
+// Targets are returned in order of address, and in the order they were added at each address.
+- (NSArray *) targetsMatchingPattern:(NSString *)pattern;
+
+@property (readonly) NSUInteger count;              // cached patterns, including stale ones not yet resolved again
+@property (readonly) NSUInteger hitCount;
+@property (readonly) NSUInteger missCount;          // includes stale entries and uncacheable patterns
+@property (readonly) NSUInteger staleCount;         // misses for patterns cached in an earlier generation
+@property (readonly) NSUInteger evictionCount;
+@property (readonly) double hitRate;                // hits over lookups, or 0 before the first lookup
+- (void) resetStatistics;
+- (void) removeAllCachedPatterns;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,362 @@
+//
+//  F53OSCPatternCache.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCPatternCache.h"
+
+#import "F53OSCServer.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCPatternCacheAddress : NSObject
+@property (copy) NSString *address;
+@property (strong) NSMutableArray *targets;
+@end
+
+@implementation F53OSCPatternCacheAddress
+@end
+
+// Entries form a list from most to least recently used. The list links do not retain; `entries` does.
+@interface F53OSCPatternCacheEntry : NSObject
+@property (copy) NSString *pattern;
+@property (assign) uint64_t generation;
+@property (copy) NSArray *targets;
+@property (unsafe_unretained, nullable) F53OSCPatternCacheEntry *newer;
+@property (unsafe_unretained, nullable) F53OSCPatternCacheEntry *older;
+@end
+
+@implementation F53OSCPatternCacheEntry
+@end
+
+
+@interface F53OSCPatternCache ()
+
+@property (strong) NSMutableDictionary<NSString *, F53OSCPatternCacheAddress *> *addresses;
+@property (strong) NSMutableDictionary<NSString *, F53OSCPatternCacheEntry *> *entries;
+@property (unsafe_unretained, nullable) F53OSCPatternCacheEntry *newestEntry;
+@property (unsafe_unretained, nullable) F53OSCPatternCacheEntry *oldestEntry;
+@property (assign) uint64_t currentGeneration;
+@property (assign) NSUInteger hits;
+@property (assign) NSUInteger misses;
+@property (assign) NSUInteger staleMisses;
+@property (assign) NSUInteger evictions;
+
+- (NSArray *) resolvePattern:(NSString *)pattern;
+- (void) unlinkEntry:(F53OSCPatternCacheEntry *)entry;
+- (void) linkNewestEntry:(F53OSCPatternCacheEntry *)entry;
+
+@end
+
+
+@implementation F53OSCPatternCache
+
+- (instancetype) init
+{
+    return [self initWithCapacity:1024];
+}
+
+- (instancetype) initWithCapacity:(NSUInteger)capacity
+{
+    self = [super init];
+    if ( self )
+    {
+        _capacity = MAX( capacity, 1 );
+        self.maxPatternLength = 1024;
+        self.addresses = [NSMutableDictionary dictionary];
+        self.entries = [NSMutableDictionary dictionaryWithCapacity:_capacity];
+        self.newestEntry = nil;
+        self.oldestEntry = nil;
+        self.currentGeneration = 0;
+        self.hits = 0;
+        self.misses = 0;
+        self.staleMisses = 0;
+        self.evictions = 0;
+    }
+    return self;
+}
+
+#pragma mark - Addresses
+
+- (void) addTarget:(id)target forAddress:(NSString *)address
+{
+    @synchronized( self )
+    {
+        F53OSCPatternCacheAddress *entry = self.addresses[address];
+        if ( entry == nil )
+        {
+            entry = [[F53OSCPatternCacheAddress alloc] init];
+            entry.address = address;
+            entry.targets = [NSMutableArray array];
+            self.addresses[address] = entry;
+        }
+        [entry.targets addObject:target];
+        self.currentGeneration++;
+    }
+}
+
+- (void) removeTarget:(id)target forAddress:(NSString *)address
+{
+    @synchronized( self )
+    {
+        F53OSCPatternCacheAddress *entry = self.addresses[address];
+        if ( entry == nil )
+            return;
+        
+        [entry.targets removeObjectIdenticalTo:target];
+        if ( entry.targets.count == 0 )
+            [self.addresses removeObjectForKey:address];
+        self.currentGeneration++;
+    }
+}
+
+- (void) removeAllTargetsForAddress:(NSString *)address
+{
+    @synchronized( self )
+    {
+        [self.addresses removeObjectForKey:address];
+        self.currentGeneration++;
+    }
+}
+
+- (void) removeAllTargets
+{
+    @synchronized( self )
+    {
+        [self.addresses removeAllObjects];
+        self.currentGeneration++;
+    }
+}
+
+- (void) invalidate
+{
+    @synchronized( self )
+    {
+        self.currentGeneration++;
+    }
+}
+
+- (uint64_t) generation
+{
+    @synchronized( self )
+    {
+        return self.currentGeneration;
+    }
+}
+
+- (NSUInteger) addressCount
+{
+    @synchronized( self )
+    {
+        return self.addresses.count;
+    }
+}
+
+#pragma mark - Lookup
+
+- (NSArray *) targetsMatchingPattern:(NSString *)pattern
+{
+    @synchronized( self )
+    {
+        F53OSCPatternCacheEntry *entry = self.entries[pattern];
+        if ( entry && entry.generation == self.currentGeneration )
+        {
+            self.hits++;
+            if ( entry != self.newestEntry )
+            {
+                [self unlinkEntry:entry];
+                [self linkNewestEntry:entry];
+            }
+            return entry.targets;
+        }
+        
+        self.misses++;
+        NSArray *targets = [self resolvePattern:pattern];
+        
+        if ( entry )
+        {
+            // Resolved again for the current generation.
+            self.staleMisses++;
+            entry.generation = self.currentGeneration;
+            entry.targets = targets;
+            [self unlinkEntry:entry];
+            [self linkNewestEntry:entry];
+            return targets;
+        }
+        
+        if ( pattern.length > self.maxPatternLength )
+            return targets;
+        
+        if ( self.entries.count >= self.capacity )
+        {
+            F53OSCPatternCacheEntry *oldestEntry = self.oldestEntry;
+            [self unlinkEntry:oldestEntry];
+            [self.entries removeObjectForKey:oldestEntry.pattern];
+            self.evictions++;
+        }
+        
+        entry = [[F53OSCPatternCacheEntry alloc] init];
+        entry.pattern = pattern;
+        entry.generation = self.currentGeneration;
+        entry.targets = targets;
+        self.entries[entry.pattern] = entry;
+        [self linkNewestEntry:entry];
+        return targets;
+    }
+}
+
+// Called while synchronized.
+- (NSArray *) resolvePattern:(NSString *)pattern
+{
+    NSCharacterSet *wildcards = [NSCharacterSet characterSetWithCharactersInString:@"*?[]{}"];
+    if ( [pattern rangeOfCharacterFromSet:wildcards].location == NSNotFound )
+    {
+        NSArray *targets = self.addresses[pattern].targets;
+        return ( targets ? [targets copy] : @[] );
+    }
+    
+    NSPredicate *predicate = [F53OSCServer predicateForAttribute:@"address" matchingOSCPattern:pattern];
+    NSArray<F53OSCPatternCacheAddress *> *matches = [self.addresses.allValues filteredArrayUsingPredicate:predicate];
+    if ( matches.count == 0 )
+        return @[];
+    
+    matches = [matches sortedArrayUsingComparator:^NSComparisonResult( F53OSCPatternCacheAddress *a, F53OSCPatternCacheAddress *b ) {
+        return [a.address compare:b.address];
+    }];
+    
+    NSMutableArray *targets = [NSMutableArray array];
+    for ( F53OSCPatternCacheAddress *match in matches )
+        [targets addObjectsFromArray:match.targets];
+    return [targets copy];
+}
+
+// Called while synchronized.
+- (void) unlinkEntry:(F53OSCPatternCacheEntry *)entry
+{
+    if ( entry.newer )
+        entry.newer.older = entry.older;
+    else
+        self.newestEntry = entry.older;
+    
+    if ( entry.older )
+        entry.older.newer = entry.newer;
+    else
+        self.oldestEntry = entry.newer;
+    
+    entry.newer = nil;
+    entry.older = nil;
+}
+
+// Called while synchronized.
+- (void) linkNewestEntry:(F53OSCPatternCacheEntry *)entry
+{
+    entry.older = self.newestEntry;
+    entry.newer = nil;
+    if ( self.newestEntry )
+        self.newestEntry.newer = entry;
+    self.newestEntry = entry;
+    if ( self.oldestEntry == nil )
+        self.oldestEntry = entry;
+}
+
+- (void) removeAllCachedPatterns
+{
+    @synchronized( self )
+    {
+        self.newestEntry = nil;
+        self.oldestEntry = nil;
+        [self.entries removeAllObjects];
+    }
+}
+
+#pragma mark - Statistics
+
+- (NSUInteger) count
+{
+    @synchronized( self )
+    {
+        return self.entries.count;
+    }
+}
+
+- (NSUInteger) hitCount
+{
+    @synchronized( self )
+    {
+        return self.hits;
+    }
+}
+
+- (NSUInteger) missCount
+{
+    @synchronized( self )
+    {
+        return self.misses;
+    }
+}
+
+- (NSUInteger) staleCount
+{
+    @synchronized( self )
+    {
+        return self.staleMisses;
+    }
+}
+
+- (NSUInteger) evictionCount
+{
+    @synchronized( self )
+    {
+        return self.evictions;
+    }
+}
+
+- (double) hitRate
+{
+    @synchronized( self )
+    {
+        NSUInteger lookups = self.hits + self.misses;
+        return ( lookups ? (double)self.hits / lookups : 0 );
+    }
+}
+
+- (void) resetStatistics
+{
+    @synchronized( self )
+    {
+        self.hits = 0;
+        self.misses = 0;
+        self.staleMisses = 0;
+        self.evictions = 0;
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,115 @@
+//
+//  F53OSCPriorityScheduler.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCMessage.h>
+#else
+#import "F53OSCMessage.h"
+#endif
+
+//
+//  F53OSCPriorityScheduler sits between F53OSCParser and a destination that may fall behind.
+//  Each received message is placed in one of four lanes, and the lanes are drained in priority order
+//  so that cue triggers and other urgent messages are not stuck behind a flood of meter data.
+//
+//  Messages are classified by their address: F53OSC control messages ("!" prefix) that reach the scheduler
+//  always use the control lane, registered addresses and address prefixes use their assigned lane, and
+//  everything else uses `defaultLane`. Order is kept within a lane, but not across lanes.
+//
+//  Bundles received through `takeBundleMessages:timeTag:` wait as a single item in the highest lane of any of their
+//  messages, and are passed on whole, with their time tag, if the destination implements that method too.
+//  Pending counts and `maxMessagesPerDrain` count such a bundle once; shed and delivered counts count its messages.
+//
+//  Messages are delivered asynchronously on `deliveryQueue` in slices of at most `maxMessagesPerDrain`,
+//  to `takeMessages:` if the destination implements it or else to `takeMessage:`. Lanes are chosen for
+//  every slice, so a message arriving in a higher lane overtakes lower-lane messages that are still pending.
+//  With `F53OSCPriorityDrainModeStrict`, a lower lane is served only while all higher lanes are empty.
+//  With `F53OSCPriorityDrainModeWeighted`, each non-empty lane is served up to its weight per round,
+//  so lower lanes keep moving under sustained high-priority traffic.
+//
+//  When `maxPendingCount` is reached, messages are shed from the lowest non-empty lane first:
+//  the oldest message in that lane is dropped to make room for a message of the same or higher priority,
+//  and a message for an even lower lane is dropped on arrival. Shed messages are passed to the destination's
+//  `didDropMessages:` if it implements it.
+//
+//  A scheduler has a single destination, which F53OSCServer and F53OSCClient point at their own delegate as they
+//  read, so each scheduler should be set on only one server or client.
+//
+//  Example usage:
+//  F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] init];
+//  [scheduler assignLane:F53OSCPriorityLaneHigh toAddressesWithPrefix:@"/cue/"];
+//  [scheduler assignLane:F53OSCPriorityLaneBulk toAddressesWithPrefix:@"/meter"];
+//  scheduler.maxPendingCount = 10000;
+//  server.priorityScheduler = scheduler;
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, F53OSCPriorityLane) {
+    F53OSCPriorityLaneControl = 0,
+    F53OSCPriorityLaneHigh,
+    F53OSCPriorityLaneNormal,
+    F53OSCPriorityLaneBulk,
+};
+
+FOUNDATION_EXPORT const NSUInteger F53OSCPriorityLaneCount;
+
+typedef NS_ENUM(NSUInteger, F53OSCPriorityDrainMode) {
+    F53OSCPriorityDrainModeStrict = 0,
+    F53OSCPriorityDrainModeWeighted,
+};
+
+@interface F53OSCPriorityScheduler : NSObject <F53OSCPacketDestination>
+
+- (instancetype) initWithDeliveryQueue:(dispatch_queue_t)queue;
+
+@property (nonatomic, weak, nullable)   id<F53OSCPacketDestination> destination;
+@property (nonatomic, strong)           dispatch_queue_t deliveryQueue;   // default main queue
+@property (assign)                      F53OSCPriorityDrainMode drainMode; // default F53OSCPriorityDrainModeStrict
+@property (assign)                      F53OSCPriorityLane defaultLane;    // default F53OSCPriorityLaneNormal
+@property (assign)                      NSUInteger maxMessagesPerDrain;    // default 64
+@property (assign)                      NSUInteger maxPendingCount;        // default 0 (no limit)
+@property (readonly)                    NSUInteger pendingCount;
+@property (readonly)                    NSUInteger shedCount;              // total over all lanes
+
+- (void) assignLane:(F53OSCPriorityLane)lane toAddress:(NSString *)address;
+- (void) assignLane:(F53OSCPriorityLane)lane toAddressesWithPrefix:(NSString *)prefix;
+- (void) removeAllLaneAssignments;
+
+- (F53OSCPriorityLane) laneForAddress:(NSString *)address;
+
+- (NSUInteger) weightForLane:(F53OSCPriorityLane)lane; // defaults 8, 4, 2, 1 from control to bulk
+- (void) setWeight:(NSUInteger)weight forLane:(F53OSCPriorityLane)lane;
+
+- (NSUInteger) pendingCountForLane:(F53OSCPriorityLane)lane;
+- (NSUInteger) shedCountForLane:(F53OSCPriorityLane)lane;
+- (NSUInteger) deliveredCountForLane:(F53OSCPriorityLane)lane;
+
+@end
+
+NS_ASSUME_NONNULL_END
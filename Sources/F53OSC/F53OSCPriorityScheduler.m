@@ -0,0 +1,505 @@
+//
+//  F53OSCPriorityScheduler.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCPriorityScheduler.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53_OSC_PRIORITY_LANE_COUNT 4
+
+const NSUInteger F53OSCPriorityLaneCount = F53_OSC_PRIORITY_LANE_COUNT;
+
+// A bundle waits in a lane as a single item so that it is delivered whole, with its time tag.
+@interface F53OSCPriorityBundle : NSObject
+@property (copy) NSArray<F53OSCMessage *> *messages;
+@property (strong) F53OSCTimeTag *timeTag;
+@end
+
+@implementation F53OSCPriorityBundle
+@end
+
+
+@interface F53OSCPriorityScheduler ()
+{
+    NSUInteger _weights[F53_OSC_PRIORITY_LANE_COUNT];
+    NSUInteger _credits[F53_OSC_PRIORITY_LANE_COUNT];      // messages the current weighted round may still take from each lane
+    NSUInteger _shedCounts[F53_OSC_PRIORITY_LANE_COUNT];
+    NSUInteger _deliveredCounts[F53_OSC_PRIORITY_LANE_COUNT];
+}
+
+@property (strong) NSArray<NSMutableArray *> *lanes;  // F53OSCMessage or F53OSCPriorityBundle items
+@property (strong) NSMutableDictionary<NSString *, NSNumber *> *addressLanes; // exact address -> lane
+@property (strong) NSMutableDictionary<NSString *, NSNumber *> *prefixLanes;  // address prefix -> lane
+@property (assign) NSUInteger totalPendingCount;
+@property (assign) NSUInteger weightedLane;  // lane currently being served by a weighted round
+@property (assign) BOOL drainScheduled;
+
+- (F53OSCPriorityLane) laneForMessage:(F53OSCMessage *)message;
+- (void) enqueueItem:(id)item inLane:(F53OSCPriorityLane)lane;
+- (NSArray<F53OSCMessage *> *) messagesInItem:(id)item;
+- (nullable id) dequeueItem;
+- (void) deliverMessages:(NSArray<F53OSCMessage *> *)messages;
+- (void) deliverItems:(NSArray *)items;
+- (void) drain;
+
+@end
+
+
+@implementation F53OSCPriorityScheduler
+
+- (instancetype) init
+{
+    return [self initWithDeliveryQueue:dispatch_get_main_queue()];
+}
+
+- (instancetype) initWithDeliveryQueue:(dispatch_queue_t)queue
+{
+    self = [super init];
+    if ( self )
+    {
+        NSMutableArray<NSMutableArray *> *lanes = [NSMutableArray arrayWithCapacity:F53_OSC_PRIORITY_LANE_COUNT];
+        for ( NSUInteger lane = 0; lane < F53_OSC_PRIORITY_LANE_COUNT; lane++ )
+        {
+            [lanes addObject:[NSMutableArray array]];
+            _weights[lane] = 1 << ( F53_OSC_PRIORITY_LANE_COUNT - 1 - lane ); // 8, 4, 2, 1
+            _credits[lane] = _weights[lane];
+            _shedCounts[lane] = 0;
+            _deliveredCounts[lane] = 0;
+        }
+        
+        self.destination = nil;
+        self.deliveryQueue = queue;
+        self.drainMode = F53OSCPriorityDrainModeStrict;
+        self.defaultLane = F53OSCPriorityLaneNormal;
+        self.maxMessagesPerDrain = 64;
+        self.maxPendingCount = 0;
+        self.lanes = [lanes copy];
+        self.addressLanes = [NSMutableDictionary dictionary];
+        self.prefixLanes = [NSMutableDictionary dictionary];
+        self.totalPendingCount = 0;
+        self.weightedLane = 0;
+        self.drainScheduled = NO;
+    }
+    return self;
+}
+
+- (NSUInteger) pendingCount
+{
+    @synchronized( self )
+    {
+        return self.totalPendingCount;
+    }
+}
+
+- (NSUInteger) shedCount
+{
+    @synchronized( self )
+    {
+        NSUInteger count = 0;
+        for ( NSUInteger lane = 0; lane < F53_OSC_PRIORITY_LANE_COUNT; lane++ )
+            count += _shedCounts[lane];
+        return count;
+    }
+}
+
+#pragma mark - lanes
+
+- (void) assignLane:(F53OSCPriorityLane)lane toAddress:(NSString *)address
+{
+    if ( lane >= F53_OSC_PRIORITY_LANE_COUNT )
+    {
+        NSLog( @"Error: F53OSCPriorityScheduler has no lane %lu.", (unsigned long)lane );
+        return;
+    }
+    
+    @synchronized( self )
+    {
+        self.addressLanes[address] = @(lane);
+    }
+}
+
+- (void) assignLane:(F53OSCPriorityLane)lane toAddressesWithPrefix:(NSString *)prefix
+{
+    if ( lane >= F53_OSC_PRIORITY_LANE_COUNT )
+    {
+        NSLog( @"Error: F53OSCPriorityScheduler has no lane %lu.", (unsigned long)lane );
+        return;
+    }
+    
+    if ( prefix.length == 0 )
+    {
+        NSLog( @"Error: F53OSCPriorityScheduler requires a non-empty address prefix." );
+        return;
+    }
+    
+    @synchronized( self )
+    {
+        self.prefixLanes[prefix] = @(lane);
+    }
+}
+
+- (void) removeAllLaneAssignments
+{
+    @synchronized( self )
+    {
+        [self.addressLanes removeAllObjects];
+        [self.prefixLanes removeAllObjects];
+    }
+}
+
+- (F53OSCPriorityLane) laneForAddress:(NSString *)address
+{
+    if ( [address hasPrefix:@"!"] )
+        return F53OSCPriorityLaneControl;
+    
+    @synchronized( self )
+    {
+        NSNumber *lane = self.addressLanes[address];
+        if ( lane )
+            return lane.unsignedIntegerValue;
+        
+        // The longest matching prefix wins, so "/cue/stop" can outrank the rest of "/cue/".
+        NSUInteger matchLength = 0;
+        for ( NSString *prefix in self.prefixLanes )
+        {
+            if ( prefix.length > matchLength && [address hasPrefix:prefix] )
+            {
+                lane = self.prefixLanes[prefix];
+                matchLength = prefix.length;
+            }
+        }
+        if ( lane )
+            return lane.unsignedIntegerValue;
+        
+        return self.defaultLane;
+    }
+}
+
+- (F53OSCPriorityLane) laneForMessage:(F53OSCMessage *)message
+{
+    return [self laneForAddress:message.addressPattern];
+}
+
+- (NSUInteger) weightForLane:(F53OSCPriorityLane)lane
+{
+    if ( lane >= F53_OSC_PRIORITY_LANE_COUNT )
+        return 0;
+    
+    @synchronized( self )
+    {
+        return _weights[lane];
+    }
+}
+
+- (void) setWeight:(NSUInteger)weight forLane:(F53OSCPriorityLane)lane
+{
+    if ( lane >= F53_OSC_PRIORITY_LANE_COUNT )
+    {
+        NSLog( @"Error: F53OSCPriorityScheduler has no lane %lu.", (unsigned long)lane );
+        return;
+    }
+    
+    if ( weight == 0 )
+    {
+        NSLog( @"Error: F53OSCPriorityScheduler lane weights must be at least 1." );
+        return;
+    }
+    
+    @synchronized( self )
+    {
+        _weights[lane] = weight;
+        _credits[lane] = MIN( _credits[lane], weight );
+    }
+}
+
+- (NSUInteger) pendingCountForLane:(F53OSCPriorityLane)lane
+{
+    if ( lane >= F53_OSC_PRIORITY_LANE_COUNT )
+        return 0;
+    
+    @synchronized( self )
+    {
+        return self.lanes[lane].count;
+    }
+}
+
+- (NSUInteger) shedCountForLane:(F53OSCPriorityLane)lane
+{
+    if ( lane >= F53_OSC_PRIORITY_LANE_COUNT )
+        return 0;
+    
+    @synchronized( self )
+    {
+        return _shedCounts[lane];
+    }
+}
+
+- (NSUInteger) deliveredCountForLane:(F53OSCPriorityLane)lane
+{
+    if ( lane >= F53_OSC_PRIORITY_LANE_COUNT )
+        return 0;
+    
+    @synchronized( self )
+    {
+        return _deliveredCounts[lane];
+    }
+}
+
+#pragma mark - F53OSCPacketDestination
+
+- (void) takeMessage:(nullable F53OSCMessage *)message
+{
+    if ( message == nil )
+        return;
+    
+    [self enqueueItem:(F53OSCMessage * _Nonnull)message inLane:[self laneForMessage:(F53OSCMessage * _Nonnull)message]];
+}
+
+// A bundle takes the highest lane of any of its messages, so an urgent message is never held back by the rest.
+- (void) takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    if ( messages.count == 0 )
+        return;
+    
+    F53OSCPriorityLane lane = F53_OSC_PRIORITY_LANE_COUNT - 1;
+    for ( F53OSCMessage *message in messages )
+        lane = MIN( lane, [self laneForMessage:message] );
+    
+    F53OSCPriorityBundle *bundle = [[F53OSCPriorityBundle alloc] init];
+    bundle.messages = messages;
+    bundle.timeTag = timeTag;
+    [self enqueueItem:bundle inLane:lane];
+}
+
+// Messages dropped before reaching the scheduler are reported on down the chain.
+- (void) didDropMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    id<F53OSCPacketDestination> destination = self.destination;
+    if ( [destination respondsToSelector:@selector(didDropMessages:)] )
+        [destination didDropMessages:messages];
+}
+
+- (BOOL) respondsToSelector:(SEL)aSelector
+{
+    // Bundles only take the whole-bundle path when the real destination asked for it.
+    if ( aSelector == @selector(takeBundleMessages:timeTag:) )
+        return [self.destination respondsToSelector:aSelector];
+    
+    return [super respondsToSelector:aSelector];
+}
+
+#pragma mark - queueing
+
+- (void) enqueueItem:(id)item inLane:(F53OSCPriorityLane)lane
+{
+    BOOL scheduleDrain = NO;
+    id shedItem = nil;
+    
+    @synchronized( self )
+    {
+        NSUInteger maxPendingCount = self.maxPendingCount;
+        if ( maxPendingCount > 0 && self.totalPendingCount >= maxPendingCount )
+        {
+            NSUInteger lowestLane = F53_OSC_PRIORITY_LANE_COUNT - 1;
+            while ( lowestLane > 0 && self.lanes[lowestLane].count == 0 )
+                lowestLane--;
+            
+            if ( lane > lowestLane )
+            {
+                _shedCounts[lane] += [self messagesInItem:item].count;
+                shedItem = item;
+            }
+            else
+            {
+                shedItem = self.lanes[lowestLane].firstObject;
+                [self.lanes[lowestLane] removeObjectAtIndex:0];
+                _shedCounts[lowestLane] += [self messagesInItem:shedItem].count;
+                self.totalPendingCount--;
+            }
+        }
+        
+        if ( shedItem != item )
+        {
+            [self.lanes[lane] addObject:item];
+            self.totalPendingCount++;
+            
+            if ( !self.drainScheduled )
+            {
+                self.drainScheduled = YES;
+                scheduleDrain = YES;
+            }
+        }
+    }
+    
+    if ( shedItem )
+    {
+        id<F53OSCPacketDestination> destination = self.destination;
+        if ( [destination respondsToSelector:@selector(didDropMessages:)] )
+            [destination didDropMessages:[self messagesInItem:shedItem]];
+    }
+    
+    if ( scheduleDrain )
+    {
+        dispatch_async( self.deliveryQueue, ^{
+            [self drain];
+        });
+    }
+}
+
+- (NSArray<F53OSCMessage *> *) messagesInItem:(id)item
+{
+    if ( [item isKindOfClass:[F53OSCPriorityBundle class]] )
+        return ((F53OSCPriorityBundle *)item).messages;
+    
+    return @[ (F53OSCMessage *)item ];
+}
+
+#pragma mark - draining
+
+// Must be called while synchronized.
+- (nullable id) dequeueItem
+{
+    if ( self.totalPendingCount == 0 )
+        return nil;
+    
+    NSUInteger lane = 0;
+    if ( self.drainMode == F53OSCPriorityDrainModeStrict )
+    {
+        while ( self.lanes[lane].count == 0 )
+            lane++;
+    }
+    else
+    {
+        // Deficit round robin: serve the current lane until it runs out of credit or messages, then move on.
+        // Credits are refilled at the start of each round, so every non-empty lane is served within two passes.
+        lane = self.weightedLane;
+        while ( self.lanes[lane].count == 0 || _credits[lane] == 0 )
+        {
+            lane = ( lane + 1 ) % F53_OSC_PRIORITY_LANE_COUNT;
+            if ( lane == 0 )
+            {
+                for ( NSUInteger i = 0; i < F53_OSC_PRIORITY_LANE_COUNT; i++ )
+                    _credits[i] = _weights[i];
+            }
+        }
+        _credits[lane]--;
+        self.weightedLane = lane;
+    }
+    
+    NSMutableArray *queue = self.lanes[lane];
+    id item = queue.firstObject;
+    [queue removeObjectAtIndex:0];
+    self.totalPendingCount--;
+    _deliveredCounts[lane] += [self messagesInItem:item].count;
+    return item;
+}
+
+- (void) deliverMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    if ( messages.count == 0 )
+        return;
+    
+    id<F53OSCPacketDestination> destination = self.destination;
+    if ( [destination respondsToSelector:@selector(takeMessages:)] )
+    {
+        [destination takeMessages:messages];
+    }
+    else
+    {
+        for ( F53OSCMessage *message in messages )
+            [destination takeMessage:message];
+    }
+}
+
+// Messages either side of a bundle go out in separate calls so the bundle keeps its place in the slice.
+- (void) deliverItems:(NSArray *)items
+{
+    id<F53OSCPacketDestination> destination = self.destination;
+    BOOL takesBundles = [destination respondsToSelector:@selector(takeBundleMessages:timeTag:)];
+    
+    NSMutableArray<F53OSCMessage *> *messages = [NSMutableArray arrayWithCapacity:items.count];
+    for ( id item in items )
+    {
+        if ( takesBundles && [item isKindOfClass:[F53OSCPriorityBundle class]] )
+        {
+            [self deliverMessages:messages];
+            messages = [NSMutableArray array];
+            
+            F53OSCPriorityBundle *bundle = item;
+            [destination takeBundleMessages:bundle.messages timeTag:bundle.timeTag];
+        }
+        else
+        {
+            [messages addObjectsFromArray:[self messagesInItem:item]];
+        }
+    }
+    [self deliverMessages:messages];
+}
+
+- (void) drain
+{
+    NSMutableArray *items;
+    BOOL scheduleDrain = NO;
+    
+    @synchronized( self )
+    {
+        NSUInteger limit = self.maxMessagesPerDrain;
+        if ( limit == 0 || limit > self.totalPendingCount )
+            limit = self.totalPendingCount;
+        
+        items = [NSMutableArray arrayWithCapacity:limit];
+        for ( NSUInteger i = 0; i < limit; i++ )
+        {
+            id item = [self dequeueItem];
+            if ( item == nil )
+                break;
+            [items addObject:item];
+        }
+        
+        // Leave the rest for another pass so that anything arriving in a higher lane meanwhile goes first.
+        scheduleDrain = ( self.totalPendingCount > 0 );
+        self.drainScheduled = scheduleDrain;
+    }
+    
+    if ( items.count > 0 )
+        [self deliverItems:items];
+    
+    if ( scheduleDrain )
+    {
+        dispatch_async( self.deliveryQueue, ^{
+            [self drain];
+        });
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
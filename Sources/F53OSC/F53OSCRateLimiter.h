@@ -0,0 +1,70 @@
+//
+//  F53OSCRateLimiter.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+//
+//  F53OSCRateLimiter applies per-peer token buckets to incoming traffic so that one misbehaving
+//  device cannot monopolize a server. Each peer has a packet bucket and a byte bucket that refill
+//  continuously at `packetsPerSecond` and `bytesPerSecond`, up to their burst sizes. A packet is
+//  admitted only if both buckets can pay for it; otherwise it is dropped and counted against the peer.
+//
+//  F53OSCServer consults its `rateLimiter` before any parsing, keyed by "host:port" of the UDP
+//  sender or TCP connection. For TCP this is a read-chunk limit rather than a message limit: each
+//  read from the connection is charged as one packet of its full length, however many SLIP frames
+//  it carries, and a rejected read is discarded through the end of the frame it stopped in.
+//
+//  At most `maxPeerCount` peers have buckets of their own. Once the table is full, peers idle for a
+//  while are forgotten, and further new peers share a single bucket, so that a flood of spoofed
+//  source addresses neither grows the table nor takes buckets from peers already in it. Drops from
+//  the shared bucket count toward the totals but not toward any peer.
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCRateLimiter : NSObject
+
+@property (assign) double packetsPerSecond; // default 0 (no packet limit)
+@property (assign) double packetBurst;      // default 0 (one second's worth of packetsPerSecond)
+@property (assign) double bytesPerSecond;   // default 0 (no byte limit)
+@property (assign) double byteBurst;        // default 0 (one second's worth of bytesPerSecond)
+@property (assign) NSUInteger maxPeerCount; // default 1024; beyond this, idle peers are forgotten and new peers share one bucket until there is room
+
+@property (readonly) NSUInteger totalDroppedPackets;
+@property (readonly) NSUInteger totalDroppedBytes;
+
+- (BOOL) admitPacketOfLength:(NSUInteger)length fromPeer:(NSString *)peer;
+- (BOOL) admitPacketOfLength:(NSUInteger)length fromPeer:(NSString *)peer atTime:(NSTimeInterval)now; // `now` is seconds on a monotonic clock
+
+- (NSDictionary<NSString *, NSNumber *> *) droppedPacketCountsByPeer;
+- (NSDictionary<NSString *, NSNumber *> *) droppedByteCountsByPeer;
+
+- (void) resetPeer:(NSString *)peer;
+- (void) reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,269 @@
+//
+//  F53OSCRateLimiter.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCRateLimiter.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53_OSC_RATE_LIMITER_IDLE_PEER_INTERVAL    10.0    // seconds without traffic before a peer may be forgotten
+#define F53_OSC_RATE_LIMITER_IDLE_SWEEP_INTERVAL    1.0     // seconds between searches of a full peer table for idle peers
+
+@interface F53OSCPeerBuckets : NSObject
+@property (assign) double packetTokens;
+@property (assign) double byteTokens;
+@property (assign) NSTimeInterval lastRefillTime;
+@property (assign) NSUInteger droppedPackets;
+@property (assign) NSUInteger droppedBytes;
+@end
+
+@implementation F53OSCPeerBuckets
+@end
+
+
+@interface F53OSCRateLimiter ()
+
+@property (strong) NSMutableDictionary<NSString *, F53OSCPeerBuckets *> *peers;
+@property (strong, nullable) F53OSCPeerBuckets *overflowBuckets; // shared by new peers while the table is full
+@property (assign) NSTimeInterval nextIdleSweepTime;
+@property (assign) NSUInteger droppedPacketsOfForgottenPeers;
+@property (assign) NSUInteger droppedBytesOfForgottenPeers;
+
+- (double) effectivePacketBurst;
+- (double) effectiveByteBurst;
+- (void) forgetIdlePeersAtTime:(NSTimeInterval)now;
+- (F53OSCPeerBuckets *) newBucketsAtTime:(NSTimeInterval)now;
+- (void) refillBuckets:(F53OSCPeerBuckets *)buckets atTime:(NSTimeInterval)now;
+
+@end
+
+
+@implementation F53OSCRateLimiter
+
+- (instancetype) init
+{
+    self = [super init];
+    if ( self )
+    {
+        self.packetsPerSecond = 0;  // no limit
+        self.packetBurst = 0;       // one second's worth
+        self.bytesPerSecond = 0;    // no limit
+        self.byteBurst = 0;         // one second's worth
+        self.maxPeerCount = 1024;
+        self.peers = [NSMutableDictionary dictionary];
+        self.overflowBuckets = nil;
+        self.nextIdleSweepTime = 0;
+        self.droppedPacketsOfForgottenPeers = 0;
+        self.droppedBytesOfForgottenPeers = 0;
+    }
+    return self;
+}
+
+- (NSString *) description
+{
+    return [NSString stringWithFormat:@"<F53OSCRateLimiter %.0f packets/s, %.0f bytes/s, %lu dropped>", self.packetsPerSecond, self.bytesPerSecond, (unsigned long)self.totalDroppedPackets];
+}
+
+- (double) effectivePacketBurst
+{
+    return ( self.packetBurst > 0 ? self.packetBurst : self.packetsPerSecond );
+}
+
+- (double) effectiveByteBurst
+{
+    return ( self.byteBurst > 0 ? self.byteBurst : self.bytesPerSecond );
+}
+
+- (BOOL) admitPacketOfLength:(NSUInteger)length fromPeer:(NSString *)peer
+{
+    return [self admitPacketOfLength:length fromPeer:peer atTime:[NSProcessInfo processInfo].systemUptime];
+}
+
+- (BOOL) admitPacketOfLength:(NSUInteger)length fromPeer:(NSString *)peer atTime:(NSTimeInterval)now
+{
+    double packetsPerSecond = self.packetsPerSecond;
+    double bytesPerSecond = self.bytesPerSecond;
+    if ( packetsPerSecond <= 0 && bytesPerSecond <= 0 )
+        return YES;
+    
+    @synchronized( self )
+    {
+        F53OSCPeerBuckets *buckets = self.peers[peer];
+        if ( !buckets && self.peers.count >= self.maxPeerCount && now >= self.nextIdleSweepTime )
+        {
+            // Searching the whole table is rationed, so a flood of new peers does not pay for it on every packet.
+            [self forgetIdlePeersAtTime:now];
+            self.nextIdleSweepTime = now + F53_OSC_RATE_LIMITER_IDLE_SWEEP_INTERVAL;
+        }
+        
+        if ( buckets )
+        {
+            [self refillBuckets:buckets atTime:now];
+        }
+        else if ( self.peers.count < self.maxPeerCount )
+        {
+            buckets = [self newBucketsAtTime:now];
+            self.peers[peer] = buckets;
+        }
+        else
+        {
+            // The table is full of active peers, e.g. during a flood from spoofed addresses. Any more share one bucket.
+            if ( self.overflowBuckets )
+                [self refillBuckets:(F53OSCPeerBuckets * _Nonnull)self.overflowBuckets atTime:now];
+            else
+                self.overflowBuckets = [self newBucketsAtTime:now];
+            buckets = (F53OSCPeerBuckets * _Nonnull)self.overflowBuckets;
+        }
+        
+        BOOL packetAdmitted = ( packetsPerSecond <= 0 || buckets.packetTokens >= 1.0 );
+        BOOL bytesAdmitted = ( bytesPerSecond <= 0 || buckets.byteTokens >= (double)length );
+        if ( packetAdmitted && bytesAdmitted )
+        {
+            if ( packetsPerSecond > 0 )
+                buckets.packetTokens -= 1.0;
+            if ( bytesPerSecond > 0 )
+                buckets.byteTokens -= (double)length;
+            return YES;
+        }
+        
+        buckets.droppedPackets++;
+        buckets.droppedBytes += length;
+        return NO;
+    }
+}
+
+// New peers start with full buckets.
+- (F53OSCPeerBuckets *) newBucketsAtTime:(NSTimeInterval)now
+{
+    F53OSCPeerBuckets *buckets = [[F53OSCPeerBuckets alloc] init];
+    buckets.packetTokens = [self effectivePacketBurst];
+    buckets.byteTokens = [self effectiveByteBurst];
+    buckets.lastRefillTime = now;
+    return buckets;
+}
+
+- (void) refillBuckets:(F53OSCPeerBuckets *)buckets atTime:(NSTimeInterval)now
+{
+    if ( now <= buckets.lastRefillTime )
+        return;
+    
+    NSTimeInterval elapsed = now - buckets.lastRefillTime;
+    buckets.packetTokens = MIN( [self effectivePacketBurst], buckets.packetTokens + elapsed * self.packetsPerSecond );
+    buckets.byteTokens = MIN( [self effectiveByteBurst], buckets.byteTokens + elapsed * self.bytesPerSecond );
+    buckets.lastRefillTime = now;
+}
+
+// Must be called while synchronized.
+- (void) forgetIdlePeersAtTime:(NSTimeInterval)now
+{
+    NSMutableArray<NSString *> *idlePeers = [NSMutableArray array];
+    [self.peers enumerateKeysAndObjectsUsingBlock:^(NSString *key, F53OSCPeerBuckets *buckets, BOOL *stop) {
+        if ( now - buckets.lastRefillTime >= F53_OSC_RATE_LIMITER_IDLE_PEER_INTERVAL )
+            [idlePeers addObject:key];
+    }];
+    
+    for ( NSString *key in idlePeers )
+    {
+        F53OSCPeerBuckets *buckets = self.peers[key];
+        self.droppedPacketsOfForgottenPeers += buckets.droppedPackets;
+        self.droppedBytesOfForgottenPeers += buckets.droppedBytes;
+        [self.peers removeObjectForKey:key];
+    }
+}
+
+- (NSUInteger) totalDroppedPackets
+{
+    @synchronized( self )
+    {
+        NSUInteger total = self.droppedPacketsOfForgottenPeers + self.overflowBuckets.droppedPackets;
+        for ( F53OSCPeerBuckets *buckets in self.peers.objectEnumerator )
+            total += buckets.droppedPackets;
+        return total;
+    }
+}
+
+- (NSUInteger) totalDroppedBytes
+{
+    @synchronized( self )
+    {
+        NSUInteger total = self.droppedBytesOfForgottenPeers + self.overflowBuckets.droppedBytes;
+        for ( F53OSCPeerBuckets *buckets in self.peers.objectEnumerator )
+            total += buckets.droppedBytes;
+        return total;
+    }
+}
+
+- (NSDictionary<NSString *, NSNumber *> *) droppedPacketCountsByPeer
+{
+    NSMutableDictionary<NSString *, NSNumber *> *counts = [NSMutableDictionary dictionary];
+    @synchronized( self )
+    {
+        [self.peers enumerateKeysAndObjectsUsingBlock:^(NSString *key, F53OSCPeerBuckets *buckets, BOOL *stop) {
+            counts[key] = @(buckets.droppedPackets);
+        }];
+    }
+    return [counts copy];
+}
+
+- (NSDictionary<NSString *, NSNumber *> *) droppedByteCountsByPeer
+{
+    NSMutableDictionary<NSString *, NSNumber *> *counts = [NSMutableDictionary dictionary];
+    @synchronized( self )
+    {
+        [self.peers enumerateKeysAndObjectsUsingBlock:^(NSString *key, F53OSCPeerBuckets *buckets, BOOL *stop) {
+            counts[key] = @(buckets.droppedBytes);
+        }];
+    }
+    return [counts copy];
+}
+
+- (void) resetPeer:(NSString *)peer
+{
+    @synchronized( self )
+    {
+        [self.peers removeObjectForKey:peer];
+    }
+}
+
+- (void) reset
+{
+    @synchronized( self )
+    {
+        [self.peers removeAllObjects];
+        self.overflowBuckets = nil;
+        self.nextIdleSweepTime = 0;
+        self.droppedPacketsOfForgottenPeers = 0;
+        self.droppedBytesOfForgottenPeers = 0;
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,90 @@
+//
+//  F53OSCReadFlowControl.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCMessage.h>
+#else
+#import "F53OSCMessage.h"
+#endif
+
+@class F53OSCSocket;
+
+//
+//  F53OSCReadFlowControl pauses TCP reads while a connection has too many received messages
+//  that have not yet reached the delegate, e.g. because they are waiting in a batcher,
+//  a conflation buffer or a priority scheduler behind a slow consumer.
+//
+//  A connection's outstanding count goes up when a parsed message enters the delivery chain
+//  and down when the message is handed to the delegate or dropped on the way (see `didDropMessages:`). Once a read leaves `highWaterMark` or more
+//  messages outstanding, the next read is not issued until the count falls to `lowWaterMark`.
+//  The socket buffers then fill and TCP's receive window pushes back on the sender,
+//  instead of undelivered messages piling up in memory.
+//
+//  F53OSCServer and F53OSCClient use the flow control set on their `readFlowControl` property,
+//  which may be shared between them.
+//  UDP traffic is never paused.
+//
+//  Example usage:
+//  F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+//  flowControl.highWaterMark = 5000;
+//  flowControl.lowWaterMark = 1000;
+//  server.readFlowControl = flowControl;
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCReadFlowControl : NSObject
+
+@property (assign)      NSUInteger highWaterMark;               // default 1024; 0 never pauses
+@property (assign)      NSUInteger lowWaterMark;                // default 256; reads resume at or below this, and below `highWaterMark`
+
+@property (readonly)    NSUInteger outstandingMessageCount;     // total over all connections
+@property (readonly)    NSUInteger peakOutstandingMessageCount;
+@property (readonly)    NSUInteger pausedConnectionCount;
+@property (readonly)    NSUInteger pauseCount;                  // number of times a connection's reads were paused
+@property (readonly)    NSTimeInterval totalPausedTime;         // summed over completed pauses
+
+- (NSUInteger) outstandingMessageCountForSocket:(F53OSCSocket *)socket;
+- (BOOL) isPausingReadsFromSocket:(F53OSCSocket *)socket;
+
+// Wrap the first and last destinations of an owner's delivery chain. Messages are counted by their `replySocket`.
+// Each owner, e.g. a server or client, gets taps of its own, which last as long as it does, so one flow control
+// can be shared by many servers and clients.
+- (id<F53OSCPacketDestination>) inletForOwner:(id)owner toDestination:(nullable id<F53OSCPacketDestination>)destination;
+- (id<F53OSCPacketDestination>) outletForOwner:(id)owner toDestination:(nullable id<F53OSCPacketDestination>)destination;
+
+// Call after each read is parsed. Returns YES if the next read should wait; `resumeHandler` is then called,
+// on whichever queue delivers the message that brings the count down, once the next read should be issued.
+- (BOOL) shouldPauseReadsFromSocket:(F53OSCSocket *)socket resumeHandler:(dispatch_block_t)resumeHandler;
+
+// Forgets a connection that has closed, discarding its resume handler. Messages from it still in flight are ignored.
+- (void) removeSocket:(F53OSCSocket *)socket;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,386 @@
+//
+//  F53OSCReadFlowControl.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCReadFlowControl.h"
+
+#import "F53OSCSocket.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Counts messages on their way through and passes them on unchanged.
+@interface F53OSCReadFlowControlTap : NSObject <F53OSCPacketDestination>
+@property (nonatomic, weak, nullable) id<F53OSCPacketDestination> destination;
+@property (nonatomic, weak, nullable) F53OSCReadFlowControl *flowControl;
+@property (nonatomic, assign) BOOL isInlet;
+@end
+
+
+// One connection's undelivered messages, and the read waiting for them to drain.
+@interface F53OSCReadFlowControlConnection : NSObject
+@property (assign) NSUInteger outstandingCount;
+@property (copy, nullable) dispatch_block_t resumeHandler;  // set while reads are paused
+@property (strong, nullable) NSDate *pausedAt;
+@end
+
+@implementation F53OSCReadFlowControlConnection
+@end
+
+
+@interface F53OSCReadFlowControl ()
+
+@property (strong) NSMapTable<F53OSCSocket *, F53OSCReadFlowControlConnection *> *connections; // weak socket -> state
+@property (assign) NSUInteger totalOutstandingCount;
+@property (assign) NSUInteger maxOutstandingCount;
+@property (assign) NSUInteger currentlyPausedCount;
+@property (assign) NSUInteger totalPauseCount;
+@property (assign) NSTimeInterval pausedTime;
+@property (strong) NSMapTable<id, F53OSCReadFlowControlTap *> *inlets;   // weak owner -> tap
+@property (strong) NSMapTable<id, F53OSCReadFlowControlTap *> *outlets;  // weak owner -> tap
+
+- (F53OSCReadFlowControlTap *) tapInTable:(NSMapTable<id, F53OSCReadFlowControlTap *> *)taps forOwner:(id)owner isInlet:(BOOL)isInlet;
+- (nullable F53OSCReadFlowControlConnection *) connectionForSocket:(F53OSCSocket *)socket create:(BOOL)create;
+- (void) messagesEntered:(NSArray<F53OSCMessage *> *)messages;
+- (void) messagesLeft:(NSArray<F53OSCMessage *> *)messages;
+
+@end
+
+
+
+@implementation F53OSCReadFlowControlTap
+
+- (BOOL) respondsToSelector:(SEL)aSelector
+{
+    // Optional batch methods are only offered when the destination can take them.
+    if ( aSelector == @selector(takeMessages:) || aSelector == @selector(takeBundleMessages:timeTag:) )
+        return [self.destination respondsToSelector:aSelector];
+    
+    // The outlet must hear about dropped messages to stop counting them, whether or not the destination cares.
+    if ( aSelector == @selector(didDropMessages:) )
+        return ( !self.isInlet || [self.destination respondsToSelector:aSelector] );
+    
+    return [super respondsToSelector:aSelector];
+}
+
+- (void) countMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    if ( self.isInlet )
+        [self.flowControl messagesEntered:messages];
+    else
+        [self.flowControl messagesLeft:messages];
+}
+
+- (void) takeMessage:(nullable F53OSCMessage *)message
+{
+    if ( message == nil )
+        return;
+    
+    // Count before handing on: a message may be delivered and leave the chain before the inlet returns.
+    if ( self.isInlet )
+        [self countMessages:@[ (F53OSCMessage * _Nonnull)message ]];
+    
+    [self.destination takeMessage:message];
+    
+    if ( !self.isInlet )
+        [self countMessages:@[ (F53OSCMessage * _Nonnull)message ]];
+}
+
+- (void) takeMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    if ( self.isInlet )
+        [self countMessages:messages];
+    
+    [self.destination takeMessages:messages];
+    
+    if ( !self.isInlet )
+        [self countMessages:messages];
+}
+
+- (void) takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    if ( self.isInlet )
+        [self countMessages:messages];
+    
+    [self.destination takeBundleMessages:messages timeTag:timeTag];
+    
+    if ( !self.isInlet )
+        [self countMessages:messages];
+}
+
+- (void) didDropMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    if ( !self.isInlet )
+        [self.flowControl messagesLeft:messages];
+    
+    id<F53OSCPacketDestination> destination = self.destination;
+    if ( [destination respondsToSelector:@selector(didDropMessages:)] )
+        [destination didDropMessages:messages];
+}
+
+@end
+
+
+@implementation F53OSCReadFlowControl
+
+- (instancetype) init
+{
+    self = [super init];
+    if ( self )
+    {
+        self.highWaterMark = 1024;
+        self.lowWaterMark = 256;
+        self.connections = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                 valueOptions:NSPointerFunctionsStrongMemory];
+        self.totalOutstandingCount = 0;
+        self.maxOutstandingCount = 0;
+        self.currentlyPausedCount = 0;
+        self.totalPauseCount = 0;
+        self.pausedTime = 0;
+        self.inlets = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                            valueOptions:NSPointerFunctionsStrongMemory];
+        self.outlets = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                             valueOptions:NSPointerFunctionsStrongMemory];
+    }
+    return self;
+}
+
+- (NSUInteger) outstandingMessageCount
+{
+    @synchronized( self )
+    {
+        return self.totalOutstandingCount;
+    }
+}
+
+- (NSUInteger) peakOutstandingMessageCount
+{
+    @synchronized( self )
+    {
+        return self.maxOutstandingCount;
+    }
+}
+
+- (NSUInteger) pausedConnectionCount
+{
+    @synchronized( self )
+    {
+        return self.currentlyPausedCount;
+    }
+}
+
+- (NSUInteger) pauseCount
+{
+    @synchronized( self )
+    {
+        return self.totalPauseCount;
+    }
+}
+
+- (NSTimeInterval) totalPausedTime
+{
+    @synchronized( self )
+    {
+        return self.pausedTime;
+    }
+}
+
+- (NSUInteger) outstandingMessageCountForSocket:(F53OSCSocket *)socket
+{
+    @synchronized( self )
+    {
+        return [self connectionForSocket:socket create:NO].outstandingCount;
+    }
+}
+
+- (BOOL) isPausingReadsFromSocket:(F53OSCSocket *)socket
+{
+    @synchronized( self )
+    {
+        return ( [self connectionForSocket:socket create:NO].resumeHandler != nil );
+    }
+}
+
+#pragma mark - delivery chain
+
+- (id<F53OSCPacketDestination>) inletForOwner:(id)owner toDestination:(nullable id<F53OSCPacketDestination>)destination
+{
+    @synchronized( self )
+    {
+        F53OSCReadFlowControlTap *inlet = [self tapInTable:self.inlets forOwner:owner isInlet:YES];
+        inlet.destination = destination;
+        return inlet;
+    }
+}
+
+- (id<F53OSCPacketDestination>) outletForOwner:(id)owner toDestination:(nullable id<F53OSCPacketDestination>)destination
+{
+    @synchronized( self )
+    {
+        F53OSCReadFlowControlTap *outlet = [self tapInTable:self.outlets forOwner:owner isInlet:NO];
+        outlet.destination = destination;
+        return outlet;
+    }
+}
+
+// Must be called while synchronized. Each owner has taps of its own, so that owners sharing the flow control
+// never redirect each other's messages.
+- (F53OSCReadFlowControlTap *) tapInTable:(NSMapTable<id, F53OSCReadFlowControlTap *> *)taps forOwner:(id)owner isInlet:(BOOL)isInlet
+{
+    F53OSCReadFlowControlTap *tap = [taps objectForKey:owner];
+    if ( tap == nil )
+    {
+        tap = [[F53OSCReadFlowControlTap alloc] init];
+        tap.flowControl = self;
+        tap.isInlet = isInlet;
+        [taps setObject:tap forKey:owner];
+    }
+    return tap;
+}
+
+// Must be called while synchronized.
+- (nullable F53OSCReadFlowControlConnection *) connectionForSocket:(F53OSCSocket *)socket create:(BOOL)create
+{
+    F53OSCReadFlowControlConnection *connection = [self.connections objectForKey:socket];
+    if ( connection == nil && create )
+    {
+        connection = [[F53OSCReadFlowControlConnection alloc] init];
+        [self.connections setObject:connection forKey:socket];
+    }
+    return connection;
+}
+
+- (void) messagesEntered:(NSArray<F53OSCMessage *> *)messages
+{
+    @synchronized( self )
+    {
+        for ( F53OSCMessage *message in messages )
+        {
+            F53OSCSocket *socket = message.replySocket;
+            if ( socket == nil || !socket.isTcpSocket )
+                continue;
+            
+            F53OSCReadFlowControlConnection *connection = [self connectionForSocket:(F53OSCSocket * _Nonnull)socket create:YES];
+            connection.outstandingCount++;
+            self.totalOutstandingCount++;
+        }
+        self.maxOutstandingCount = MAX( self.maxOutstandingCount, self.totalOutstandingCount );
+    }
+}
+
+- (void) messagesLeft:(NSArray<F53OSCMessage *> *)messages
+{
+    NSMutableArray<dispatch_block_t> *resumeHandlers = nil;
+    
+    @synchronized( self )
+    {
+        NSUInteger highWaterMark = self.highWaterMark;
+        NSUInteger lowWaterMark = ( highWaterMark > 0 ? MIN( self.lowWaterMark, highWaterMark - 1 ) : self.lowWaterMark );
+        
+        for ( F53OSCMessage *message in messages )
+        {
+            F53OSCSocket *socket = message.replySocket;
+            if ( socket == nil || !socket.isTcpSocket )
+                continue;
+            
+            // Connections that were removed while this message was in flight no longer count.
+            F53OSCReadFlowControlConnection *connection = [self connectionForSocket:(F53OSCSocket * _Nonnull)socket create:NO];
+            if ( connection.outstandingCount == 0 )
+                continue;
+            
+            connection.outstandingCount--;
+            self.totalOutstandingCount--;
+            
+            dispatch_block_t resumeHandler = connection.resumeHandler;
+            if ( resumeHandler && connection.outstandingCount <= lowWaterMark )
+            {
+                self.pausedTime += -[connection.pausedAt timeIntervalSinceNow];
+                self.currentlyPausedCount--;
+                connection.resumeHandler = nil;
+                connection.pausedAt = nil;
+                
+                if ( resumeHandlers == nil )
+                    resumeHandlers = [NSMutableArray array];
+                [resumeHandlers addObject:resumeHandler];
+            }
+        }
+    }
+    
+    // Issue reads outside the lock; they only enqueue work on each socket's own queue.
+    for ( dispatch_block_t resumeHandler in resumeHandlers )
+        resumeHandler();
+}
+
+#pragma mark - pausing
+
+- (BOOL) shouldPauseReadsFromSocket:(F53OSCSocket *)socket resumeHandler:(dispatch_block_t)resumeHandler
+{
+    @synchronized( self )
+    {
+        NSUInteger highWaterMark = self.highWaterMark;
+        if ( highWaterMark == 0 )
+            return NO;
+        
+        F53OSCReadFlowControlConnection *connection = [self connectionForSocket:socket create:NO];
+        if ( connection.outstandingCount < highWaterMark )
+            return NO;
+        
+        if ( connection.resumeHandler == nil )
+        {
+            self.currentlyPausedCount++;
+            self.totalPauseCount++;
+            connection.pausedAt = [NSDate date];
+        }
+        connection.resumeHandler = resumeHandler;
+        return YES;
+    }
+}
+
+- (void) removeSocket:(F53OSCSocket *)socket
+{
+    @synchronized( self )
+    {
+        F53OSCReadFlowControlConnection *connection = [self connectionForSocket:socket create:NO];
+        if ( connection == nil )
+            return;
+        
+        if ( connection.resumeHandler )
+        {
+            self.pausedTime += -[connection.pausedAt timeIntervalSinceNow];
+            self.currentlyPausedCount--;
+        }
+        
+        self.totalOutstandingCount -= connection.outstandingCount;
+        [self.connections removeObjectForKey:socket];
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
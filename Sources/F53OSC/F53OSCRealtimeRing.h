@@ -0,0 +1,155 @@
+//
+//  F53OSCRealtimeRing.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import <stdbool.h>
+#import <stdint.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCMessage.h>
+#else
+#import "F53OSCMessage.h"
+#endif
+
+//
+//  F53OSCRealtimeRing hands received OSC messages to a real-time thread, such as an audio render callback, as
+//  fixed-size C records. Producers decode messages into records and push them into a bounded ring; the consumer
+//  polls the ring with `F53OSCRealtimeRingPop()`, which takes no locks, makes no Objective-C calls, and never
+//  allocates. Each record carries a numeric ID for its address, its type tags, and its argument values inline,
+//  so the consumer never touches an F53OSCMessage.
+//
+//  Addresses are registered ahead of time with `registerAddress:`, which returns the ID records will carry.
+//  Messages to unregistered addresses are not pushed. Only int, float, string, blob, and the argument-free
+//  T, F, N, and I types are carried, up to F53OSC_REALTIME_MAX_ARGUMENTS arguments and
+//  F53OSC_REALTIME_INLINE_BYTES bytes of string and blob data per message.
+//
+//  There may be one producer or, with F53OSCRealtimeRingMultipleProducers, any number of them, e.g. several
+//  servers' queues; there must be only one consumer. When the ring is full, new records are dropped and counted.
+//
+//  Records can be pushed from F53OSCMessages (the ring is an F53OSCPacketDestination), from raw OSC packet
+//  bytes with `F53OSCRealtimeRingPushPacket()`, which allocates nothing either, or from an F53OSCServer whose
+//  `realtimeRing` is set, which decodes UDP packets straight into the ring without parsing them into objects.
+//
+//  Example usage:
+//  F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] init];
+//  uint32_t gainID = [ring registerAddress:@"/mixer/gain"];
+//  server.realtimeRing = ring;
+//  F53OSCRealtimeRingRef ringRef = ring.ringRef; // hand this to the audio thread; valid while `ring` exists
+//
+//  // on the audio thread
+//  F53OSCRealtimeRecord record;
+//  while ( F53OSCRealtimeRingPop( ringRef, &record ) )
+//  {
+//      if ( record.addressID == gainID && record.typeTags[0] == 'f' )
+//          gain = record.arguments[0].f;
+//  }
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53OSC_REALTIME_MAX_ARGUMENTS   8
+#define F53OSC_REALTIME_INLINE_BYTES    64
+
+typedef union
+{
+    int32_t i;      // 'i'
+    float   f;      // 'f'
+    struct
+    {
+        uint16_t offset;
+        uint16_t length;
+    } bytes;        // 's' (NUL-terminated; length excludes the NUL) and 'b', within the record's `inlineBytes`
+} F53OSCRealtimeValue;
+
+typedef struct
+{
+    uint32_t            addressID;
+    uint32_t            argumentCount;
+    uint64_t            timeTag;                // the enclosing bundle's OSC time tag, or 1 (immediately) for a message on its own
+    double              receivedTimestamp;      // see F53OSCPacket `receivedTimestamp`
+    char                typeTags[F53OSC_REALTIME_MAX_ARGUMENTS + 1]; // without the leading comma; NUL-terminated
+    F53OSCRealtimeValue arguments[F53OSC_REALTIME_MAX_ARGUMENTS];    // T, F, N, and I have no value
+    uint8_t             inlineBytes[F53OSC_REALTIME_INLINE_BYTES];
+} F53OSCRealtimeRecord;
+
+typedef struct F53OSCRealtimeRingState *F53OSCRealtimeRingRef;
+
+typedef NS_ENUM( NSInteger, F53OSCRealtimeRingProducerMode ) {
+    F53OSCRealtimeRingSingleProducer,       // pushes come from one thread or serial queue at a time
+    F53OSCRealtimeRingMultipleProducers,    // pushes may come from any number of threads at once
+};
+
+typedef NS_ENUM( NSInteger, F53OSCRealtimeRingPushResult ) {
+    F53OSCRealtimeRingPushed,               // every message in the packet was pushed
+    F53OSCRealtimeRingPushOverflowed,       // the ring filled up; messages that did not fit were dropped
+    F53OSCRealtimeRingPushSkipped,          // nothing was pushed: an address is unregistered, an argument can not be carried, or the packet is not an OSC message or bundle
+    F53OSCRealtimeRingPushMalformed,        // nothing was pushed: the packet is not valid OSC
+};
+
+// Real-time safe: no locks, allocation, or Objective-C. Only one thread may pop.
+FOUNDATION_EXPORT bool F53OSCRealtimeRingPop( F53OSCRealtimeRingRef ring, F53OSCRealtimeRecord *outRecord );
+
+// Allocation free. Returns false, counting an overflow, if the ring is full.
+FOUNDATION_EXPORT bool F53OSCRealtimeRingPush( F53OSCRealtimeRingRef ring, const F53OSCRealtimeRecord *record );
+
+// Allocation free. A packet, including all of a bundle's messages, is either pushed in full (up to overflow) or not at all.
+FOUNDATION_EXPORT F53OSCRealtimeRingPushResult F53OSCRealtimeRingPushPacket( F53OSCRealtimeRingRef ring, const void *bytes, size_t length, double receivedTimestamp );
+
+// Lock free. Returns 0 for an unregistered address.
+FOUNDATION_EXPORT uint32_t F53OSCRealtimeRingAddressID( F53OSCRealtimeRingRef ring, const char *address, size_t length );
+
+// Returns the string or blob bytes of argument `index`, or NULL if it is neither.
+FOUNDATION_EXPORT const void * _Nullable F53OSCRealtimeRecordBytes( const F53OSCRealtimeRecord *record, uint32_t index, uint32_t * _Nullable outLength );
+
+
+@interface F53OSCRealtimeRing : NSObject <F53OSCPacketDestination>
+
+- (instancetype) init; // 1024 records, multiple producers, 256 addresses
+- (instancetype) initWithCapacity:(NSUInteger)capacity producerMode:(F53OSCRealtimeRingProducerMode)producerMode maxAddressCount:(NSUInteger)maxAddressCount NS_DESIGNATED_INITIALIZER;
+
+@property (readonly) NSUInteger capacity;                   // rounded up to a power of two
+@property (readonly) F53OSCRealtimeRingProducerMode producerMode;
+@property (readonly) NSUInteger maxAddressCount;
+@property (readonly) F53OSCRealtimeRingRef ringRef;         // valid for the lifetime of the ring object
+
+// Registration is thread-safe and may happen while producers are pushing. Returns 0 once `maxAddressCount` addresses are registered.
+- (uint32_t) registerAddress:(NSString *)address;
+- (nullable NSString *) addressForID:(uint32_t)addressID;
+@property (readonly) NSUInteger addressCount;
+
+- (BOOL) pushMessage:(F53OSCMessage *)message; // NO if the address is unregistered, an argument can not be carried, or the ring is full
+
+@property (readonly) NSUInteger count;                      // records waiting; approximate while pushing or popping
+@property (readonly) NSUInteger pushedCount;
+@property (readonly) NSUInteger poppedCount;
+@property (readonly) NSUInteger overflowCount;              // records dropped because the ring was full
+@property (readonly) NSUInteger unregisteredCount;          // messages skipped for an unregistered address
+@property (readonly) NSUInteger unsupportedCount;           // messages skipped for arguments a record can not carry
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,592 @@
+//
+//  F53OSCRealtimeRing.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCRealtimeRing.h"
+
+#import "F53OSCParser.h"
+#import "F53OSCTimeTag.h"
+#import "F53OSCWire.h"
+
+#import <os/lock.h>
+#import <stdatomic.h>
+#import <stdlib.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53OSC_REALTIME_CACHE_LINE  64
+
+typedef struct
+{
+    _Atomic size_t          sequence;   // equals the slot's position when free, and position + 1 once its record is published
+    F53OSCRealtimeRecord    record;
+} F53OSCRealtimeSlot;
+
+// Entries are written once, under the registration lock, and published by storing their ID last, so lookups need no lock.
+typedef struct
+{
+    _Atomic uint32_t    addressID;      // 0 while the entry is empty
+    uint32_t            hash;
+    size_t              length;
+    char                *address;
+} F53OSCRealtimeAddressEntry;
+
+// Positions only ever increase; a slot's index is its position masked by the capacity. The producer and consumer
+// positions sit on separate cache lines so that pushing and popping do not contend for one.
+struct F53OSCRealtimeRingState
+{
+    F53OSCRealtimeSlot          *slots;
+    size_t                      mask;
+    bool                        multipleProducers;
+    
+    F53OSCRealtimeAddressEntry  *addresses;
+    size_t                      addressMask;
+    
+    _Alignas( F53OSC_REALTIME_CACHE_LINE ) _Atomic size_t enqueuePosition;
+    _Atomic uint64_t            pushedCount;
+    _Atomic uint64_t            overflowCount;
+    _Atomic uint64_t            unregisteredCount;
+    _Atomic uint64_t            unsupportedCount;
+    
+    _Alignas( F53OSC_REALTIME_CACHE_LINE ) _Atomic size_t dequeuePosition;
+    _Atomic uint64_t            poppedCount;
+};
+
+typedef NS_ENUM( NSInteger, F53OSCRealtimeDecodeStatus ) {
+    F53OSCRealtimeDecoded,
+    F53OSCRealtimeUnregistered,
+    F53OSCRealtimeUnsupported,
+    F53OSCRealtimeMalformed,
+};
+
+#pragma mark - Ring
+
+bool F53OSCRealtimeRingPop( F53OSCRealtimeRingRef ring, F53OSCRealtimeRecord *outRecord )
+{
+    size_t position = atomic_load_explicit( &ring->dequeuePosition, memory_order_relaxed );
+    F53OSCRealtimeSlot *slot = &ring->slots[position & ring->mask];
+    if ( atomic_load_explicit( &slot->sequence, memory_order_acquire ) != position + 1 )
+        return false; // empty, or the producer that claimed this slot has not finished writing it
+    
+    memcpy( outRecord, &slot->record, sizeof( F53OSCRealtimeRecord ) );
+    
+    // Frees the slot for the producer one lap ahead.
+    atomic_store_explicit( &slot->sequence, position + ring->mask + 1, memory_order_release );
+    atomic_store_explicit( &ring->dequeuePosition, position + 1, memory_order_relaxed );
+    atomic_fetch_add_explicit( &ring->poppedCount, 1, memory_order_relaxed );
+    return true;
+}
+
+bool F53OSCRealtimeRingPush( F53OSCRealtimeRingRef ring, const F53OSCRealtimeRecord *record )
+{
+    F53OSCRealtimeSlot *slot;
+    size_t position = atomic_load_explicit( &ring->enqueuePosition, memory_order_relaxed );
+    for ( ;; )
+    {
+        slot = &ring->slots[position & ring->mask];
+        size_t sequence = atomic_load_explicit( &slot->sequence, memory_order_acquire );
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if ( difference == 0 )
+        {
+            // The slot is free; claim it. Competing producers race for the position with a compare-and-swap.
+            if ( !ring->multipleProducers )
+            {
+                atomic_store_explicit( &ring->enqueuePosition, position + 1, memory_order_relaxed );
+                break;
+            }
+            if ( atomic_compare_exchange_weak_explicit( &ring->enqueuePosition, &position, position + 1, memory_order_relaxed, memory_order_relaxed ) )
+                break;
+        }
+        else if ( difference < 0 )
+        {
+            // The slot still holds the record from one lap ago, so the ring is full.
+            atomic_fetch_add_explicit( &ring->overflowCount, 1, memory_order_relaxed );
+            return false;
+        }
+        else
+        {
+            position = atomic_load_explicit( &ring->enqueuePosition, memory_order_relaxed );
+        }
+    }
+    
+    memcpy( &slot->record, record, sizeof( F53OSCRealtimeRecord ) );
+    atomic_store_explicit( &slot->sequence, position + 1, memory_order_release );
+    atomic_fetch_add_explicit( &ring->pushedCount, 1, memory_order_relaxed );
+    return true;
+}
+
+#pragma mark - Addresses
+
+static uint32_t F53OSCRealtimeHash( const char *bytes, size_t length )
+{
+    uint32_t hash = 2166136261u; // FNV-1a
+    for ( size_t i = 0; i < length; i++ )
+    {
+        hash ^= (uint8_t)bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t F53OSCRealtimeRingAddressID( F53OSCRealtimeRingRef ring, const char *address, size_t length )
+{
+    uint32_t hash = F53OSCRealtimeHash( address, length );
+    for ( size_t index = hash & ring->addressMask; ; index = ( index + 1 ) & ring->addressMask )
+    {
+        F53OSCRealtimeAddressEntry *entry = &ring->addresses[index];
+        uint32_t addressID = atomic_load_explicit( &entry->addressID, memory_order_acquire );
+        if ( addressID == 0 )
+            return 0; // the table is never full, so an unregistered address always reaches an empty entry
+        if ( entry->hash == hash && entry->length == length && memcmp( entry->address, address, length ) == 0 )
+            return addressID;
+    }
+}
+
+const void * _Nullable F53OSCRealtimeRecordBytes( const F53OSCRealtimeRecord *record, uint32_t index, uint32_t * _Nullable outLength )
+{
+    if ( index >= record->argumentCount || ( record->typeTags[index] != 's' && record->typeTags[index] != 'b' ) )
+        return NULL;
+    
+    if ( outLength )
+        *outLength = record->arguments[index].bytes.length;
+    return &record->inlineBytes[record->arguments[index].bytes.offset];
+}
+
+#pragma mark - Decoding
+
+static bool F53OSCRealtimeCopyBytes( F53OSCRealtimeRecord *record, size_t *used, uint32_t index, const void *bytes, size_t length, bool terminate )
+{
+    size_t needed = length + ( terminate ? 1 : 0 );
+    if ( *used + needed > F53OSC_REALTIME_INLINE_BYTES )
+        return false;
+    
+    memcpy( &record->inlineBytes[*used], bytes, length );
+    if ( terminate )
+        record->inlineBytes[*used + length] = '\0';
+    record->arguments[index].bytes.offset = (uint16_t)*used;
+    record->arguments[index].bytes.length = (uint16_t)length;
+    *used += needed;
+    return true;
+}
+
+static F53OSCRealtimeDecodeStatus F53OSCRealtimeDecodeMessage( F53OSCRealtimeRingRef ring, const uint8_t *bytes, size_t length, F53OSCRealtimeRecord *record )
+{
+    F53OSCWireMessage message;
+    if ( !F53OSCWireReadMessage( bytes, length, &message ) )
+        return F53OSCRealtimeMalformed;
+    
+    record->addressID = F53OSCRealtimeRingAddressID( ring, message.address, message.addressLength );
+    if ( record->addressID == 0 )
+        return F53OSCRealtimeUnregistered;
+    
+    if ( message.argumentCount > F53OSC_REALTIME_MAX_ARGUMENTS )
+        return F53OSCRealtimeUnsupported;
+    
+    size_t used = 0;
+    uint32_t index = 0;
+    F53OSCWireArgument argument;
+    F53OSCWireArgumentStatus status;
+    while ( ( status = F53OSCWireMessageNextArgument( &message, &argument ) ) == F53OSCWireArgumentRead )
+    {
+        record->typeTags[index] = argument.type;
+        switch ( argument.type )
+        {
+            case 'i':
+                record->arguments[index].i = argument.value.i;
+                break;
+            case 'f':
+                record->arguments[index].f = argument.value.f;
+                break;
+            case 's':
+            case 'b':
+                if ( !F53OSCRealtimeCopyBytes( record, &used, index, argument.value.data.bytes, argument.value.data.length, ( argument.type == 's' ) ) )
+                    return F53OSCRealtimeUnsupported;
+                break;
+            default:
+                break; // T, F, N, and I have no data
+        }
+        index++;
+    }
+    
+    if ( status == F53OSCWireArgumentTruncated )
+        return F53OSCRealtimeMalformed;
+    if ( status == F53OSCWireArgumentUnknownType )
+        return F53OSCRealtimeUnsupported;
+    
+    record->argumentCount = index;
+    record->typeTags[index] = '\0';
+    return F53OSCRealtimeDecoded;
+}
+
+// Walks a message or bundle. The first pass checks that every message can be decoded, without pushing, so that
+// a packet is either pushed in full or left entirely to the caller.
+static F53OSCRealtimeDecodeStatus F53OSCRealtimeWalkPacket( F53OSCRealtimeRingRef ring, const uint8_t *bytes, size_t length, uint64_t timeTag, double receivedTimestamp,
+                                                           bool push, NSUInteger depth, bool *overflowed )
+{
+    if ( length == 0 )
+        return F53OSCRealtimeMalformed;
+    
+    if ( bytes[0] == '/' )
+    {
+        F53OSCRealtimeRecord record;
+        F53OSCRealtimeDecodeStatus status = F53OSCRealtimeDecodeMessage( ring, bytes, length, &record );
+        if ( status == F53OSCRealtimeDecoded && push )
+        {
+            record.timeTag = timeTag;
+            record.receivedTimestamp = receivedTimestamp;
+            if ( !F53OSCRealtimeRingPush( ring, &record ) )
+                *overflowed = true;
+        }
+        return status;
+    }
+    
+    if ( bytes[0] != '#' )
+        return F53OSCRealtimeUnsupported; // e.g. encrypted or F53OSC control data
+    
+    F53OSCWireBundle bundle;
+    if ( depth >= F53OSCParserMaxBundleDepth || !F53OSCWireReadBundle( bytes, length, &bundle ) )
+        return F53OSCRealtimeMalformed;
+    
+    const void *element;
+    size_t elementLength;
+    F53OSCWireElementStatus elementStatus;
+    while ( ( elementStatus = F53OSCWireBundleNextElement( &bundle, &element, &elementLength ) ) == F53OSCWireElementRead )
+    {
+        F53OSCRealtimeDecodeStatus status = F53OSCRealtimeWalkPacket( ring, element, elementLength, bundle.timeTag, receivedTimestamp, push, depth + 1, overflowed );
+        if ( status != F53OSCRealtimeDecoded )
+            return status;
+    }
+    return ( elementStatus == F53OSCWireElementsEnd ? F53OSCRealtimeDecoded : F53OSCRealtimeMalformed );
+}
+
+F53OSCRealtimeRingPushResult F53OSCRealtimeRingPushPacket( F53OSCRealtimeRingRef ring, const void *bytes, size_t length, double receivedTimestamp )
+{
+    bool overflowed = false;
+    F53OSCRealtimeDecodeStatus status = F53OSCRealtimeWalkPacket( ring, bytes, length, F53OSC_WIRE_IMMEDIATELY, receivedTimestamp, false, 0, &overflowed );
+    switch ( status )
+    {
+        case F53OSCRealtimeDecoded:
+            break;
+        case F53OSCRealtimeUnregistered:
+            atomic_fetch_add_explicit( &ring->unregisteredCount, 1, memory_order_relaxed );
+            return F53OSCRealtimeRingPushSkipped;
+        case F53OSCRealtimeUnsupported:
+            atomic_fetch_add_explicit( &ring->unsupportedCount, 1, memory_order_relaxed );
+            return F53OSCRealtimeRingPushSkipped;
+        case F53OSCRealtimeMalformed:
+            return F53OSCRealtimeRingPushMalformed;
+    }
+    
+    F53OSCRealtimeWalkPacket( ring, bytes, length, F53OSC_WIRE_IMMEDIATELY, receivedTimestamp, true, 0, &overflowed );
+    return ( overflowed ? F53OSCRealtimeRingPushOverflowed : F53OSCRealtimeRingPushed );
+}
+
+
+#pragma mark - F53OSCRealtimeRing
+
+@interface F53OSCRealtimeRing ()
+{
+    F53OSCRealtimeRingRef _ring;
+    os_unfair_lock _registrationLock;
+}
+
+@property (strong) NSMutableArray<NSString *> *registeredAddresses; // index is ID - 1; guarded by the registration lock
+
+- (BOOL) pushMessage:(F53OSCMessage *)message timeTag:(uint64_t)timeTag;
+
+@end
+
+
+@implementation F53OSCRealtimeRing
+
+- (instancetype) init
+{
+    return [self initWithCapacity:1024 producerMode:F53OSCRealtimeRingMultipleProducers maxAddressCount:256];
+}
+
+- (instancetype) initWithCapacity:(NSUInteger)capacity producerMode:(F53OSCRealtimeRingProducerMode)producerMode maxAddressCount:(NSUInteger)maxAddressCount
+{
+    self = [super init];
+    if ( self )
+    {
+        size_t slotCount = 2;
+        while ( slotCount < capacity )
+            slotCount <<= 1;
+        
+        // Twice as many entries as addresses keeps probes short and guarantees an empty entry to stop at.
+        maxAddressCount = MAX( maxAddressCount, (NSUInteger)1 );
+        size_t addressSlotCount = 2;
+        while ( addressSlotCount < 2 * maxAddressCount )
+            addressSlotCount <<= 1;
+        
+        void *state = NULL;
+        if ( posix_memalign( &state, F53OSC_REALTIME_CACHE_LINE, sizeof( struct F53OSCRealtimeRingState ) ) != 0 )
+            return nil;
+        _ring = state;
+        memset( _ring, 0, sizeof( struct F53OSCRealtimeRingState ) );
+        _ring->slots = calloc( slotCount, sizeof( F53OSCRealtimeSlot ) );
+        _ring->addresses = calloc( addressSlotCount, sizeof( F53OSCRealtimeAddressEntry ) );
+        if ( _ring->slots == NULL || _ring->addresses == NULL )
+        {
+            free( _ring->slots );
+            free( _ring->addresses );
+            free( _ring );
+            _ring = NULL;
+            return nil;
+        }
+        
+        _ring->mask = slotCount - 1;
+        _ring->multipleProducers = ( producerMode == F53OSCRealtimeRingMultipleProducers );
+        _ring->addressMask = addressSlotCount - 1;
+        for ( size_t i = 0; i < slotCount; i++ )
+            atomic_init( &_ring->slots[i].sequence, i );
+        
+        _capacity = slotCount;
+        _producerMode = producerMode;
+        _maxAddressCount = maxAddressCount;
+        _registrationLock = OS_UNFAIR_LOCK_INIT;
+        self.registeredAddresses = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    if ( _ring == NULL )
+        return;
+    
+    for ( size_t i = 0; i <= _ring->addressMask; i++ )
+        free( _ring->addresses[i].address );
+    free( _ring->addresses );
+    free( _ring->slots );
+    free( _ring );
+}
+
+- (F53OSCRealtimeRingRef) ringRef
+{
+    return _ring;
+}
+
+- (NSUInteger) count
+{
+    size_t enqueued = atomic_load_explicit( &_ring->enqueuePosition, memory_order_relaxed );
+    size_t dequeued = atomic_load_explicit( &_ring->dequeuePosition, memory_order_relaxed );
+    return ( enqueued > dequeued ? MIN( enqueued - dequeued, self.capacity ) : 0 );
+}
+
+- (NSUInteger) pushedCount
+{
+    return (NSUInteger)atomic_load_explicit( &_ring->pushedCount, memory_order_relaxed );
+}
+
+- (NSUInteger) poppedCount
+{
+    return (NSUInteger)atomic_load_explicit( &_ring->poppedCount, memory_order_relaxed );
+}
+
+- (NSUInteger) overflowCount
+{
+    return (NSUInteger)atomic_load_explicit( &_ring->overflowCount, memory_order_relaxed );
+}
+
+- (NSUInteger) unregisteredCount
+{
+    return (NSUInteger)atomic_load_explicit( &_ring->unregisteredCount, memory_order_relaxed );
+}
+
+- (NSUInteger) unsupportedCount
+{
+    return (NSUInteger)atomic_load_explicit( &_ring->unsupportedCount, memory_order_relaxed );
+}
+
+#pragma mark - Addresses
+
+- (uint32_t) registerAddress:(NSString *)address
+{
+    const char *bytes = address.UTF8String;
+    if ( bytes == NULL )
+        return 0;
+    
+    size_t length = strlen( bytes );
+    uint32_t hash = F53OSCRealtimeHash( bytes, length );
+    uint32_t addressID = 0;
+    
+    os_unfair_lock_lock( &_registrationLock );
+    
+    for ( size_t index = hash & _ring->addressMask; ; index = ( index + 1 ) & _ring->addressMask )
+    {
+        F53OSCRealtimeAddressEntry *entry = &_ring->addresses[index];
+        uint32_t existingID = atomic_load_explicit( &entry->addressID, memory_order_relaxed );
+        if ( existingID && entry->hash == hash && entry->length == length && memcmp( entry->address, bytes, length ) == 0 )
+        {
+            addressID = existingID;
+            break;
+        }
+        
+        if ( existingID == 0 )
+        {
+            if ( self.registeredAddresses.count >= self.maxAddressCount )
+                break;
+            
+            char *copy = malloc( length + 1 );
+            if ( copy == NULL )
+                break;
+            memcpy( copy, bytes, length + 1 );
+            
+            entry->hash = hash;
+            entry->length = length;
+            entry->address = copy;
+            [self.registeredAddresses addObject:[address copy]];
+            addressID = (uint32_t)self.registeredAddresses.count;
+            atomic_store_explicit( &entry->addressID, addressID, memory_order_release ); // publishes the entry to lookups
+            break;
+        }
+    }
+    
+    os_unfair_lock_unlock( &_registrationLock );
+    
+    if ( addressID == 0 )
+        NSLog( @"Warning: %@ unable to register %@; %lu addresses are already registered.", self, address, (unsigned long)self.maxAddressCount );
+    return addressID;
+}
+
+- (nullable NSString *) addressForID:(uint32_t)addressID
+{
+    NSString *address = nil;
+    os_unfair_lock_lock( &_registrationLock );
+    if ( addressID > 0 && addressID <= self.registeredAddresses.count )
+        address = self.registeredAddresses[addressID - 1];
+    os_unfair_lock_unlock( &_registrationLock );
+    return address;
+}
+
+- (NSUInteger) addressCount
+{
+    os_unfair_lock_lock( &_registrationLock );
+    NSUInteger addressCount = self.registeredAddresses.count;
+    os_unfair_lock_unlock( &_registrationLock );
+    return addressCount;
+}
+
+#pragma mark - Pushing
+
+- (BOOL) pushMessage:(F53OSCMessage *)message
+{
+    return [self pushMessage:message timeTag:F53OSC_WIRE_IMMEDIATELY];
+}
+
+- (BOOL) pushMessage:(F53OSCMessage *)message timeTag:(uint64_t)timeTag
+{
+    const char *address = message.addressPattern.UTF8String;
+    F53OSCRealtimeRecord record;
+    record.addressID = ( address ? F53OSCRealtimeRingAddressID( _ring, address, strlen( address ) ) : 0 );
+    if ( record.addressID == 0 )
+    {
+        atomic_fetch_add_explicit( &_ring->unregisteredCount, 1, memory_order_relaxed );
+        return NO;
+    }
+    
+    NSArray *arguments = message.arguments;
+    NSString *typeTags = message.typeTagString; // leading comma, then one tag per argument
+    if ( arguments.count > F53OSC_REALTIME_MAX_ARGUMENTS || typeTags.length != arguments.count + 1 )
+    {
+        atomic_fetch_add_explicit( &_ring->unsupportedCount, 1, memory_order_relaxed );
+        return NO;
+    }
+    
+    size_t used = 0;
+    BOOL supported = YES;
+    for ( uint32_t index = 0; index < arguments.count && supported; index++ )
+    {
+        char type = (char)[typeTags characterAtIndex:index + 1];
+        id argument = arguments[index];
+        record.typeTags[index] = type;
+        switch ( type )
+        {
+            case 'i':
+                record.arguments[index].i = [argument intValue];
+                break;
+            case 'f':
+                record.arguments[index].f = [argument floatValue];
+                break;
+            case 's':
+            {
+                const char *string = [argument UTF8String];
+                supported = ( string && F53OSCRealtimeCopyBytes( &record, &used, index, string, strlen( string ), true ) );
+                break;
+            }
+            case 'b':
+            {
+                NSData *blob = argument;
+                supported = F53OSCRealtimeCopyBytes( &record, &used, index, blob.bytes, blob.length, false );
+                break;
+            }
+            case 'T':
+            case 'F':
+            case 'N':
+            case 'I':
+                break;
+            default:
+                supported = NO;
+                break;
+        }
+    }
+    
+    if ( !supported )
+    {
+        atomic_fetch_add_explicit( &_ring->unsupportedCount, 1, memory_order_relaxed );
+        return NO;
+    }
+    
+    record.argumentCount = (uint32_t)arguments.count;
+    record.typeTags[arguments.count] = '\0';
+    record.timeTag = timeTag;
+    record.receivedTimestamp = message.receivedTimestamp;
+    return F53OSCRealtimeRingPush( _ring, &record );
+}
+
+#pragma mark - F53OSCPacketDestination
+
+- (void) takeMessage:(nullable F53OSCMessage *)message
+{
+    if ( message )
+        [self pushMessage:(F53OSCMessage * _Nonnull)message];
+}
+
+- (void) takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    uint64_t bundleTimeTag = ( (uint64_t)timeTag.seconds << 32 ) | timeTag.fraction;
+    for ( F53OSCMessage *message in messages )
+        [self pushMessage:message timeTag:bundleTimeTag];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,72 @@
+//
+//  F53OSCReceiveBufferPool.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+//
+//  F53OSCReceiveBufferPool hands out fixed-size receive buffers carved from larger slabs, and takes them back
+//  once the data that wraps them is deallocated, so a steady stream of datagrams reuses the same memory instead
+//  of allocating and freeing a buffer for each one. Slabs are allocated as needed, up to `maxBufferCount`
+//  buffers in all, and are kept until the pool and every buffer taken from it have gone away.
+//
+//  Buffers are wrapped with `dataWithBuffer:length:`. Anything parsed from that data which still refers to its
+//  bytes keeps the buffer out of the pool, so a pool that runs dry means consumers are holding on to data;
+//  `takeBuffer` then returns NULL and the caller should fall back to a buffer of its own.
+//
+//  Taking and returning buffers is thread-safe and never allocates once the slabs exist.
+//
+//  Example usage:
+//  F53OSCReceiveBufferPool *pool = [[F53OSCReceiveBufferPool alloc] initWithBufferSize:65535 buffersPerSlab:8 maxBufferCount:32];
+//  void *buffer = [pool takeBuffer];
+//  ssize_t length = recv( fd, buffer, pool.bufferSize, 0 );
+//  NSData *data = [pool dataWithBuffer:buffer length:length]; // the buffer goes back to the pool when `data` is deallocated
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCReceiveBufferPool : NSObject
+
+- (instancetype) init NS_UNAVAILABLE;
+- (instancetype) initWithBufferSize:(NSUInteger)bufferSize buffersPerSlab:(NSUInteger)buffersPerSlab maxBufferCount:(NSUInteger)maxBufferCount NS_DESIGNATED_INITIALIZER;
+
+@property (readonly) NSUInteger bufferSize;
+@property (readonly) NSUInteger buffersPerSlab;
+@property (readonly) NSUInteger maxBufferCount;
+
+@property (readonly) NSUInteger slabCount;          // slabs allocated so far; each is one malloc
+@property (readonly) NSUInteger buffersInUse;
+@property (readonly) NSUInteger takeCount;          // buffers handed out
+@property (readonly) NSUInteger exhaustedCount;     // calls to `takeBuffer` that found no free buffer
+
+- (nullable void *) takeBuffer;
+- (void) returnBuffer:(void *)buffer; // only for buffers that were never wrapped
+
+// Wraps a buffer taken from this pool without copying it; the buffer returns to the pool when the data is deallocated.
+- (NSData *) dataWithBuffer:(void *)buffer length:(NSUInteger)length;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,222 @@
+//
+//  F53OSCReceiveBufferPool.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCReceiveBufferPool.h"
+
+#import <os/lock.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+// The pool's state lives in a plain struct so that it can outlive the pool object while wrapped buffers are
+// still out. It holds one reference for the pool object and one for each buffer in use, and is freed by
+// whichever lets go last.
+typedef struct
+{
+    os_unfair_lock lock;
+    size_t bufferSize;
+    NSUInteger buffersPerSlab;
+    NSUInteger maxSlabCount;
+    NSUInteger slabCount;
+    UInt8 **slabs;
+    void **freeBuffers;
+    NSUInteger freeCount;
+    NSUInteger references;
+    NSUInteger takeCount;
+    NSUInteger exhaustedCount;
+} F53OSCReceiveBufferPoolState;
+
+static void F53OSCReceiveBufferPoolStateFree( F53OSCReceiveBufferPoolState *state )
+{
+    for ( NSUInteger i = 0; i < state->slabCount; i++ )
+        free( state->slabs[i] );
+    free( state->slabs );
+    free( state->freeBuffers );
+    free( state );
+}
+
+// Must be called with the lock held. Returns YES if this was the last reference.
+static BOOL F53OSCReceiveBufferPoolStateRelease( F53OSCReceiveBufferPoolState *state )
+{
+    state->references--;
+    return ( state->references == 0 );
+}
+
+static void F53OSCReceiveBufferPoolStateReturnBuffer( F53OSCReceiveBufferPoolState *state, void *buffer )
+{
+    os_unfair_lock_lock( &state->lock );
+    state->freeBuffers[state->freeCount] = buffer;
+    state->freeCount++;
+    BOOL last = F53OSCReceiveBufferPoolStateRelease( state );
+    os_unfair_lock_unlock( &state->lock );
+    
+    if ( last )
+        F53OSCReceiveBufferPoolStateFree( state );
+}
+
+
+@interface F53OSCReceiveBufferPool ()
+{
+    F53OSCReceiveBufferPoolState *_state;
+}
+
+@property (strong) void (^deallocator)( void *bytes, NSUInteger length ); // created once, shared by every wrapped buffer
+
+@end
+
+
+@implementation F53OSCReceiveBufferPool
+
+- (instancetype) initWithBufferSize:(NSUInteger)bufferSize buffersPerSlab:(NSUInteger)buffersPerSlab maxBufferCount:(NSUInteger)maxBufferCount
+{
+    self = [super init];
+    if ( self )
+    {
+        bufferSize = MAX( bufferSize, (NSUInteger)1 );
+        buffersPerSlab = MAX( buffersPerSlab, (NSUInteger)1 );
+        NSUInteger maxSlabCount = MAX( ( maxBufferCount + buffersPerSlab - 1 ) / buffersPerSlab, (NSUInteger)1 );
+        
+        _bufferSize = bufferSize;
+        _buffersPerSlab = buffersPerSlab;
+        _maxBufferCount = maxSlabCount * buffersPerSlab;
+        
+        F53OSCReceiveBufferPoolState *state = calloc( 1, sizeof( F53OSCReceiveBufferPoolState ) );
+        state->lock = OS_UNFAIR_LOCK_INIT;
+        state->bufferSize = bufferSize;
+        state->buffersPerSlab = buffersPerSlab;
+        state->maxSlabCount = maxSlabCount;
+        state->slabs = calloc( maxSlabCount, sizeof( UInt8 * ) );
+        state->freeBuffers = calloc( _maxBufferCount, sizeof( void * ) );
+        state->references = 1; // the pool object
+        _state = state;
+        
+        // Captures only the state pointer, so the block holds no reference to the pool object.
+        self.deallocator = ^( void *bytes, NSUInteger length ) {
+            F53OSCReceiveBufferPoolStateReturnBuffer( state, bytes );
+        };
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    os_unfair_lock_lock( &_state->lock );
+    BOOL last = F53OSCReceiveBufferPoolStateRelease( _state );
+    os_unfair_lock_unlock( &_state->lock );
+    
+    if ( last )
+        F53OSCReceiveBufferPoolStateFree( _state );
+}
+
+- (NSUInteger) slabCount
+{
+    os_unfair_lock_lock( &_state->lock );
+    NSUInteger slabCount = _state->slabCount;
+    os_unfair_lock_unlock( &_state->lock );
+    return slabCount;
+}
+
+- (NSUInteger) buffersInUse
+{
+    os_unfair_lock_lock( &_state->lock );
+    NSUInteger buffersInUse = _state->references - 1;
+    os_unfair_lock_unlock( &_state->lock );
+    return buffersInUse;
+}
+
+- (NSUInteger) takeCount
+{
+    os_unfair_lock_lock( &_state->lock );
+    NSUInteger takeCount = _state->takeCount;
+    os_unfair_lock_unlock( &_state->lock );
+    return takeCount;
+}
+
+- (NSUInteger) exhaustedCount
+{
+    os_unfair_lock_lock( &_state->lock );
+    NSUInteger exhaustedCount = _state->exhaustedCount;
+    os_unfair_lock_unlock( &_state->lock );
+    return exhaustedCount;
+}
+
+#pragma mark -
+
+- (nullable void *) takeBuffer
+{
+    F53OSCReceiveBufferPoolState *state = _state;
+    void *buffer = NULL;
+    
+    os_unfair_lock_lock( &state->lock );
+    
+    if ( state->freeCount == 0 && state->slabCount < state->maxSlabCount )
+    {
+        // Pages of a new slab are only committed as datagrams are written to them.
+        UInt8 *slab = malloc( state->buffersPerSlab * state->bufferSize );
+        if ( slab )
+        {
+            state->slabs[state->slabCount] = slab;
+            state->slabCount++;
+            
+            // Pushed in reverse so that the lowest buffers are taken first, keeping a light load on the same pages.
+            for ( NSUInteger i = state->buffersPerSlab; i > 0; i-- )
+                state->freeBuffers[state->freeCount++] = slab + ( i - 1 ) * state->bufferSize;
+        }
+    }
+    
+    if ( state->freeCount )
+    {
+        state->freeCount--;
+        buffer = state->freeBuffers[state->freeCount];
+        state->references++;
+        state->takeCount++;
+    }
+    else
+    {
+        state->exhaustedCount++;
+    }
+    
+    os_unfair_lock_unlock( &state->lock );
+    return buffer;
+}
+
+- (void) returnBuffer:(void *)buffer
+{
+    F53OSCReceiveBufferPoolStateReturnBuffer( _state, buffer );
+}
+
+- (NSData *) dataWithBuffer:(void *)buffer length:(NSUInteger)length
+{
+    return [[NSData alloc] initWithBytesNoCopy:buffer length:MIN( length, self.bufferSize ) deallocator:self.deallocator];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
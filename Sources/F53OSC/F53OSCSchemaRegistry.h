@@ -0,0 +1,120 @@
+//
+//  F53OSCSchemaRegistry.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#if F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSCWire.h>
+#else
+#import "F53OSCWire.h"
+#endif
+
+@class F53OSCSocket;
+
+//
+//  F53OSCSchemaRegistry decodes messages to known addresses straight from packet bytes, without creating
+//  F53OSCMessages or boxing their arguments. Each address is registered with the type tags it must carry and
+//  either a struct to decode the arguments into or a handler for the raw arguments.
+//
+//  When a server's `schemaRegistry` is set, F53OSCParser checks every received message, including messages in
+//  bundles, against the registry before parsing it. A message to a registered address whose type tags match
+//  the signature is decoded and passed to the schema's handler; one whose type tags do not match, or whose
+//  arguments are truncated, is rejected and counted. Neither reaches the server's delegate. Messages to
+//  unregistered addresses are parsed and delivered as usual.
+//
+//  Addresses may be OSC patterns, e.g. "/mixer/*/gain", which are tried in registration order after exact
+//  addresses. In a signature, 'T' and 'F' each match either boolean type tag.
+//
+//  Struct fields are laid out by the caller and located with `offsetof()`: 'i' is an int32_t, 'f' a float,
+//  'T' and 'F' a bool, and 's' and 'b' an F53OSCSchemaBytes pointing into the packet. 'N' and 'I' have no field,
+//  but still take a place in the offsets array. String and blob bytes, and the context, are only valid
+//  during the handler call. Handlers are called synchronously on the queue that parsed the packet.
+//
+//  Example usage:
+//  typedef struct { int32_t channel; float level; F53OSCSchemaBytes name; } FaderMove;
+//  size_t offsets[] = { offsetof( FaderMove, channel ), offsetof( FaderMove, level ), offsetof( FaderMove, name ) };
+//
+//  F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+//  [registry registerAddress:@"/mixer/fader" signature:@"ifs" structSize:sizeof( FaderMove ) fieldOffsets:offsets
+//                    handler:^( const void *values, const F53OSCSchemaContext *context ) {
+//      const FaderMove *move = values;
+//      [mixer setLevel:move->level forChannel:move->channel];
+//  }];
+//  server.schemaRegistry = registry;
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53OSC_SCHEMA_MAX_ARGUMENTS     16
+#define F53OSC_SCHEMA_MAX_STRUCT_SIZE   256
+
+typedef struct
+{
+    const void  *bytes;     // strings are NUL-terminated
+    size_t      length;     // excludes a string's NUL
+} F53OSCSchemaBytes;
+
+typedef struct
+{
+    const char                          *address;           // NUL-terminated
+    size_t                              addressLength;
+    uint64_t                            timeTag;            // the enclosing bundle's OSC time tag, or F53OSC_WIRE_IMMEDIATELY for a message on its own
+    NSTimeInterval                      receivedTimestamp;  // see F53OSCPacket `receivedTimestamp`
+    __unsafe_unretained F53OSCSocket    * _Nullable replySocket;
+} F53OSCSchemaContext;
+
+typedef void (^F53OSCSchemaStructHandler)( const void *values, const F53OSCSchemaContext *context );
+typedef void (^F53OSCSchemaArgumentHandler)( const F53OSCWireArgument *arguments, NSUInteger count, const F53OSCSchemaContext *context );
+
+typedef NS_ENUM( NSInteger, F53OSCSchemaResult ) {
+    F53OSCSchemaUnregistered,   // no schema for the address; the message should be parsed as usual
+    F53OSCSchemaHandled,        // decoded and passed to the schema's handler
+    F53OSCSchemaRejected,       // the type tags did not match the signature or the arguments were truncated
+};
+
+@interface F53OSCSchemaRegistry : NSObject
+
+// Registering an address again replaces its schema. Returns NO for an invalid signature or layout.
+- (BOOL) registerAddress:(NSString *)address signature:(NSString *)signature structSize:(size_t)structSize fieldOffsets:(const size_t *)fieldOffsets handler:(F53OSCSchemaStructHandler)handler;
+- (BOOL) registerAddress:(NSString *)address signature:(NSString *)signature handler:(F53OSCSchemaArgumentHandler)handler;
+- (void) unregisterAddress:(NSString *)address;
+- (void) removeAllSchemas;
+
+@property (readonly) NSUInteger schemaCount;
+
+// `bytes` must hold one OSC message.
+- (F53OSCSchemaResult) handleMessageBytes:(const void *)bytes length:(size_t)length timeTag:(uint64_t)timeTag receivedTimestamp:(NSTimeInterval)receivedTimestamp
+                              replySocket:(nullable F53OSCSocket *)replySocket;
+
+@property (readonly) NSUInteger handledCount;
+@property (readonly) NSUInteger rejectedCount;
+- (NSUInteger) handledCountForAddress:(NSString *)address;
+- (NSUInteger) rejectedCountForAddress:(NSString *)address;
+- (void) resetCounts;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,460 @@
+//
+//  F53OSCSchemaRegistry.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCSchemaRegistry.h"
+
+#import "F53OSCAddressIndex.h"
+
+#import <stdlib.h>
+#import <string.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCSchemaEntry : NSObject
+@property (copy) NSString *address;
+@property (copy) NSData *addressBytes;          // UTF-8, NUL-terminated
+@property (assign) size_t addressLength;        // excludes the NUL
+@property (assign) uint32_t hash32;
+@property (assign) BOOL isPattern;
+@property (copy) NSData *signature;             // NUL-terminated
+@property (assign) NSUInteger argumentCount;
+@property (assign) size_t structSize;
+@property (copy, nullable) NSData *fieldOffsets; // size_t per argument
+@property (copy, nullable) F53OSCSchemaStructHandler structHandler;
+@property (copy, nullable) F53OSCSchemaArgumentHandler argumentHandler;
+@property (assign) NSUInteger handledCount;
+@property (assign) NSUInteger rejectedCount;
+@end
+
+@implementation F53OSCSchemaEntry
+@end
+
+typedef struct
+{
+    uint32_t                                hash;
+    __unsafe_unretained F53OSCSchemaEntry   * _Nullable entry;  // retained by `exactEntries`
+} F53OSCSchemaSlot;
+
+
+@interface F53OSCSchemaRegistry ()
+{
+    F53OSCSchemaSlot    *_slots;        // open addressing over the exact addresses; rebuilt whenever they change
+    size_t              _slotMask;
+}
+
+@property (strong) NSMutableDictionary<NSString *, F53OSCSchemaEntry *> *exactEntries;
+@property (strong) NSMutableArray<F53OSCSchemaEntry *> *patternEntries;
+@property (assign) NSUInteger totalHandledCount;
+@property (assign) NSUInteger totalRejectedCount;
+
+- (BOOL) registerEntry:(F53OSCSchemaEntry *)entry signature:(NSString *)signature;
+- (void) rebuildSlots;
+- (nullable F53OSCSchemaEntry *) entryForAddress:(const char *)address length:(size_t)length;
+- (nullable F53OSCSchemaEntry *) registeredEntryForAddress:(NSString *)address;
+
+@end
+
+static uint32_t F53OSCSchemaHash( const char *bytes, size_t length )
+{
+    uint32_t hash = 2166136261u; // FNV-1a
+    for ( size_t i = 0; i < length; i++ )
+    {
+        hash ^= (uint8_t)bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static BOOL F53OSCSchemaIsPattern( NSString *address )
+{
+    return ( [address rangeOfCharacterFromSet:[NSCharacterSet characterSetWithCharactersInString:@"*?[]{}"]].location != NSNotFound );
+}
+
+
+@implementation F53OSCSchemaRegistry
+
+- (instancetype) init
+{
+    self = [super init];
+    if ( self )
+    {
+        self.exactEntries = [NSMutableDictionary dictionary];
+        self.patternEntries = [NSMutableArray array];
+        self.totalHandledCount = 0;
+        self.totalRejectedCount = 0;
+        [self rebuildSlots];
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    free( _slots );
+}
+
+#pragma mark - Registration
+
+- (BOOL) registerAddress:(NSString *)address signature:(NSString *)signature structSize:(size_t)structSize fieldOffsets:(const size_t *)fieldOffsets handler:(F53OSCSchemaStructHandler)handler
+{
+    if ( structSize == 0 || structSize > F53OSC_SCHEMA_MAX_STRUCT_SIZE )
+    {
+        NSLog( @"Error: F53OSCSchemaRegistry struct size %lu for %@ must be between 1 and %d bytes.", (unsigned long)structSize, address, F53OSC_SCHEMA_MAX_STRUCT_SIZE );
+        return NO;
+    }
+    
+    const char *typeTags = [signature UTF8String];
+    size_t count = strlen( typeTags );
+    for ( size_t i = 0; i < count; i++ )
+    {
+        size_t fieldSize = 0;
+        switch ( typeTags[i] )
+        {
+            case 'i': fieldSize = sizeof( int32_t ); break;
+            case 'f': fieldSize = sizeof( float ); break;
+            case 'T':
+            case 'F': fieldSize = sizeof( bool ); break;
+            case 's':
+            case 'b': fieldSize = sizeof( F53OSCSchemaBytes ); break;
+            default: break; // no field, or an invalid type that registerEntry: rejects
+        }
+        if ( fieldSize && fieldOffsets[i] + fieldSize > structSize )
+        {
+            NSLog( @"Error: F53OSCSchemaRegistry field %lu of %@ does not fit in a struct of %lu bytes.", (unsigned long)i, address, (unsigned long)structSize );
+            return NO;
+        }
+    }
+    
+    F53OSCSchemaEntry *entry = [[F53OSCSchemaEntry alloc] init];
+    entry.address = address;
+    entry.structSize = structSize;
+    entry.fieldOffsets = [NSData dataWithBytes:fieldOffsets length:count * sizeof( size_t )];
+    entry.structHandler = handler;
+    return [self registerEntry:entry signature:signature];
+}
+
+- (BOOL) registerAddress:(NSString *)address signature:(NSString *)signature handler:(F53OSCSchemaArgumentHandler)handler
+{
+    F53OSCSchemaEntry *entry = [[F53OSCSchemaEntry alloc] init];
+    entry.address = address;
+    entry.argumentHandler = handler;
+    return [self registerEntry:entry signature:signature];
+}
+
+- (BOOL) registerEntry:(F53OSCSchemaEntry *)entry signature:(NSString *)signature
+{
+    const char *typeTags = [signature UTF8String];
+    size_t count = strlen( typeTags );
+    if ( count > F53OSC_SCHEMA_MAX_ARGUMENTS )
+    {
+        NSLog( @"Error: F53OSCSchemaRegistry signature \"%@\" for %@ has more than %d arguments.", signature, entry.address, F53OSC_SCHEMA_MAX_ARGUMENTS );
+        return NO;
+    }
+    if ( strspn( typeTags, "ifsbTFNI" ) != count )
+    {
+        NSLog( @"Error: F53OSCSchemaRegistry signature \"%@\" for %@ contains an unsupported type.", signature, entry.address );
+        return NO;
+    }
+    
+    const char *address = [entry.address UTF8String];
+    entry.addressLength = strlen( address );
+    entry.addressBytes = [NSData dataWithBytes:address length:entry.addressLength + 1];
+    entry.hash32 = F53OSCSchemaHash( address, entry.addressLength );
+    entry.isPattern = F53OSCSchemaIsPattern( entry.address );
+    entry.signature = [NSData dataWithBytes:typeTags length:count + 1];
+    entry.argumentCount = count;
+    
+    @synchronized( self )
+    {
+        [self unregisterAddress:entry.address];
+        if ( entry.isPattern )
+        {
+            [self.patternEntries addObject:entry];
+        }
+        else
+        {
+            self.exactEntries[entry.address] = entry;
+            [self rebuildSlots];
+        }
+    }
+    return YES;
+}
+
+- (void) unregisterAddress:(NSString *)address
+{
+    @synchronized( self )
+    {
+        if ( self.exactEntries[address] )
+        {
+            [self.exactEntries removeObjectForKey:address];
+            [self rebuildSlots];
+        }
+        
+        NSIndexSet *patternIndexes = [self.patternEntries indexesOfObjectsPassingTest:^BOOL( F53OSCSchemaEntry *entry, NSUInteger idx, BOOL *stop ) {
+            return [entry.address isEqualToString:address];
+        }];
+        [self.patternEntries removeObjectsAtIndexes:patternIndexes];
+    }
+}
+
+- (void) removeAllSchemas
+{
+    @synchronized( self )
+    {
+        [self.exactEntries removeAllObjects];
+        [self.patternEntries removeAllObjects];
+        [self rebuildSlots];
+    }
+}
+
+- (NSUInteger) schemaCount
+{
+    @synchronized( self )
+    {
+        return self.exactEntries.count + self.patternEntries.count;
+    }
+}
+
+// Called while synchronized. The table is kept at most half full so probes stay short.
+- (void) rebuildSlots
+{
+    size_t capacity = 16;
+    while ( capacity < self.exactEntries.count * 2 )
+        capacity *= 2;
+    
+    free( _slots );
+    _slots = calloc( capacity, sizeof( F53OSCSchemaSlot ) );
+    _slotMask = capacity - 1;
+    
+    for ( F53OSCSchemaEntry *entry in self.exactEntries.allValues )
+    {
+        size_t index = entry.hash32 & _slotMask;
+        while ( _slots[index].entry )
+            index = ( index + 1 ) & _slotMask;
+        _slots[index].hash = entry.hash32;
+        _slots[index].entry = entry;
+    }
+}
+
+// Called while synchronized. `address` must be NUL-terminated.
+- (nullable F53OSCSchemaEntry *) entryForAddress:(const char *)address length:(size_t)length
+{
+    uint32_t hash = F53OSCSchemaHash( address, length );
+    for ( size_t index = hash & _slotMask; _slots[index].entry; index = ( index + 1 ) & _slotMask )
+    {
+        F53OSCSchemaEntry *entry = _slots[index].entry;
+        if ( _slots[index].hash == hash && entry.addressLength == length && memcmp( entry.addressBytes.bytes, address, length ) == 0 )
+            return entry;
+    }
+    
+    for ( F53OSCSchemaEntry *entry in self.patternEntries )
+    {
+        if ( F53OSCPatternMatchesAddress( entry.addressBytes.bytes, address, length ) )
+            return entry;
+    }
+    
+    return nil;
+}
+
+// Called while synchronized. Finds the schema registered under `address`, which may be a pattern, rather than one matching it.
+- (nullable F53OSCSchemaEntry *) registeredEntryForAddress:(NSString *)address
+{
+    F53OSCSchemaEntry *entry = self.exactEntries[address];
+    if ( entry )
+        return entry;
+    
+    for ( F53OSCSchemaEntry *patternEntry in self.patternEntries )
+    {
+        if ( [patternEntry.address isEqualToString:address] )
+            return patternEntry;
+    }
+    return nil;
+}
+
+#pragma mark - Decoding
+
+- (F53OSCSchemaResult) handleMessageBytes:(const void *)bytes length:(size_t)length timeTag:(uint64_t)timeTag receivedTimestamp:(NSTimeInterval)receivedTimestamp
+                              replySocket:(nullable F53OSCSocket *)replySocket
+{
+    F53OSCWireMessage message;
+    if ( !F53OSCWireReadMessage( bytes, length, &message ) )
+        return F53OSCSchemaUnregistered; // left to the parser, which reports malformed messages
+    
+    F53OSCSchemaEntry *entry;
+    @synchronized( self )
+    {
+        entry = [self entryForAddress:message.address length:message.addressLength];
+    }
+    if ( entry == nil )
+        return F53OSCSchemaUnregistered;
+    
+    // Check the signature against the raw type tags before reading any argument.
+    const char *signature = entry.signature.bytes;
+    BOOL matches = ( message.argumentCount == entry.argumentCount );
+    for ( NSUInteger i = 0; matches && i < message.argumentCount; i++ )
+    {
+        char expected = signature[i];
+        char actual = message.typeTags[i];
+        if ( expected == 'T' || expected == 'F' )
+            matches = ( actual == 'T' || actual == 'F' );
+        else
+            matches = ( actual == expected );
+    }
+    
+    F53OSCWireArgument arguments[F53OSC_SCHEMA_MAX_ARGUMENTS];
+    for ( NSUInteger i = 0; matches && i < message.argumentCount; i++ )
+        matches = ( F53OSCWireMessageNextArgument( &message, &arguments[i] ) == F53OSCWireArgumentRead );
+    
+    if ( !matches )
+    {
+        @synchronized( self )
+        {
+            entry.rejectedCount++;
+            self.totalRejectedCount++;
+        }
+        return F53OSCSchemaRejected;
+    }
+    
+    F53OSCSchemaContext context = {
+        .address = message.address,
+        .addressLength = message.addressLength,
+        .timeTag = timeTag,
+        .receivedTimestamp = receivedTimestamp,
+        .replySocket = replySocket,
+    };
+    
+    F53OSCSchemaStructHandler structHandler = entry.structHandler;
+    if ( structHandler )
+    {
+        _Alignas( max_align_t ) uint8_t values[F53OSC_SCHEMA_MAX_STRUCT_SIZE];
+        memset( values, 0, entry.structSize );
+        
+        const size_t *fieldOffsets = entry.fieldOffsets.bytes;
+        for ( NSUInteger i = 0; i < message.argumentCount; i++ )
+        {
+            uint8_t *field = values + fieldOffsets[i];
+            F53OSCWireArgument *argument = &arguments[i];
+            switch ( argument->type )
+            {
+                case 'i':
+                    memcpy( field, &argument->value.i, sizeof( int32_t ) );
+                    break;
+                case 'f':
+                    memcpy( field, &argument->value.f, sizeof( float ) );
+                    break;
+                case 'T':
+                case 'F':
+                {
+                    bool value = ( argument->type == 'T' );
+                    memcpy( field, &value, sizeof( bool ) );
+                    break;
+                }
+                case 's':
+                case 'b':
+                {
+                    F53OSCSchemaBytes value = { argument->value.data.bytes, argument->value.data.length };
+                    memcpy( field, &value, sizeof( F53OSCSchemaBytes ) );
+                    break;
+                }
+                default:
+                    break; // N and I have no field
+            }
+        }
+        structHandler( values, &context );
+    }
+    else
+    {
+        entry.argumentHandler( arguments, message.argumentCount, &context );
+    }
+    
+    @synchronized( self )
+    {
+        entry.handledCount++;
+        self.totalHandledCount++;
+    }
+    return F53OSCSchemaHandled;
+}
+
+#pragma mark - Counts
+
+- (NSUInteger) handledCount
+{
+    @synchronized( self )
+    {
+        return self.totalHandledCount;
+    }
+}
+
+- (NSUInteger) rejectedCount
+{
+    @synchronized( self )
+    {
+        return self.totalRejectedCount;
+    }
+}
+
+- (NSUInteger) handledCountForAddress:(NSString *)address
+{
+    @synchronized( self )
+    {
+        return [self registeredEntryForAddress:address].handledCount;
+    }
+}
+
+- (NSUInteger) rejectedCountForAddress:(NSString *)address
+{
+    @synchronized( self )
+    {
+        return [self registeredEntryForAddress:address].rejectedCount;
+    }
+}
+
+- (void) resetCounts
+{
+    @synchronized( self )
+    {
+        self.totalHandledCount = 0;
+        self.totalRejectedCount = 0;
+        for ( F53OSCSchemaEntry *entry in self.exactEntries.allValues )
+        {
+            entry.handledCount = 0;
+            entry.rejectedCount = 0;
+        }
+        for ( F53OSCSchemaEntry *entry in self.patternEntries )
+        {
+            entry.handledCount = 0;
+            entry.rejectedCount = 0;
+        }
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -32,6 +32,14 @@
 #import "F53OSC.h"
 #endif
 
+@class F53OSCEncryptSessionCache;
+@class F53OSCNativeUdpTransport;
+@class F53OSCPriorityScheduler;
+@class F53OSCRateLimiter;
+@class F53OSCReadFlowControl;
+@class F53OSCRealtimeRing;
+@class F53OSCSchemaRegistry;
+
 @protocol F53OSCServerDelegate;
 
 
@@ -39,6 +47,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 #define F53_OSC_SERVER_DEBUG 0
 
+typedef NS_ENUM( NSInteger, F53OSCServerUdpTransport ) {
+    F53OSCServerUdpTransportGCDAsyncSocket = 0,    // GCDAsyncUdpSocket, with its own socket queue
+    F53OSCServerUdpTransportNative,                 // F53OSCNativeUdpTransport, read directly on the server's queue; falls back to GCDAsyncUdpSocket if it can not start or multicast groups are joined
+};
+
 @interface F53OSCServer : NSObject <GCDAsyncSocketDelegate, GCDAsyncUdpSocketDelegate, F53OSCControlHandler>
 
 + (NSString *) validCharsForOSCMethod;
@@ -46,12 +59,31 @@ NS_ASSUME_NONNULL_BEGIN
                      matchingOSCPattern:(NSString *)pattern;
 
 @property (nonatomic, weak)                 id<F53OSCServerDelegate> delegate;
+@property (nonatomic, strong, null_resettable) dispatch_queue_t delegateCallbackQueue; // defaults to main queue; used for connect and disconnect callbacks
 @property (nonatomic, strong, readonly)     F53OSCSocket *udpSocket;
 @property (nonatomic, strong, readonly)     F53OSCSocket *tcpSocket;
 @property (nonatomic, assign)               UInt16 port;         // default 0
 @property (nonatomic, assign)               UInt16 udpReplyPort; // default 0
 @property (nonatomic, getter=isIPv6Enabled) BOOL IPv6Enabled;    // default NO
 @property (strong, nullable)                NSData *keyPair;
+@property (strong, nullable)                F53OSCEncryptSessionCache *encryptionSessionCache; // default nil; when set, completed handshakes are issued tickets that let clients resume their session on reconnect
+@property (nonatomic, assign)               BOOL udpEncryptionEnabled;          // default NO; when set with `keyPair`, UDP peers may run the encryption handshake and send sealed datagrams
+@property (nonatomic, assign)               NSUInteger maxUdpEncryptionSessions; // default 256; bounds confirmed and unconfirmed UDP sessions together, and the oldest unconfirmed session makes room first
+@property (nonatomic, readonly)             NSUInteger udpEncryptionSessionCount;            // sessions confirmed by a sealed datagram from the peer
+@property (nonatomic, readonly)             NSUInteger unconfirmedUdpEncryptionSessionCount; // answered requests, at most 16, awaiting a sealed datagram
+
+// Batching applies only when the delegate implements `takeMessages:`.
+@property (nonatomic, assign)               NSUInteger maxMessageBatchSize;     // default 0 (no limit)
+@property (nonatomic, assign)               NSTimeInterval messageBatchLatency; // default 0 (deliver at the end of each read)
+@property (strong, nullable)                F53OSCConflationBuffer *conflationBuffer; // default nil; when set, messages reach the delegate through it
+@property (strong, nullable)                F53OSCPriorityScheduler *priorityScheduler; // default nil; when set, messages reach the delegate in lane priority order
+@property (strong, nullable)                F53OSCRateLimiter *rateLimiter; // default nil; when set, each UDP datagram and each TCP read chunk from a peer is admitted before it is parsed
+@property (strong, nullable)                F53OSCReadFlowControl *readFlowControl; // default nil; when set, TCP reads pause while a connection has too many undelivered messages
+@property (strong, nullable)                F53OSCRealtimeRing *realtimeRing; // default nil; when set, UDP packets the ring can carry are decoded straight into it instead of reaching the delegate, after any encrypted UDP session has opened them
+@property (strong, nullable)                F53OSCSchemaRegistry *schemaRegistry; // default nil; when set, messages to its addresses are decoded by it instead of reaching the delegate
+@property (nonatomic, assign)               F53OSCServerUdpTransport udpTransport; // default F53OSCServerUdpTransportGCDAsyncSocket; takes effect on the next `startListening`
+@property (strong, readonly, nullable)      F53OSCNativeUdpTransport *nativeUdpTransport; // while listening with the native UDP transport
+@property (nonatomic, copy, nullable)       F53OSCSocketOptions *socketOptions; // default nil; applied to the listening sockets, accepted TCP connections, and the native UDP transport, which alone reads receive timestamps
 
 - (instancetype) initWithDelegateQueue:(nullable dispatch_queue_t)queue;
 
@@ -59,11 +91,18 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL) startListening:(out NSError **)outError;
 - (void) stopListening;
 
+// Multicast groups are joined on the UDP socket, now if listening and otherwise when listening starts. Memberships persist
+// across `stopListening`. A nil interface lets the OS choose; pass an interface address or name (e.g. "en0") to select one.
+// Joining while listening with the native UDP transport moves UDP over to GCDAsyncUdpSocket.
+@property (nonatomic, readonly) NSArray<NSString *> *multicastGroups;
+- (BOOL) joinMulticastGroup:(NSString *)group onInterface:(nullable NSString *)interface error:(out NSError **)outError;
+- (BOOL) leaveMulticastGroup:(NSString *)group onInterface:(nullable NSString *)interface error:(out NSError **)outError;
+
 @end
 
 @protocol F53OSCServerDelegate <F53OSCPacketDestination>
 
-@optional
+@optional // Called asynchronously on the server's `delegateCallbackQueue`.
 - (void)serverDidConnect:(F53OSCServer *)server toSocket:(F53OSCSocket *)socket;
 - (void)serverDidDisconnect:(F53OSCServer *)server fromSocket:(F53OSCSocket *)socket;
 
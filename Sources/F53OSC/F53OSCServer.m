@@ -30,12 +30,31 @@
 
 #import "F53OSCServer.h"
 
+#if __has_include(<F53OSC/F53OSC-Swift.h>) // F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSC-Swift.h>
+#elif SWIFT_PACKAGE // Swift Package Manager
+@import F53OSCEncrypt;
+#endif
 #import "F53OSCFoundationAdditions.h"
 #import "F53OSCEncryptHandshake.h"
+#import "F53OSCEncryptSessionCache.h"
+#import "F53OSCConflationBuffer.h"
+#import "F53OSCDatagramCipher.h"
+#import "F53OSCMessageBatcher.h"
+#import "F53OSCNativeUdpTransport.h"
+#import "F53OSCPriorityScheduler.h"
+#import "F53OSCReadFlowControl.h"
+#import "F53OSCRealtimeRing.h"
+#import "F53OSCSchemaRegistry.h"
+#import "F53OSCRateLimiter.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
 
+#define END             0300    /* indicates end of packet */
+
+#define F53OSCServerMaxUnconfirmedUdpEncryptionSessions     16
+
 @interface F53OSCServer ()
 
 @property (atomic, strong) dispatch_queue_t queue;
@@ -45,6 +64,26 @@ NS_ASSUME_NONNULL_BEGIN
 @property (strong) NSMutableDictionary<NSNumber *, NSMutableData *> *activeData;        // NSMutableData keyed by index; buffers the incoming data.
 @property (strong) NSMutableDictionary<NSNumber *, NSMutableDictionary *> *activeState; // NSMutableDictionary keyed by index; stores state of incoming data.
 @property (assign) long activeIndex;
+@property (strong) F53OSCMessageBatcher *messageBatcher;
+@property (strong) NSMutableArray<NSDictionary<NSString *, NSString *> *> *multicastMemberships; // group and optional interface
+@property (assign) BOOL isListening;
+@property (strong, readwrite, nullable) F53OSCNativeUdpTransport *nativeUdpTransport;
+@property (strong) NSMutableDictionary<NSString *, F53OSCSocket *> *udpEncryptionSessions; // confirmed sessions' reply sockets keyed by peer "host:port"
+@property (strong) NSMutableArray<NSString *> *udpEncryptionSessionPeers;                   // in the order their sessions were confirmed
+@property (strong) NSMutableDictionary<NSString *, F53OSCSocket *> *unconfirmedUdpEncryptionSessions; // answered requests awaiting a sealed datagram; guarded by udpEncryptionSessions
+@property (strong) NSMutableArray<NSString *> *unconfirmedUdpEncryptionSessionPeers;                   // in the order their requests were answered
+
+- (nullable id<F53OSCPacketDestination>) destinationForRead;
+- (void) performDelegateCallback:(dispatch_block_t)block;
+- (BOOL) startNativeUdpTransport:(out NSError **)outError;
+- (BOOL) restartUdpOnGCDAsyncUdpSocket:(out NSError **)outError;
+- (void) receiveUdpData:(NSData *)data fromHost:(nullable NSString *)host port:(UInt16)port receivedTimestamp:(NSTimeInterval)receivedTimestamp;
+- (void) issueEncryptionTicketToSocket:(F53OSCSocket *)socket;
+- (void) resumeEncryptionWithHandshake:(F53OSCEncryptHandshake *)handshake onSocket:(F53OSCSocket *)socket;
+- (void) handleUdpEncryptionRequest:(F53OSCMessage *)message peerKey:(NSData *)peerKey;
+- (F53OSCSocket *) newUdpEncryptionSocketForHost:(nullable NSString *)host port:(UInt16)port;
+- (void) addUnconfirmedUdpEncryptionSession:(F53OSCSocket *)socket forPeer:(NSString *)peer;
+- (void) confirmUdpEncryptionSession:(F53OSCSocket *)socket forPeer:(NSString *)peer;
 
 @end
 
@@ -142,6 +181,9 @@ NS_ASSUME_NONNULL_BEGIN
         self.port = 0;
         self.udpReplyPort = 0;
         self.IPv6Enabled = NO;
+        self.delegateCallbackQueue = nil; // main queue
+        self.maxMessageBatchSize = 0;   // no limit
+        self.messageBatchLatency = 0;   // deliver at the end of each read
 
         if ( !queue )
             queue = dispatch_get_main_queue();
@@ -160,6 +202,18 @@ NS_ASSUME_NONNULL_BEGIN
         self.activeData = [NSMutableDictionary dictionaryWithCapacity:1];
         self.activeState = [NSMutableDictionary dictionaryWithCapacity:1];
         self.activeIndex = 0;
+        self.messageBatcher = [[F53OSCMessageBatcher alloc] initWithQueue:queue];
+        self.multicastMemberships = [NSMutableArray array];
+        self.isListening = NO;
+        self.udpTransport = F53OSCServerUdpTransportGCDAsyncSocket;
+        self.nativeUdpTransport = nil;
+        self.socketOptions = nil;
+        self.udpEncryptionEnabled = NO;
+        self.maxUdpEncryptionSessions = 256;
+        self.udpEncryptionSessions = [NSMutableDictionary dictionary];
+        self.udpEncryptionSessionPeers = [NSMutableArray array];
+        self.unconfirmedUdpEncryptionSessions = [NSMutableDictionary dictionary];
+        self.unconfirmedUdpEncryptionSessionPeers = [NSMutableArray array];
     }
     return self;
 }
@@ -175,10 +229,23 @@ NS_ASSUME_NONNULL_BEGIN
 
     [self.tcpSocket stopListening];
     [self.udpSocket stopListening];
+    [self.nativeUdpTransport stopListening];
+    self.nativeUdpTransport = nil;
     self.tcpSocket.port = _port;
     self.udpSocket.port = _port;
 }
 
+- (void) setDelegateCallbackQueue:(nullable dispatch_queue_t)queue
+{
+    if ( !queue )
+        queue = dispatch_get_main_queue();
+    
+    @synchronized( self )
+    {
+        _delegateCallbackQueue = queue;
+    }
+}
+
 - (void) setIPv6Enabled:(BOOL)IPv6Enabled
 {
     _IPv6Enabled = IPv6Enabled;
@@ -186,6 +253,13 @@ NS_ASSUME_NONNULL_BEGIN
     self.udpSocket.IPv6Enabled = _IPv6Enabled;
 }
 
+- (void) setSocketOptions:(nullable F53OSCSocketOptions *)socketOptions
+{
+    _socketOptions = [socketOptions copy];
+    self.tcpSocket.options = _socketOptions;
+    self.udpSocket.options = _socketOptions;
+}
+
 - (BOOL) startListening
 {
     return [self startListening:nil];
@@ -198,16 +272,57 @@ NS_ASSUME_NONNULL_BEGIN
     [self.udpSocket.udpSocket synchronouslySetDelegateQueue:self.queue];
     
     BOOL success;
+    NSArray<NSDictionary<NSString *, NSString *> *> *memberships;
+    @synchronized( self.multicastMemberships )
+    {
+        memberships = [self.multicastMemberships copy];
+    }
+    self.udpSocket.reusePort = ( memberships.count > 0 ); // let other receivers share the group's port
+    
+    BOOL useNativeUdpTransport = ( self.udpTransport == F53OSCServerUdpTransportNative );
+    if ( useNativeUdpTransport && memberships.count )
+    {
+        NSLog( @"Warning: %@ uses GCDAsyncUdpSocket because multicast groups are joined.", self );
+        useNativeUdpTransport = NO;
+    }
+    
     success = [self.tcpSocket startListening:outError];
     if ( success )
-        success = [self.udpSocket startListening:outError];
+        success = ( useNativeUdpTransport ? [self startNativeUdpTransport:outError] : [self.udpSocket startListening:outError] );
+    if ( success )
+    {
+        self.isListening = YES;
+        
+        for ( NSDictionary<NSString *, NSString *> *membership in memberships )
+        {
+            NSError *error = nil;
+            if ( ![self.udpSocket joinMulticastGroup:membership[@"group"] onInterface:membership[@"interface"] error:&error] )
+                NSLog( @"Warning: %@ unable to join multicast group %@ - %@", self, membership[@"group"], [error localizedDescription] );
+        }
+    }
     return success;
 }
 
 - (void) stopListening
 {
+    self.isListening = NO;
+    
+    @synchronized( self.udpEncryptionSessions )
+    {
+        for ( F53OSCSocket *socket in self.udpEncryptionSessions.objectEnumerator )
+            [socket.udpSocket close];
+        for ( F53OSCSocket *socket in self.unconfirmedUdpEncryptionSessions.objectEnumerator )
+            [socket.udpSocket close];
+        [self.udpEncryptionSessions removeAllObjects];
+        [self.udpEncryptionSessionPeers removeAllObjects];
+        [self.unconfirmedUdpEncryptionSessions removeAllObjects];
+        [self.unconfirmedUdpEncryptionSessionPeers removeAllObjects];
+    }
+    
     [self.tcpSocket stopListening];
     [self.udpSocket stopListening];
+    [self.nativeUdpTransport stopListening];
+    self.nativeUdpTransport = nil;
     
     // unset delegate queue
     // - this prevents the socket from holding a strong reference to this object. If the socket holds the final reference, this object will dealloc on the delegateQueue which could be a background thread.
@@ -216,12 +331,124 @@ NS_ASSUME_NONNULL_BEGIN
     [self.udpSocket.udpSocket synchronouslySetDelegateQueue:nil];
 }
 
+- (BOOL) startNativeUdpTransport:(out NSError **)outError
+{
+    __weak typeof(self) weakSelf = self;
+    F53OSCNativeUdpTransport *transport = [[F53OSCNativeUdpTransport alloc] initWithQueue:self.queue receiveHandler:^( NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp ) {
+        [weakSelf receiveUdpData:data fromHost:F53OSCSocketAddressHost( address ) port:F53OSCSocketAddressPort( address ) receivedTimestamp:timestamp];
+    }];
+    transport.socketOptions = self.socketOptions;
+    
+    NSError *error = nil;
+    if ( ![transport listenOnPort:self.port IPv6Enabled:self.isIPv6Enabled error:&error] )
+    {
+        // Fall back rather than fail; if the port itself is the problem, GCDAsyncUdpSocket reports it.
+        NSLog( @"Warning: %@ unable to start the native UDP transport, using GCDAsyncUdpSocket - %@", self, [error localizedDescription] );
+        return [self.udpSocket startListening:outError];
+    }
+    
+    self.nativeUdpTransport = transport;
+    return YES;
+}
+
+#pragma mark - Multicast
+
+- (NSArray<NSString *> *) multicastGroups
+{
+    @synchronized( self.multicastMemberships )
+    {
+        return [self.multicastMemberships valueForKey:@"group"];
+    }
+}
+
+- (BOOL) joinMulticastGroup:(NSString *)group onInterface:(nullable NSString *)interface error:(out NSError **)outError
+{
+    if ( ![F53OSCSocket isMulticastAddress:group] )
+    {
+        if ( outError != NULL )
+            *outError = [NSError errorWithDomain:@"F53OSCServerErrorDomain" code:-1 userInfo:@{ NSLocalizedDescriptionKey : [NSString stringWithFormat:@"%@ is not a multicast group address.", group] }];
+        return NO;
+    }
+    
+    NSMutableDictionary<NSString *, NSString *> *membership = [NSMutableDictionary dictionaryWithObject:group forKey:@"group"];
+    if ( interface )
+        membership[@"interface"] = interface;
+    
+    @synchronized( self.multicastMemberships )
+    {
+        if ( [self.multicastMemberships containsObject:membership] )
+            return YES;
+    }
+    
+    if ( self.isListening && self.nativeUdpTransport && ![self restartUdpOnGCDAsyncUdpSocket:outError] )
+        return NO;
+    
+    // A socket that is already bound can not turn on port reuse, so the membership is joined as is.
+    if ( self.isListening && ![self.udpSocket joinMulticastGroup:group onInterface:interface error:outError] )
+        return NO;
+    
+    @synchronized( self.multicastMemberships )
+    {
+        [self.multicastMemberships addObject:[membership copy]];
+    }
+    return YES;
+}
+
+- (BOOL) leaveMulticastGroup:(NSString *)group onInterface:(nullable NSString *)interface error:(out NSError **)outError
+{
+    NSMutableDictionary<NSString *, NSString *> *membership = [NSMutableDictionary dictionaryWithObject:group forKey:@"group"];
+    if ( interface )
+        membership[@"interface"] = interface;
+    
+    @synchronized( self.multicastMemberships )
+    {
+        if ( ![self.multicastMemberships containsObject:membership] )
+            return YES;
+        [self.multicastMemberships removeObject:membership];
+    }
+    
+    // The native transport never holds a membership; joining a group moves UDP over to GCDAsyncUdpSocket.
+    if ( self.isListening && !self.nativeUdpTransport )
+        return [self.udpSocket leaveMulticastGroup:group onInterface:interface error:outError];
+    
+    return YES;
+}
+
+// The native transport does not join multicast groups, so a server listening on it moves UDP to GCDAsyncUdpSocket,
+// as `startListening:` does when groups are already joined. If that fails, the native transport is started again.
+- (BOOL) restartUdpOnGCDAsyncUdpSocket:(out NSError **)outError
+{
+    NSLog( @"Warning: %@ switches to GCDAsyncUdpSocket to join a multicast group.", self );
+    
+    [self.nativeUdpTransport stopListening];
+    self.nativeUdpTransport = nil;
+    
+    self.udpSocket.reusePort = YES; // let other receivers share the group's port
+    if ( [self.udpSocket startListening:outError] )
+        return YES;
+    
+    self.udpSocket.reusePort = NO;
+    NSError *error = nil;
+    if ( ![self startNativeUdpTransport:&error] )
+        NSLog( @"Error: %@ unable to resume receiving UDP - %@", self, [error localizedDescription] );
+    return NO;
+}
+
+#pragma mark -
+
 - (void) handleF53OSCControlMessage:(F53OSCMessage *)message
 {
     if ( [F53OSCEncryptHandshake isEncryptHandshakeMessage:message] )
     {
         if ( self.keyPair )
         {
+            NSData *requestedPeerKey = [F53OSCEncryptHandshake requestedPeerKeyForMessage:message];
+            if ( requestedPeerKey && message.replySocket.isUdpSocket )
+            {
+                [self handleUdpEncryptionRequest:message peerKey:(NSData * _Nonnull)requestedPeerKey];
+                return;
+            }
+            
             if ( !message.replySocket.encrypter )
                 [message.replySocket setKeyPair:self.keyPair];
             F53OSCEncryptHandshake *handshake = [F53OSCEncryptHandshake handshakeWithEncrypter:message.replySocket.encrypter];
@@ -236,6 +463,12 @@ NS_ASSUME_NONNULL_BEGIN
                 else if ( handshake.lastProcessedMessage == F53OSCEncryptionHandshakeMessageBegin )
                 {
                     message.replySocket.isEncrypting = YES;
+                    if ( message.replySocket.isTcpSocket )
+                        [self issueEncryptionTicketToSocket:message.replySocket];
+                }
+                else if ( handshake.lastProcessedMessage == F53OSCEncryptionHandshakeMessageResume && message.replySocket.isTcpSocket )
+                {
+                    [self resumeEncryptionWithHandshake:handshake onSocket:message.replySocket];
                 }
                 else
                 {
@@ -254,6 +487,96 @@ NS_ASSUME_NONNULL_BEGIN
     }
 }
 
+// Sends a ticket for the session just agreed on `socket`, encrypted, so that the client can resume it later.
+- (void) issueEncryptionTicketToSocket:(F53OSCSocket *)socket
+{
+    F53OSCEncryptSessionCache *sessionCache = self.encryptionSessionCache;
+    F53OSCEncrypt *encrypter = socket.encrypter;
+    NSData *peerKey = encrypter.peerKey;
+    if ( !sessionCache || !encrypter || !peerKey )
+        return;
+    
+    F53OSCEncryptSession *session = [sessionCache issueSessionForPeerKey:(NSData * _Nonnull)peerKey encrypter:(F53OSCEncrypt * _Nonnull)encrypter];
+    F53OSCEncryptHandshake *handshake = [F53OSCEncryptHandshake handshakeWithEncrypter:(F53OSCEncrypt * _Nonnull)encrypter];
+    [socket sendPacket:[handshake encryptionTicketMessageWithTicket:session.ticket lifetime:sessionCache.lifetime]];
+}
+
+// A resumed session is used at once, since the client sends encrypted packets right behind its resume message. Tickets
+// are single use, so the session is confirmed with a new one. Otherwise the client is told to run a full handshake.
+- (void) resumeEncryptionWithHandshake:(F53OSCEncryptHandshake *)handshake onSocket:(F53OSCSocket *)socket
+{
+    F53OSCEncryptSessionCache *sessionCache = self.encryptionSessionCache;
+    NSData *peerKey = handshake.peerKey;
+    NSData *ticket = handshake.ticket;
+    NSData *proof = handshake.ticketProof;
+    NSData *keyPair = self.keyPair;
+    
+    F53OSCEncryptSession *session = nil;
+    if ( sessionCache && peerKey && ticket && proof )
+        session = [sessionCache takeSessionForPeerKey:(NSData * _Nonnull)peerKey ticket:(NSData * _Nonnull)ticket proof:(NSData * _Nonnull)proof];
+    
+    // Sessions agreed before the server's key pair changed are not resumed.
+    if ( session && keyPair && [session.encrypter.keyPairData isEqualToData:(NSData * _Nonnull)keyPair] )
+    {
+        socket.encrypter = session.encrypter;
+        socket.isEncrypting = YES;
+        [self issueEncryptionTicketToSocket:socket];
+    }
+    else
+    {
+        [socket sendPacket:[handshake rejectResumptionMessage]];
+    }
+}
+
+// Messages go through the conflation buffer and then the priority scheduler, whichever are set. Otherwise delegates
+// that take batches receive messages through the batcher; call `-endRead` on it once the read is parsed.
+// With read flow control, the whole chain is wrapped so that messages are counted on the way in and out.
+- (nullable id<F53OSCPacketDestination>) destinationForRead
+{
+    id<F53OSCServerDelegate> delegate = self.delegate;
+    
+    id<F53OSCPacketDestination> delivery = delegate;
+    F53OSCReadFlowControl *readFlowControl = self.readFlowControl;
+    if ( readFlowControl )
+        delivery = [readFlowControl outletForOwner:self toDestination:delegate];
+    
+    id<F53OSCPacketDestination> destination = delivery;
+    F53OSCPriorityScheduler *priorityScheduler = self.priorityScheduler;
+    F53OSCConflationBuffer *conflationBuffer = self.conflationBuffer;
+    if ( priorityScheduler )
+    {
+        priorityScheduler.destination = destination;
+        destination = priorityScheduler;
+    }
+    if ( conflationBuffer )
+    {
+        conflationBuffer.destination = destination;
+        destination = conflationBuffer;
+    }
+    
+    if ( !priorityScheduler && !conflationBuffer && [delegate respondsToSelector:@selector(takeMessages:)] )
+    {
+        self.messageBatcher.destination = delivery;
+        self.messageBatcher.maxBatchSize = self.maxMessageBatchSize;
+        self.messageBatcher.maxLatency = self.messageBatchLatency;
+        destination = self.messageBatcher;
+    }
+    
+    if ( readFlowControl )
+        return [readFlowControl inletForOwner:self toDestination:destination];
+    
+    return destination;
+}
+
+- (void) performDelegateCallback:(dispatch_block_t)block
+{
+    dispatch_queue_t queue = self.delegateCallbackQueue;
+    if ( queue == dispatch_get_main_queue() && [NSThread isMainThread] )
+        block();
+    else
+        dispatch_async( queue, block );
+}
+
 #pragma mark - GCDAsyncSocketDelegate
 
 - (nullable dispatch_queue_t) newSocketQueueForConnectionFromAddress:(NSData *)address onSocket:(GCDAsyncSocket *)sock
@@ -270,6 +593,7 @@ NS_ASSUME_NONNULL_BEGIN
     F53OSCSocket *activeSocket = [F53OSCSocket socketWithTcpSocket:newSocket];
     activeSocket.host = newSocket.connectedHost;
     activeSocket.port = newSocket.connectedPort;
+    activeSocket.options = self.socketOptions;
 
     NSNumber *key = [NSNumber numberWithLong:self.activeIndex];
     [self.activeTcpSockets setObject:activeSocket forKey:key];
@@ -283,14 +607,9 @@ NS_ASSUME_NONNULL_BEGIN
     
     if ( [self.delegate respondsToSelector:@selector(serverDidConnect:toSocket:)] )
     {
-        dispatch_block_t block = ^{
+        [self performDelegateCallback:^{
             [self.delegate serverDidConnect:self toSocket:activeSocket];
-        };
-        
-        if ( [NSThread isMainThread] )
-            block();
-        else
-            dispatch_async( dispatch_get_main_queue(), block );
+        }];
     }
 }
 
@@ -312,7 +631,36 @@ NS_ASSUME_NONNULL_BEGIN
     NSMutableDictionary<NSString *, id> *activeState = [self.activeState objectForKey:key];
     if ( activeData && activeState )
     {
-        [F53OSCParser translateSlipData:data toData:activeData withState:activeState destination:self.delegate controlHandler:self];
+        F53OSCRateLimiter *rateLimiter = self.rateLimiter;
+        if ( rateLimiter )
+        {
+            F53OSCSocket *activeSocket = activeState[@"socket"];
+            NSString *peer = [NSString stringWithFormat:@"%@:%hu", activeSocket.host, activeSocket.port];
+            // TCP is a read-chunk limit: each read is charged as one packet, however many SLIP frames it carries.
+            if ( ![rateLimiter admitPacketOfLength:data.length fromPeer:peer] )
+            {
+                // Discard the rejected chunk. If it stopped partway into a frame, also discard the rest of that frame.
+                const Byte *bytes = data.bytes;
+                BOOL endsOnFrameBoundary = ( data.length > 0 && bytes[data.length - 1] == END );
+                [activeData setData:[NSData data]];
+                activeState[@"dangling_ESC"] = @NO;
+                activeState[@"dropping_frame"] = @( !endsOnFrameBoundary );
+                [sock readDataWithTimeout:-1 tag:tag];
+                return;
+            }
+        }
+        
+        activeState[@"schemaRegistry"] = self.schemaRegistry;
+        [F53OSCParser translateSlipData:data toData:activeData withState:activeState destination:[self destinationForRead] controlHandler:self];
+        [self.messageBatcher endRead];
+        
+        // Leave the next read to the flow control while too many of this connection's messages are undelivered.
+        F53OSCReadFlowControl *readFlowControl = self.readFlowControl;
+        if ( readFlowControl && [readFlowControl shouldPauseReadsFromSocket:activeState[@"socket"] resumeHandler:^{
+            [sock readDataWithTimeout:-1 tag:tag];
+        }] )
+            return;
+        
         [sock readDataWithTimeout:-1 tag:tag];
     }
 }
@@ -380,16 +728,12 @@ NS_ASSUME_NONNULL_BEGIN
     {
         if ( [self.delegate respondsToSelector:@selector(serverDidDisconnect:fromSocket:)] )
         {
-            dispatch_block_t block = ^{
+            [self performDelegateCallback:^{
                 [self.delegate serverDidDisconnect:self fromSocket:socket];
-            };
-            
-            if ( [NSThread isMainThread] )
-                block();
-            else
-                dispatch_async( dispatch_get_main_queue(), block );
+            }];
         }
         
+        [self.readFlowControl removeSocket:socket];
         [self.activeTcpSockets removeObjectForKey:keyOfDyingSocket];
         [self.activeData removeObjectForKey:keyOfDyingSocket];
         [self.activeState removeObjectForKey:keyOfDyingSocket];
@@ -424,15 +768,234 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void) udpSocket:(GCDAsyncUdpSocket *)sock didReceiveData:(NSData *)data fromAddress:(NSData *)address withFilterContext:(nullable id)filterContext
 {
-    GCDAsyncUdpSocket *rawReplySocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:self delegateQueue:self.udpSocket.udpSocket.delegateQueue];
-    F53OSCSocket *replySocket = [F53OSCSocket socketWithUdpSocket:rawReplySocket];
-    replySocket.host = [GCDAsyncUdpSocket hostFromAddress:address];
-    replySocket.port = self.udpReplyPort;
-    replySocket.IPv6Enabled = self.isIPv6Enabled;
+    [self receiveUdpData:data fromHost:[GCDAsyncUdpSocket hostFromAddress:address] port:[GCDAsyncUdpSocket portFromAddress:address] receivedTimestamp:0];
+}
 
+// Called on the server's queue by either UDP transport.
+- (void) receiveUdpData:(NSData *)data fromHost:(nullable NSString *)host port:(UInt16)port receivedTimestamp:(NSTimeInterval)receivedTimestamp
+{
     [self.udpSocket.stats addBytes:[data length]];
+    
+    // Reject before anything is allocated or parsed for this datagram.
+    F53OSCRateLimiter *rateLimiter = self.rateLimiter;
+    if ( rateLimiter )
+    {
+        NSString *peer = [NSString stringWithFormat:@"%@:%hu", host, port];
+        if ( ![rateLimiter admitPacketOfLength:data.length fromPeer:peer] )
+            return;
+    }
+    
+    // Peers with an encrypted UDP session are answered from their session's socket, at the port they send from.
+    F53OSCSocket *replySocket = nil;
+    id<F53OSCControlHandler> controlHandler = nil;
+    BOOL wasEncrypted = NO;
+    if ( self.udpEncryptionEnabled && self.keyPair && data.length )
+    {
+        controlHandler = self;
+        NSString *peer = [NSString stringWithFormat:@"%@:%hu", host, port];
+        char marker = ((const char *)data.bytes)[0];
+        
+        F53OSCSocket *confirmedSocket = nil;
+        F53OSCSocket *unconfirmedSocket = nil;
+        @synchronized( self.udpEncryptionSessions )
+        {
+            confirmedSocket = self.udpEncryptionSessions[peer];
+            unconfirmedSocket = self.unconfirmedUdpEncryptionSessions[peer];
+        }
+        
+        if ( marker == '*' )
+        {
+            // Forged, replayed, and sessionless datagrams are dropped here.
+            replySocket = confirmedSocket;
+            NSData *clearData = [confirmedSocket.datagramCipher openDatagram:data];
+            if ( clearData == nil && unconfirmedSocket )
+            {
+                // The first datagram sealed with a new session's key confirms it, should `!beginEncryption` be lost.
+                replySocket = unconfirmedSocket;
+                clearData = [unconfirmedSocket.datagramCipher openDatagram:data];
+                if ( clearData )
+                    [self confirmUdpEncryptionSession:unconfirmedSocket forPeer:peer];
+            }
+            if ( clearData == nil )
+                return;
+            
+            replySocket.isEncrypting = YES;
+            data = clearData;
+            wasEncrypted = YES;
+        }
+        else if ( marker == '!' )
+        {
+            // Handshake messages go to the newest session. A socket made for a request is kept only if the request is answered.
+            replySocket = unconfirmedSocket ?: confirmedSocket ?: [self newUdpEncryptionSocketForHost:host port:port];
+        }
+        else
+        {
+            replySocket = confirmedSocket ?: unconfirmedSocket;
+        }
+    }
+    
+    // Packets the ring can not carry, e.g. to unregistered addresses, still reach the delegate. Like the parser, the ring
+    // takes nothing but opened datagrams from a peer whose session is encrypting.
+    F53OSCRealtimeRing *realtimeRing = self.realtimeRing;
+    if ( realtimeRing && ( wasEncrypted || !replySocket.isEncrypting ) )
+    {
+        F53OSCRealtimeRingPushResult result = F53OSCRealtimeRingPushPacket( realtimeRing.ringRef, data.bytes, data.length, receivedTimestamp );
+        if ( result == F53OSCRealtimeRingPushed || result == F53OSCRealtimeRingPushOverflowed )
+            return;
+    }
+    
+    if ( replySocket == nil )
+    {
+        GCDAsyncUdpSocket *rawReplySocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:self delegateQueue:self.udpSocket.udpSocket.delegateQueue];
+        replySocket = [F53OSCSocket socketWithUdpSocket:rawReplySocket];
+        replySocket.host = host;
+        replySocket.port = self.udpReplyPort;
+        replySocket.IPv6Enabled = self.isIPv6Enabled;
+    }
 
-    [F53OSCParser processOscData:data forDestination:self.delegate replyToSocket:replySocket controlHandler:nil wasEncrypted:NO];
+    [F53OSCParser processOscData:data forDestination:[self destinationForRead] replyToSocket:(F53OSCSocket * _Nonnull)replySocket controlHandler:controlHandler wasEncrypted:wasEncrypted receivedTimestamp:receivedTimestamp
+                  schemaRegistry:self.schemaRegistry];
+    [self.messageBatcher endRead];
+}
+
+#pragma mark - encrypted UDP sessions
+
+- (NSUInteger) udpEncryptionSessionCount
+{
+    @synchronized( self.udpEncryptionSessions )
+    {
+        return self.udpEncryptionSessions.count;
+    }
+}
+
+- (NSUInteger) unconfirmedUdpEncryptionSessionCount
+{
+    @synchronized( self.udpEncryptionSessions )
+    {
+        return self.unconfirmedUdpEncryptionSessions.count;
+    }
+}
+
+// A request may be repeated after a lost approval, or forged by anyone who can send from the peer's address. A confirmed
+// session keeps its key, and the peer is sent the same approval again. Any other request is answered from an unconfirmed
+// session, keyed afresh each time, which replaces the confirmed one only once a datagram sealed with its key arrives.
+- (void) handleUdpEncryptionRequest:(F53OSCMessage *)message peerKey:(NSData *)peerKey
+{
+    F53OSCSocket *socket = message.replySocket;
+    NSString *peer = [NSString stringWithFormat:@"%@:%hu", socket.host, socket.port];
+    
+    F53OSCSocket *confirmedSocket = nil;
+    @synchronized( self.udpEncryptionSessions )
+    {
+        confirmedSocket = self.udpEncryptionSessions[peer];
+    }
+    
+    F53OSCEncrypt *confirmedEncrypter = confirmedSocket.encrypter;
+    if ( confirmedEncrypter && [confirmedEncrypter.peerKey isEqualToData:peerKey] )
+    {
+        F53OSCMessage *approveEncryptingMessage = [[F53OSCEncryptHandshake handshakeWithEncrypter:(F53OSCEncrypt * _Nonnull)confirmedEncrypter] approveEncryptionMessage];
+        if ( approveEncryptingMessage )
+            [confirmedSocket sendPacket:approveEncryptingMessage];
+        return;
+    }
+    
+    // e.g. the peer now has another key pair.
+    if ( socket == confirmedSocket )
+        socket = [self newUdpEncryptionSocketForHost:socket.host port:socket.port];
+    
+    if ( !socket.encrypter )
+        [socket setKeyPair:self.keyPair];
+    F53OSCEncryptHandshake *handshake = [F53OSCEncryptHandshake handshakeWithEncrypter:(F53OSCEncrypt * _Nonnull)socket.encrypter];
+    if ( ![handshake processHandshakeMessage:message] )
+        return;
+    
+    // The new key gets a new cipher, so that nothing counted under the old key carries over.
+    socket.isEncrypting = NO;
+    socket.datagramCipher = [[F53OSCDatagramCipher alloc] initWithEncrypter:(F53OSCEncrypt * _Nonnull)socket.encrypter initiator:NO];
+    [self addUnconfirmedUdpEncryptionSession:socket forPeer:peer];
+    
+    F53OSCMessage *approveEncryptingMessage = [handshake approveEncryptionMessage];
+    if ( approveEncryptingMessage )
+        [socket sendPacket:approveEncryptingMessage];
+}
+
+- (F53OSCSocket *) newUdpEncryptionSocketForHost:(nullable NSString *)host port:(UInt16)port
+{
+    GCDAsyncUdpSocket *rawSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:self delegateQueue:self.udpSocket.udpSocket.delegateQueue];
+    F53OSCSocket *socket = [F53OSCSocket socketWithUdpSocket:rawSocket];
+    socket.host = host;
+    socket.port = port;
+    socket.IPv6Enabled = self.isIPv6Enabled;
+    return socket;
+}
+
+// Unconfirmed sessions are kept to a few, and make room before confirmed ones do, so that a flood of requests can not
+// push out the sessions in use.
+- (void) addUnconfirmedUdpEncryptionSession:(F53OSCSocket *)socket forPeer:(NSString *)peer
+{
+    NSUInteger maxSessions = self.maxUdpEncryptionSessions;
+    @synchronized( self.udpEncryptionSessions )
+    {
+        F53OSCSocket *unconfirmedSocket = self.unconfirmedUdpEncryptionSessions[peer];
+        if ( unconfirmedSocket == socket )
+            return;
+        
+        if ( unconfirmedSocket )
+        {
+            [unconfirmedSocket.udpSocket close];
+            [self.unconfirmedUdpEncryptionSessions removeObjectForKey:peer];
+            [self.unconfirmedUdpEncryptionSessionPeers removeObject:peer];
+        }
+        
+        while ( self.unconfirmedUdpEncryptionSessionPeers.count >= F53OSCServerMaxUnconfirmedUdpEncryptionSessions ||
+                ( maxSessions && self.unconfirmedUdpEncryptionSessionPeers.count + self.udpEncryptionSessionPeers.count >= maxSessions ) )
+        {
+            if ( self.unconfirmedUdpEncryptionSessionPeers.count )
+            {
+                NSString *oldestPeer = self.unconfirmedUdpEncryptionSessionPeers.firstObject;
+                [self.unconfirmedUdpEncryptionSessions[oldestPeer].udpSocket close];
+                [self.unconfirmedUdpEncryptionSessions removeObjectForKey:oldestPeer];
+                [self.unconfirmedUdpEncryptionSessionPeers removeObjectAtIndex:0];
+            }
+            else if ( self.udpEncryptionSessionPeers.count )
+            {
+                NSString *oldestPeer = self.udpEncryptionSessionPeers.firstObject;
+                [self.udpEncryptionSessions[oldestPeer].udpSocket close];
+                [self.udpEncryptionSessions removeObjectForKey:oldestPeer];
+                [self.udpEncryptionSessionPeers removeObjectAtIndex:0];
+            }
+            else
+            {
+                break;
+            }
+        }
+        
+        self.unconfirmedUdpEncryptionSessions[peer] = socket;
+        [self.unconfirmedUdpEncryptionSessionPeers addObject:peer];
+    }
+}
+
+// Moves an unconfirmed session to the confirmed sessions, in place of any earlier session with the peer.
+- (void) confirmUdpEncryptionSession:(F53OSCSocket *)socket forPeer:(NSString *)peer
+{
+    @synchronized( self.udpEncryptionSessions )
+    {
+        if ( self.unconfirmedUdpEncryptionSessions[peer] != socket )
+            return;
+        
+        [self.unconfirmedUdpEncryptionSessions removeObjectForKey:peer];
+        [self.unconfirmedUdpEncryptionSessionPeers removeObject:peer];
+        
+        F53OSCSocket *confirmedSocket = self.udpEncryptionSessions[peer];
+        if ( confirmedSocket )
+        {
+            [confirmedSocket.udpSocket close];
+            [self.udpEncryptionSessionPeers removeObject:peer];
+        }
+        
+        self.udpEncryptionSessions[peer] = socket;
+        [self.udpEncryptionSessionPeers addObject:peer];
+    }
 }
 
 - (void) udpSocketDidClose:(GCDAsyncUdpSocket *)sock withError:(nullable NSError *)error
@@ -40,6 +40,7 @@ NS_ASSUME_NONNULL_BEGIN
 #define F53_OSC_SOCKET_DEBUG 0
 
 @class F53OSCPacket;
+@class F53OSCDatagramCipher;
 @class F53OSCEncrypt;
 
 typedef NS_ENUM( NSInteger, F53TCPDataFraming ) {
@@ -60,6 +61,28 @@ typedef NS_ENUM( NSInteger, F53TCPDataFraming ) {
 @end
 
 
+///
+///  F53OSCSocketOptions holds kernel socket options for an F53OSCSocket, F53OSCClient, or F53OSCServer. Zero and NO
+///  leave the system default in place. Options that do not apply to a socket, e.g. TCP options on a UDP socket, are skipped.
+///
+///  Darwin has no SO_BUSY_POLL or TCP_QUICKACK; `sendMoreAcks` sets TCP_SENDMOREACKS, its nearest counterpart. Receive
+///  timestamps use SO_TIMESTAMP, which has microsecond resolution, and are read only by F53OSCNativeUdpTransport.
+///
+
+@interface F53OSCSocketOptions : NSObject <NSCopying>
+
+@property (assign) int receiveBufferSize;   // SO_RCVBUF in bytes; a larger buffer absorbs bursts that would otherwise be dropped
+@property (assign) int sendBufferSize;      // SO_SNDBUF in bytes
+@property (assign) UInt8 dscp;              // Differentiated Services code point, 0-63, e.g. 46 for expedited forwarding; sets IP_TOS or IPV6_TCLASS
+@property (assign) BOOL noDelay;            // TCP_NODELAY; sends small packets immediately rather than coalescing them
+@property (assign) BOOL sendMoreAcks;       // TCP_SENDMOREACKS; acknowledges more often rather than delaying acks
+@property (assign) BOOL receiveTimestamps;  // SO_TIMESTAMP; stamps received packets with the kernel's receive time, see F53OSCPacket `receivedTimestamp`
+
+- (BOOL) applyToSocket:(int)fd error:(out NSError **)outError; // a BSD socket file descriptor of any family and type
+
+@end
+
+
 ///
 ///  An F53OSCSocket object represents either a TCP socket or UDP socket, but never both at the same time.
 ///
@@ -84,11 +107,26 @@ typedef NS_ENUM( NSInteger, F53TCPDataFraming ) {
 @property (nonatomic, getter=isIPv6Enabled) BOOL IPv6Enabled;
 
 @property (nonatomic, readonly) BOOL hostIsLocal;
+@property (nonatomic, readonly) BOOL hostIsMulticast;           // an IPv4 or IPv6 multicast group address
+
+// Multicast sending (UDP only): used when `host` is a multicast group. `interface`, if set, selects the outgoing interface.
+@property (nonatomic, assign) UInt8 multicastTTL;               // Default 1, i.e. the local network only
+@property (nonatomic, assign) BOOL multicastLoopback;           // Default YES; also deliver to listeners on this host
+@property (nonatomic, assign) BOOL reusePort;                   // Default NO; lets several UDP sockets listen on one port, e.g. for a multicast group
 
 @property (strong, readonly, nullable) F53OSCStats *stats;
 
+@property (nonatomic, copy, nullable) F53OSCSocketOptions *options; // Default nil; applied when listening, connecting, or sending, and immediately to an open socket
+
 @property (strong, nullable) F53OSCEncrypt *encrypter;
 @property (assign) BOOL isEncrypting;
+@property (strong, nullable) F53OSCDatagramCipher *datagramCipher; // UDP only; when set, each datagram is sealed with it while encrypting
+
+// While a resumed encryption session is unconfirmed, packets sent are also held, so that they can be sent again if
+// the peer rejects it; while not encrypting, they are only held. F53OSC control messages are never held.
+// Change `isEncrypting` while synchronized on the socket to switch atomically with respect to sends.
+- (void) beginHoldingPackets;
+- (NSArray<NSData *> *) endHoldingPackets; // returns the clear data of the packets held, in order
 
 - (BOOL) startListening;
 - (BOOL) startListening:(out NSError **)outError;
@@ -99,9 +137,21 @@ typedef NS_ENUM( NSInteger, F53TCPDataFraming ) {
 - (BOOL) isConnected;
 
 - (void) sendPacket:(F53OSCPacket *)packet;
+- (void) sendPacketData:(NSData *)data; // already-encoded OSC message or bundle; encrypted and framed as needed
+- (void) sendPacketData:(NSData *)data slipFramedData:(nullable NSData *)slipFramedData; // reuses `slipFramedData`, i.e. `data` already framed, when neither encrypting nor unframed
+
++ (NSData *) slipFramedData:(NSData *)data; // double END SLIP frame as sent over TCP
 
 - (void) setKeyPair:(NSData *)keyPair;
 
+- (BOOL) applyOptions:(out NSError **)outError; // applies `options` to the underlying sockets that are open now
+
+// Multicast receiving (UDP only): the socket must already be listening. A nil interface lets the OS choose.
+- (BOOL) joinMulticastGroup:(NSString *)group onInterface:(nullable NSString *)interface error:(out NSError **)outError;
+- (BOOL) leaveMulticastGroup:(NSString *)group onInterface:(nullable NSString *)interface error:(out NSError **)outError;
+
++ (BOOL) isMulticastAddress:(nullable NSString *)host;
+
 @end
 
 
@@ -35,8 +35,13 @@
 #elif SWIFT_PACKAGE // Swift Package Manager
 @import F53OSCEncrypt;
 #endif
+#import "F53OSCDatagramCipher.h"
 #import "F53OSCPacket.h"
 
+#import <arpa/inet.h>
+#import <netinet/in.h>
+#import <netinet/tcp.h>
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -123,6 +128,105 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+#pragma mark - F53OSCSocketOptions
+
+@interface F53OSCSocketOptions ()
+
+- (BOOL) setOption:(int)option level:(int)level value:(int)value name:(NSString *)name onSocket:(int)fd error:(out NSError **)outError;
+
+@end
+
+@implementation F53OSCSocketOptions
+
+- (id) copyWithZone:(nullable NSZone *)zone
+{
+    F53OSCSocketOptions *copy = [[[self class] allocWithZone:zone] init];
+    copy.receiveBufferSize = self.receiveBufferSize;
+    copy.sendBufferSize = self.sendBufferSize;
+    copy.dscp = self.dscp;
+    copy.noDelay = self.noDelay;
+    copy.sendMoreAcks = self.sendMoreAcks;
+    copy.receiveTimestamps = self.receiveTimestamps;
+    return copy;
+}
+
+- (NSString *) description
+{
+    return [NSString stringWithFormat:@"<F53OSCSocketOptions rcvbuf = %i sndbuf = %i dscp = %hhu noDelay = %i sendMoreAcks = %i receiveTimestamps = %i>",
+            self.receiveBufferSize, self.sendBufferSize, self.dscp, self.noDelay, self.sendMoreAcks, self.receiveTimestamps];
+}
+
+- (BOOL) applyToSocket:(int)fd error:(out NSError **)outError
+{
+    int type = 0;
+    socklen_t typeLength = sizeof( type );
+    if ( getsockopt( fd, SOL_SOCKET, SO_TYPE, &type, &typeLength ) == -1 )
+    {
+        if ( outError != NULL )
+            *outError = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{ NSLocalizedDescriptionKey : @"Not a socket." }];
+        return NO;
+    }
+    
+    struct sockaddr_storage local = { 0 };
+    socklen_t localLength = sizeof( local );
+    getsockname( fd, (struct sockaddr *)&local, &localLength );
+    
+    if ( self.receiveBufferSize > 0 && ![self setOption:SO_RCVBUF level:SOL_SOCKET value:self.receiveBufferSize name:@"SO_RCVBUF" onSocket:fd error:outError] )
+        return NO;
+    
+    if ( self.sendBufferSize > 0 && ![self setOption:SO_SNDBUF level:SOL_SOCKET value:self.sendBufferSize name:@"SO_SNDBUF" onSocket:fd error:outError] )
+        return NO;
+    
+    if ( self.dscp )
+    {
+        int trafficClass = ( self.dscp & 0x3F ) << 2; // the low two bits are ECN
+        if ( local.ss_family == AF_INET6 )
+        {
+            if ( ![self setOption:IPV6_TCLASS level:IPPROTO_IPV6 value:trafficClass name:@"IPV6_TCLASS" onSocket:fd error:outError] )
+                return NO;
+            setsockopt( fd, IPPROTO_IP, IP_TOS, &trafficClass, sizeof( trafficClass ) ); // also marks IPv4 traffic on a dual-stack socket, where supported
+        }
+        else if ( ![self setOption:IP_TOS level:IPPROTO_IP value:trafficClass name:@"IP_TOS" onSocket:fd error:outError] )
+        {
+            return NO;
+        }
+    }
+    
+    if ( type == SOCK_STREAM )
+    {
+        if ( self.noDelay && ![self setOption:TCP_NODELAY level:IPPROTO_TCP value:1 name:@"TCP_NODELAY" onSocket:fd error:outError] )
+            return NO;
+        
+#ifdef TCP_SENDMOREACKS
+        if ( self.sendMoreAcks && ![self setOption:TCP_SENDMOREACKS level:IPPROTO_TCP value:1 name:@"TCP_SENDMOREACKS" onSocket:fd error:outError] )
+            return NO;
+#endif
+    }
+    else if ( type == SOCK_DGRAM )
+    {
+        if ( self.receiveTimestamps && ![self setOption:SO_TIMESTAMP level:SOL_SOCKET value:1 name:@"SO_TIMESTAMP" onSocket:fd error:outError] )
+            return NO;
+    }
+    
+    return YES;
+}
+
+- (BOOL) setOption:(int)option level:(int)level value:(int)value name:(NSString *)name onSocket:(int)fd error:(out NSError **)outError
+{
+    if ( setsockopt( fd, level, option, &value, sizeof( value ) ) == 0 )
+        return YES;
+    
+    if ( outError != NULL )
+    {
+        int code = errno;
+        NSString *description = [NSString stringWithFormat:@"Unable to set %@ to %i - %s", name, value, strerror( code )];
+        *outError = [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:@{ NSLocalizedDescriptionKey : description }];
+    }
+    return NO;
+}
+
+@end
+
 #pragma mark - F53OSCSocket
 
 @interface F53OSCSocket ()
@@ -130,6 +234,12 @@ NS_ASSUME_NONNULL_BEGIN
 @property (strong, readwrite, nullable) GCDAsyncSocket *tcpSocket;
 @property (strong, readwrite, nullable) GCDAsyncUdpSocket *udpSocket;
 @property (strong, readwrite, nullable) F53OSCStats *stats;
+@property (assign) BOOL multicastOptionsApplied;    // reset whenever the options or the underlying socket change
+@property (strong, nullable) NSMutableArray<NSData *> *heldPacketData;
+
+- (void) sendMulticastData:(NSData *)data;
+- (void) applyOptionsLoggingFailure;
+- (NSError *) errorWithDescription:(NSString *)description;
 
 @end
 
@@ -156,6 +266,9 @@ NS_ASSUME_NONNULL_BEGIN
         self.host = @"localhost";
         self.port = 0;
         self.tcpDataFraming = F53TCPDataFramingSLIP;
+        self.multicastTTL = 1;
+        self.multicastLoopback = YES;
+        self.reusePort = NO;
     }
     return self;
 }
@@ -176,6 +289,9 @@ NS_ASSUME_NONNULL_BEGIN
         self.host = @"localhost";
         self.port = 0;
         self.tcpDataFraming = F53TCPDataFramingSLIP;
+        self.multicastTTL = 1;
+        self.multicastLoopback = YES;
+        self.reusePort = NO;
         self.stats = nil;
     }
     return self;
@@ -218,9 +334,53 @@ NS_ASSUME_NONNULL_BEGIN
         _hostIsLocal = ( !_host.length ||
                         [_host isEqualToString:@"localhost"] ||
                         [_host isEqualToString:@"127.0.0.1"] );
+        _hostIsMulticast = [F53OSCSocket isMulticastAddress:_host];
+        self.multicastOptionsApplied = NO;
     }
 }
 
+- (void) setInterface:(nullable NSString *)interface
+{
+    _interface = interface.copy;
+    self.multicastOptionsApplied = NO;
+}
+
+- (void) setMulticastTTL:(UInt8)multicastTTL
+{
+    _multicastTTL = multicastTTL;
+    self.multicastOptionsApplied = NO;
+}
+
+- (void) setMulticastLoopback:(BOOL)multicastLoopback
+{
+    _multicastLoopback = multicastLoopback;
+    self.multicastOptionsApplied = NO;
+}
+
+- (void) setOptions:(nullable F53OSCSocketOptions *)options
+{
+    _options = [options copy];
+    [self applyOptionsLoggingFailure];
+}
+
++ (BOOL) isMulticastAddress:(nullable NSString *)host
+{
+    if ( host.length == 0 )
+        return NO;
+    
+    const char *string = host.UTF8String;
+    
+    struct in_addr address4;
+    if ( inet_pton( AF_INET, string, &address4 ) == 1 )
+        return IN_MULTICAST( ntohl( address4.s_addr ) ); // 224.0.0.0/4
+    
+    struct in6_addr address6;
+    if ( inet_pton( AF_INET6, string, &address6 ) == 1 )
+        return IN6_IS_ADDR_MULTICAST( &address6 ); // ff00::/8
+    
+    return NO;
+}
+
 - (BOOL) isIPv6Enabled
 {
     if ( self.isTcpSocket )
@@ -249,12 +409,20 @@ NS_ASSUME_NONNULL_BEGIN
 {
     if ( self.tcpSocket )
     {
-        return [self.tcpSocket acceptOnInterface:self.interface port:self.port error:outError];
+        if ( ![self.tcpSocket acceptOnInterface:self.interface port:self.port error:outError] )
+            return NO;
+        
+        [self applyOptionsLoggingFailure]; // accepted sockets inherit the listening socket's buffer sizes
+        return YES;
     }
     else if ( self.udpSocket )
     {
+        if ( self.reusePort && ![self.udpSocket enableReusePort:YES error:outError] )
+            return NO;
+        
         if ( [self.udpSocket bindToPort:self.port interface:self.interface error:outError] )
         {
+            [self applyOptionsLoggingFailure];
             if ( !self.stats )
                 self.stats = [[F53OSCStats alloc] init];
             return [self.udpSocket beginReceiving:outError];
@@ -327,14 +495,87 @@ NS_ASSUME_NONNULL_BEGIN
         return;
 
     NSData *data = [packet packetData];
+    if ( data == nil )
+        return;
+
+    [self sendPacketData:data];
+}
 
-    if ( self.isEncrypting )
++ (NSData *) slipFramedData:(NSData *)data
+{
+    // Outgoing OSC messages are framed using the double END SLIP protocol: http://www.rfc-editor.org/rfc/rfc1055.txt
+    // Every byte expands to at most two, so one allocation covers the frame.
+    
+    NSUInteger length = [data length];
+    const Byte *buffer = [data bytes];
+    Byte *frame = malloc( 2 * length + 2 );
+    if ( frame == NULL )
+        return [NSData data];
+    
+    NSUInteger frameLength = 0;
+    frame[frameLength++] = END;
+    for ( NSUInteger index = 0; index < length; index++ )
+    {
+        if ( buffer[index] == END )
+        {
+            frame[frameLength++] = ESC;
+            frame[frameLength++] = ESC_END;
+        }
+        else if ( buffer[index] == ESC )
+        {
+            frame[frameLength++] = ESC;
+            frame[frameLength++] = ESC_ESC;
+        }
+        else
+        {
+            frame[frameLength++] = buffer[index];
+        }
+    }
+    frame[frameLength++] = END;
+    
+    Byte *fitted = realloc( frame, frameLength );
+    if ( fitted )
+        frame = fitted;
+    
+    return [NSData dataWithBytesNoCopy:frame length:frameLength freeWhenDone:YES];
+}
+
+- (void) sendPacketData:(NSData *)data
+{
+    [self sendPacketData:data slipFramedData:nil];
+}
+
+- (void) sendPacketData:(NSData *)data slipFramedData:(nullable NSData *)slipFramedData
+{
+    BOOL isEncrypting;
+    @synchronized( self )
+    {
+        isEncrypting = self.isEncrypting;
+        if ( self.heldPacketData && data.length && ((const char *)data.bytes)[0] != '!' )
+        {
+            [self.heldPacketData addObject:data];
+            if ( !isEncrypting )
+                return;
+        }
+    }
+    
+    F53OSCDatagramCipher *datagramCipher = self.datagramCipher;
+    if ( isEncrypting && datagramCipher && self.udpSocket )
+    {
+        NSData *datagram = [datagramCipher sealPacketData:data];
+        if ( datagram == nil )
+            return;
+        data = datagram;
+        slipFramedData = nil;
+    }
+    else if ( isEncrypting )
     {
         NSData *encrypted = [self.encrypter encryptDataWithClearData:data];
         char *beginning = "*";
         NSMutableData *newData = [NSMutableData dataWithBytes:beginning length:1];
         [newData appendData:encrypted];
         data = newData;
+        slipFramedData = nil; // the frame holds the clear data
     }
 
     //NSLog( @"%@ sending message with native length: %li", self, [data length] );
@@ -346,40 +587,28 @@ NS_ASSUME_NONNULL_BEGIN
             case F53TCPDataFramingNone:
                 break;
 
-            case F53TCPDataFramingSLIP: {
-
-                // Outgoing OSC messages are framed using the double END SLIP protocol: http://www.rfc-editor.org/rfc/rfc1055.txt
-
-                NSMutableData *slipData = [NSMutableData data];
-                Byte esc_end[2] = {ESC, ESC_END};
-                Byte esc_esc[2] = {ESC, ESC_ESC};
-                Byte end[1] = {END};
-
-                [slipData appendBytes:end length:1];
-                NSUInteger length = [data length];
-                const Byte *buffer = [data bytes];
-                for ( NSUInteger index = 0; index < length; index++ )
-                {
-                    if ( buffer[index] == END )
-                        [slipData appendBytes:esc_end length:2];
-                    else if ( buffer[index] == ESC )
-                        [slipData appendBytes:esc_esc length:2];
-                    else
-                        [slipData appendBytes:&(buffer[index]) length:1];
-                }
-                [slipData appendBytes:end length:1];
-
-                data = slipData;
-
-            } break;
+            case F53TCPDataFramingSLIP:
+                data = ( slipFramedData ? slipFramedData : [F53OSCSocket slipFramedData:data] );
+                break;
         }
 
         [self.tcpSocket writeData:data withTimeout:-1 tag:[data length]];
     }
     else if ( self.udpSocket )
     {
+        if ( self.hostIsMulticast )
+        {
+            [self sendMulticastData:data];
+            return;
+        }
+        
+        // With options set, the socket stays open between sends so that its options persist. Encrypting sockets stay
+        // open so that the peer can tell their session apart by its address.
+        BOOL keepsSocketOpen = ( self.options != nil || self.encrypter != nil );
+        BOOL needsBind = ( keepsSocketOpen ? [self.udpSocket isClosed] : ( self.interface != nil ) );
+        
         NSError *error = nil;
-        if ( self.interface )
+        if ( needsBind )
         {
             // Port 0 means that the OS should choose a random ephemeral port for this socket.
             [self.udpSocket bindToPort:0 interface:self.interface error:&error];
@@ -389,6 +618,9 @@ NS_ASSUME_NONNULL_BEGIN
                 NSLog( @"Warning: %@ unable to bind interface %@ - %@", self, self.interface, [error localizedDescription] );
                 return;
             }
+            
+            if ( keepsSocketOpen )
+                [self applyOptionsLoggingFailure];
         }
 
         if ( ![self.udpSocket enableBroadcast:YES error:&error] )
@@ -400,7 +632,8 @@ NS_ASSUME_NONNULL_BEGIN
         if ( self.host )
             [self.udpSocket sendData:data toHost:(NSString * _Nonnull)self.host port:self.port withTimeout:-1 tag:0];
         
-        [self.udpSocket closeAfterSending];
+        if ( !keepsSocketOpen )
+            [self.udpSocket closeAfterSending];
     }
 }
 
@@ -409,6 +642,180 @@ NS_ASSUME_NONNULL_BEGIN
     self.encrypter = [[F53OSCEncrypt alloc] initWithKeyPairData:keyPair];
 }
 
+- (void) beginHoldingPackets
+{
+    @synchronized( self )
+    {
+        if ( !self.heldPacketData )
+            self.heldPacketData = [NSMutableArray array];
+    }
+}
+
+- (NSArray<NSData *> *) endHoldingPackets
+{
+    @synchronized( self )
+    {
+        NSArray<NSData *> *heldPacketData = ( self.heldPacketData ? [self.heldPacketData copy] : @[] );
+        self.heldPacketData = nil;
+        return heldPacketData;
+    }
+}
+
+- (BOOL) applyOptions:(out NSError **)outError
+{
+    F53OSCSocketOptions *options = self.options;
+    if ( options == nil )
+        return YES;
+    
+    __block BOOL applied = YES;
+    __block NSError *error = nil;
+    void (^applyToSockets)( int fd4, int fd6 ) = ^( int fd4, int fd6 ) {
+        NSError *socketError = nil;
+        if ( fd4 != -1 && ![options applyToSocket:fd4 error:&socketError] )
+        {
+            applied = NO;
+            error = socketError;
+        }
+        if ( fd6 != -1 && fd6 != fd4 && ![options applyToSocket:fd6 error:&socketError] )
+        {
+            applied = NO;
+            error = socketError;
+        }
+    };
+    
+    // The file descriptors may only be used on the socket's own queue.
+    GCDAsyncSocket *tcpSocket = self.tcpSocket;
+    GCDAsyncUdpSocket *udpSocket = self.udpSocket;
+    if ( tcpSocket )
+    {
+        [tcpSocket performBlock:^{
+            applyToSockets( [tcpSocket socket4FD], [tcpSocket socket6FD] );
+        }];
+    }
+    else if ( udpSocket )
+    {
+        [udpSocket performBlock:^{
+            applyToSockets( [udpSocket socket4FD], [udpSocket socket6FD] );
+        }];
+    }
+    
+    if ( !applied && outError != NULL )
+        *outError = error;
+    return applied;
+}
+
+- (void) applyOptionsLoggingFailure
+{
+    NSError *error = nil;
+    if ( ![self applyOptions:&error] )
+        NSLog( @"Warning: %@ unable to apply socket options %@ - %@", self, self.options, [error localizedDescription] );
+}
+
+#pragma mark - multicast
+
+// Unlike unicast sends, the socket stays open between multicast sends so that its options persist.
+- (void) sendMulticastData:(NSData *)data
+{
+    GCDAsyncUdpSocket *udpSocket = self.udpSocket;
+    if ( udpSocket == nil || self.host == nil )
+        return;
+    
+    if ( [udpSocket isClosed] )
+    {
+        self.multicastOptionsApplied = NO;
+        
+        NSError *error = nil;
+        if ( ![udpSocket bindToPort:0 interface:nil error:&error] )
+        {
+            NSLog( @"Warning: %@ unable to open a socket for multicast - %@", self, [error localizedDescription] );
+            return;
+        }
+        
+        [self applyOptionsLoggingFailure];
+    }
+    
+    if ( !self.multicastOptionsApplied )
+    {
+        NSError *error = nil;
+        NSString *interface = self.interface;
+        if ( interface.length )
+        {
+            BOOL isIPv6Group = ( [self.host rangeOfString:@":"].location != NSNotFound );
+            BOOL selected = ( isIPv6Group ? [udpSocket sendIPv6MulticastOnInterface:(NSString * _Nonnull)interface error:&error]
+                                          : [udpSocket sendIPv4MulticastOnInterface:(NSString * _Nonnull)interface error:&error] );
+            if ( !selected )
+                NSLog( @"Warning: %@ unable to send multicast on interface %@ - %@", self, interface, [error localizedDescription] );
+        }
+        
+        int ttl = self.multicastTTL;
+        u_char ttl4 = (u_char)self.multicastTTL;
+        u_char loop4 = ( self.multicastLoopback ? 1 : 0 );
+        u_int loop6 = ( self.multicastLoopback ? 1 : 0 );
+        // errno is read inside the block, on the socket's queue, right after the call that failed.
+        __block int errorCode = 0;
+        [udpSocket performBlock:^{
+            int fd4 = [udpSocket socket4FD];
+            if ( fd4 != -1 )
+            {
+                if ( setsockopt( fd4, IPPROTO_IP, IP_MULTICAST_TTL, &ttl4, sizeof( ttl4 ) ) != 0 && !errorCode )
+                    errorCode = errno;
+                if ( setsockopt( fd4, IPPROTO_IP, IP_MULTICAST_LOOP, &loop4, sizeof( loop4 ) ) != 0 && !errorCode )
+                    errorCode = errno;
+            }
+            int fd6 = [udpSocket socket6FD];
+            if ( fd6 != -1 )
+            {
+                if ( setsockopt( fd6, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &ttl, sizeof( ttl ) ) != 0 && !errorCode )
+                    errorCode = errno;
+                if ( setsockopt( fd6, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &loop6, sizeof( loop6 ) ) != 0 && !errorCode )
+                    errorCode = errno;
+            }
+        }];
+        if ( errorCode )
+            NSLog( @"Warning: %@ unable to set multicast TTL and loopback - %s", self, strerror( errorCode ) );
+        
+        self.multicastOptionsApplied = YES;
+    }
+    
+    [udpSocket sendData:data toHost:(NSString * _Nonnull)self.host port:self.port withTimeout:-1 tag:0];
+}
+
+- (BOOL) joinMulticastGroup:(NSString *)group onInterface:(nullable NSString *)interface error:(out NSError **)outError
+{
+    if ( self.udpSocket == nil )
+    {
+        if ( outError != NULL )
+            *outError = [self errorWithDescription:@"Multicast requires a UDP socket."];
+        return NO;
+    }
+    
+    if ( ![F53OSCSocket isMulticastAddress:group] )
+    {
+        if ( outError != NULL )
+            *outError = [self errorWithDescription:[NSString stringWithFormat:@"%@ is not a multicast group address.", group]];
+        return NO;
+    }
+    
+    return [self.udpSocket joinMulticastGroup:group onInterface:interface error:outError];
+}
+
+- (BOOL) leaveMulticastGroup:(NSString *)group onInterface:(nullable NSString *)interface error:(out NSError **)outError
+{
+    if ( self.udpSocket == nil )
+    {
+        if ( outError != NULL )
+            *outError = [self errorWithDescription:@"Multicast requires a UDP socket."];
+        return NO;
+    }
+    
+    return [self.udpSocket leaveMulticastGroup:group onInterface:interface error:outError];
+}
+
+- (NSError *) errorWithDescription:(NSString *)description
+{
+    return [NSError errorWithDomain:@"F53OSCSocketErrorDomain" code:-1 userInfo:@{ NSLocalizedDescriptionKey : description }];
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
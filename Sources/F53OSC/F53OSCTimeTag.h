@@ -33,11 +33,14 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (assign) UInt32 seconds;
 @property (assign) UInt32 fraction;
+@property (readonly) uint64_t wireValue; // seconds in the high 32 bits and fraction in the low, as F53OSCWire reads and writes time tags
 
 + (F53OSCTimeTag *) timeTagWithDate:(NSDate *)date;
 + (F53OSCTimeTag *) immediateTimeTag;
++ (F53OSCTimeTag *) timeTagWithWireValue:(uint64_t)wireValue;
 
 - (NSData *) oscTimeTagData;
+- (void) appendOSCTimeTagDataToData:(NSMutableData *)data;
 + (nullable F53OSCTimeTag *) timeTagWithOSCTimeBytes:(char *)buf;
 
 @end
@@ -30,6 +30,7 @@
 
 #import "F53OSCTimeTag.h"
 
+#import "F53OSCWire.h"
 #import "NSDate+F53OSCTimeTag.h"
 
 
@@ -63,34 +64,51 @@ NS_ASSUME_NONNULL_BEGIN
     return result;
 }
 
++ (F53OSCTimeTag *) timeTagWithWireValue:(uint64_t)wireValue
+{
+    F53OSCTimeTag *result = [[F53OSCTimeTag alloc] init];
+    result.seconds = (UInt32)( wireValue >> 32 );
+    result.fraction = (UInt32)wireValue;
+    return result;
+}
+
 + (nullable F53OSCTimeTag *) timeTagWithOSCTimeBytes:(char *)buf
 {
     if ( buf == NULL )
         return nil;
     
-    UInt32 seconds = *((UInt32 *)buf);
-    buf += sizeof( UInt32 );
-    UInt32 fraction = *((UInt32 *)buf);
-    
-    F53OSCTimeTag *result = [[F53OSCTimeTag alloc] init];
-    result.seconds = OSSwapBigToHostInt32( seconds );
-    result.fraction = OSSwapBigToHostInt32( fraction );
-    return result;
+    F53OSCWireReader reader;
+    uint64_t wireValue = 0;
+    F53OSCWireReaderInit( &reader, buf, sizeof( wireValue ) ); // the caller guarantees 8 bytes
+    F53OSCWireReadTimeTag( &reader, &wireValue );
+    return [F53OSCTimeTag timeTagWithWireValue:wireValue];
 }
 
 
 #pragma mark -
 
+- (uint64_t) wireValue
+{
+    return ( (uint64_t)self.seconds << 32 ) | self.fraction;
+}
+
 - (NSData *) oscTimeTagData
 {
-    UInt32 swappedSeconds = OSSwapHostToBigInt32( self.seconds );
-    UInt32 swappedFraction = OSSwapHostToBigInt32( self.fraction );
-    NSMutableData *data = [NSMutableData data];
-    [data appendBytes:&swappedSeconds length:sizeof( UInt32 )];
-    [data appendBytes:&swappedFraction length:sizeof( UInt32 )];
+    NSMutableData *data = [NSMutableData dataWithCapacity:8];
+    [self appendOSCTimeTagDataToData:data];
     return [data copy];
 }
 
+- (void) appendOSCTimeTagDataToData:(NSMutableData *)data
+{
+    NSUInteger offset = data.length;
+    [data increaseLengthBy:8];
+    
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit( &writer, (uint8_t *)data.mutableBytes + offset, 8 );
+    F53OSCWireWriteTimeTag( &writer, self.wireValue );
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,79 @@
+//
+//  F53OSCTransportEngine.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+//
+//  F53OSCTransportEngine lets many F53OSCClients share a fixed set of sockets and queues instead of each one
+//  owning its own. Set a client's `transportEngine` to opt in.
+//
+//  - UDP clients send from a pool of sockets, one per interface and address family, to a destination address
+//    resolved once per host and port and shared by every client that sends there. A UDP client keeps no socket
+//    of its own; multicast destinations still use the client's own socket.
+//  - TCP clients still need a connection each, but their sockets run on a fixed pool of worker queues rather
+//    than on a queue created per socket.
+//
+//  Resolved UDP addresses are cached; call `invalidateResolvedAddresses` after DNS changes. A host that fails to
+//  resolve is looked up again once `failedLookupRetryInterval` has passed, so a transient DNS failure is not permanent.
+//
+//  Example usage:
+//  F53OSCTransportEngine *engine = [F53OSCTransportEngine sharedEngine];
+//  for ( F53OSCClient *client in fixtures )
+//      client.transportEngine = engine;
+//
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSCTransportEngine : NSObject
+
++ (F53OSCTransportEngine *) sharedEngine;
+
+- (instancetype) init; // one TCP worker per active processor, up to 4
+- (instancetype) initWithTcpWorkerCount:(NSUInteger)tcpWorkerCount NS_DESIGNATED_INITIALIZER;
+
+@property (readonly) NSUInteger tcpWorkerCount;
+@property (readonly) NSUInteger udpSocketCount;         // pooled UDP sockets opened so far
+@property (readonly) NSUInteger resolvedAddressCount;   // distinct UDP destinations cached
+@property (readonly) NSUInteger datagramCount;          // UDP sends from a pooled socket
+@property (readonly) NSUInteger unresolvedSendCount;    // UDP sends skipped because the host could not be resolved
+@property (readonly) NSUInteger addressGeneration;      // increments when cached addresses are invalidated
+@property (readonly) NSUInteger lookupCount;            // host lookups made, including retries of failed ones
+@property (assign)   NSTimeInterval failedLookupRetryInterval; // default 5 seconds; how long a failed lookup is cached
+
+// Returns a shared, immutable sockaddr for the destination, or nil if it can not be resolved.
+- (nullable NSData *) addressForHost:(NSString *)host port:(UInt16)port preferIPv6:(BOOL)preferIPv6;
+
+// A nil address counts as an unresolved send and returns NO.
+- (BOOL) sendDatagram:(NSData *)data toAddress:(nullable NSData *)address interface:(nullable NSString *)interface;
+
+// Serial queues handed out in turn, for use as a GCDAsyncSocket `socketQueue`.
+- (dispatch_queue_t) nextTcpWorkerQueue;
+
+- (void) invalidateResolvedAddresses;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,309 @@
+//
+//  F53OSCTransportEngine.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import "F53OSCTransportEngine.h"
+
+#import "F53OSCSocket.h"
+
+#import <sys/socket.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define F53OSC_TRANSPORT_ENGINE_MAX_DEFAULT_TCP_WORKERS 4
+#define F53OSC_TRANSPORT_ENGINE_DEFAULT_FAILED_LOOKUP_RETRY_INTERVAL 5.0 // seconds
+
+@interface F53OSCTransportEngine ()
+
+@property (strong) dispatch_queue_t udpQueue;                                           // socket queue shared by the pooled UDP sockets
+@property (strong) NSArray<dispatch_queue_t> *tcpWorkerQueues;
+@property (assign) NSUInteger nextTcpWorkerIndex;
+@property (strong) NSMutableDictionary<NSString *, GCDAsyncUdpSocket *> *udpSockets;    // "interface|family" -> socket; "" is the default interface
+@property (strong) NSMutableDictionary<NSString *, NSData *> *resolvedAddresses;        // "host|port|family" -> sockaddr
+@property (strong) NSMutableDictionary<NSString *, NSNumber *> *failedLookups;          // "host|port|family" -> system uptime after which to look up again
+@property (assign) NSUInteger totalLookupCount;
+@property (assign) NSUInteger totalDatagramCount;
+@property (assign) NSUInteger totalUnresolvedSendCount;
+@property (assign) NSUInteger generation;
+
+- (nullable GCDAsyncUdpSocket *) udpSocketForInterface:(nullable NSString *)interface IPv6:(BOOL)IPv6;
+
+@end
+
+
+@implementation F53OSCTransportEngine
+
++ (F53OSCTransportEngine *) sharedEngine
+{
+    static F53OSCTransportEngine *sharedEngine = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once( &onceToken, ^{
+        sharedEngine = [[F53OSCTransportEngine alloc] init];
+    });
+    return sharedEngine;
+}
+
+- (instancetype) init
+{
+    NSUInteger processorCount = [NSProcessInfo processInfo].activeProcessorCount;
+    return [self initWithTcpWorkerCount:MIN( MAX( processorCount, 1 ), F53OSC_TRANSPORT_ENGINE_MAX_DEFAULT_TCP_WORKERS )];
+}
+
+- (instancetype) initWithTcpWorkerCount:(NSUInteger)tcpWorkerCount
+{
+    self = [super init];
+    if ( self )
+    {
+        if ( tcpWorkerCount == 0 )
+            tcpWorkerCount = 1;
+        
+        NSMutableArray<dispatch_queue_t> *queues = [NSMutableArray arrayWithCapacity:tcpWorkerCount];
+        for ( NSUInteger i = 0; i < tcpWorkerCount; i++ )
+        {
+            NSString *label = [NSString stringWithFormat:@"com.figure53.F53OSCTransportEngine.tcp.%lu", (unsigned long)i];
+            [queues addObject:dispatch_queue_create( label.UTF8String, DISPATCH_QUEUE_SERIAL )];
+        }
+        
+        self.udpQueue = dispatch_queue_create( "com.figure53.F53OSCTransportEngine.udp", DISPATCH_QUEUE_SERIAL );
+        self.tcpWorkerQueues = queues;
+        self.nextTcpWorkerIndex = 0;
+        self.udpSockets = [NSMutableDictionary dictionary];
+        self.resolvedAddresses = [NSMutableDictionary dictionary];
+        self.failedLookups = [NSMutableDictionary dictionary];
+        self.failedLookupRetryInterval = F53OSC_TRANSPORT_ENGINE_DEFAULT_FAILED_LOOKUP_RETRY_INTERVAL;
+        self.totalLookupCount = 0;
+        self.totalDatagramCount = 0;
+        self.totalUnresolvedSendCount = 0;
+        self.generation = 0;
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    for ( GCDAsyncUdpSocket *udpSocket in self.udpSockets.allValues )
+        [udpSocket closeAfterSending];
+}
+
+- (NSUInteger) tcpWorkerCount
+{
+    return self.tcpWorkerQueues.count;
+}
+
+- (NSUInteger) udpSocketCount
+{
+    @synchronized( self )
+    {
+        return self.udpSockets.count;
+    }
+}
+
+- (NSUInteger) resolvedAddressCount
+{
+    @synchronized( self )
+    {
+        return self.resolvedAddresses.count;
+    }
+}
+
+- (NSUInteger) lookupCount
+{
+    @synchronized( self )
+    {
+        return self.totalLookupCount;
+    }
+}
+
+- (NSUInteger) datagramCount
+{
+    @synchronized( self )
+    {
+        return self.totalDatagramCount;
+    }
+}
+
+- (NSUInteger) unresolvedSendCount
+{
+    @synchronized( self )
+    {
+        return self.totalUnresolvedSendCount;
+    }
+}
+
+- (NSUInteger) addressGeneration
+{
+    @synchronized( self )
+    {
+        return self.generation;
+    }
+}
+
+- (void) invalidateResolvedAddresses
+{
+    @synchronized( self )
+    {
+        [self.resolvedAddresses removeAllObjects];
+        [self.failedLookups removeAllObjects];
+        self.generation++;
+    }
+}
+
+#pragma mark - UDP
+
+- (nullable NSData *) addressForHost:(NSString *)host port:(UInt16)port preferIPv6:(BOOL)preferIPv6
+{
+    if ( host.length == 0 )
+        return nil;
+    
+    NSString *key = [NSString stringWithFormat:@"%@|%hu|%d", host, port, preferIPv6];
+    NSTimeInterval now = [NSProcessInfo processInfo].systemUptime;
+    @synchronized( self )
+    {
+        NSData *address = self.resolvedAddresses[key];
+        if ( address )
+            return address;
+        
+        // A host that failed to resolve is not looked up again until its retry time, so that sends to it stay cheap.
+        NSNumber *retryTime = self.failedLookups[key];
+        if ( retryTime && now < retryTime.doubleValue )
+            return nil;
+        
+        self.totalLookupCount++;
+    }
+    
+    // Resolve outside the lock so that a slow lookup does not hold up sends to other destinations.
+    NSError *error = nil;
+    NSData *address = nil;
+    NSArray<NSData *> *addresses = [GCDAsyncSocket lookupHost:host port:port error:&error];
+    for ( NSData *candidate in addresses )
+    {
+        BOOL isIPv6 = [GCDAsyncSocket isIPv6Address:candidate];
+        if ( isIPv6 == preferIPv6 )
+        {
+            address = candidate;
+            break;
+        }
+        if ( address == nil )
+            address = candidate;
+    }
+    
+    if ( address == nil )
+        NSLog( @"Warning: F53OSCTransportEngine unable to resolve %@ - %@", host, error ? [error localizedDescription] : @"(no addresses)" );
+    
+    @synchronized( self )
+    {
+        // Another thread may have resolved it meanwhile; keep the first so that clients share one object.
+        NSData *existing = self.resolvedAddresses[key];
+        if ( existing )
+            return existing;
+        
+        if ( address == nil )
+        {
+            self.failedLookups[key] = @( [NSProcessInfo processInfo].systemUptime + self.failedLookupRetryInterval );
+            return nil;
+        }
+        
+        address = [address copy];
+        self.resolvedAddresses[key] = (NSData * _Nonnull)address;
+        [self.failedLookups removeObjectForKey:key];
+        return address;
+    }
+}
+
+- (BOOL) sendDatagram:(NSData *)data toAddress:(nullable NSData *)address interface:(nullable NSString *)interface
+{
+    @synchronized( self )
+    {
+        if ( address.length == 0 )
+        {
+            self.totalUnresolvedSendCount++;
+            return NO;
+        }
+        
+        BOOL IPv6 = ( ((const struct sockaddr *)address.bytes)->sa_family == AF_INET6 );
+        GCDAsyncUdpSocket *udpSocket = [self udpSocketForInterface:interface IPv6:IPv6];
+        if ( udpSocket == nil )
+            return NO;
+        
+        [udpSocket sendData:data toAddress:(NSData * _Nonnull)address withTimeout:-1 tag:0];
+        self.totalDatagramCount++;
+        return YES;
+    }
+}
+
+// Must be called while synchronized.
+- (nullable GCDAsyncUdpSocket *) udpSocketForInterface:(nullable NSString *)interface IPv6:(BOOL)IPv6
+{
+    NSString *key = [NSString stringWithFormat:@"%@|%d", ( interface ? interface : @"" ), IPv6 ? 6 : 4];
+    GCDAsyncUdpSocket *udpSocket = self.udpSockets[key];
+    if ( udpSocket )
+        return udpSocket;
+    
+    udpSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil socketQueue:self.udpQueue];
+    [udpSocket setIPv4Enabled:!IPv6];
+    [udpSocket setIPv6Enabled:IPv6];
+    
+    NSError *error = nil;
+    if ( interface.length )
+    {
+        // Port 0 means that the OS should choose a random ephemeral port for this socket.
+        if ( ![udpSocket bindToPort:0 interface:interface error:&error] )
+        {
+            NSLog( @"Warning: F53OSCTransportEngine unable to bind interface %@ - %@", interface, [error localizedDescription] );
+            return nil;
+        }
+    }
+    
+    // Match F53OSCSocket, which allows clients to address a broadcast destination.
+    if ( !IPv6 && ![udpSocket enableBroadcast:YES error:&error] )
+    {
+        NSString *errString = error ? [error localizedDescription] : @"(unknown error)";
+        NSLog( @"Warning: F53OSCTransportEngine unable to enable UDP broadcast - %@", errString );
+    }
+    
+    self.udpSockets[key] = udpSocket;
+    return udpSocket;
+}
+
+#pragma mark - TCP
+
+- (dispatch_queue_t) nextTcpWorkerQueue
+{
+    @synchronized( self )
+    {
+        dispatch_queue_t queue = self.tcpWorkerQueues[self.nextTcpWorkerIndex];
+        self.nextTcpWorkerIndex = ( self.nextTcpWorkerIndex + 1 ) % self.tcpWorkerQueues.count;
+        return queue;
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
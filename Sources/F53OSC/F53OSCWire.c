@@ -0,0 +1,339 @@
+//
+//  F53OSCWire.c
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include "F53OSCWire.h"
+
+#include <libkern/OSByteOrder.h>
+#include <string.h>
+
+
+#pragma mark - Reading
+
+void F53OSCWireReaderInit( F53OSCWireReader *reader, const void *bytes, size_t length )
+{
+    reader->bytes = bytes;
+    reader->length = ( bytes ? length : 0 );
+    reader->offset = 0;
+}
+
+bool F53OSCWireReadInt32( F53OSCWireReader *reader, int32_t *outValue )
+{
+    if ( F53OSCWireReaderRemaining( reader ) < 4 )
+        return false;
+    
+    *outValue = (int32_t)OSReadBigInt32( reader->bytes, reader->offset );
+    reader->offset += 4;
+    return true;
+}
+
+bool F53OSCWireReadFloat32( F53OSCWireReader *reader, float *outValue )
+{
+    if ( F53OSCWireReaderRemaining( reader ) < 4 )
+        return false;
+    
+    uint32_t bits = OSReadBigInt32( reader->bytes, reader->offset );
+    memcpy( outValue, &bits, sizeof( bits ) );
+    reader->offset += 4;
+    return true;
+}
+
+bool F53OSCWireReadTimeTag( F53OSCWireReader *reader, uint64_t *outTimeTag )
+{
+    if ( F53OSCWireReaderRemaining( reader ) < 8 )
+        return false;
+    
+    *outTimeTag = OSReadBigInt64( reader->bytes, reader->offset );
+    reader->offset += 8;
+    return true;
+}
+
+bool F53OSCWireReadString( F53OSCWireReader *reader, const char **outString, size_t *outLength )
+{
+    size_t remaining = F53OSCWireReaderRemaining( reader );
+    if ( remaining == 0 )
+        return false;
+    
+    const uint8_t *start = reader->bytes + reader->offset;
+    const uint8_t *terminator = memchr( start, '\0', remaining );
+    if ( terminator == NULL )
+        return false;
+    
+    size_t length = (size_t)( terminator - start );
+    *outString = (const char *)start;
+    *outLength = length;
+    reader->offset += ( F53OSCWireStringSize( length ) < remaining ? F53OSCWireStringSize( length ) : remaining );
+    return true;
+}
+
+bool F53OSCWireReadBlob( F53OSCWireReader *reader, const void **outBytes, size_t *outLength )
+{
+    size_t remaining = F53OSCWireReaderRemaining( reader );
+    if ( remaining < 4 )
+        return false;
+    
+    size_t length = OSReadBigInt32( reader->bytes, reader->offset );
+    if ( length > remaining - 4 )
+        return false;
+    
+    *outBytes = reader->bytes + reader->offset + 4;
+    *outLength = length;
+    reader->offset += ( F53OSCWireBlobSize( length ) < remaining ? F53OSCWireBlobSize( length ) : remaining );
+    return true;
+}
+
+bool F53OSCWireReadMessage( const void *bytes, size_t length, F53OSCWireMessage *outMessage )
+{
+    F53OSCWireReader *reader = &outMessage->arguments;
+    F53OSCWireReaderInit( reader, bytes, length );
+    outMessage->nextArgument = 0;
+    outMessage->argumentCount = 0;
+    outMessage->typeTags = "";
+    
+    const char *address;
+    if ( !F53OSCWireReadString( reader, &address, &outMessage->addressLength ) )
+        return false;
+    outMessage->address = address;
+    
+    // A message without a type tag string has no arguments.
+    if ( F53OSCWireReaderRemaining( reader ) == 0 || reader->bytes[reader->offset] != ',' )
+        return true;
+    
+    const char *typeTags;
+    size_t typeTagsLength;
+    if ( !F53OSCWireReadString( reader, &typeTags, &typeTagsLength ) )
+        return false;
+    outMessage->typeTags = typeTags + 1;
+    outMessage->argumentCount = typeTagsLength - 1;
+    return true;
+}
+
+F53OSCWireArgumentStatus F53OSCWireMessageNextArgument( F53OSCWireMessage *message, F53OSCWireArgument *outArgument )
+{
+    if ( message->nextArgument >= message->argumentCount )
+        return F53OSCWireArgumentsEnd;
+    
+    F53OSCWireReader *reader = &message->arguments;
+    char type = message->typeTags[message->nextArgument];
+    outArgument->type = type;
+    switch ( type )
+    {
+        case 'i':
+            if ( !F53OSCWireReadInt32( reader, &outArgument->value.i ) )
+                return F53OSCWireArgumentTruncated;
+            break;
+        case 'f':
+            if ( !F53OSCWireReadFloat32( reader, &outArgument->value.f ) )
+                return F53OSCWireArgumentTruncated;
+            break;
+        case 's':
+        {
+            const char *string;
+            if ( !F53OSCWireReadString( reader, &string, &outArgument->value.data.length ) )
+                return F53OSCWireArgumentTruncated;
+            outArgument->value.data.bytes = string;
+            break;
+        }
+        case 'b':
+            if ( !F53OSCWireReadBlob( reader, &outArgument->value.data.bytes, &outArgument->value.data.length ) )
+                return F53OSCWireArgumentTruncated;
+            break;
+        case 'T':
+        case 'F':
+        case 'N':
+        case 'I':
+            break; // no data
+        default:
+            return F53OSCWireArgumentUnknownType;
+    }
+    
+    message->nextArgument++;
+    return F53OSCWireArgumentRead;
+}
+
+bool F53OSCWireReadBundle( const void *bytes, size_t length, F53OSCWireBundle *outBundle )
+{
+    static const char bundlePrefix[8] = "#bundle"; // includes the terminating NUL, which pads the OSC string to 8 bytes
+    
+    F53OSCWireReader *reader = &outBundle->elements;
+    F53OSCWireReaderInit( reader, bytes, length );
+    outBundle->timeTag = F53OSC_WIRE_IMMEDIATELY;
+    
+    if ( length < sizeof( bundlePrefix ) || memcmp( bytes, bundlePrefix, sizeof( bundlePrefix ) ) != 0 )
+        return false;
+    reader->offset = sizeof( bundlePrefix );
+    
+    // A bundle too short for its time tag is read as empty.
+    if ( !F53OSCWireReadTimeTag( reader, &outBundle->timeTag ) )
+        reader->offset = reader->length;
+    return true;
+}
+
+F53OSCWireElementStatus F53OSCWireBundleNextElement( F53OSCWireBundle *bundle, const void **outBytes, size_t *outLength )
+{
+    F53OSCWireReader *reader = &bundle->elements;
+    if ( F53OSCWireReaderRemaining( reader ) <= 4 )
+        return F53OSCWireElementsEnd; // a trailing size with no element is ignored
+    
+    size_t length = OSReadBigInt32( reader->bytes, reader->offset );
+    if ( length > F53OSCWireReaderRemaining( reader ) - 4 )
+        return F53OSCWireElementTruncated;
+    
+    *outBytes = reader->bytes + reader->offset + 4;
+    *outLength = length;
+    reader->offset += 4 + length;
+    return F53OSCWireElementRead;
+}
+
+
+#pragma mark - Writing
+
+void F53OSCWireWriterInit( F53OSCWireWriter *writer, void *bytes, size_t capacity )
+{
+    writer->bytes = bytes;
+    writer->capacity = capacity;
+    writer->length = 0;
+    writer->overflowed = false;
+}
+
+// Returns where `size` bytes may be written, or NULL after marking the writer overflowed.
+static uint8_t *F53OSCWireReserve( F53OSCWireWriter *writer, size_t size )
+{
+    if ( writer->overflowed || size > writer->capacity - writer->length )
+    {
+        writer->overflowed = true;
+        return NULL;
+    }
+    
+    uint8_t *destination = writer->bytes + writer->length;
+    writer->length += size;
+    return destination;
+}
+
+bool F53OSCWireWriteInt32( F53OSCWireWriter *writer, int32_t value )
+{
+    uint8_t *destination = F53OSCWireReserve( writer, 4 );
+    if ( destination == NULL )
+        return false;
+    
+    OSWriteBigInt32( destination, 0, (uint32_t)value );
+    return true;
+}
+
+bool F53OSCWireWriteFloat32( F53OSCWireWriter *writer, float value )
+{
+    uint8_t *destination = F53OSCWireReserve( writer, 4 );
+    if ( destination == NULL )
+        return false;
+    
+    uint32_t bits;
+    memcpy( &bits, &value, sizeof( bits ) );
+    OSWriteBigInt32( destination, 0, bits );
+    return true;
+}
+
+bool F53OSCWireWriteTimeTag( F53OSCWireWriter *writer, uint64_t timeTag )
+{
+    uint8_t *destination = F53OSCWireReserve( writer, 8 );
+    if ( destination == NULL )
+        return false;
+    
+    OSWriteBigInt64( destination, 0, timeTag );
+    return true;
+}
+
+bool F53OSCWireWriteString( F53OSCWireWriter *writer, const char *string, size_t length )
+{
+    size_t size = F53OSCWireStringSize( length );
+    uint8_t *destination = F53OSCWireReserve( writer, size );
+    if ( destination == NULL )
+        return false;
+    
+    if ( length )
+        memcpy( destination, string, length );
+    memset( destination + length, 0, size - length );
+    return true;
+}
+
+bool F53OSCWireWriteBlob( F53OSCWireWriter *writer, const void *bytes, size_t length )
+{
+    size_t size = F53OSCWireBlobSize( length );
+    if ( length > UINT32_MAX )
+    {
+        writer->overflowed = true;
+        return false;
+    }
+    
+    uint8_t *destination = F53OSCWireReserve( writer, size );
+    if ( destination == NULL )
+        return false;
+    
+    OSWriteBigInt32( destination, 0, (uint32_t)length );
+    if ( length )
+        memcpy( destination + 4, bytes, length );
+    memset( destination + 4 + length, 0, size - 4 - length );
+    return true;
+}
+
+bool F53OSCWireWriteMessageHeader( F53OSCWireWriter *writer, const char *address, size_t addressLength, const char *typeTags, size_t typeTagCount )
+{
+    if ( !F53OSCWireWriteString( writer, address, addressLength ) )
+        return false;
+    
+    size_t size = F53OSCWireStringSize( typeTagCount + 1 );
+    uint8_t *destination = F53OSCWireReserve( writer, size );
+    if ( destination == NULL )
+        return false;
+    
+    destination[0] = ',';
+    if ( typeTagCount )
+        memcpy( destination + 1, typeTags, typeTagCount );
+    memset( destination + 1 + typeTagCount, 0, size - 1 - typeTagCount );
+    return true;
+}
+
+bool F53OSCWireWriteBundleHeader( F53OSCWireWriter *writer, uint64_t timeTag )
+{
+    return ( F53OSCWireWriteString( writer, "#bundle", 7 ) && F53OSCWireWriteTimeTag( writer, timeTag ) );
+}
+
+bool F53OSCWireBeginElement( F53OSCWireWriter *writer, size_t *outMark )
+{
+    *outMark = writer->length;
+    return ( F53OSCWireReserve( writer, 4 ) != NULL );
+}
+
+bool F53OSCWireEndElement( F53OSCWireWriter *writer, size_t mark )
+{
+    if ( writer->overflowed || mark + 4 > writer->length )
+        return false;
+    
+    size_t length = writer->length - mark - 4;
+    if ( length > UINT32_MAX )
+        return false;
+    
+    OSWriteBigInt32( writer->bytes, mark, (uint32_t)length );
+    return true;
+}
@@ -0,0 +1,180 @@
+//
+//  F53OSCWire.h
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//
+//  F53OSCWire is a plain C layer for reading and writing the OSC wire format against caller-owned buffers.
+//  It neither allocates nor calls into Objective-C, so it may be used from real-time threads and from C or
+//  C++ code. F53OSCMessage, F53OSCBundle, F53OSCParser, and the Foundation additions are built on it.
+//
+//  A reader is a cursor over bytes it does not own. Every read is bounds checked: a read that would run past
+//  the end fails, returns false, and leaves the cursor where it was. Strings and blobs are returned as
+//  pointers into the reader's bytes, valid for as long as those bytes are. Padding missing from the very
+//  end of a buffer is tolerated, as it always has been by F53OSCParser.
+//
+//  A writer is a cursor over a buffer of fixed capacity. A write that does not fit fails, writes nothing,
+//  and marks the writer `overflowed`; every later write fails too, so a sequence of writes may be checked
+//  once at the end. The `...Size()` functions give the encoded size of each primitive for sizing a buffer.
+//
+//  Example usage:
+//  uint8_t buffer[64];
+//  F53OSCWireWriter writer;
+//  F53OSCWireWriterInit( &writer, buffer, sizeof( buffer ) );
+//  F53OSCWireWriteMessageHeader( &writer, "/mixer/gain", 11, "f", 1 );
+//  F53OSCWireWriteFloat32( &writer, 0.5f );
+//  if ( !writer.overflowed )
+//      send( sock, buffer, writer.length, 0 );
+//
+//  F53OSCWireMessage message;
+//  F53OSCWireArgument argument;
+//  if ( F53OSCWireReadMessage( bytes, length, &message ) )
+//  {
+//      while ( F53OSCWireMessageNextArgument( &message, &argument ) == F53OSCWireArgumentRead )
+//      {
+//          if ( argument.type == 'f' )
+//              gain = argument.value.f;
+//      }
+//  }
+//
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma clang assume_nonnull begin
+
+#define F53OSC_WIRE_IMMEDIATELY     1   // the OSC time tag meaning "now"
+
+typedef struct
+{
+    const uint8_t   *bytes;
+    size_t          length;
+    size_t          offset;     // the next byte to read
+} F53OSCWireReader;
+
+typedef struct
+{
+    uint8_t         *bytes;
+    size_t          capacity;
+    size_t          length;     // bytes written so far
+    bool            overflowed; // a write did not fit; all later writes fail
+} F53OSCWireWriter;
+
+// One argument of a message. Only the types F53OSCParser accepts are read: i, f, s, b, T, F, N, and I.
+typedef struct
+{
+    char            type;
+    union
+    {
+        int32_t     i;          // 'i'
+        float       f;          // 'f'
+        struct
+        {
+            const void  *bytes;
+            size_t      length;
+        } data;                 // 's' (NUL-terminated in the packet; length excludes the NUL) and 'b'
+    } value;                    // T, F, N, and I have no value
+} F53OSCWireArgument;
+
+typedef struct
+{
+    const char          *address;
+    size_t              addressLength;
+    const char          *typeTags;          // without the leading comma, NUL-terminated; "" if the message has no type tag string
+    size_t              argumentCount;
+    size_t              nextArgument;
+    F53OSCWireReader    arguments;          // positioned at the next argument's data
+} F53OSCWireMessage;
+
+typedef struct
+{
+    uint64_t            timeTag;            // F53OSC_WIRE_IMMEDIATELY if the bundle is too short to hold one
+    F53OSCWireReader    elements;           // positioned at the next element's size
+} F53OSCWireBundle;
+
+typedef enum
+{
+    F53OSCWireArgumentRead,                 // `outArgument` holds the next argument
+    F53OSCWireArgumentsEnd,                 // every argument has been read
+    F53OSCWireArgumentTruncated,            // the argument's data runs past the end of the message
+    F53OSCWireArgumentUnknownType,          // the type tag is not one F53OSC reads
+} F53OSCWireArgumentStatus;
+
+typedef enum
+{
+    F53OSCWireElementRead,                  // `outBytes` and `outLength` hold the next element, a message or bundle
+    F53OSCWireElementsEnd,
+    F53OSCWireElementTruncated,             // the element claims to be larger than the rest of the bundle
+} F53OSCWireElementStatus;
+
+#pragma mark - Sizes
+
+static inline size_t F53OSCWireStringSize( size_t length ) { return ( length + 4 ) & ~(size_t)3; } // always at least one NUL
+static inline size_t F53OSCWireBlobSize( size_t length ) { return 4 + ( ( length + 3 ) & ~(size_t)3 ); }
+static inline size_t F53OSCWireReaderRemaining( const F53OSCWireReader *reader ) { return reader->length - reader->offset; }
+
+#pragma mark - Reading
+
+void F53OSCWireReaderInit( F53OSCWireReader *reader, const void * _Nullable bytes, size_t length ); // NULL bytes read as empty
+bool F53OSCWireReadInt32( F53OSCWireReader *reader, int32_t *outValue );
+bool F53OSCWireReadFloat32( F53OSCWireReader *reader, float *outValue );
+bool F53OSCWireReadTimeTag( F53OSCWireReader *reader, uint64_t *outTimeTag ); // seconds in the high 32 bits, fraction in the low
+bool F53OSCWireReadString( F53OSCWireReader *reader, const char * _Nullable * _Nonnull outString, size_t *outLength ); // fails without a NUL
+bool F53OSCWireReadBlob( F53OSCWireReader *reader, const void * _Nullable * _Nonnull outBytes, size_t *outLength );
+
+// Reads a message's address and type tags. Arguments are then read in order with `F53OSCWireMessageNextArgument()`.
+bool F53OSCWireReadMessage( const void *bytes, size_t length, F53OSCWireMessage *outMessage );
+F53OSCWireArgumentStatus F53OSCWireMessageNextArgument( F53OSCWireMessage *message, F53OSCWireArgument *outArgument );
+
+// Reads a bundle's "#bundle" prefix and time tag. Elements are then read in order with `F53OSCWireBundleNextElement()`.
+bool F53OSCWireReadBundle( const void *bytes, size_t length, F53OSCWireBundle *outBundle );
+F53OSCWireElementStatus F53OSCWireBundleNextElement( F53OSCWireBundle *bundle, const void * _Nullable * _Nonnull outBytes, size_t *outLength );
+
+#pragma mark - Writing
+
+void F53OSCWireWriterInit( F53OSCWireWriter *writer, void *bytes, size_t capacity );
+bool F53OSCWireWriteInt32( F53OSCWireWriter *writer, int32_t value );
+bool F53OSCWireWriteFloat32( F53OSCWireWriter *writer, float value );
+bool F53OSCWireWriteTimeTag( F53OSCWireWriter *writer, uint64_t timeTag );
+bool F53OSCWireWriteString( F53OSCWireWriter *writer, const char * _Nullable string, size_t length ); // writes `length` bytes, then NUL padding
+bool F53OSCWireWriteBlob( F53OSCWireWriter *writer, const void * _Nullable bytes, size_t length );
+
+// Writes an address, then the type tag string: a comma followed by `typeTagCount` tags.
+bool F53OSCWireWriteMessageHeader( F53OSCWireWriter *writer, const char *address, size_t addressLength, const char *typeTags, size_t typeTagCount );
+bool F53OSCWireWriteBundleHeader( F53OSCWireWriter *writer, uint64_t timeTag );
+
+// Reserves an element's size; write the element, then end it to fill the size in.
+bool F53OSCWireBeginElement( F53OSCWireWriter *writer, size_t *outMark );
+bool F53OSCWireEndElement( F53OSCWireWriter *writer, size_t mark );
+
+#pragma clang assume_nonnull end
+
+#ifdef __cplusplus
+}
+#endif
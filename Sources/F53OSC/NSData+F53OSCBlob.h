@@ -32,6 +32,7 @@ NS_ASSUME_NONNULL_BEGIN
 @interface NSData (F53OSCBlobAdditions)
 
 - (NSData *) oscBlobData;
+- (void) appendOSCBlobDataToData:(NSMutableData *)data; // appends the same bytes as `oscBlobData` without creating an intermediate NSData
 + (nullable NSData *) dataWithOSCBlobBytes:(const char *)buf maxLength:(NSUInteger)maxLength bytesRead:(out NSUInteger *)outBytesRead;
 
 // deprecated
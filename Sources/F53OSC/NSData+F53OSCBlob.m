@@ -30,6 +30,8 @@
 
 #import "NSData+F53OSCBlob.h"
 
+#import "F53OSCWire.h"
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -37,39 +39,35 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSData *) oscBlobData
 {
-    UInt32 dataSize = (UInt32)[self length];
-    dataSize = OSSwapHostToBigInt32( dataSize );
-    NSMutableData *newData = [NSMutableData dataWithBytes:&dataSize length:sizeof(UInt32)];
-    
-    [newData appendData:self];
- 
-    // In OSC everything is in multiples of 4 bytes. We must add null bytes to pad out to 4.
-    char zero = 0;
-    for ( int i = ([self length] - 1) % 4; i < 3; i++ )
-        [newData appendBytes:&zero length:1];
-    
+    NSMutableData *newData = [NSMutableData dataWithCapacity:F53OSCWireBlobSize( [self length] )];
+    [self appendOSCBlobDataToData:newData];
     return [newData copy];
 }
 
+- (void) appendOSCBlobDataToData:(NSMutableData *)data
+{
+    // In OSC everything is in multiples of 4 bytes. Zero-filled padding.
+    NSUInteger offset = data.length;
+    NSUInteger blobLength = F53OSCWireBlobSize( [self length] );
+    [data increaseLengthBy:blobLength];
+    
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit( &writer, (uint8_t *)data.mutableBytes + offset, blobLength );
+    F53OSCWireWriteBlob( &writer, [self bytes], [self length] );
+}
+
 ///
 ///  An OSC blob is an int32 size count followed by a sequence of 8-bit bytes,
 ///  followed by 0-3 additional null characters to make the total number of bits a multiple of 32.
 ///
 + (nullable NSData *) dataWithOSCBlobBytes:(const char *)buf maxLength:(NSUInteger)maxLength bytesRead:(out NSUInteger *)outBytesRead
 {
-    if ( buf == NULL || maxLength == 0 )
-    {
-        if ( outBytesRead != NULL )
-            *outBytesRead = 0;
-        return nil;
-    }
-    
-    UInt32 dataSize = 0;
+    F53OSCWireReader reader;
+    F53OSCWireReaderInit( &reader, buf, maxLength );
     
-    dataSize = *((UInt32 *)buf);
-    dataSize = OSSwapBigToHostInt32( dataSize );
-    
-    if ( dataSize + 4 > maxLength )
+    const void *bytes = NULL;
+    size_t length = 0;
+    if ( !F53OSCWireReadBlob( &reader, &bytes, &length ) ) // fails if the size count claims more than `maxLength` holds
     {
         if ( outBytesRead != NULL )
             *outBytesRead = 0;
@@ -77,18 +75,9 @@ NS_ASSUME_NONNULL_BEGIN
     }
     
     if ( outBytesRead != NULL )
-        *outBytesRead = dataSize;
-    
-    buf += 4;
-    NSData *result = [NSData dataWithBytes:buf length:dataSize];
-    
-    if ( outBytesRead != NULL )
-    {
-        NSUInteger bytesRead = result.length + 4; // include length of size count byte
-        *outBytesRead = ( 4 * ceil( bytesRead / 4.0 ) ); // round up to a multiple of 32 bits
-    }
+        *outBytesRead = reader.offset; // includes the size count; a multiple of 32 bits, unless the buffer ends first
     
-    return result;
+    return [NSData dataWithBytes:bytes length:length];
 }
 
 #pragma mark - deprecations
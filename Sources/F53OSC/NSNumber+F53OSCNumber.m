@@ -30,6 +30,8 @@
 
 #import "NSNumber+F53OSCNumber.h"
 
+#import "F53OSCWire.h"
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -49,22 +51,23 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (nullable NSNumber *) numberWithOSCFloatBytes:(const char *)buf maxLength:(NSUInteger)maxLength
 {
-    if ( buf == NULL || maxLength < sizeof( SInt32 ) )
-        return nil;
+    F53OSCWireReader reader;
+    F53OSCWireReaderInit( &reader, buf, maxLength );
     
-    SInt32 intValue = *((SInt32 *)buf);
-    intValue = OSSwapBigToHostInt32( intValue );
-    Float32 floatValue = *((Float32 *)&intValue);
+    Float32 floatValue = 0;
+    if ( !F53OSCWireReadFloat32( &reader, &floatValue ) )
+        return nil;
     return [NSNumber numberWithFloat:floatValue];
 }
 
 + (nullable NSNumber *) numberWithOSCIntBytes:(const char *)buf maxLength:(NSUInteger)maxLength
 {
-    if ( buf == NULL || maxLength < sizeof( SInt32 ) )
-        return nil;
+    F53OSCWireReader reader;
+    F53OSCWireReaderInit( &reader, buf, maxLength );
     
-    SInt32 intValue = *((SInt32 *)buf);
-    intValue = OSSwapBigToHostInt32( intValue );
+    SInt32 intValue = 0;
+    if ( !F53OSCWireReadInt32( &reader, &intValue ) )
+        return nil;
     return [NSNumber numberWithInteger:intValue];
 }
 
@@ -32,6 +32,7 @@ NS_ASSUME_NONNULL_BEGIN
 @interface NSString (F53OSCStringAdditions)
 
 - (NSData *) oscStringData;
+- (void) appendOSCStringDataToData:(NSMutableData *)data; // appends the same bytes as `oscStringData` without creating an intermediate NSData
 + (nullable NSString *) stringWithOSCStringBytes:(const char *)buf maxLength:(NSUInteger)maxLength bytesRead:(out NSUInteger *)outBytesRead;
 
 // Escapes characters that are special in regex (ICU v3) but not special in OSC.
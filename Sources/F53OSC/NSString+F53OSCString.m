@@ -30,6 +30,8 @@
 
 #import "NSString+F53OSCString.h"
 
+#import "F53OSCWire.h"
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -40,21 +42,25 @@ NS_ASSUME_NONNULL_BEGIN
     //  A note on the 4s: For OSC, strings are all null-terminated and in multiples of 4 bytes.
     //  If the data is already a multiple of 4 bytes, it needs to have four null bytes appended.
     
-    NSUInteger length = [self lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
-    NSUInteger stringLength = length;
-    const char *bytes = [self cStringUsingEncoding:NSUTF8StringEncoding];
-    length = 4 * ( ceil( (length + 1) / 4.0 ) );
+    NSMutableData *data = [NSMutableData data];
+    [self appendOSCStringDataToData:data];
+    return [data copy];
+}
 
-    char *string = malloc( length * sizeof( char ) );
-    NSUInteger i;
-    for ( i = 0; i < stringLength; i++ )
-        string[i] = bytes[i];
-    for ( ; i < length; i++ )
-        string[i] = 0;
-         
-    NSData *data = [NSData dataWithBytes:string length:length];
-    free( string );
-    return data;
+- (void) appendOSCStringDataToData:(NSMutableData *)data
+{
+    NSUInteger stringLength = [self lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    const char *bytes = [self cStringUsingEncoding:NSUTF8StringEncoding];
+    if ( bytes == NULL )
+        stringLength = 0;
+    
+    NSUInteger offset = data.length;
+    NSUInteger paddedLength = F53OSCWireStringSize( stringLength );
+    [data increaseLengthBy:paddedLength];
+    
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit( &writer, (uint8_t *)data.mutableBytes + offset, paddedLength );
+    F53OSCWireWriteString( &writer, bytes, stringLength );
 }
 
 ///
@@ -63,35 +69,17 @@ NS_ASSUME_NONNULL_BEGIN
 ///
 + (nullable NSString *) stringWithOSCStringBytes:(const char *)buf maxLength:(NSUInteger)maxLength bytesRead:(out NSUInteger *)outBytesRead
 {
-    if ( buf == NULL || maxLength == 0 )
-    {
-        if ( outBytesRead != NULL )
-            *outBytesRead = 0;
-        return nil;
-    }
-    
-    NSUInteger bytesRead = 0;
-    for ( NSUInteger index = 0; index < maxLength; index++ )
-    {
-        if ( buf[index] == 0 )
-        {
-            // found a NULL character within the buffer
-            bytesRead = index + 1; // include length of null terminator character
-            break;
-        }
-    }
-    if (bytesRead == 0)
-    {
-        // Buffer wasn't null terminated, so it's not a valid OSC string.
-        if ( outBytesRead != NULL )
-            *outBytesRead = 0;
-        return nil;
-    }
+    F53OSCWireReader reader;
+    F53OSCWireReaderInit( &reader, buf, maxLength );
     
-    NSString *result = [NSString stringWithUTF8String:buf];
+    const char *string = NULL;
+    size_t length = 0;
+    NSString *result = nil;
+    if ( F53OSCWireReadString( &reader, &string, &length ) ) // fails if the buffer is not null terminated
+        result = [[NSString alloc] initWithBytes:string length:length encoding:NSUTF8StringEncoding];
     
     if ( outBytesRead != NULL )
-        *outBytesRead = 4 * ceil( bytesRead / 4.0 ); // round up to a multiple of 32 bits
+        *outBytesRead = ( result ? reader.offset : 0 ); // a multiple of 32 bits, unless the buffer ends first
     
     return result;
 }
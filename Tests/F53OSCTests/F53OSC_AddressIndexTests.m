@@ -0,0 +1,262 @@
+//
+//  F53OSC_AddressIndexTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCAddressIndex.h"
+#import "F53OSCServer.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define BENCHMARK_OBJECTS   100000
+
+@interface AddressIndexTestCue : NSObject
+@property (copy, nullable) NSString *oscAddress;
++ (instancetype) cueWithAddress:(nullable NSString *)address;
+@end
+
+@implementation AddressIndexTestCue
+
++ (instancetype) cueWithAddress:(nullable NSString *)address
+{
+    AddressIndexTestCue *cue = [[self alloc] init];
+    cue.oscAddress = address;
+    return cue;
+}
+
+@end
+
+
+#pragma mark - AddressIndexCountingCue
+
+@interface AddressIndexCountingCue : AddressIndexTestCue
+@property (assign) NSUInteger addressReadCount;
+@end
+
+@implementation AddressIndexCountingCue
+
+- (nullable NSString *)oscAddress
+{
+    self.addressReadCount++;
+    return super.oscAddress;
+}
+
+@end
+
+
+#pragma mark - F53OSC_AddressIndexTests
+
+@interface F53OSC_AddressIndexTests : XCTestCase
+@end
+
+@implementation F53OSC_AddressIndexTests
+
+- (NSArray<NSString *> *)addressesOfObjects:(NSArray<AddressIndexTestCue *> *)objects
+{
+    return [objects valueForKey:@"oscAddress"];
+}
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_addressIndexHasCorrectDefaults
+{
+    F53OSCAddressIndex *index = [[F53OSCAddressIndex alloc] initWithAddressKeyPath:@"oscAddress"];
+
+    XCTAssertEqualObjects(index.addressKeyPath, @"oscAddress");
+    XCTAssertEqual(index.parallelThreshold, 4096);
+    XCTAssertEqual(index.count, 0);
+    XCTAssertEqualObjects([index objectsMatchingPattern:@"/*"], @[]);
+}
+
+
+#pragma mark - Matching tests
+
+- (void)testThat_patternMatchingFollowsOSCRules
+{
+    XCTAssertTrue(F53OSCPatternMatchesAddress("/cue/*/level", "/cue/12/level", 13));
+    XCTAssertFalse(F53OSCPatternMatchesAddress("/cue/*/level", "/cue/1/2/level", 14), @"'*' should not match across a '/'");
+    XCTAssertTrue(F53OSCPatternMatchesAddress("/cue/?", "/cue/5", 6));
+    XCTAssertFalse(F53OSCPatternMatchesAddress("/cue/?", "/cue/55", 7));
+    XCTAssertTrue(F53OSCPatternMatchesAddress("/ch/[1-3]", "/ch/2", 5));
+    XCTAssertTrue(F53OSCPatternMatchesAddress("/ch/[!1-3]", "/ch/7", 5));
+    XCTAssertFalse(F53OSCPatternMatchesAddress("/ch/[!1-3]", "/ch/2", 5));
+    XCTAssertTrue(F53OSCPatternMatchesAddress("/{go,stop}", "/stop", 5));
+    XCTAssertFalse(F53OSCPatternMatchesAddress("/{go,stop}", "/pause", 6));
+    XCTAssertTrue(F53OSCPatternMatchesAddress("/exact", "/exact/more", 6), @"Only `addressLength` bytes should be matched");
+}
+
+- (void)testThat_addressIndexMatchesLikePredicates
+{
+    NSMutableArray<AddressIndexTestCue *> *cues = [NSMutableArray array];
+    for (NSString *address in @[@"/cue/10/go", @"/cue/1/go", @"/cue/2/go", @"/cue/1/level", @"/cue/1", @"/cue10/go", @"/mixer/1/mute", @"/cue/3/stop"])
+        [cues addObject:[AddressIndexTestCue cueWithAddress:address]];
+    [cues addObject:[AddressIndexTestCue cueWithAddress:nil]];
+
+    F53OSCAddressIndex *index = [[F53OSCAddressIndex alloc] initWithObjects:cues addressKeyPath:@"oscAddress"];
+    XCTAssertEqual(index.count, 8, @"An object without an address should be ignored");
+
+    for (NSString *pattern in @[@"/cue/*/go", @"/cue/1*", @"/cue/{1,3}/*", @"/cue/[0-9]/go", @"/cue/1/go", @"/*/1/*", @"/cue/?/go", @"/cue", @"/nothing/*"])
+    {
+        NSPredicate *predicate = [F53OSCServer predicateForAttribute:@"oscAddress" matchingOSCPattern:pattern];
+        NSSet *expected = [NSSet setWithArray:[cues filteredArrayUsingPredicate:predicate]];
+        NSArray *matches = [index objectsMatchingPattern:pattern];
+        XCTAssertEqual(matches.count, expected.count, @"%@", pattern);
+        XCTAssertEqualObjects([NSSet setWithArray:matches], expected, @"%@", pattern);
+    }
+
+    XCTAssertEqualObjects([self addressesOfObjects:[index objectsMatchingPattern:@"/cue/*/go"]], (@[@"/cue/1/go", @"/cue/2/go", @"/cue/10/go"]),
+                          @"Matches should be in component order");
+}
+
+- (void)testThat_addressIndexFiltersInParallel
+{
+    NSMutableArray<AddressIndexTestCue *> *cues = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 10000; i++)
+        [cues addObject:[AddressIndexTestCue cueWithAddress:[NSString stringWithFormat:@"/cue/%lu/%@", (unsigned long)i, (i % 2 ? @"go" : @"stop")]]];
+
+    F53OSCAddressIndex *serialIndex = [[F53OSCAddressIndex alloc] initWithObjects:cues addressKeyPath:@"oscAddress"];
+    serialIndex.parallelThreshold = NSUIntegerMax;
+    F53OSCAddressIndex *parallelIndex = [[F53OSCAddressIndex alloc] initWithObjects:cues addressKeyPath:@"oscAddress"];
+    parallelIndex.parallelThreshold = 1;
+
+    for (NSString *pattern in @[@"/cue/*/go", @"/cue/1?/stop", @"/cue/{5,50,500}/*", @"/*/*/*"])
+    {
+        NSArray *serialMatches = [serialIndex objectsMatchingPattern:pattern];
+        XCTAssertGreaterThan(serialMatches.count, 0, @"%@", pattern);
+        XCTAssertEqualObjects([parallelIndex objectsMatchingPattern:pattern], serialMatches, @"Parallel filtering should give the same matches in the same order for %@", pattern);
+    }
+}
+
+
+#pragma mark - Incremental update tests
+
+- (void)testThat_addressIndexAddsAndRemovesIncrementally
+{
+    F53OSCAddressIndex *index = [[F53OSCAddressIndex alloc] initWithAddressKeyPath:@"oscAddress"];
+    AddressIndexTestCue *first = [AddressIndexTestCue cueWithAddress:@"/cue/1/go"];
+    AddressIndexTestCue *second = [AddressIndexTestCue cueWithAddress:@"/cue/1/go"];
+    AddressIndexTestCue *other = [AddressIndexTestCue cueWithAddress:@"/cue/1"];
+
+    [index addObject:first];
+    [index addObject:other];
+    [index addObject:second];
+    XCTAssertEqual(index.count, 3);
+    XCTAssertEqualObjects([index objectsMatchingPattern:@"/cue/1/go"], (@[first, second]), @"Objects at one address should keep the order they were added");
+    XCTAssertEqualObjects([index objectsMatchingPattern:@"/cue/1"], @[other]);
+    XCTAssertEqualObjects([index objectsMatchingPattern:@"/cue/*"], @[other]);
+
+    [index removeObject:first];
+    XCTAssertEqualObjects([index objectsMatchingPattern:@"/cue/1/go"], @[second]);
+
+    // An object whose address changed since it was added can still be removed.
+    second.oscAddress = @"/cue/9/go";
+    [index removeObject:second];
+    XCTAssertEqualObjects([index objectsMatchingPattern:@"/cue/*/go"], @[]);
+    [index addObject:second];
+    XCTAssertEqualObjects([index objectsMatchingPattern:@"/cue/*/go"], @[second]);
+
+    [index removeObject:[AddressIndexTestCue cueWithAddress:@"/cue/1"]];
+    XCTAssertEqual(index.count, 2, @"Removing an object that was never added should do nothing");
+
+    [index removeAllObjects];
+    XCTAssertEqual(index.count, 0);
+    XCTAssertEqualObjects([index objectsMatchingPattern:@"/cue/*"], @[]);
+}
+
+
+#pragma mark - Performance tests
+
+- (NSArray<NSString *> *)benchmarkPatterns
+{
+    return @[@"/cue/*/level", @"/cue/1?/level", @"/cue/{1,22,333}/level", @"/cue/5*/level"];
+}
+
+- (NSUInteger)addressReadCountOfCues:(NSArray<AddressIndexCountingCue *> *)cues
+{
+    NSUInteger count = 0;
+    for (AddressIndexCountingCue *cue in cues)
+        count += cue.addressReadCount;
+    return count;
+}
+
+// What makes the index faster than predicates, checked without timing: no KVC per object once it is built.
+- (void)testThat_addressIndexReadsEachAddressOnce
+{
+    NSMutableArray<AddressIndexCountingCue *> *cues = [NSMutableArray arrayWithCapacity:BENCHMARK_OBJECTS];
+    for (NSUInteger i = 0; i < BENCHMARK_OBJECTS; i++)
+        [cues addObject:[AddressIndexCountingCue cueWithAddress:[NSString stringWithFormat:@"/cue/%lu/level", (unsigned long)i]]];
+
+    F53OSCAddressIndex *index = [[F53OSCAddressIndex alloc] initWithObjects:cues addressKeyPath:@"oscAddress"];
+    XCTAssertEqual([self addressReadCountOfCues:cues], BENCHMARK_OBJECTS, @"Each address should be read once, when it is added");
+
+    for (NSString *pattern in [self benchmarkPatterns])
+    {
+        NSUInteger readCount = [self addressReadCountOfCues:cues];
+        NSArray *indexMatches = [index objectsMatchingPattern:pattern];
+        XCTAssertEqual([self addressReadCountOfCues:cues], readCount, @"Matching %@ should not read any address again", pattern);
+
+        NSArray *predicateMatches = nil;
+        @autoreleasepool
+        {
+            NSPredicate *predicate = [F53OSCServer predicateForAttribute:@"oscAddress" matchingOSCPattern:pattern];
+            predicateMatches = [cues filteredArrayUsingPredicate:predicate];
+        }
+        XCTAssertEqual([self addressReadCountOfCues:cues], readCount + BENCHMARK_OBJECTS, @"A predicate reads every address for each pattern");
+        XCTAssertEqualObjects([NSSet setWithArray:indexMatches], [NSSet setWithArray:predicateMatches], @"%@", pattern);
+    }
+}
+
+- (void)testThat_addressIndexMatchingPerformance
+{
+    NSMutableArray<AddressIndexTestCue *> *cues = [NSMutableArray arrayWithCapacity:BENCHMARK_OBJECTS];
+    for (NSUInteger i = 0; i < BENCHMARK_OBJECTS; i++)
+        [cues addObject:[AddressIndexTestCue cueWithAddress:[NSString stringWithFormat:@"/cue/%lu/level", (unsigned long)i]]];
+
+    F53OSCAddressIndex *index = [[F53OSCAddressIndex alloc] initWithObjects:cues addressKeyPath:@"oscAddress"];
+    NSArray<NSString *> *patterns = [self benchmarkPatterns];
+
+    [self measureBlock:^{
+        for (NSString *pattern in patterns)
+            [index objectsMatchingPattern:pattern];
+    }];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,340 @@
+//
+//  F53OSC_BundleBuilderTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCBundle.h"
+#import "F53OSCBundleBuilder.h"
+#import "F53OSCMessage.h"
+#import "F53OSCParser.h"
+#import "F53OSCSocket.h"
+#import "F53OSCTimeTag.h"
+
+#import "NSData+F53OSCBlob.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - BundleBuilderTestDestination
+
+@interface BundleBuilderTestDestination : NSObject <F53OSCPacketDestination>
+@property (nonatomic, strong) NSMutableArray<F53OSCMessage *> *receivedMessages;
+@end
+
+@implementation BundleBuilderTestDestination
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+        self.receivedMessages = [NSMutableArray array];
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (message)
+        [self.receivedMessages addObject:message];
+}
+
+@end
+
+
+#pragma mark - F53OSC_BundleBuilderTests
+
+@interface F53OSC_BundleBuilderTests : XCTestCase
+@end
+
+
+@implementation F53OSC_BundleBuilderTests
+
+- (NSArray<F53OSCMessage *> *)messagesWithCount:(NSUInteger)count
+{
+    NSMutableArray<F53OSCMessage *> *messages = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        NSString *address = [NSString stringWithFormat:@"/cue/%lu/level", (unsigned long)i];
+        [messages addObject:[F53OSCMessage messageWithAddressPattern:address arguments:@[@(i), @(0.5f), @"abc"]]];
+    }
+    return messages;
+}
+
+- (NSArray<F53OSCMessage *> *)decodedMessagesFromPacketData:(NSData *)packetData
+{
+    BundleBuilderTestDestination *destination = [[BundleBuilderTestDestination alloc] init];
+    GCDAsyncUdpSocket *rawSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    F53OSCSocket *socket = [F53OSCSocket socketWithUdpSocket:rawSocket];
+    [F53OSCParser processOscData:packetData forDestination:destination replyToSocket:socket controlHandler:nil wasEncrypted:NO];
+    return destination.receivedMessages;
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_builderHasCorrectDefaults
+{
+    F53OSCBundleBuilder *builder = [[F53OSCBundleBuilder alloc] init];
+
+    XCTAssertNotNil(builder, @"Builder should not be nil");
+    XCTAssertEqualObjects(builder.timeTag.oscTimeTagData, [F53OSCTimeTag immediateTimeTag].oscTimeTagData, @"Default timeTag should be immediateTimeTag");
+    XCTAssertEqual(builder.maxPacketSize, 0, @"Default maxPacketSize should be 0");
+    XCTAssertEqual(builder.bundleCount, 0, @"Default bundleCount should be 0");
+    XCTAssertEqual(builder.length, 0, @"Default length should be 0");
+    XCTAssertEqual([builder finish].count, 0, @"Empty builder should produce no bundles");
+}
+
+
+#pragma mark - Encoding tests
+
+- (void)testThat_appendHelpersMatchCopyingEncoders
+{
+    NSArray<NSString *> *strings = @[@"", @"a", @"abc", @"abcd", @"abcde", @"/some/address"];
+    for (NSString *string in strings)
+    {
+        NSMutableData *data = [NSMutableData data];
+        [string appendOSCStringDataToData:data];
+        XCTAssertEqualObjects(data, [string oscStringData], @"Appended string data should match oscStringData for \"%@\"", string);
+    }
+
+    for (NSUInteger length = 0; length < 9; length++)
+    {
+        NSMutableData *blob = [NSMutableData dataWithLength:length];
+        memset(blob.mutableBytes, 0x5A, length);
+        NSMutableData *data = [NSMutableData data];
+        [blob appendOSCBlobDataToData:data];
+        XCTAssertEqualObjects(data, [blob oscBlobData], @"Appended blob data should match oscBlobData for length %lu", (unsigned long)length);
+    }
+
+    F53OSCTimeTag *timeTag = [F53OSCTimeTag timeTagWithDate:[NSDate dateWithTimeIntervalSince1970:1609459200]];
+    NSMutableData *timeTagData = [NSMutableData data];
+    [timeTag appendOSCTimeTagDataToData:timeTagData];
+    XCTAssertEqualObjects(timeTagData, [timeTag oscTimeTagData], @"Appended time tag data should match oscTimeTagData");
+}
+
+- (void)testThat_builderMatchesBundlePacketData
+{
+    F53OSCTimeTag *timeTag = [F53OSCTimeTag timeTagWithDate:[NSDate dateWithTimeIntervalSince1970:1609459200]];
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:5];
+
+    NSMutableArray<NSData *> *elements = [NSMutableArray array];
+    for (F53OSCMessage *message in messages)
+        [elements addObject:[message packetData]];
+    F53OSCBundle *bundle = [F53OSCBundle bundleWithTimeTag:timeTag elements:elements];
+
+    F53OSCBundleBuilder *builder = [F53OSCBundleBuilder builderWithTimeTag:timeTag];
+    for (F53OSCMessage *message in messages)
+        [builder addPacket:message];
+    NSArray<NSData *> *result = [builder finish];
+
+    XCTAssertEqual(result.count, 1, @"Builder without a size limit should produce one bundle");
+    XCTAssertEqualObjects(result.firstObject, [bundle packetData], @"Builder output should match F53OSCBundle packetData");
+    XCTAssertEqual(builder.bundleCount, 0, @"Builder should reset after finish");
+}
+
+- (void)testThat_builderEncodesNestedBundles
+{
+    F53OSCTimeTag *timeTag = [F53OSCTimeTag immediateTimeTag];
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:4];
+
+    F53OSCBundle *inner = [F53OSCBundle bundleWithTimeTag:timeTag elements:@[[messages[1] packetData], [messages[2] packetData]]];
+    F53OSCBundle *outer = [F53OSCBundle bundleWithTimeTag:timeTag elements:@[[messages[0] packetData], [inner packetData], [messages[3] packetData]]];
+
+    F53OSCBundleBuilder *builder = [F53OSCBundleBuilder builderWithTimeTag:timeTag];
+    [builder addPacket:messages[0]];
+    [builder beginBundleWithTimeTag:timeTag];
+    [builder addPacket:messages[1]];
+    [builder addPacket:messages[2]];
+    [builder endBundle];
+    [builder addPacket:messages[3]];
+    NSArray<NSData *> *result = [builder finish];
+
+    XCTAssertEqual(result.count, 1, @"Builder should produce one bundle");
+    XCTAssertEqualObjects(result.firstObject, [outer packetData], @"Nested builder output should match nested F53OSCBundle packetData");
+
+    // Adding an F53OSCBundle packet directly should produce the same bytes.
+    F53OSCBundleBuilder *packetBuilder = [F53OSCBundleBuilder builderWithTimeTag:timeTag];
+    [packetBuilder addPacket:messages[0]];
+    [packetBuilder addPacket:inner];
+    [packetBuilder addPacketData:[messages[3] packetData]];
+    XCTAssertEqualObjects([packetBuilder finish].firstObject, [outer packetData], @"Adding a bundle packet should match nested F53OSCBundle packetData");
+
+    NSArray<F53OSCMessage *> *decoded = [self decodedMessagesFromPacketData:(NSData *)result.firstObject];
+    XCTAssertEqualObjects(decoded, messages, @"Decoded messages should match in order");
+}
+
+- (void)testThat_builderRejectsUnalignedPacketData
+{
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:2];
+    NSData *packetData = [messages[0] packetData];
+    NSData *unalignedData = [packetData subdataWithRange:NSMakeRange(0, packetData.length - 1)];
+
+    F53OSCBundleBuilder *builder = [F53OSCBundleBuilder builderWithTimeTag:[F53OSCTimeTag immediateTimeTag]];
+    [builder addPacketData:unalignedData];
+    XCTAssertEqual(builder.elementCount, 0, @"Unaligned packet data should not be added");
+    [builder addPacketData:[NSData data]];
+    XCTAssertEqual(builder.elementCount, 0, @"Empty packet data should not be added");
+
+    [builder addPacketData:packetData];
+    [builder addPacket:messages[1]];
+    XCTAssertEqual(builder.elementCount, 2);
+    XCTAssertEqualObjects([self decodedMessagesFromPacketData:(NSData *)[builder finish].firstObject], messages, @"Only the aligned packets should be decoded");
+}
+
+- (void)testThat_builderClosesUnterminatedBundlesOnFinish
+{
+    F53OSCBundleBuilder *builder = [[F53OSCBundleBuilder alloc] init];
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:2];
+
+    [builder beginBundleWithTimeTag:[F53OSCTimeTag immediateTimeTag]];
+    [builder addPacket:messages[0]];
+    [builder beginBundleWithTimeTag:[F53OSCTimeTag immediateTimeTag]];
+    [builder addPacket:messages[1]];
+    NSArray<NSData *> *result = [builder finish];
+
+    XCTAssertEqual(result.count, 1, @"Builder should produce one bundle");
+    XCTAssertEqualObjects([self decodedMessagesFromPacketData:(NSData *)result.firstObject], messages, @"Decoded messages should match");
+}
+
+
+#pragma mark - Splitting tests
+
+- (void)testThat_builderSplitsToMaxPacketSize
+{
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:500];
+
+    NSArray<NSData *> *result = [F53OSCBundleBuilder bundleDataWithPackets:messages
+                                                                   timeTag:[F53OSCTimeTag immediateTimeTag]
+                                                             maxPacketSize:F53OSCEthernetUDPPayloadSize];
+
+    XCTAssertGreaterThan(result.count, 1, @"Large batch should be split into multiple bundles");
+
+    NSMutableArray<F53OSCMessage *> *decoded = [NSMutableArray array];
+    for (NSData *packetData in result)
+    {
+        XCTAssertLessThanOrEqual(packetData.length, F53OSCEthernetUDPPayloadSize, @"Each bundle should fit the payload limit");
+        XCTAssertTrue(packetData.length % 4 == 0, @"Each bundle should be 4-byte aligned");
+        [decoded addObjectsFromArray:[self decodedMessagesFromPacketData:packetData]];
+    }
+
+    XCTAssertEqualObjects(decoded, messages, @"All messages should be decoded in order across split bundles");
+}
+
+- (void)testThat_builderKeepsNestedBundleIntactWhenSplitting
+{
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:6];
+    NSUInteger messageLength = [messages[0] packetData].length + sizeof(UInt32);
+
+    F53OSCBundleBuilder *builder = [[F53OSCBundleBuilder alloc] init];
+    builder.maxPacketSize = 16 + messageLength * 3;
+
+    [builder addPacket:messages[0]];
+    [builder addPacket:messages[1]];
+    [builder beginBundleWithTimeTag:[F53OSCTimeTag immediateTimeTag]];
+    [builder addPacket:messages[2]];
+    [builder addPacket:messages[3]];
+    [builder endBundle];
+    [builder addPacket:messages[4]];
+    [builder addPacket:messages[5]];
+    NSArray<NSData *> *result = [builder finish];
+
+    // [0, 1] [nested 2, 3] [4, 5]
+    XCTAssertEqual(result.count, 3, @"Nested bundle should move to its own bundle as a whole");
+
+    NSMutableArray<F53OSCMessage *> *decoded = [NSMutableArray array];
+    for (NSData *packetData in result)
+    {
+        XCTAssertLessThanOrEqual(packetData.length, builder.maxPacketSize, @"Each bundle should fit the payload limit");
+        [decoded addObjectsFromArray:[self decodedMessagesFromPacketData:packetData]];
+    }
+    XCTAssertEqualObjects(decoded, messages, @"All messages should be decoded in order");
+}
+
+- (void)testThat_builderEmitsOversizedElementAlone
+{
+    NSMutableData *largeBlob = [NSMutableData dataWithLength:4096];
+    F53OSCMessage *large = [F53OSCMessage messageWithAddressPattern:@"/large" arguments:@[largeBlob]];
+    NSArray<F53OSCMessage *> *small = [self messagesWithCount:2];
+
+    NSArray<NSData *> *result = [F53OSCBundleBuilder bundleDataWithPackets:@[small[0], large, small[1]]
+                                                                   timeTag:[F53OSCTimeTag immediateTimeTag]
+                                                             maxPacketSize:F53OSCEthernetUDPPayloadSize];
+
+    XCTAssertEqual(result.count, 3, @"Oversized element should be placed in its own bundle");
+    XCTAssertGreaterThan(result[1].length, F53OSCEthernetUDPPayloadSize, @"Oversized element cannot be split");
+}
+
+
+#pragma mark - Performance tests
+
+- (void)testThat_builderPerformanceIsReasonable
+{
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:200];
+    NSUInteger iterations = 200;
+
+    NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < iterations; i++)
+    {
+        NSMutableArray<NSData *> *elements = [NSMutableArray arrayWithCapacity:messages.count];
+        for (F53OSCMessage *message in messages)
+            [elements addObject:[message packetData]];
+        XCTAssertNotNil([[F53OSCBundle bundleWithTimeTag:[F53OSCTimeTag immediateTimeTag] elements:elements] packetData]);
+    }
+    NSTimeInterval bundleElapsed = [NSDate timeIntervalSinceReferenceDate] - startTime;
+
+    startTime = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < iterations; i++)
+    {
+        NSArray<NSData *> *result = [F53OSCBundleBuilder bundleDataWithPackets:messages timeTag:[F53OSCTimeTag immediateTimeTag] maxPacketSize:0];
+        XCTAssertEqual(result.count, 1);
+    }
+    NSTimeInterval builderElapsed = [NSDate timeIntervalSinceReferenceDate] - startTime;
+
+    NSLog(@"Bundle encoding performance: F53OSCBundle %.3f seconds, F53OSCBundleBuilder %.3f seconds for %lu bundles of %lu messages",
+          bundleElapsed, builderElapsed, (unsigned long)iterations, (unsigned long)messages.count);
+
+    XCTAssertLessThan(builderElapsed, bundleElapsed * 1.5, @"Builder should not be slower than encoding through F53OSCBundle");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
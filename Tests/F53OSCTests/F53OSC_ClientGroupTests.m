@@ -0,0 +1,310 @@
+//
+//  F53OSC_ClientGroupTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCClientGroup.h"
+#import "F53OSCMessage.h"
+#import "F53OSCServer.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define PORT_BASE   9600
+
+#pragma mark - GroupTestReceiver
+
+@interface GroupTestReceiver : NSObject <F53OSCServerDelegate>
+@property (assign) NSUInteger messageCount;
+@property (assign) NSUInteger expectedMessageCount;
+@property (strong, nullable) XCTestExpectation *allMessagesExpectation;
+@end
+
+@implementation GroupTestReceiver
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    self.messageCount++;
+    if (self.messageCount == self.expectedMessageCount)
+        [self.allMessagesExpectation fulfill];
+}
+
+@end
+
+
+#pragma mark - F53OSC_ClientGroupTests
+
+@interface F53OSC_ClientGroupTests : XCTestCase
+@end
+
+@implementation F53OSC_ClientGroupTests
+
+- (F53OSCServer *)startServerOnPort:(UInt16)port receiver:(GroupTestReceiver *)receiver
+{
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = receiver;
+    server.port = port;
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening on port %hu", port);
+    XCTAssertNil(error);
+
+    [self addTeardownBlock:^{
+        [server stopListening];
+    }];
+    return server;
+}
+
+- (F53OSCClient *)clientForPort:(UInt16)port useTcp:(BOOL)useTcp
+{
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"127.0.0.1";
+    client.port = port;
+    client.useTcp = useTcp;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+    }];
+    return client;
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_clientGroupHasCorrectDefaults
+{
+    F53OSCClientGroup *group = [[F53OSCClientGroup alloc] init];
+
+    XCTAssertEqual(group.count, 0);
+    XCTAssertEqual(group.clients.count, 0);
+    XCTAssertEqual(group.encodedPacketCount, 0);
+    XCTAssertEqual(group.sharedDatagramCount, 0);
+    XCTAssertEqual(group.sharedFrameCount, 0);
+    XCTAssertEqual(group.individualSendCount, 0);
+    XCTAssertEqual(group.unresolvedSendCount, 0);
+}
+
+- (void)testThat_clientGroupManagesMembers
+{
+    F53OSCClientGroup *group = [[F53OSCClientGroup alloc] init];
+    F53OSCClient *first = [[F53OSCClient alloc] init];
+    F53OSCClient *second = [[F53OSCClient alloc] init];
+
+    [group addClient:first];
+    [group addClient:second];
+    [group addClient:first];
+    XCTAssertEqual(group.count, 2, @"A client should only be added once");
+    XCTAssertTrue([group containsClient:first]);
+
+    [group removeClient:first];
+    XCTAssertFalse([group containsClient:first]);
+    XCTAssertEqualObjects(group.clients, @[second]);
+
+    [group removeAllClients];
+    XCTAssertEqual(group.count, 0);
+}
+
+
+#pragma mark - Fan-out tests
+
+- (void)testThat_clientGroupSendsToUdpMembersFromSharedSocket
+{
+    NSUInteger memberCount = 10;
+    NSUInteger packetCount = 5;
+
+    F53OSCClientGroup *group = [[F53OSCClientGroup alloc] init];
+    NSMutableArray<XCTestExpectation *> *expectations = [NSMutableArray array];
+    NSMutableArray<GroupTestReceiver *> *receivers = [NSMutableArray array];
+
+    for (NSUInteger i = 0; i < memberCount; i++)
+    {
+        GroupTestReceiver *receiver = [[GroupTestReceiver alloc] init];
+        receiver.expectedMessageCount = packetCount;
+        receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:[NSString stringWithFormat:@"Member %lu received all packets", (unsigned long)i]];
+        [receivers addObject:receiver];
+        [expectations addObject:(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation];
+
+        UInt16 port = PORT_BASE + 10 + i;
+        [self startServerOnPort:port receiver:receiver];
+        [group addClient:[self clientForPort:port useTcp:NO]];
+    }
+
+    for (NSUInteger i = 0; i < packetCount; i++)
+        [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:@[@(i)]]];
+
+    [self waitForExpectations:expectations timeout:5.0];
+
+    XCTAssertEqual(group.encodedPacketCount, packetCount, @"Each packet should be encoded once for the whole group");
+    XCTAssertEqual(group.sharedDatagramCount, memberCount * packetCount);
+    XCTAssertEqual(group.sharedFrameCount, 0);
+    XCTAssertEqual(group.unresolvedSendCount, 0);
+    for (GroupTestReceiver *receiver in receivers)
+        XCTAssertEqual(receiver.messageCount, packetCount);
+}
+
+- (void)testThat_clientGroupSendsSharedFrameToTcpMembers
+{
+    NSUInteger memberCount = 3;
+    NSUInteger packetCount = 4;
+    UInt16 port = PORT_BASE + 30;
+
+    GroupTestReceiver *receiver = [[GroupTestReceiver alloc] init];
+    receiver.expectedMessageCount = memberCount * packetCount;
+    receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"All members' packets received"];
+    [self startServerOnPort:port receiver:receiver];
+
+    F53OSCClientGroup *group = [[F53OSCClientGroup alloc] init];
+    for (NSUInteger i = 0; i < memberCount; i++)
+    {
+        F53OSCClient *client = [self clientForPort:port useTcp:YES];
+        XCTAssertTrue([client connect]);
+        [group addClient:client];
+    }
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+
+    // Include bytes that SLIP has to escape.
+    NSData *slipBytes = [NSData dataWithBytes:"\xc0\xdb" length:2];
+    for (NSUInteger i = 0; i < packetCount; i++)
+        [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:@[@(i), slipBytes]]];
+
+    [self waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:5.0];
+
+    XCTAssertEqual(group.encodedPacketCount, packetCount);
+    XCTAssertEqual(group.sharedFrameCount, memberCount * packetCount);
+    XCTAssertEqual(group.sharedDatagramCount, 0);
+    XCTAssertEqual(receiver.messageCount, memberCount * packetCount);
+}
+
+- (void)testThat_clientGroupSkipsMembersWithoutAddress
+{
+    F53OSCClientGroup *group = [[F53OSCClientGroup alloc] init];
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"";
+    [group addClient:client];
+
+    [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:@[]]];
+    [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:@[]]];
+
+    XCTAssertEqual(group.unresolvedSendCount, 2);
+    XCTAssertEqual(group.sharedDatagramCount, 0);
+}
+
+- (void)testThat_clientGroupResolvesThroughItsTransportEngine
+{
+    F53OSCClientGroup *group = [[F53OSCClientGroup alloc] init];
+    XCTAssertNotNil(group.transportEngine);
+    group.transportEngine.failedLookupRetryInterval = 0.2;
+
+    F53OSCClient *resolvable = [self clientForPort:PORT_BASE + 50 useTcp:NO];
+    F53OSCClient *unresolvable = [self clientForPort:PORT_BASE + 51 useTcp:NO];
+    unresolvable.host = @"host.invalid";
+    [group addClient:resolvable];
+    [group addClient:unresolvable];
+
+    [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:@[]]];
+    [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:@[]]];
+    XCTAssertEqual(group.sharedDatagramCount, 2);
+    XCTAssertEqual(group.unresolvedSendCount, 2);
+    XCTAssertEqual(group.transportEngine.resolvedAddressCount, 1);
+    XCTAssertEqual(group.transportEngine.lookupCount, 2, @"Each destination should be looked up once while its result is cached");
+
+    // A host that failed to resolve is not given up on.
+    [NSThread sleepForTimeInterval:0.3];
+    [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:@[]]];
+    XCTAssertEqual(group.transportEngine.lookupCount, 3);
+
+    [group invalidateResolvedAddresses];
+    XCTAssertEqual(group.transportEngine.resolvedAddressCount, 0);
+}
+
+
+#pragma mark - Performance tests
+
+- (void)testThat_clientGroupFanOutIsCheaperThanIndividualClients
+{
+    NSUInteger memberCount = 200;
+    NSUInteger packetCount = 50;
+    UInt16 port = PORT_BASE + 40;
+
+    GroupTestReceiver *receiver = [[GroupTestReceiver alloc] init];
+    [self startServerOnPort:port receiver:receiver];
+
+    F53OSCClientGroup *group = [[F53OSCClientGroup alloc] init];
+    NSMutableArray<F53OSCClient *> *clients = [NSMutableArray arrayWithCapacity:memberCount];
+    for (NSUInteger i = 0; i < memberCount; i++)
+    {
+        F53OSCClient *client = [self clientForPort:port useTcp:NO];
+        [clients addObject:client];
+        [group addClient:client];
+    }
+
+    NSArray *arguments = @[@"level", @1, @0.5f, @"channel name"];
+
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < packetCount; i++)
+    {
+        F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/status" arguments:arguments];
+        for (F53OSCClient *client in clients)
+            [client sendPacket:message];
+    }
+    NSTimeInterval individualTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+    start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < packetCount; i++)
+        [group sendPacket:[F53OSCMessage messageWithAddressPattern:@"/status" arguments:arguments]];
+    NSTimeInterval groupTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSLog(@"Fan-out of %lu packets to %lu members: individual clients %.4f s (%.2f us per member), group %.4f s (%.2f us per member)",
+          (unsigned long)packetCount, (unsigned long)memberCount,
+          individualTime, individualTime * 1e6 / (memberCount * packetCount),
+          groupTime, groupTime * 1e6 / (memberCount * packetCount));
+
+    XCTAssertEqual(group.encodedPacketCount, packetCount);
+    XCTAssertEqual(group.sharedDatagramCount, memberCount * packetCount);
+    XCTAssertLessThan(groupTime, individualTime, @"Encoding once and sharing a socket should beat sending from each client");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -30,6 +30,8 @@
 
 #import <XCTest/XCTest.h>
 
+#import "F53OSCBundle.h"
+#import "F53OSCBundleBuilder.h"
 #import "F53OSCClient.h"
 #import "F53OSCMessage.h"
 #import "F53OSCServer.h"
@@ -47,8 +49,71 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface F53OSCClient (F53OSC_ClientTestsAccess)
 @property (strong, nullable)    F53OSCSocket *socket;
+@property (strong, nullable)    NSMutableDictionary<NSString *, id> *readState;
 @end
 
+// Records read-progress and connection callbacks along with the queue they arrived on.
+@interface ClientTestsCallbackRecorder : NSObject <F53OSCClientDelegate>
+@property (atomic, assign)              NSUInteger didReadCallCount;
+@property (atomic, assign)              NSUInteger lastReadLength;
+@property (atomic, assign)              BOOL connectCalledOnCallbackQueue;
+@property (nonatomic, strong, nullable) XCTestExpectation *connectExpectation;
+@end
+
+@implementation ClientTestsCallbackRecorder
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+}
+
+- (void)client:(F53OSCClient *)client didReadData:(NSUInteger)lengthOfCurrentRead
+{
+    self.didReadCallCount++;
+    self.lastReadLength = lengthOfCurrentRead;
+}
+
+- (void)clientDidConnect:(F53OSCClient *)client
+{
+    self.connectCalledOnCallbackQueue = ( dispatch_get_specific((__bridge const void *)self) != NULL );
+    [self.connectExpectation fulfill];
+}
+
+@end
+
+
+// Counts the datagrams that arrive on a plain UDP socket, so tests can see how many packets a client actually sent.
+@interface ClientTestsDatagramCounter : NSObject <GCDAsyncUdpSocketDelegate>
+@property (nonatomic, strong)           GCDAsyncUdpSocket *udpSocket;
+@property (atomic, assign)              NSUInteger datagramCount;
+@property (atomic, assign)              NSUInteger byteCount;
+- (BOOL)listenOnPort:(UInt16)port;
+@end
+
+@implementation ClientTestsDatagramCounter
+
+- (BOOL)listenOnPort:(UInt16)port
+{
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.ClientTests.datagramCounter", DISPATCH_QUEUE_SERIAL);
+    self.udpSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:self delegateQueue:queue];
+
+    NSError *error = nil;
+    if (![self.udpSocket bindToPort:port error:&error] || ![self.udpSocket beginReceiving:&error])
+    {
+        NSLog(@"ClientTestsDatagramCounter could not listen on port %hu: %@", port, error);
+        return NO;
+    }
+    return YES;
+}
+
+- (void)udpSocket:(GCDAsyncUdpSocket *)sock didReceiveData:(NSData *)data fromAddress:(NSData *)address withFilterContext:(nullable id)filterContext
+{
+    self.datagramCount++;
+    self.byteCount += data.length;
+}
+
+@end
+
+
 @interface F53OSC_ClientTests : XCTestCase <F53OSCServerDelegate, F53OSCClientDelegate>
 
 @property (nonatomic, strong, nullable) XCTestExpectation *connectionExpectation;
@@ -60,6 +125,10 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, nullable) XCTestExpectation *tcpEncryptedMessageExpectation;
 @property (nonatomic, strong, nullable) XCTestExpectation *udpAttemptedEncryptedMessageExpectation;
 
+@property (nonatomic, strong, nullable) NSMutableArray<F53OSCMessage *> *coalescedMessages;
+@property (nonatomic, assign)           NSUInteger expectedCoalescedMessageCount;
+@property (nonatomic, strong, nullable) XCTestExpectation *coalescedMessagesExpectation;
+
 @end
 
 @implementation F53OSC_ClientTests
@@ -138,6 +207,20 @@ NS_ASSUME_NONNULL_BEGIN
     XCTAssertNil(client.interface, @"Default interface should be nil");
     XCTAssertEqualObjects(client.host, @"localhost", @"Default host should be 'localhost'");
     XCTAssertEqual(client.port, 53000, @"Default port should be 53000");
+    XCTAssertEqual(client.coalescingInterval, 0, @"Default coalescingInterval should be 0 (disabled)");
+    XCTAssertEqual(client.coalescingMaxPacketSize, F53OSCEthernetUDPPayloadSize, @"Default coalescingMaxPacketSize should fit an Ethernet UDP payload");
+    XCTAssertEqualObjects(client.delegateCallbackQueue, dispatch_get_main_queue(), @"Default delegateCallbackQueue should be the main queue");
+    XCTAssertEqual(client.maxMessageBatchSize, 0, @"Default maxMessageBatchSize should be 0 (no limit)");
+    XCTAssertEqual(client.messageBatchLatency, 0, @"Default messageBatchLatency should be 0");
+    XCTAssertNil(client.priorityScheduler, @"Default priorityScheduler should be nil");
+    XCTAssertNil(client.readFlowControl, @"Default readFlowControl should be nil");
+    XCTAssertNil(client.transportEngine, @"Default transportEngine should be nil");
+    XCTAssertNil(client.outboundQueue, @"Default outboundQueue should be nil");
+    XCTAssertFalse(client.reconnectsAutomatically, @"Default reconnectsAutomatically should be NO");
+    XCTAssertEqual(client.reconnectMinimumDelay, 0.25, @"Default reconnectMinimumDelay should be 0.25");
+    XCTAssertEqual(client.reconnectMaximumDelay, 8.0, @"Default reconnectMaximumDelay should be 8");
+    XCTAssertEqual(client.reconnectAttemptCount, 0);
+    XCTAssertEqual(client.reconnectCount, 0);
     XCTAssertFalse(client.IPv6Enabled, @"Default IPv6Enabled should be NO");
     XCTAssertFalse(client.useTcp, @"Default useTcp should be NO");
     XCTAssertEqual(client.tcpTimeout, -1, @"Default tcpTimeout should be -1");
@@ -150,6 +233,10 @@ NS_ASSUME_NONNULL_BEGIN
     XCTAssertTrue(client.isValid, @"Default client should be valid");
     XCTAssertFalse(client.isConnected, @"Default client should not be connected");
     XCTAssertTrue(client.hostIsLocal, @"Default hostIsLocal should be YES");
+    XCTAssertFalse(client.hostIsMulticast, @"Default hostIsMulticast should be NO");
+    XCTAssertEqual(client.multicastTTL, 1, @"Default multicastTTL should be 1");
+    XCTAssertTrue(client.multicastLoopback, @"Default multicastLoopback should be YES");
+    XCTAssertNil(client.socketOptions, @"Default socketOptions should be nil");
 }
 
 - (void)testThat_clientCanConfigureProperties
@@ -1225,13 +1312,291 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 
+#pragma mark - Coalescing tests
+
+- (void)testThat_clientCoalescingIntervalHandlesEdgeValues
+{
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+
+    client.coalescingInterval = -1;
+    XCTAssertEqual(client.coalescingInterval, 0, @"Negative coalescingInterval should be clamped to 0");
+
+    client.coalescingInterval = 0.005;
+    XCTAssertEqualWithAccuracy(client.coalescingInterval, 0.005, 0.0001);
+
+    client.coalescingInterval = 0;
+    XCTAssertEqual(client.coalescingInterval, 0);
+
+    XCTAssertNoThrow([client flush], @"Flushing with nothing gathered should do nothing");
+}
+
+- (void)testThat_clientCoalescingDeliversMessagesInOrder
+{
+    UInt16 port = PORT_BASE + 91;
+
+    F53OSCServer *server = [self basicServerWithPort:port];
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    F53OSCClient *client = [self basicClientWithPort:port];
+    client.coalescingInterval = 0.01;
+
+    NSUInteger messageCount = 200;
+    self.coalescedMessages = [NSMutableArray array];
+    self.expectedCoalescedMessageCount = messageCount;
+    self.coalescedMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"All coalesced messages received"];
+
+    for (NSUInteger i = 0; i < messageCount; i++)
+    {
+        F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/coalesce/order" arguments:@[@(i)]];
+        [client sendPacket:message];
+    }
+    [client flush];
+
+    [self waitForExpectations:@[self.coalescedMessagesExpectation] timeout:5.0];
+
+    XCTAssertEqual(self.coalescedMessages.count, messageCount);
+    for (NSUInteger i = 0; i < self.coalescedMessages.count; i++)
+        XCTAssertEqualObjects(self.coalescedMessages[i].arguments.firstObject, @(i), @"Messages should arrive in the order they were sent");
+}
+
+- (void)testThat_clientCoalescingFlushesAfterInterval
+{
+    UInt16 port = PORT_BASE + 93;
+
+    F53OSCServer *server = [self basicServerWithPort:port];
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    F53OSCClient *client = [self basicClientWithPort:port];
+    client.coalescingInterval = 0.05;
+
+    self.coalescedMessages = [NSMutableArray array];
+    self.expectedCoalescedMessageCount = 3;
+    self.coalescedMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Coalesced messages received without an explicit flush"];
+
+    [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/coalesce/timer" arguments:@[@0]]];
+    [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/coalesce/timer" arguments:@[@1]]];
+    [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/coalesce/timer" arguments:@[@2]]];
+
+    [self waitForExpectations:@[self.coalescedMessagesExpectation] timeout:2.0];
+
+    XCTAssertEqual(self.coalescedMessages.count, 3);
+    for (NSUInteger i = 0; i < self.coalescedMessages.count; i++)
+        XCTAssertEqualObjects(self.coalescedMessages[i].arguments.firstObject, @(i));
+}
+
+- (void)testThat_clientCoalescingKeepsOrderWithImmediateSends
+{
+    UInt16 port = PORT_BASE + 94;
+
+    F53OSCServer *server = [self basicServerWithPort:port];
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    F53OSCClient *client = [self basicClientWithPort:port];
+    client.coalescingInterval = 0.001; // short enough that the flush timer races the immediate sends
+
+    NSUInteger pairCount = 100;
+    self.coalescedMessages = [NSMutableArray array];
+    self.expectedCoalescedMessageCount = pairCount * 2;
+    self.coalescedMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Coalesced and immediate messages received"];
+
+    for (NSUInteger i = 0; i < pairCount; i++)
+    {
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/coalesce/race" arguments:@[@(i * 2)]]];
+        [NSThread sleepForTimeInterval:0.001];
+
+        // Never gathered, so it must wait for the gathered message to go out.
+        NSData *data = [[F53OSCMessage messageWithAddressPattern:@"/coalesce/race" arguments:@[@(i * 2 + 1)]] packetData];
+        [client sendPacketData:data slipFramedData:nil];
+    }
+
+    [self waitForExpectations:@[self.coalescedMessagesExpectation] timeout:5.0];
+
+    XCTAssertEqual(self.coalescedMessages.count, pairCount * 2);
+    for (NSUInteger i = 0; i < self.coalescedMessages.count; i++)
+        XCTAssertEqualObjects(self.coalescedMessages[i].arguments.firstObject, @(i), @"An immediate send should not overtake a gathered one");
+}
+
+- (void)testThat_clientCoalescingRespectsMaxPacketSize
+{
+    UInt16 port = PORT_BASE + 95;
+
+    ClientTestsDatagramCounter *counter = [[ClientTestsDatagramCounter alloc] init];
+    XCTAssertTrue([counter listenOnPort:port]);
+    [self addTeardownBlock:^{
+        [counter.udpSocket close];
+    }];
+
+    F53OSCClient *client = [self basicClientWithPort:port];
+    client.coalescingInterval = 10.0; // long enough that only size and -flush send bundles
+    client.coalescingMaxPacketSize = 512;
+
+    NSUInteger messageCount = 100;
+    NSUInteger payloadBytes = 0;
+    for (NSUInteger i = 0; i < messageCount; i++)
+    {
+        F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/coalesce/size" arguments:@[@(i), @"payload"]];
+        payloadBytes += message.packetData.length;
+        [client sendPacket:message];
+    }
+    [client flush];
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+    XCTAssertGreaterThan(counter.datagramCount, 1, @"Bundles should be split at coalescingMaxPacketSize");
+    XCTAssertLessThan(counter.datagramCount, messageCount / 4, @"Messages should share datagrams");
+    XCTAssertLessThanOrEqual(counter.byteCount, counter.datagramCount * client.coalescingMaxPacketSize, @"No datagram should exceed coalescingMaxPacketSize");
+    XCTAssertGreaterThan(counter.byteCount, payloadBytes, @"All message bytes plus bundle framing should arrive");
+}
+
+- (void)testThat_clientCoalescingReducesDatagramsSent
+{
+    NSUInteger messageCount = 2000;
+
+    NSUInteger (^countDatagrams)(UInt16, NSTimeInterval, NSTimeInterval *) = ^NSUInteger(UInt16 port, NSTimeInterval interval, NSTimeInterval *sendTime) {
+        ClientTestsDatagramCounter *counter = [[ClientTestsDatagramCounter alloc] init];
+        XCTAssertTrue([counter listenOnPort:port]);
+
+        F53OSCClient *client = [self basicClientWithPort:port];
+        client.coalescingInterval = interval;
+
+        NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+        for (NSUInteger i = 0; i < messageCount; i++)
+        {
+            F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/coalesce/benchmark/fader" arguments:@[@(i), @(0.5f)]];
+            [client sendPacket:message];
+        }
+        [client flush];
+        *sendTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+        [counter.udpSocket close];
+        return counter.datagramCount;
+    };
+
+    NSTimeInterval directTime = 0;
+    NSTimeInterval coalescedTime = 0;
+    NSUInteger directDatagrams = countDatagrams(PORT_BASE + 97, 0, &directTime);
+    NSUInteger coalescedDatagrams = countDatagrams(PORT_BASE + 99, 0.005, &coalescedTime);
+
+    NSLog(@"Coalescing benchmark (%lu messages):", (unsigned long)messageCount);
+    NSLog(@"  direct:    %lu datagrams, %.4f s to send", (unsigned long)directDatagrams, directTime);
+    NSLog(@"  coalesced: %lu datagrams, %.4f s to send", (unsigned long)coalescedDatagrams, coalescedTime);
+
+    XCTAssertGreaterThan(coalescedDatagrams, 0);
+    XCTAssertGreaterThan(directDatagrams, coalescedDatagrams * 10, @"Coalescing should send far fewer datagrams");
+}
+
+
+#pragma mark - Delegate callback queue tests
+
+- (void)testThat_clientDelegateCallbackQueueHandlesEdgeValues
+{
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+
+    dispatch_queue_t queue = dispatch_queue_create("test.callback.queue", DISPATCH_QUEUE_SERIAL);
+    client.delegateCallbackQueue = queue;
+    XCTAssertEqual(client.delegateCallbackQueue, queue);
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnonnull"
+    client.delegateCallbackQueue = nil;
+#pragma clang diagnostic pop
+    XCTAssertEqual(client.delegateCallbackQueue, dispatch_get_main_queue(), @"Setting nil should reset to the main queue");
+}
+
+- (void)testThat_clientCallsConnectOnDelegateCallbackQueue
+{
+    UInt16 port = PORT_BASE + 92;
+
+    F53OSCServer *server = [self basicServerWithPort:port];
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    ClientTestsCallbackRecorder *recorder = [[ClientTestsCallbackRecorder alloc] init];
+    recorder.connectExpectation = [[XCTestExpectation alloc] initWithDescription:@"Client connected"];
+
+    dispatch_queue_t callbackQueue = dispatch_queue_create("test.callback.queue", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_set_specific(callbackQueue, (__bridge const void *)recorder, (void *)1, NULL);
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.delegate = recorder;
+    client.delegateCallbackQueue = callbackQueue;
+    client.port = port;
+    client.useTcp = YES;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        client.delegate = nil;
+    }];
+
+    XCTAssertTrue([client connect]);
+    [self waitForExpectations:@[recorder.connectExpectation] timeout:5.0];
+
+    XCTAssertTrue(recorder.connectCalledOnCallbackQueue, @"clientDidConnect: should be called on delegateCallbackQueue");
+}
+
+- (void)testThat_clientReadsDoNotWaitOnBlockedMainThread
+{
+    ClientTestsCallbackRecorder *recorder = [[ClientTestsCallbackRecorder alloc] init];
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.delegate = recorder;
+    client.readChunkSize = 16;
+
+    GCDAsyncSocket *tcpSocket = [[GCDAsyncSocket alloc] initWithDelegate:nil delegateQueue:dispatch_get_main_queue()];
+    client.readState[@"socket"] = [F53OSCSocket socketWithTcpSocket:tcpSocket];
+
+    // Unterminated SLIP data, so each read just grows the current packet.
+    NSMutableData *chunk = [NSMutableData dataWithLength:16];
+    memset(chunk.mutableBytes, 'a', chunk.length);
+
+    NSUInteger readCount = 10000;
+    dispatch_semaphore_t readsDone = dispatch_semaphore_create(0);
+    __block NSTimeInterval readTime = 0;
+
+    dispatch_queue_t ioQueue = dispatch_queue_create("test.io.queue", DISPATCH_QUEUE_SERIAL);
+    dispatch_async(ioQueue, ^{
+        NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+        for (NSUInteger i = 0; i < readCount; i++)
+            [client socket:tcpSocket didReadData:chunk withTag:0];
+        readTime = [NSDate timeIntervalSinceReferenceDate] - start;
+        dispatch_semaphore_signal(readsDone);
+    });
+
+    // Block the main thread for the whole run; reads must finish regardless.
+    long result = dispatch_semaphore_wait(readsDone, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5.0 * NSEC_PER_SEC)));
+    XCTAssertEqual(result, 0, @"Reads should complete while the main thread is blocked");
+    XCTAssertEqual(recorder.didReadCallCount, 0, @"No callback can run while the main thread is blocked");
+
+    NSLog(@"%lu reads with a blocked main thread: %.4f s (%.0f reads/s)", (unsigned long)readCount, readTime, readCount / MAX(readTime, 0.000001));
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+
+    XCTAssertEqual(recorder.didReadCallCount, 1, @"Pending read notifications should be coalesced into one");
+    XCTAssertEqual(recorder.lastReadLength, readCount * chunk.length, @"The coalesced notification should report the latest length");
+}
+
+
 #pragma mark - F53OSCServerDelegate
 
 - (void)takeMessage:(nullable F53OSCMessage *)message
 {
     self.receivedMessage = message;
 
-    if ([message.addressPattern hasPrefix:@"/chunk"])
+    if ([message.addressPattern hasPrefix:@"/coalesce"])
+    {
+        [self.coalescedMessages addObject:message];
+        if (self.coalescedMessages.count == self.expectedCoalescedMessageCount)
+            [self.coalescedMessagesExpectation fulfill];
+    }
+    else if ([message.addressPattern hasPrefix:@"/chunk"])
         [self.chunkedMessageExpectation fulfill];
     else if ([message.addressPattern hasPrefix:@"/tcp/unencrypted"])
         [self.tcpUnencryptedMessageExpectation fulfill];
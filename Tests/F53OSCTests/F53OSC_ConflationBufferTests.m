@@ -0,0 +1,389 @@
+//
+//  F53OSC_ConflationBufferTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCConflationBuffer.h"
+#import "F53OSCMessage.h"
+#import "F53OSCTimeTag.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - ConflationTestDestination
+
+@interface ConflationTestDestination : NSObject <F53OSCPacketDestination>
+@property (strong) NSMutableArray<F53OSCMessage *> *messages;
+@property (assign) NSUInteger takeMessagesCallCount;
+@property (strong, nullable) dispatch_semaphore_t gate; // when set, each delivery waits on it to simulate a slow consumer
+@end
+
+@implementation ConflationTestDestination
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+        self.messages = [NSMutableArray array];
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (message)
+        [self.messages addObject:message];
+}
+
+- (void)takeMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    if (self.gate)
+        dispatch_semaphore_wait(self.gate, DISPATCH_TIME_FOREVER);
+
+    @synchronized (self)
+    {
+        self.takeMessagesCallCount++;
+        [self.messages addObjectsFromArray:messages];
+    }
+}
+
+@end
+
+
+#pragma mark - ConflationBundleTestDestination
+
+@interface ConflationBundleTestDestination : ConflationTestDestination
+@property (strong) NSMutableArray<NSArray<F53OSCMessage *> *> *bundles;
+@property (strong) NSMutableArray<F53OSCTimeTag *> *bundleTimeTags;
+@property (strong) NSMutableArray<NSNumber *> *messageCountsBeforeBundles; // messages already delivered when each bundle arrived
+@end
+
+@implementation ConflationBundleTestDestination
+
+- (void)takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    if (!self.bundles)
+    {
+        self.bundles = [NSMutableArray array];
+        self.bundleTimeTags = [NSMutableArray array];
+        self.messageCountsBeforeBundles = [NSMutableArray array];
+    }
+    [self.bundles addObject:messages];
+    [self.bundleTimeTags addObject:timeTag];
+    [self.messageCountsBeforeBundles addObject:@(self.messages.count)];
+}
+
+@end
+
+
+#pragma mark - F53OSC_ConflationBufferTests
+
+@interface F53OSC_ConflationBufferTests : XCTestCase
+@end
+
+@implementation F53OSC_ConflationBufferTests
+
+- (void)drainQueue:(dispatch_queue_t)queue
+{
+    dispatch_sync(queue, ^{});
+}
+
+- (NSArray *)firstArgumentsOfMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    NSMutableArray *arguments = [NSMutableArray array];
+    for (F53OSCMessage *message in messages)
+        [arguments addObject:message.arguments.firstObject ?: [NSNull null]];
+    return arguments;
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_conflationBufferHasCorrectDefaults
+{
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] init];
+
+    XCTAssertNil(buffer.destination);
+    XCTAssertEqual(buffer.deliveryQueue, dispatch_get_main_queue(), @"Default deliveryQueue should be the main queue");
+    XCTAssertEqual(buffer.pendingCount, 0);
+    XCTAssertEqual(buffer.conflatedCount, 0);
+    XCTAssertFalse([buffer conflatesAddress:@"/fader"]);
+}
+
+- (void)testThat_conflationBufferMatchesRegisteredAddresses
+{
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] init];
+    [buffer conflateAddress:@"/meter" keyArgumentCount:0];
+    [buffer conflateAddressesWithPrefix:@"/fader/" keyArgumentCount:0];
+
+    XCTAssertTrue([buffer conflatesAddress:@"/meter"]);
+    XCTAssertFalse([buffer conflatesAddress:@"/meter/1"], @"Exact addresses should not match as prefixes");
+    XCTAssertTrue([buffer conflatesAddress:@"/fader/1"]);
+    XCTAssertFalse([buffer conflatesAddress:@"/cue/1/go"]);
+
+    [buffer removeAllConflatedAddresses];
+    XCTAssertFalse([buffer conflatesAddress:@"/meter"]);
+    XCTAssertFalse([buffer conflatesAddress:@"/fader/1"]);
+}
+
+
+#pragma mark - Conflation tests
+
+- (void)testThat_conflationBufferKeepsNewestValuePerAddress
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.conflation.delivery", DISPATCH_QUEUE_SERIAL);
+    ConflationTestDestination *destination = [[ConflationTestDestination alloc] init];
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] initWithDeliveryQueue:queue];
+    buffer.destination = destination;
+    [buffer conflateAddress:@"/fader" keyArgumentCount:0];
+
+    dispatch_suspend(queue);
+    for (NSUInteger i = 0; i < 100; i++)
+        [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/fader" arguments:@[@(i)]]];
+
+    XCTAssertEqual(buffer.pendingCount, 1, @"Only the newest value should be pending");
+    XCTAssertEqual(buffer.conflatedCount, 99);
+
+    dispatch_resume(queue);
+    [self drainQueue:queue];
+
+    XCTAssertEqual(destination.messages.count, 1);
+    XCTAssertEqualObjects(destination.messages.firstObject.arguments.firstObject, @99, @"The newest value should win");
+}
+
+- (void)testThat_conflationBufferKeysOnLeadingArguments
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.conflation.delivery", DISPATCH_QUEUE_SERIAL);
+    ConflationTestDestination *destination = [[ConflationTestDestination alloc] init];
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] initWithDeliveryQueue:queue];
+    buffer.destination = destination;
+    [buffer conflateAddress:@"/channel/level" keyArgumentCount:1];
+
+    dispatch_suspend(queue);
+    for (NSUInteger i = 0; i < 10; i++)
+    {
+        [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/channel/level" arguments:@[@1, @(i)]]];
+        [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/channel/level" arguments:@[@2, @(i * 10)]]];
+    }
+    // Too few arguments to build a key, so this one is treated as discrete.
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/channel/level" arguments:@[]]];
+
+    XCTAssertEqual(buffer.pendingCount, 3);
+
+    dispatch_resume(queue);
+    [self drainQueue:queue];
+
+    XCTAssertEqual(destination.messages.count, 3);
+    XCTAssertEqualObjects(destination.messages[0].arguments, (@[@1, @9]));
+    XCTAssertEqualObjects(destination.messages[1].arguments, (@[@2, @90]));
+    XCTAssertEqual(destination.messages[2].arguments.count, 0);
+}
+
+- (void)testThat_conflationBufferUsesLongestMatchingPrefix
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.conflation.delivery", DISPATCH_QUEUE_SERIAL);
+    ConflationTestDestination *destination = [[ConflationTestDestination alloc] init];
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] initWithDeliveryQueue:queue];
+    buffer.destination = destination;
+
+    // Enough overlapping prefixes that enumeration order can not pick the right one by chance.
+    for (NSUInteger i = 0; i < 32; i++)
+        [buffer conflateAddressesWithPrefix:[NSString stringWithFormat:@"/mix/other%lu/", (unsigned long)i] keyArgumentCount:0];
+    [buffer conflateAddressesWithPrefix:@"/mix/ch/" keyArgumentCount:1];
+    [buffer conflateAddressesWithPrefix:@"/mix/" keyArgumentCount:0];
+    [buffer conflateAddressesWithPrefix:@"/m" keyArgumentCount:0];
+
+    dispatch_suspend(queue);
+    for (NSUInteger i = 0; i < 10; i++)
+    {
+        [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/mix/ch/gain" arguments:@[@1, @(i)]]];
+        [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/mix/ch/gain" arguments:@[@2, @(i)]]];
+        [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/mix/bus/gain" arguments:@[@1, @(i)]]];
+        [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/mix/bus/gain" arguments:@[@2, @(i)]]];
+    }
+
+    // "/mix/ch/" keys on the channel number; the rest of "/mix/" keys on the address alone.
+    XCTAssertEqual(buffer.pendingCount, 3);
+
+    dispatch_resume(queue);
+    [self drainQueue:queue];
+
+    XCTAssertEqual(destination.messages.count, 3);
+    XCTAssertEqualObjects(destination.messages[0].arguments, (@[@1, @9]));
+    XCTAssertEqualObjects(destination.messages[1].arguments, (@[@2, @9]));
+    XCTAssertEqualObjects(destination.messages[2].addressPattern, @"/mix/bus/gain");
+    XCTAssertEqualObjects(destination.messages[2].arguments, (@[@2, @9]));
+}
+
+- (void)testThat_conflationBufferKeepsArgumentTypesApart
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.conflation.delivery", DISPATCH_QUEUE_SERIAL);
+    ConflationTestDestination *destination = [[ConflationTestDestination alloc] init];
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] initWithDeliveryQueue:queue];
+    buffer.destination = destination;
+    [buffer conflateAddress:@"/channel/level" keyArgumentCount:1];
+
+    dispatch_suspend(queue);
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/channel/level" arguments:@[@1, @10]]];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/channel/level" arguments:@[@1.0f, @20]]];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/channel/level" arguments:@[@1, @30]]];
+
+    // An int 1 and a float 1.0 are different keys, even though the NSNumbers compare equal.
+    XCTAssertEqual(buffer.pendingCount, 2);
+
+    dispatch_resume(queue);
+    [self drainQueue:queue];
+
+    XCTAssertEqual(destination.messages.count, 2);
+    XCTAssertEqualObjects(destination.messages[0].typeTagString, @",ii");
+    XCTAssertEqualObjects(destination.messages[0].arguments[1], @30);
+    XCTAssertEqualObjects(destination.messages[1].typeTagString, @",fi");
+    XCTAssertEqualObjects(destination.messages[1].arguments[1], @20);
+}
+
+- (void)testThat_conflationBufferKeepsDiscreteMessagesInOrder
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.conflation.delivery", DISPATCH_QUEUE_SERIAL);
+    ConflationTestDestination *destination = [[ConflationTestDestination alloc] init];
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] initWithDeliveryQueue:queue];
+    buffer.destination = destination;
+    [buffer conflateAddress:@"/fader" keyArgumentCount:0];
+
+    dispatch_suspend(queue);
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/fader" arguments:@[@0]]];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@1]]];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/fader" arguments:@[@2]]];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@3]]];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@4]]];
+    dispatch_resume(queue);
+    [self drainQueue:queue];
+
+    // The surviving fader value keeps its place after the discrete message that preceded it.
+    XCTAssertEqualObjects([self firstArgumentsOfMessages:destination.messages], (@[@1, @2, @3, @4]));
+}
+
+- (void)testThat_conflationBufferForwardsBundlesWholeAndInOrder
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.conflation.delivery", DISPATCH_QUEUE_SERIAL);
+    ConflationTestDestination *destination = [[ConflationTestDestination alloc] init];
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] initWithDeliveryQueue:queue];
+    buffer.destination = destination;
+    [buffer conflateAddress:@"/fader" keyArgumentCount:0];
+    F53OSCTimeTag *timeTag = [F53OSCTimeTag timeTagWithDate:[NSDate dateWithTimeIntervalSinceNow:1.0]];
+
+    XCTAssertFalse([buffer respondsToSelector:@selector(takeBundleMessages:timeTag:)], @"Bundles should only be forwarded to destinations that take them");
+
+    // A destination without takeBundleMessages:timeTag: still gets a bundle's messages in their place.
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@0]]];
+    [buffer takeBundleMessages:@[[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@1]],
+                                 [F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@2]]] timeTag:timeTag];
+    [self drainQueue:queue];
+    XCTAssertEqualObjects([self firstArgumentsOfMessages:destination.messages], (@[@0, @1, @2]));
+
+    ConflationBundleTestDestination *bundleDestination = [[ConflationBundleTestDestination alloc] init];
+    buffer.destination = bundleDestination;
+    XCTAssertTrue([buffer respondsToSelector:@selector(takeBundleMessages:timeTag:)]);
+
+    dispatch_suspend(queue);
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/fader" arguments:@[@0]]];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@1]]];
+    [buffer takeBundleMessages:@[[F53OSCMessage messageWithAddressPattern:@"/fader" arguments:@[@2]],
+                                 [F53OSCMessage messageWithAddressPattern:@"/fader" arguments:@[@3]]] timeTag:timeTag];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/fader" arguments:@[@4]]];
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@5]]];
+    XCTAssertEqual(buffer.pendingCount, 5);
+    dispatch_resume(queue);
+    [self drainQueue:queue];
+
+    XCTAssertEqual(bundleDestination.bundles.count, 1);
+    XCTAssertEqualObjects([self firstArgumentsOfMessages:bundleDestination.bundles.firstObject], (@[@2, @3]), @"Messages in a bundle should not be conflated");
+    XCTAssertEqual(bundleDestination.bundleTimeTags.firstObject, timeTag);
+    XCTAssertEqualObjects(bundleDestination.messageCountsBeforeBundles, @[@1], @"Messages received before a bundle should be delivered first");
+    XCTAssertEqualObjects([self firstArgumentsOfMessages:bundleDestination.messages], (@[@1, @4, @5]));
+    XCTAssertEqual(buffer.conflatedCount, 1);
+}
+
+- (void)testThat_conflationBufferStaysBoundedWhileConsumerIsBlocked
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.conflation.delivery", DISPATCH_QUEUE_SERIAL);
+    ConflationTestDestination *destination = [[ConflationTestDestination alloc] init];
+    destination.gate = dispatch_semaphore_create(0);
+
+    F53OSCConflationBuffer *buffer = [[F53OSCConflationBuffer alloc] initWithDeliveryQueue:queue];
+    buffer.destination = destination;
+    [buffer conflateAddressesWithPrefix:@"/meter/" keyArgumentCount:0];
+
+    NSMutableArray<F53OSCMessage *> *meterMessages = [NSMutableArray array];
+    for (NSUInteger channel = 0; channel < 16; channel++)
+        [meterMessages addObject:[F53OSCMessage messageWithAddressPattern:[NSString stringWithFormat:@"/meter/%lu", (unsigned long)channel] arguments:@[@(channel)]]];
+
+    // The first delivery blocks on the gate, so everything after it piles up behind a stalled consumer.
+    [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@0]]];
+    [NSThread sleepForTimeInterval:0.05];
+
+    NSUInteger updateCount = 200000;
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < updateCount; i++)
+    {
+        [buffer takeMessage:meterMessages[i % meterMessages.count]];
+        if (i % 50000 == 0)
+            [buffer takeMessage:[F53OSCMessage messageWithAddressPattern:@"/go" arguments:@[@(i + 1)]]];
+    }
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSLog(@"Conflated %lu updates behind a blocked consumer in %.4f s; %lu pending", (unsigned long)updateCount, elapsed, (unsigned long)buffer.pendingCount);
+
+    XCTAssertLessThanOrEqual(buffer.pendingCount, meterMessages.count + 4, @"Pending messages should be bounded by the number of keys plus discrete messages");
+    XCTAssertGreaterThanOrEqual(buffer.conflatedCount, updateCount - meterMessages.count);
+
+    // Release the consumer for the stalled delivery and the one queued behind it.
+    dispatch_semaphore_signal(destination.gate);
+    dispatch_semaphore_signal(destination.gate);
+    [self drainQueue:queue];
+
+    XCTAssertEqual(destination.takeMessagesCallCount, 2, @"At most one delivery should be queued behind a stalled one");
+    XCTAssertEqual(destination.messages.count, 1 + meterMessages.count + 4);
+    XCTAssertEqual(buffer.pendingCount, 0);
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
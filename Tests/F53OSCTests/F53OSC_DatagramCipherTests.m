@@ -0,0 +1,550 @@
+//
+//  F53OSC_DatagramCipherTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCClient.h"
+#import "F53OSCDatagramCipher.h"
+#import "F53OSCEncryptHandshake.h"
+#import "F53OSCMessage.h"
+#import "F53OSCRealtimeRing.h"
+#import "F53OSCServer.h"
+#import "F53OSCSocket.h"
+
+#if __has_include(<F53OSC/F53OSC-Swift.h>) // F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSC-Swift.h>
+#elif __has_include("F53OSC-Swift.h")
+#import "F53OSC-Swift.h"
+#endif
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define PORT_BASE   10300
+
+#define BENCHMARK_DATAGRAMS     10000
+
+@interface F53OSCClient (F53OSC_DatagramCipherTestsAccess)
+@property (strong, nullable)    F53OSCSocket *socket;
+@end
+
+// Plays both ends of an encrypted UDP session.
+@interface DatagramCipherTestPeer : NSObject <F53OSCServerDelegate, F53OSCClientDelegate>
+@property (atomic, strong)              NSMutableArray<F53OSCMessage *> *receivedMessages;
+@property (nonatomic, strong, nullable) XCTestExpectation *connectExpectation;
+@property (nonatomic, strong, nullable) XCTestExpectation *messageExpectation;
+@end
+
+@implementation DatagramCipherTestPeer
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+        self.receivedMessages = [NSMutableArray array];
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (!message)
+        return;
+
+    [self.receivedMessages addObject:message];
+    [self.messageExpectation fulfill];
+}
+
+- (void)clientDidConnect:(F53OSCClient *)client
+{
+    [self.connectExpectation fulfill];
+}
+
+@end
+
+
+#pragma mark - F53OSC_DatagramCipherTests
+
+@interface F53OSC_DatagramCipherTests : XCTestCase
+@end
+
+@implementation F53OSC_DatagramCipherTests
+
+// An initiator and a responder cipher that share a session key.
+- (NSArray<F53OSCDatagramCipher *> *)agreedCiphers
+{
+    F53OSCEncrypt *local = [[F53OSCEncrypt alloc] init];
+    F53OSCEncrypt *remote = [[F53OSCEncrypt alloc] init];
+    XCTAssertNotNil([local generateKeyPair]);
+    XCTAssertNotNil([remote generateKeyPair]);
+
+    [local generateSalt];
+    remote.salt = local.salt;
+    XCTAssertTrue([local beginEncryptingWithPeerKey:(NSData * _Nonnull)remote.publicKeyData]);
+    XCTAssertTrue([remote beginEncryptingWithPeerKey:(NSData * _Nonnull)local.publicKeyData]);
+
+    return @[[[F53OSCDatagramCipher alloc] initWithEncrypter:local initiator:YES],
+             [[F53OSCDatagramCipher alloc] initWithEncrypter:remote initiator:NO]];
+}
+
+- (NSData *)packetDataForNumber:(NSInteger)number
+{
+    return [[F53OSCMessage messageWithAddressPattern:@"/datagram" arguments:@[@(number)]] packetData];
+}
+
+- (F53OSCServer *)encryptingServerWithPort:(UInt16)port peer:(DatagramCipherTestPeer *)peer
+{
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = peer;
+    server.port = port;
+    server.udpReplyPort = port + 1;
+    server.keyPair = [[[F53OSCEncrypt alloc] init] generateKeyPair];
+    server.udpEncryptionEnabled = YES;
+
+    [self addTeardownBlock:^{
+        [server stopListening];
+        server.delegate = nil;
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    return server;
+}
+
+- (F53OSCClient *)encryptingClientWithPort:(UInt16)port peer:(DatagramCipherTestPeer *)peer
+{
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.delegate = peer;
+    client.host = @"localhost";
+    client.port = port;
+    client.udpEncryptionEnabled = YES;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        client.delegate = nil;
+    }];
+
+    return client;
+}
+
+- (void)connectClient:(F53OSCClient *)client keyPair:(NSData *)keyPair peer:(DatagramCipherTestPeer *)peer
+{
+    XCTestExpectation *connectExpectation = [[XCTestExpectation alloc] initWithDescription:@"Client connected"];
+    peer.connectExpectation = connectExpectation;
+    XCTAssertTrue([client connectEncryptedWithKeyPair:keyPair]);
+    XCTAssertEqual([XCTWaiter waitForExpectations:@[connectExpectation] timeout:5.0], XCTWaiterResultCompleted, @"Client should finish the handshake");
+    peer.connectExpectation = nil;
+}
+
+- (void)sendMessageFromClient:(F53OSCClient *)client peer:(DatagramCipherTestPeer *)peer
+{
+    XCTestExpectation *messageExpectation = [[XCTestExpectation alloc] initWithDescription:@"Message received"];
+    peer.messageExpectation = messageExpectation;
+    [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/udp/encrypted" arguments:@[@(peer.receivedMessages.count)]]];
+    XCTAssertEqual([XCTWaiter waitForExpectations:@[messageExpectation] timeout:5.0], XCTWaiterResultCompleted, @"Server should receive the message");
+    peer.messageExpectation = nil;
+}
+
+- (void)waitForServerQueue
+{
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.25]];
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_datagramCipherHasCorrectDefaults
+{
+    NSArray<F53OSCDatagramCipher *> *ciphers = [self agreedCiphers];
+
+    XCTAssertTrue(ciphers[0].initiator);
+    XCTAssertFalse(ciphers[1].initiator);
+    XCTAssertEqual(ciphers[0].sealedCount, 0);
+    XCTAssertEqual(ciphers[0].openedCount, 0);
+    XCTAssertEqual(ciphers[0].replayedCount, 0);
+    XCTAssertEqual(ciphers[0].failedCount, 0);
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    XCTAssertFalse(server.udpEncryptionEnabled);
+    XCTAssertEqual(server.maxUdpEncryptionSessions, 256);
+    XCTAssertEqual(server.udpEncryptionSessionCount, 0);
+
+    XCTAssertFalse([[F53OSCClient alloc] init].udpEncryptionEnabled);
+}
+
+
+#pragma mark - Sealing tests
+
+- (void)testThat_sealedDatagramsOpenAtThePeer
+{
+    NSArray<F53OSCDatagramCipher *> *ciphers = [self agreedCiphers];
+    F53OSCDatagramCipher *initiator = ciphers[0];
+    F53OSCDatagramCipher *responder = ciphers[1];
+
+    NSData *packetData = [self packetDataForNumber:1];
+    NSData *datagram = [initiator sealPacketData:packetData];
+    XCTAssertNotNil(datagram);
+    XCTAssertEqual(((const char *)datagram.bytes)[0], '*');
+    XCTAssertEqual(datagram.length, 1 + 12 + packetData.length + 16, @"Datagrams carry the nonce and tag");
+    XCTAssertEqualObjects([responder openDatagram:(NSData * _Nonnull)datagram], packetData);
+
+    NSData *reply = [responder sealPacketData:packetData];
+    XCTAssertEqualObjects([initiator openDatagram:(NSData * _Nonnull)reply], packetData);
+
+    XCTAssertEqual(initiator.sealedCount, 1);
+    XCTAssertEqual(initiator.openedCount, 1);
+    XCTAssertEqual(responder.sealedCount, 1);
+    XCTAssertEqual(responder.openedCount, 1);
+}
+
+- (void)testThat_eachDatagramHasItsOwnNonce
+{
+    F53OSCDatagramCipher *initiator = [self agreedCiphers][0];
+    NSData *packetData = [self packetDataForNumber:1];
+
+    NSData *first = [initiator sealPacketData:packetData];
+    NSData *second = [initiator sealPacketData:packetData];
+    XCTAssertNotEqualObjects([first subdataWithRange:NSMakeRange(1, 12)], [second subdataWithRange:NSMakeRange(1, 12)]);
+    XCTAssertNotEqualObjects(first, second);
+}
+
+- (void)testThat_forgedAndReflectedDatagramsAreRejected
+{
+    NSArray<F53OSCDatagramCipher *> *ciphers = [self agreedCiphers];
+    F53OSCDatagramCipher *initiator = ciphers[0];
+    F53OSCDatagramCipher *responder = ciphers[1];
+
+    NSMutableData *tampered = [[initiator sealPacketData:[self packetDataForNumber:1]] mutableCopy];
+    ((uint8_t *)tampered.mutableBytes)[tampered.length - 1] ^= 0x01;
+    XCTAssertNil([responder openDatagram:tampered]);
+
+    // A datagram sent back to the end that sealed it is not accepted there.
+    NSData *reflected = [initiator sealPacketData:[self packetDataForNumber:2]];
+    XCTAssertNil([initiator openDatagram:(NSData * _Nonnull)reflected]);
+
+    XCTAssertNil([responder openDatagram:[NSData dataWithBytes:"*short" length:6]]);
+    XCTAssertNil([responder openDatagram:[self packetDataForNumber:3]], @"Clear packets are not datagrams");
+
+    XCTAssertEqual(responder.failedCount, 3);
+    XCTAssertEqual(initiator.failedCount, 1);
+
+    // A forged datagram does not use up the counter of the real one.
+    tampered = [[initiator sealPacketData:[self packetDataForNumber:4]] mutableCopy];
+    NSData *genuine = [tampered copy];
+    ((uint8_t *)tampered.mutableBytes)[20] ^= 0x01;
+    XCTAssertNil([responder openDatagram:tampered]);
+    XCTAssertNotNil([responder openDatagram:genuine]);
+}
+
+
+#pragma mark - Replay window tests
+
+- (void)testThat_replayedDatagramsAreRejected
+{
+    NSArray<F53OSCDatagramCipher *> *ciphers = [self agreedCiphers];
+    F53OSCDatagramCipher *initiator = ciphers[0];
+    F53OSCDatagramCipher *responder = ciphers[1];
+
+    NSData *datagram = (NSData * _Nonnull)[initiator sealPacketData:[self packetDataForNumber:1]];
+    XCTAssertNotNil([responder openDatagram:datagram]);
+    XCTAssertNil([responder openDatagram:datagram]);
+    XCTAssertNil([responder openDatagram:datagram]);
+
+    XCTAssertEqual(responder.openedCount, 1);
+    XCTAssertEqual(responder.replayedCount, 2);
+}
+
+- (void)testThat_reorderedDatagramsAreAcceptedOnce
+{
+    NSArray<F53OSCDatagramCipher *> *ciphers = [self agreedCiphers];
+    F53OSCDatagramCipher *initiator = ciphers[0];
+    F53OSCDatagramCipher *responder = ciphers[1];
+
+    NSMutableArray<NSData *> *datagrams = [NSMutableArray array];
+    for (NSInteger i = 0; i < 100; i++)
+        [datagrams addObject:(NSData * _Nonnull)[initiator sealPacketData:[self packetDataForNumber:i]]];
+
+    // Newest first, then the rest twice over.
+    for (NSInteger i = 99; i >= 0; i--)
+        XCTAssertEqualObjects([responder openDatagram:datagrams[i]], [self packetDataForNumber:i]);
+    for (NSData *datagram in datagrams)
+        XCTAssertNil([responder openDatagram:datagram]);
+
+    XCTAssertEqual(responder.openedCount, 100);
+    XCTAssertEqual(responder.replayedCount, 100);
+}
+
+- (void)testThat_datagramsTooFarBehindAreRejected
+{
+    NSArray<F53OSCDatagramCipher *> *ciphers = [self agreedCiphers];
+    F53OSCDatagramCipher *initiator = ciphers[0];
+    F53OSCDatagramCipher *responder = ciphers[1];
+
+    NSData *oldest = (NSData * _Nonnull)[initiator sealPacketData:[self packetDataForNumber:0]];
+    NSData *withinWindow = (NSData * _Nonnull)[initiator sealPacketData:[self packetDataForNumber:1]];
+    for (NSInteger i = 2; i < F53OSCDatagramCipherReplayWindow; i++)
+        [initiator sealPacketData:[self packetDataForNumber:i]];
+
+    // Counter 1984 leaves counter 0 just outside the window, and counter 1 just inside it.
+    NSData *newest = (NSData * _Nonnull)[initiator sealPacketData:[self packetDataForNumber:F53OSCDatagramCipherReplayWindow]];
+    XCTAssertNotNil([responder openDatagram:newest]);
+    XCTAssertNil([responder openDatagram:oldest]);
+    XCTAssertNotNil([responder openDatagram:withinWindow]);
+
+    XCTAssertEqual(responder.replayedCount, 1);
+}
+
+
+#pragma mark - Encrypted UDP session tests
+
+- (void)testThat_udpClientCanSendEncryptedMessages
+{
+    DatagramCipherTestPeer *peer = [[DatagramCipherTestPeer alloc] init];
+    UInt16 port = PORT_BASE;
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = peer;
+    server.port = port;
+    server.udpReplyPort = port + 1;
+    server.keyPair = [[[F53OSCEncrypt alloc] init] generateKeyPair];
+    server.udpEncryptionEnabled = YES;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.delegate = peer;
+    client.host = @"localhost";
+    client.port = port;
+    client.useTcp = NO;
+    client.udpEncryptionEnabled = YES;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        client.delegate = nil;
+        [server stopListening];
+        server.delegate = nil;
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    XCTestExpectation *connectExpectation = [[XCTestExpectation alloc] initWithDescription:@"Client connected"];
+    peer.connectExpectation = connectExpectation;
+    XCTAssertTrue([client connectEncryptedWithKeyPair:(NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair]]);
+    XCTAssertEqual([XCTWaiter waitForExpectations:@[connectExpectation] timeout:5.0], XCTWaiterResultCompleted, @"Client should finish the handshake");
+    XCTAssertTrue(client.isEncrypting);
+    XCTAssertNotNil(client.socket.datagramCipher);
+    XCTAssertEqual(server.udpEncryptionSessionCount, 0, @"The session should not be confirmed before a sealed datagram arrives");
+    XCTAssertEqual(server.unconfirmedUdpEncryptionSessionCount, 1);
+
+    XCTestExpectation *messageExpectation = [[XCTestExpectation alloc] initWithDescription:@"Message received"];
+    peer.messageExpectation = messageExpectation;
+    [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/udp/encrypted" arguments:@[@"secret", @(42)]]];
+    XCTAssertEqual([XCTWaiter waitForExpectations:@[messageExpectation] timeout:5.0], XCTWaiterResultCompleted, @"Server should receive the message");
+    XCTAssertEqual(server.udpEncryptionSessionCount, 1, @"The first sealed datagram should confirm the session");
+    XCTAssertEqual(server.unconfirmedUdpEncryptionSessionCount, 0);
+
+    F53OSCMessage *received = peer.receivedMessages.lastObject;
+    XCTAssertEqualObjects(received.addressPattern, @"/udp/encrypted");
+    XCTAssertEqualObjects(received.arguments, (@[@"secret", @(42)]));
+    XCTAssertEqual(client.socket.datagramCipher.sealedCount, 1, @"The message should have been sealed");
+
+    [client disconnect];
+    XCTAssertFalse(client.isEncrypting);
+    XCTAssertNil(client.socket.datagramCipher);
+}
+
+- (void)testThat_serverKeepsAtMostMaxUdpEncryptionSessions
+{
+    DatagramCipherTestPeer *peer = [[DatagramCipherTestPeer alloc] init];
+    UInt16 port = PORT_BASE + 10;
+    F53OSCServer *server = [self encryptingServerWithPort:port peer:peer];
+    server.maxUdpEncryptionSessions = 2;
+
+    for (NSUInteger i = 0; i < 3; i++)
+    {
+        F53OSCClient *client = [self encryptingClientWithPort:port peer:peer];
+        [self connectClient:client keyPair:(NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair] peer:peer];
+        [self sendMessageFromClient:client peer:peer];
+    }
+
+    XCTAssertEqual(server.udpEncryptionSessionCount, 2);
+    XCTAssertEqual(server.unconfirmedUdpEncryptionSessionCount, 0);
+
+    [server stopListening];
+    XCTAssertEqual(server.udpEncryptionSessionCount, 0);
+}
+
+- (void)testThat_udpClientHandshakesAgainFromTheSamePort
+{
+    DatagramCipherTestPeer *peer = [[DatagramCipherTestPeer alloc] init];
+    UInt16 port = PORT_BASE + 20;
+    F53OSCServer *server = [self encryptingServerWithPort:port peer:peer];
+    F53OSCClient *client = [self encryptingClientWithPort:port peer:peer];
+    NSData *keyPair = (NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair];
+
+    [self connectClient:client keyPair:keyPair peer:peer];
+    [self sendMessageFromClient:client peer:peer];
+    NSData *salt = client.socket.encrypter.salt;
+    XCTAssertNotNil(salt);
+
+    // The socket stays bound across a disconnect, so the second handshake comes from the same port.
+    [client disconnect];
+    [self connectClient:client keyPair:keyPair peer:peer];
+    XCTAssertEqualObjects(client.socket.encrypter.salt, salt, @"A confirmed session should be approved again with its existing key");
+    [self sendMessageFromClient:client peer:peer];
+    [self sendMessageFromClient:client peer:peer];
+    XCTAssertEqual(server.udpEncryptionSessionCount, 1);
+    XCTAssertEqual(server.unconfirmedUdpEncryptionSessionCount, 0);
+
+    // A new key pair from the same port gets a new session, which takes over once it is confirmed.
+    [client disconnect];
+    [self connectClient:client keyPair:(NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair] peer:peer];
+    XCTAssertNotEqualObjects(client.socket.encrypter.salt, salt);
+    XCTAssertEqual(server.unconfirmedUdpEncryptionSessionCount, 1);
+    [self sendMessageFromClient:client peer:peer];
+    XCTAssertEqual(server.udpEncryptionSessionCount, 1);
+    XCTAssertEqual(server.unconfirmedUdpEncryptionSessionCount, 0);
+    XCTAssertEqual(peer.receivedMessages.count, 4);
+}
+
+- (void)testThat_requestFloodLeavesConfirmedSessionAlone
+{
+    DatagramCipherTestPeer *peer = [[DatagramCipherTestPeer alloc] init];
+    UInt16 port = PORT_BASE + 30;
+    F53OSCServer *server = [self encryptingServerWithPort:port peer:peer];
+    server.maxUdpEncryptionSessions = 8;
+    F53OSCClient *client = [self encryptingClientWithPort:port peer:peer];
+
+    [self connectClient:client keyPair:(NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair] peer:peer];
+    [self sendMessageFromClient:client peer:peer];
+    NSData *salt = client.socket.encrypter.salt;
+    XCTAssertEqual(server.udpEncryptionSessionCount, 1);
+
+    // Requests are sent in the clear, so anyone on the path can replay the client's own from its address.
+    NSData *replayedRequest = [[[F53OSCEncryptHandshake handshakeWithEncrypter:(F53OSCEncrypt * _Nonnull)client.socket.encrypter] requestEncryptionMessage] packetData];
+    for (NSUInteger i = 0; i < 50; i++)
+        [client.socket.udpSocket sendData:replayedRequest toHost:@"localhost" port:port withTimeout:-1 tag:0];
+
+    // Requests from many other ports fill the unconfirmed sessions, which make room before confirmed ones do.
+    F53OSCEncrypt *forger = [[F53OSCEncrypt alloc] init];
+    [forger generateKeyPair];
+    NSData *forgedRequest = [[[F53OSCEncryptHandshake handshakeWithEncrypter:forger] requestEncryptionMessage] packetData];
+    NSMutableArray<GCDAsyncUdpSocket *> *forgingSockets = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 40; i++)
+    {
+        GCDAsyncUdpSocket *forgingSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+        [forgingSocket sendData:forgedRequest toHost:@"localhost" port:port withTimeout:-1 tag:0];
+        [forgingSockets addObject:forgingSocket];
+    }
+    [self waitForServerQueue];
+    for (GCDAsyncUdpSocket *forgingSocket in forgingSockets)
+        [forgingSocket closeAfterSending];
+
+    XCTAssertEqual(server.udpEncryptionSessionCount, 1, @"The confirmed session should outlast the flood");
+    XCTAssertLessThanOrEqual(server.unconfirmedUdpEncryptionSessionCount, 7);
+    XCTAssertEqualObjects(client.socket.encrypter.salt, salt, @"Replayed requests should not change the session key");
+
+    [self sendMessageFromClient:client peer:peer];
+    XCTAssertEqual(peer.receivedMessages.count, 2);
+}
+
+- (void)testThat_realtimeRingTakesOnlySealedDatagramsFromASession
+{
+    DatagramCipherTestPeer *peer = [[DatagramCipherTestPeer alloc] init];
+    UInt16 port = PORT_BASE + 40;
+    F53OSCServer *server = [self encryptingServerWithPort:port peer:peer];
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] initWithCapacity:16 producerMode:F53OSCRealtimeRingSingleProducer maxAddressCount:4];
+    uint32_t gainID = [ring registerAddress:@"/mixer/gain"];
+    server.realtimeRing = ring;
+    F53OSCClient *client = [self encryptingClientWithPort:port peer:peer];
+
+    [self connectClient:client keyPair:(NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair] peer:peer];
+    [self sendMessageFromClient:client peer:peer];
+    XCTAssertEqual(server.udpEncryptionSessionCount, 1);
+
+    // Sent in the clear from the session's own address, as a spoofer would.
+    NSData *plainPacket = [[F53OSCMessage messageWithAddressPattern:@"/mixer/gain" arguments:@[@0.5f]] packetData];
+    [client.socket.udpSocket sendData:plainPacket toHost:@"localhost" port:port withTimeout:-1 tag:0];
+    [self waitForServerQueue];
+    XCTAssertEqual(ring.count, 0, @"A plaintext datagram from an encrypting peer should not reach the ring");
+    XCTAssertEqual(peer.receivedMessages.count, 1, @"A plaintext datagram from an encrypting peer should not reach the delegate");
+
+    [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/mixer/gain" arguments:@[@0.75f]]];
+    F53OSCRealtimeRecord record;
+    BOOL popped = NO;
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5.0];
+    while (!popped && [deadline timeIntervalSinceNow] > 0)
+    {
+        popped = F53OSCRealtimeRingPop(ring.ringRef, &record);
+        if (!popped)
+            [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    XCTAssertTrue(popped, @"A sealed datagram should reach the ring once opened");
+    XCTAssertEqual(record.addressID, gainID);
+    XCTAssertEqual(record.arguments[0].f, 0.75f);
+    XCTAssertEqual(ring.count, 0);
+}
+
+
+#pragma mark - Benchmarks
+
+- (void)testThat_sealingAndOpeningDatagramsIsFast
+{
+    NSArray<F53OSCDatagramCipher *> *ciphers = [self agreedCiphers];
+    F53OSCDatagramCipher *initiator = ciphers[0];
+    F53OSCDatagramCipher *responder = ciphers[1];
+    NSData *packetData = [self packetDataForNumber:1];
+
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < BENCHMARK_DATAGRAMS; i++)
+    {
+        NSData *datagram = [initiator sealPacketData:packetData];
+        if (![responder openDatagram:(NSData * _Nonnull)datagram])
+            XCTFail(@"Datagram %lu should open", (unsigned long)i);
+    }
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSLog(@"Sealed and opened %d datagrams in %.3f s (%.1f us each)", BENCHMARK_DATAGRAMS, elapsed, elapsed / BENCHMARK_DATAGRAMS * 1000000.0);
+    XCTAssertEqual(responder.openedCount, BENCHMARK_DATAGRAMS);
+    XCTAssertLessThan(elapsed, 5.0);
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
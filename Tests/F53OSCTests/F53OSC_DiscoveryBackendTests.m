@@ -0,0 +1,486 @@
+//
+//  F53OSC_DiscoveryBackendTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCBrowser.h"
+#import "F53OSCDiscoveryBackend.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define BENCHMARK_SERVICES      1000
+
+@interface F53OSCBrowser (F53OSC_DiscoveryBackendTestsAccess)
+- (nullable F53OSCClientRecord *)clientRecordForHost:(NSString *)host port:(UInt16)port;
+- (nullable F53OSCClientRecord *)clientRecordForNetService:(NSNetService *)netService;
+@end
+
+
+#pragma mark -
+
+@interface F53OSC_DiscoveryBackendTests : XCTestCase <F53OSCBrowserDelegate>
+@property (nonatomic, strong) NSMutableArray<F53OSCClientRecord *> *addedClientRecords;
+@property (nonatomic, strong) NSMutableArray<F53OSCClientRecord *> *removedClientRecords;
+@end
+
+
+@implementation F53OSC_DiscoveryBackendTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.addedClientRecords = [NSMutableArray array];
+    self.removedClientRecords = [NSMutableArray array];
+}
+
+- (F53OSCBrowser *)browserWithBackend:(F53OSCLocalDiscoveryBackend *)backend
+{
+    F53OSCBrowser *browser = [[F53OSCBrowser alloc] init];
+    browser.serviceType = @"_osc._udp.";
+    browser.useTCP = NO;
+    browser.discoveryBackend = backend;
+
+    [self addTeardownBlock:^{
+        [browser stop];
+    }];
+
+    return browser;
+}
+
+- (void)startBrowser:(F53OSCBrowser *)browser
+{
+    // NOTE: `stop` clears the browser's delegate.
+    browser.delegate = self;
+    [browser start];
+    XCTAssertTrue(browser.running, @"Browser should be running");
+}
+
+- (void)publishServiceCount:(NSUInteger)count toBackend:(F53OSCLocalDiscoveryBackend *)backend
+{
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        NSString *host = [NSString stringWithFormat:@"10.0.%lu.%lu", (unsigned long)(i / 250), (unsigned long)(i % 250 + 1)];
+        [backend publishServiceWithName:[NSString stringWithFormat:@"Device %lu", (unsigned long)i] type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[host]];
+    }
+}
+
+- (BOOL)waitForClientRecordCount:(NSUInteger)count inBrowser:(F53OSCBrowser *)browser
+{
+    for (NSUInteger i = 0; i < 500 && browser.clientRecords.count != count; i++)
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    return (browser.clientRecords.count == count);
+}
+
+- (BOOL)waitForResolveCount:(NSUInteger)count inBackend:(F53OSCLocalDiscoveryBackend *)backend
+{
+    for (NSUInteger i = 0; i < 500 && backend.resolveCount != count; i++)
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    return (backend.resolveCount == count);
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_localDiscoveryBackendHasCorrectDefaults
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+
+    XCTAssertNil(backend.delegate);
+    XCTAssertEqual(backend.resolveDelay, 0.0);
+    XCTAssertFalse(backend.searching);
+    XCTAssertEqual(backend.resolveCount, 0);
+    XCTAssertEqual(backend.maxResolvingCount, 0);
+
+    F53OSCDiscoveredService *service = [[F53OSCDiscoveredService alloc] initWithName:@"Device" type:@"_osc._udp." domain:@"local."];
+    XCTAssertEqual(service.port, -1, @"Services are not resolved until they are resolved");
+    XCTAssertEqual(service.addresses.count, 0);
+    XCTAssertNil(service.netService);
+    XCTAssertEqualObjects(service.key, [F53OSCDiscoveredService keyForServiceWithName:@"Device" type:@"_osc._udp" domain:@"local"], @"Keys ignore trailing dots");
+
+    F53OSCBrowser *browser = [[F53OSCBrowser alloc] init];
+    XCTAssertNil(browser.discoveryBackend);
+    XCTAssertEqual(browser.maxConcurrentResolves, 16);
+    XCTAssertEqual(browser.resolveTimeout, 5.0);
+    XCTAssertEqual(browser.resolvedAddressLifetime, 120.0);
+    XCTAssertEqual(browser.resolveCount, 0);
+    XCTAssertEqual(browser.resolvedAddressCacheHitCount, 0);
+}
+
+
+#pragma mark - Discovery tests
+
+- (void)testThat_browserAddsAndRemovesServicesFromBackend
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    [backend publishServiceWithName:@"Stage Left" type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[@"192.168.1.10"]];
+    [backend publishServiceWithName:@"Stage Right" type:@"_osc._udp." domain:@"local." port:53001 hostAddresses:@[@"192.168.1.11", @"fe80::1"]];
+    [backend publishServiceWithName:@"Lighting" type:@"_osc._tcp." domain:@"local." port:53002 hostAddresses:@[@"192.168.1.12"]];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    [self startBrowser:browser];
+    XCTAssertTrue(backend.searching);
+
+    XCTAssertTrue([self waitForClientRecordCount:2 inBrowser:browser], @"Only services of the browser's type should be added");
+    XCTAssertEqual(self.addedClientRecords.count, 2);
+
+    F53OSCClientRecord *stageRight = [browser clientRecordForHost:@"192.168.1.11" port:53001];
+    XCTAssertNotNil(stageRight);
+    XCTAssertEqualObjects(stageRight.discoveredService.name, @"Stage Right");
+    XCTAssertEqualObjects(stageRight.hostAddresses, @[@"192.168.1.11"], @"IPv6 addresses are skipped unless resolveIPv6Addresses is set");
+    XCTAssertFalse(stageRight.useTCP);
+    XCTAssertNil(stageRight.netService);
+    XCTAssertNil([browser clientRecordForHost:@"192.168.1.11" port:53000], @"Lookups should match the port");
+    XCTAssertNil([browser clientRecordForHost:@"192.168.1.12" port:53002]);
+
+    [backend unpublishServiceWithName:@"Stage Right" type:@"_osc._udp." domain:@"local."];
+    XCTAssertTrue([self waitForClientRecordCount:1 inBrowser:browser]);
+    XCTAssertEqual(self.removedClientRecords.firstObject, stageRight);
+    XCTAssertNil([browser clientRecordForHost:@"192.168.1.11" port:53001], @"Removed records should leave the index");
+    XCTAssertNotNil([browser clientRecordForHost:@"192.168.1.10" port:53000]);
+
+    [backend publishServiceWithName:@"Late" type:@"_osc._udp" domain:@"local" port:53003 hostAddresses:@[@"192.168.1.13"]];
+    XCTAssertTrue([self waitForClientRecordCount:2 inBrowser:browser], @"Services published while browsing should be added");
+}
+
+- (void)testThat_clientRecordsSharingAnAddressAreFoundInOrder
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    [backend publishServiceWithName:@"First" type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[@"127.0.0.1"]];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:1 inBrowser:browser]);
+
+    [backend publishServiceWithName:@"Second" type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[@"127.0.0.1"]];
+    XCTAssertTrue([self waitForClientRecordCount:2 inBrowser:browser]);
+    XCTAssertEqualObjects([browser clientRecordForHost:@"127.0.0.1" port:53000].discoveredService.name, @"First");
+
+    [backend unpublishServiceWithName:@"First" type:@"_osc._udp." domain:@"local."];
+    XCTAssertTrue([self waitForClientRecordCount:1 inBrowser:browser]);
+    XCTAssertEqualObjects([browser clientRecordForHost:@"127.0.0.1" port:53000].discoveredService.name, @"Second");
+}
+
+- (void)testThat_browserResolvesServicesConcurrentlyUpToTheLimit
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    backend.resolveDelay = 0.05;
+    [self publishServiceCount:100 toBackend:backend];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    browser.maxConcurrentResolves = 8;
+
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:100 inBrowser:browser]);
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSLog(@"Resolved 100 services, 8 at a time, in %.3f s", elapsed);
+    XCTAssertEqual(backend.maxResolvingCount, 8);
+    XCTAssertEqual(backend.resolveCount, 100);
+    XCTAssertEqual(browser.resolveCount, 100);
+    XCTAssertLessThan(elapsed, 100 * backend.resolveDelay / 2, @"Resolving should not be one service at a time");
+}
+
+- (void)testThat_browserCanResolveWithoutALimit
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    backend.resolveDelay = 0.05;
+    [self publishServiceCount:50 toBackend:backend];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    browser.maxConcurrentResolves = 0;
+    [self startBrowser:browser];
+
+    XCTAssertTrue([self waitForClientRecordCount:50 inBrowser:browser]);
+    XCTAssertEqual(backend.maxResolvingCount, 50);
+}
+
+- (void)testThat_servicesThatFailToResolveAreNotAdded
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    backend.resolveDelay = 0.5;
+    [backend publishServiceWithName:@"Slow" type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[@"127.0.0.1"]];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    browser.resolveTimeout = 0.1;
+    [self startBrowser:browser];
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+    XCTAssertEqual(browser.resolveCount, 1);
+    XCTAssertEqual(browser.clientRecords.count, 0, @"A service that times out should not be added");
+}
+
+- (void)testThat_delegateCanRejectDiscoveredServices
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    [backend publishServiceWithName:@"Accepted" type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[@"127.0.0.1"]];
+    [backend publishServiceWithName:@"Rejected" type:@"_osc._udp." domain:@"local." port:53001 hostAddresses:@[@"127.0.0.1"]];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    [self startBrowser:browser];
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    XCTAssertEqual(browser.clientRecords.count, 1);
+    XCTAssertEqualObjects(browser.clientRecords.firstObject.discoveredService.name, @"Accepted");
+}
+
+
+#pragma mark - Resolved address cache tests
+
+- (void)testThat_restartedBrowserAddsServicesFromCache
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    backend.resolveDelay = 0.05;
+    [self publishServiceCount:20 toBackend:backend];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:20 inBrowser:browser]);
+    XCTAssertEqual(backend.resolveCount, 20);
+
+    [browser stop];
+    XCTAssertEqual(browser.clientRecords.count, 0);
+
+    // Cached services are added well before they could resolve, and are then resolved again in the background.
+    backend.resolveDelay = 1.0;
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:20 inBrowser:browser]);
+    XCTAssertLessThan([NSDate timeIntervalSinceReferenceDate] - start, backend.resolveDelay, @"Cached services should not wait to resolve");
+    XCTAssertEqual(browser.resolvedAddressCacheHitCount, 20);
+    XCTAssertNotNil([browser clientRecordForHost:@"10.0.0.1" port:53000]);
+    XCTAssertTrue([self waitForResolveCount:40 inBackend:backend]);
+
+    [browser stop];
+    [browser removeAllResolvedAddresses];
+    backend.resolveDelay = 0.05;
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:20 inBrowser:browser]);
+    XCTAssertEqual(browser.resolvedAddressCacheHitCount, 20, @"Services should not come from the cache once it is emptied");
+    XCTAssertEqual(backend.resolveCount, 60);
+}
+
+- (void)testThat_cachedServicesThatMovedAreUpdated
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    [backend publishServiceWithName:@"Mover" type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[@"10.0.0.1"]];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:1 inBrowser:browser]);
+    [browser stop];
+
+    // Republished while the browser is stopped, so only the cache knows the old address.
+    backend.resolveDelay = 0.1;
+    [backend publishServiceWithName:@"Mover" type:@"_osc._udp." domain:@"local." port:53001 hostAddresses:@[@"10.0.0.2"]];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:1 inBrowser:browser]);
+    F53OSCClientRecord *clientRecord = browser.clientRecords.firstObject;
+    XCTAssertEqual([browser clientRecordForHost:@"10.0.0.1" port:53000], clientRecord, @"The record should first come from the cache");
+
+    for (NSUInteger i = 0; i < 200 && ![browser clientRecordForHost:@"10.0.0.2" port:53001]; i++)
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    XCTAssertEqual([browser clientRecordForHost:@"10.0.0.2" port:53001], clientRecord, @"The record should be updated in place");
+    XCTAssertNil([browser clientRecordForHost:@"10.0.0.1" port:53000], @"The old address should leave the index");
+    XCTAssertEqual(clientRecord.port, 53001);
+    XCTAssertEqualObjects(clientRecord.hostAddresses, @[@"10.0.0.2"]);
+    XCTAssertEqual(self.addedClientRecords.count, 2, @"Updating a record should not add another");
+}
+
+- (void)testThat_removedServicesLeaveTheCache
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    [backend publishServiceWithName:@"Leaver" type:@"_osc._udp." domain:@"local." port:53000 hostAddresses:@[@"10.0.0.1"]];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:1 inBrowser:browser]);
+
+    [backend unpublishServiceWithName:@"Leaver" type:@"_osc._udp." domain:@"local."];
+    XCTAssertTrue([self waitForClientRecordCount:0 inBrowser:browser]);
+
+    [backend publishServiceWithName:@"Leaver" type:@"_osc._udp." domain:@"local." port:53001 hostAddresses:@[@"10.0.0.2"]];
+    XCTAssertTrue([self waitForClientRecordCount:1 inBrowser:browser]);
+    XCTAssertEqual(browser.resolvedAddressCacheHitCount, 0, @"A removed service should be resolved again when it comes back");
+    XCTAssertNotNil([browser clientRecordForHost:@"10.0.0.2" port:53001]);
+    XCTAssertNil([browser clientRecordForHost:@"10.0.0.1" port:53000]);
+}
+
+- (void)testThat_expiredAddressesAreResolvedAgain
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    [self publishServiceCount:5 toBackend:backend];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    browser.resolvedAddressLifetime = 0.2;
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:5 inBrowser:browser]);
+
+    [browser stop];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:5 inBrowser:browser]);
+    XCTAssertEqual(backend.resolveCount, 10);
+    XCTAssertEqual(browser.resolvedAddressCacheHitCount, 0);
+
+    // A lifetime of 0 caches nothing.
+    [browser stop];
+    browser.resolvedAddressLifetime = 0;
+    [browser removeAllResolvedAddresses];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:5 inBrowser:browser]);
+    [browser stop];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:5 inBrowser:browser]);
+    XCTAssertEqual(backend.resolveCount, 20);
+}
+
+
+#pragma mark - File tests
+
+- (void)testThat_localDiscoveryBackendPublishesServicesFromFile
+{
+    NSURL *url = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSString stringWithFormat:@"F53OSC-services-%@.json", [NSUUID UUID].UUIDString]];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    }];
+
+    NSArray *services = @[
+        @{ @"name": @"Console", @"type": @"_osc._udp.", @"port": @(53000), @"hostAddresses": @[@"127.0.0.1"] },
+        @{ @"name": @"Playback", @"type": @"_osc._udp.", @"domain": @"local.", @"port": @(53001), @"hostAddresses": @[@"127.0.0.2"] },
+    ];
+    XCTAssertTrue([[NSJSONSerialization dataWithJSONObject:services options:0 error:nil] writeToURL:url atomically:YES]);
+
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    NSError *error = nil;
+    XCTAssertTrue([backend publishServicesFromFileAtURL:url error:&error]);
+    XCTAssertNil(error);
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:2 inBrowser:browser]);
+    XCTAssertNotNil([browser clientRecordForHost:@"127.0.0.2" port:53001]);
+}
+
+- (void)testThat_localDiscoveryBackendRejectsMalformedFiles
+{
+    NSURL *url = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSString stringWithFormat:@"F53OSC-services-%@.json", [NSUUID UUID].UUIDString]];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    }];
+
+    // The second entry has no port, so neither is published.
+    NSArray *services = @[
+        @{ @"name": @"Console", @"type": @"_osc._udp.", @"port": @(53000), @"hostAddresses": @[@"127.0.0.1"] },
+        @{ @"name": @"Playback", @"type": @"_osc._udp.", @"hostAddresses": @[@"127.0.0.2"] },
+    ];
+    XCTAssertTrue([[NSJSONSerialization dataWithJSONObject:services options:0 error:nil] writeToURL:url atomically:YES]);
+
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    NSError *error = nil;
+    XCTAssertFalse([backend publishServicesFromFileAtURL:url error:&error]);
+    XCTAssertNotNil(error);
+
+    error = nil;
+    XCTAssertFalse([backend publishServicesFromFileAtURL:[url URLByAppendingPathExtension:@"missing"] error:&error]);
+    XCTAssertNotNil(error);
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    [self startBrowser:browser];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertEqual(browser.clientRecords.count, 0);
+}
+
+
+#pragma mark - Benchmarks
+
+- (void)testThat_clientRecordLookupIsFastWithManyServices
+{
+    F53OSCLocalDiscoveryBackend *backend = [[F53OSCLocalDiscoveryBackend alloc] init];
+    [self publishServiceCount:BENCHMARK_SERVICES toBackend:backend];
+
+    F53OSCBrowser *browser = [self browserWithBackend:backend];
+    browser.maxConcurrentResolves = 0;
+    [self startBrowser:browser];
+    XCTAssertTrue([self waitForClientRecordCount:BENCHMARK_SERVICES inBrowser:browser]);
+
+    NSMutableArray<NSString *> *hosts = [NSMutableArray arrayWithCapacity:BENCHMARK_SERVICES];
+    for (F53OSCClientRecord *aClientRecord in browser.clientRecords)
+        [hosts addObject:aClientRecord.hostAddresses.firstObject];
+
+    NSUInteger found = 0;
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < 10; i++)
+    {
+        for (NSString *aHost in hosts)
+            found += ([browser clientRecordForHost:aHost port:53000] != nil);
+    }
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSLog(@"Looked up %d client records among %d in %.3f ms", BENCHMARK_SERVICES * 10, BENCHMARK_SERVICES, elapsed * 1000.0);
+    XCTAssertEqual(found, BENCHMARK_SERVICES * 10);
+    XCTAssertLessThan(elapsed, 0.5);
+}
+
+
+#pragma mark - F53OSCBrowserDelegate
+
+- (void)browser:(F53OSCBrowser *)browser didAddClientRecord:(F53OSCClientRecord *)clientRecord
+{
+    [self.addedClientRecords addObject:clientRecord];
+}
+
+- (void)browser:(F53OSCBrowser *)browser didRemoveClientRecord:(F53OSCClientRecord *)clientRecord
+{
+    [self.removedClientRecords addObject:clientRecord];
+}
+
+- (BOOL)browser:(F53OSCBrowser *)browser shouldAcceptDiscoveredService:(F53OSCDiscoveredService *)service
+{
+    return ![service.name isEqualToString:@"Rejected"];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,451 @@
+//
+//  F53OSC_EncryptSessionCacheTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCClient.h"
+#import "F53OSCEncryptSessionCache.h"
+#import "F53OSCMessage.h"
+#import "F53OSCServer.h"
+
+#if __has_include(<F53OSC/F53OSC-Swift.h>) // F53OSC_BUILT_AS_FRAMEWORK
+#import <F53OSC/F53OSC-Swift.h>
+#elif __has_include("F53OSC-Swift.h")
+#import "F53OSC-Swift.h"
+#endif
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define PORT_BASE   10200
+
+#define BENCHMARK_RECONNECTS    10
+
+@interface F53OSCClient (F53OSC_EncryptSessionCacheTestsAccess)
+@property (strong, nullable)    F53OSCSocket *socket;
+@end
+
+// Plays both ends of an encrypted connection, noting when each connect, disconnect, and message happens.
+@interface EncryptSessionTestPeer : NSObject <F53OSCServerDelegate, F53OSCClientDelegate>
+@property (atomic, strong)              NSMutableArray<F53OSCMessage *> *receivedMessages;
+@property (atomic, assign)              NSTimeInterval lastMessageTime;
+@property (nonatomic, strong, nullable) XCTestExpectation *connectExpectation;
+@property (nonatomic, strong, nullable) XCTestExpectation *disconnectExpectation;
+@property (nonatomic, strong, nullable) XCTestExpectation *messageExpectation;
+@end
+
+@implementation EncryptSessionTestPeer
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+        self.receivedMessages = [NSMutableArray array];
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (!message)
+        return;
+
+    self.lastMessageTime = [NSDate timeIntervalSinceReferenceDate];
+    [self.receivedMessages addObject:message];
+    [self.messageExpectation fulfill];
+}
+
+- (void)clientDidConnect:(F53OSCClient *)client
+{
+    [self.connectExpectation fulfill];
+}
+
+- (void)clientDidDisconnect:(F53OSCClient *)client
+{
+    [self.disconnectExpectation fulfill];
+}
+
+@end
+
+
+#pragma mark - F53OSC_EncryptSessionCacheTests
+
+@interface F53OSC_EncryptSessionCacheTests : XCTestCase
+@end
+
+@implementation F53OSC_EncryptSessionCacheTests
+
+// Two encrypters that have agreed a session key with each other.
+- (NSArray<F53OSCEncrypt *> *)agreedEncrypters
+{
+    F53OSCEncrypt *local = [[F53OSCEncrypt alloc] init];
+    F53OSCEncrypt *remote = [[F53OSCEncrypt alloc] init];
+    XCTAssertNotNil([local generateKeyPair]);
+    XCTAssertNotNil([remote generateKeyPair]);
+
+    [local generateSalt];
+    remote.salt = local.salt;
+    XCTAssertTrue([local beginEncryptingWithPeerKey:(NSData * _Nonnull)remote.publicKeyData]);
+    XCTAssertTrue([remote beginEncryptingWithPeerKey:(NSData * _Nonnull)local.publicKeyData]);
+
+    return @[local, remote];
+}
+
+- (F53OSCServer *)serverWithPort:(UInt16)port peer:(EncryptSessionTestPeer *)peer
+{
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = peer;
+    server.port = port;
+    server.udpReplyPort = port + 1;
+    server.keyPair = [[[F53OSCEncrypt alloc] init] generateKeyPair];
+    server.encryptionSessionCache = [[F53OSCEncryptSessionCache alloc] init];
+
+    [self addTeardownBlock:^{
+        [server stopListening];
+        server.delegate = nil;
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    return server;
+}
+
+- (F53OSCClient *)clientWithPort:(UInt16)port peer:(EncryptSessionTestPeer *)peer
+{
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.delegate = peer;
+    client.host = @"localhost";
+    client.port = port;
+    client.useTcp = YES;
+    client.encryptionSessionCache = [[F53OSCEncryptSessionCache alloc] init];
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        client.delegate = nil;
+    }];
+
+    return client;
+}
+
+- (BOOL)connectClient:(F53OSCClient *)client keyPair:(NSData *)keyPair peer:(EncryptSessionTestPeer *)peer
+{
+    XCTestExpectation *connectExpectation = [[XCTestExpectation alloc] initWithDescription:@"Client connected"];
+    peer.connectExpectation = connectExpectation;
+    if (![client connectEncryptedWithKeyPair:keyPair])
+        return NO;
+    return ([XCTWaiter waitForExpectations:@[connectExpectation] timeout:5.0] == XCTWaiterResultCompleted);
+}
+
+- (BOOL)disconnectClient:(F53OSCClient *)client peer:(EncryptSessionTestPeer *)peer
+{
+    XCTestExpectation *disconnectExpectation = [[XCTestExpectation alloc] initWithDescription:@"Client disconnected"];
+    peer.disconnectExpectation = disconnectExpectation;
+    [client disconnect];
+    return ([XCTWaiter waitForExpectations:@[disconnectExpectation] timeout:5.0] == XCTWaiterResultCompleted);
+}
+
+- (BOOL)waitForTicketInCache:(F53OSCEncryptSessionCache *)sessionCache
+{
+    for (NSUInteger i = 0; i < 200 && sessionCache.count == 0; i++)
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    return (sessionCache.count > 0);
+}
+
+// Connects, sends one message as soon as the client reports that it is connected, and returns the seconds from
+// `connect` until the server received it.
+- (NSTimeInterval)timeToFirstMessageForClient:(F53OSCClient *)client keyPair:(NSData *)keyPair peer:(EncryptSessionTestPeer *)peer
+{
+    XCTestExpectation *messageExpectation = [[XCTestExpectation alloc] initWithDescription:@"Message received"];
+    peer.messageExpectation = messageExpectation;
+
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    XCTAssertTrue([self connectClient:client keyPair:keyPair peer:peer], @"Client should connect");
+    [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/cue/1/go" arguments:@[]]];
+
+    XCTAssertEqual([XCTWaiter waitForExpectations:@[messageExpectation] timeout:5.0], XCTWaiterResultCompleted, @"Server should receive the message");
+    peer.messageExpectation = nil;
+    return peer.lastMessageTime - start;
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_encryptSessionCacheHasCorrectDefaults
+{
+    F53OSCEncryptSessionCache *sessionCache = [[F53OSCEncryptSessionCache alloc] init];
+
+    XCTAssertEqual(sessionCache.lifetime, 3600.0);
+    XCTAssertEqual(sessionCache.maxSessionCount, 256);
+    XCTAssertEqual(sessionCache.count, 0);
+    XCTAssertEqual(sessionCache.resumedCount, 0);
+    XCTAssertEqual(sessionCache.rejectedCount, 0);
+
+    XCTAssertNil([[F53OSCServer alloc] init].encryptionSessionCache);
+    XCTAssertNil([[F53OSCClient alloc] init].encryptionSessionCache);
+}
+
+
+#pragma mark - Session tests
+
+- (void)testThat_issuedSessionsAreTakenOnceWithProof
+{
+    NSArray<F53OSCEncrypt *> *encrypters = [self agreedEncrypters];
+    F53OSCEncrypt *server = encrypters[0];
+    F53OSCEncrypt *client = encrypters[1];
+    NSData *clientKey = (NSData * _Nonnull)client.publicKeyData;
+
+    F53OSCEncryptSessionCache *sessionCache = [[F53OSCEncryptSessionCache alloc] init];
+    F53OSCEncryptSession *session = [sessionCache issueSessionForPeerKey:clientKey encrypter:server];
+    XCTAssertEqual(session.ticket.length, F53OSCEncryptSessionTicketLength);
+    XCTAssertEqual(sessionCache.count, 1);
+
+    NSData *proof = (NSData * _Nonnull)[client encryptDataWithClearData:session.ticket];
+
+    // A wrong ticket, or a proof made without the session key, leaves the session in place.
+    NSMutableData *wrongTicket = [session.ticket mutableCopy];
+    ((uint8_t *)wrongTicket.mutableBytes)[0] ^= 0xff;
+    XCTAssertNil([sessionCache takeSessionForPeerKey:clientKey ticket:wrongTicket proof:proof]);
+
+    F53OSCEncrypt *stranger = [self agreedEncrypters][0];
+    NSData *forgedProof = (NSData * _Nonnull)[stranger encryptDataWithClearData:session.ticket];
+    XCTAssertNil([sessionCache takeSessionForPeerKey:clientKey ticket:session.ticket proof:forgedProof]);
+    XCTAssertEqual(sessionCache.count, 1);
+    XCTAssertEqual(sessionCache.rejectedCount, 2);
+
+    F53OSCEncryptSession *resumed = [sessionCache takeSessionForPeerKey:clientKey ticket:session.ticket proof:proof];
+    XCTAssertEqual(resumed, session);
+    XCTAssertEqual(resumed.encrypter, server);
+    XCTAssertEqual(sessionCache.resumedCount, 1);
+    XCTAssertEqual(sessionCache.count, 0);
+
+    XCTAssertNil([sessionCache takeSessionForPeerKey:clientKey ticket:session.ticket proof:proof], @"A replayed ticket should be rejected");
+    XCTAssertEqual(sessionCache.rejectedCount, 3);
+}
+
+- (void)testThat_issuingReplacesEarlierSessionForPeer
+{
+    NSArray<F53OSCEncrypt *> *encrypters = [self agreedEncrypters];
+    NSData *clientKey = (NSData * _Nonnull)encrypters[1].publicKeyData;
+
+    F53OSCEncryptSessionCache *sessionCache = [[F53OSCEncryptSessionCache alloc] init];
+    F53OSCEncryptSession *first = [sessionCache issueSessionForPeerKey:clientKey encrypter:encrypters[0]];
+    F53OSCEncryptSession *second = [sessionCache issueSessionForPeerKey:clientKey encrypter:encrypters[0]];
+    XCTAssertNotEqualObjects(first.ticket, second.ticket, @"Tickets should be random");
+    XCTAssertEqual(sessionCache.count, 1);
+
+    NSData *firstProof = (NSData * _Nonnull)[encrypters[1] encryptDataWithClearData:first.ticket];
+    XCTAssertNil([sessionCache takeSessionForPeerKey:clientKey ticket:first.ticket proof:firstProof], @"A replaced ticket should be rejected");
+
+    NSData *secondProof = (NSData * _Nonnull)[encrypters[1] encryptDataWithClearData:second.ticket];
+    XCTAssertEqual([sessionCache takeSessionForPeerKey:clientKey ticket:second.ticket proof:secondProof], second);
+}
+
+- (void)testThat_sessionsExpire
+{
+    NSArray<F53OSCEncrypt *> *encrypters = [self agreedEncrypters];
+    NSData *clientKey = (NSData * _Nonnull)encrypters[1].publicKeyData;
+    NSData *serverKey = (NSData * _Nonnull)encrypters[0].publicKeyData;
+
+    F53OSCEncryptSessionCache *sessionCache = [[F53OSCEncryptSessionCache alloc] init];
+    sessionCache.lifetime = 0.05;
+
+    F53OSCEncryptSession *session = [sessionCache issueSessionForPeerKey:clientKey encrypter:encrypters[0]];
+    [sessionCache storeSessionForPeerKey:serverKey ticket:session.ticket lifetime:3600.0 encrypter:encrypters[1]];
+    XCTAssertEqual(sessionCache.count, 2);
+
+    usleep(100000);
+
+    NSData *proof = (NSData * _Nonnull)[encrypters[1] encryptDataWithClearData:session.ticket];
+    XCTAssertNil([sessionCache takeSessionForPeerKey:clientKey ticket:session.ticket proof:proof], @"An expired ticket should be rejected");
+    XCTAssertNil([sessionCache takeSessionForPeerKey:serverKey], @"A stored ticket should be limited to the cache's lifetime");
+    XCTAssertEqual(sessionCache.count, 0);
+}
+
+- (void)testThat_storedSessionsAreTakenOnce
+{
+    NSArray<F53OSCEncrypt *> *encrypters = [self agreedEncrypters];
+    NSData *serverKey = (NSData * _Nonnull)encrypters[0].publicKeyData;
+    NSData *ticket = [NSData dataWithBytes:"0123456789abcdef" length:F53OSCEncryptSessionTicketLength];
+
+    F53OSCEncryptSessionCache *sessionCache = [[F53OSCEncryptSessionCache alloc] init];
+    [sessionCache storeSessionForPeerKey:serverKey ticket:ticket lifetime:0 encrypter:encrypters[1]];
+    XCTAssertEqual(sessionCache.count, 0, @"A ticket without a lifetime should not be stored");
+
+    [sessionCache storeSessionForPeerKey:serverKey ticket:ticket lifetime:60.0 encrypter:encrypters[1]];
+    F53OSCEncryptSession *session = [sessionCache takeSessionForPeerKey:serverKey];
+    XCTAssertEqualObjects(session.ticket, ticket);
+    XCTAssertEqual(session.encrypter, encrypters[1]);
+    XCTAssertNil([sessionCache takeSessionForPeerKey:serverKey]);
+}
+
+- (void)testThat_storedSessionsCanBeCheckedWithoutTakingThem
+{
+    NSArray<F53OSCEncrypt *> *encrypters = [self agreedEncrypters];
+    NSData *serverKey = (NSData * _Nonnull)encrypters[0].publicKeyData;
+    NSData *ticket = [NSData dataWithBytes:"0123456789abcdef" length:F53OSCEncryptSessionTicketLength];
+
+    F53OSCEncryptSessionCache *sessionCache = [[F53OSCEncryptSessionCache alloc] init];
+    XCTAssertNil([sessionCache sessionForPeerKey:serverKey]);
+
+    [sessionCache storeSessionForPeerKey:serverKey ticket:ticket lifetime:60.0 encrypter:encrypters[1]];
+    F53OSCEncryptSession *session = [sessionCache sessionForPeerKey:serverKey];
+    XCTAssertEqualObjects(session.ticket, ticket);
+    XCTAssertEqual([sessionCache sessionForPeerKey:serverKey], session, @"Checking a session should leave it in the cache");
+    XCTAssertEqual(sessionCache.count, 1);
+    XCTAssertEqual(sessionCache.resumedCount, 0);
+
+    XCTAssertEqual([sessionCache takeSessionForPeerKey:serverKey], session);
+    XCTAssertNil([sessionCache sessionForPeerKey:serverKey]);
+}
+
+- (void)testThat_sessionClosestToExpiringIsEvicted
+{
+    F53OSCEncrypt *encrypter = [self agreedEncrypters][0];
+
+    F53OSCEncryptSessionCache *sessionCache = [[F53OSCEncryptSessionCache alloc] init];
+    sessionCache.maxSessionCount = 2;
+
+    NSData *firstKey = [@"first" dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *secondKey = [@"second" dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *thirdKey = [@"third" dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *ticket = [NSData dataWithBytes:"0123456789abcdef" length:F53OSCEncryptSessionTicketLength];
+
+    [sessionCache storeSessionForPeerKey:firstKey ticket:ticket lifetime:60.0 encrypter:encrypter];
+    [sessionCache storeSessionForPeerKey:secondKey ticket:ticket lifetime:30.0 encrypter:encrypter];
+    [sessionCache storeSessionForPeerKey:thirdKey ticket:ticket lifetime:60.0 encrypter:encrypter];
+    XCTAssertEqual(sessionCache.count, 2);
+
+    XCTAssertNotNil([sessionCache takeSessionForPeerKey:firstKey]);
+    XCTAssertNil([sessionCache takeSessionForPeerKey:secondKey], @"The session closest to expiring should have been evicted");
+    XCTAssertNotNil([sessionCache takeSessionForPeerKey:thirdKey]);
+}
+
+
+#pragma mark - Resumption tests
+
+- (void)testThat_tcpClientResumesSessionOnReconnect
+{
+    UInt16 port = PORT_BASE + 10;
+    EncryptSessionTestPeer *peer = [[EncryptSessionTestPeer alloc] init];
+    F53OSCServer *server = [self serverWithPort:port peer:peer];
+    F53OSCClient *client = [self clientWithPort:port peer:peer];
+    NSData *keyPair = (NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair];
+
+    XCTAssertTrue([self connectClient:client keyPair:keyPair peer:peer], @"Client should connect with a full handshake");
+    XCTAssertTrue([self waitForTicketInCache:(F53OSCEncryptSessionCache * _Nonnull)client.encryptionSessionCache], @"Client should receive a ticket");
+    XCTAssertEqual(server.encryptionSessionCache.count, 1);
+    XCTAssertTrue([self disconnectClient:client peer:peer]);
+
+    NSTimeInterval elapsed = [self timeToFirstMessageForClient:client keyPair:keyPair peer:peer];
+    XCTAssertLessThan(elapsed, 5.0);
+    XCTAssertTrue(client.isEncrypting, @"Client should be encrypting");
+    XCTAssertEqual(server.encryptionSessionCache.resumedCount, 1, @"Server should resume the session");
+    XCTAssertEqualObjects(peer.receivedMessages.lastObject.addressPattern, @"/cue/1/go");
+
+    // The resumed session is confirmed with a new ticket, so the next reconnect resumes too.
+    XCTAssertTrue([self waitForTicketInCache:(F53OSCEncryptSessionCache * _Nonnull)client.encryptionSessionCache], @"Client should receive a new ticket");
+    XCTAssertTrue([self disconnectClient:client peer:peer]);
+    [self timeToFirstMessageForClient:client keyPair:keyPair peer:peer];
+    XCTAssertEqual(server.encryptionSessionCache.resumedCount, 2);
+    XCTAssertEqual(server.encryptionSessionCache.rejectedCount, 0);
+}
+
+- (void)testThat_rejectedResumptionFallsBackToFullHandshake
+{
+    UInt16 port = PORT_BASE + 20;
+    EncryptSessionTestPeer *peer = [[EncryptSessionTestPeer alloc] init];
+    F53OSCServer *server = [self serverWithPort:port peer:peer];
+    F53OSCClient *client = [self clientWithPort:port peer:peer];
+    NSData *keyPair = (NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair];
+
+    XCTAssertTrue([self connectClient:client keyPair:keyPair peer:peer]);
+    XCTAssertTrue([self waitForTicketInCache:(F53OSCEncryptSessionCache * _Nonnull)client.encryptionSessionCache]);
+    XCTAssertTrue([self disconnectClient:client peer:peer]);
+
+    // e.g. the server restarted and lost its sessions.
+    [server.encryptionSessionCache removeAllSessions];
+
+    [self timeToFirstMessageForClient:client keyPair:keyPair peer:peer];
+    XCTAssertEqual(server.encryptionSessionCache.rejectedCount, 1);
+    XCTAssertEqual(server.encryptionSessionCache.resumedCount, 0);
+    XCTAssertTrue(client.isEncrypting, @"Client should be encrypting after the full handshake");
+    XCTAssertEqual(peer.receivedMessages.count, 1, @"A message sent before the rejection should be sent again, once");
+    XCTAssertEqualObjects(peer.receivedMessages.lastObject.addressPattern, @"/cue/1/go");
+    XCTAssertTrue([self waitForTicketInCache:(F53OSCEncryptSessionCache * _Nonnull)client.encryptionSessionCache], @"The full handshake should issue a new ticket");
+}
+
+
+#pragma mark - Performance tests
+
+- (void)testThat_resumedReconnectDeliversFirstMessageSooner
+{
+    UInt16 port = PORT_BASE + 30;
+    EncryptSessionTestPeer *peer = [[EncryptSessionTestPeer alloc] init];
+    F53OSCServer *server = [self serverWithPort:port peer:peer];
+    F53OSCClient *client = [self clientWithPort:port peer:peer];
+    NSData *keyPair = (NSData * _Nonnull)[[[F53OSCEncrypt alloc] init] generateKeyPair];
+    F53OSCEncryptSessionCache *clientSessionCache = (F53OSCEncryptSessionCache * _Nonnull)client.encryptionSessionCache;
+
+    NSTimeInterval fullTime = 0;
+    NSTimeInterval resumedTime = 0;
+    for (NSUInteger i = 0; i < BENCHMARK_RECONNECTS; i++)
+    {
+        // Full handshake: no session to resume.
+        [clientSessionCache removeAllSessions];
+        fullTime += [self timeToFirstMessageForClient:client keyPair:keyPair peer:peer];
+        XCTAssertTrue([self waitForTicketInCache:clientSessionCache]);
+        XCTAssertTrue([self disconnectClient:client peer:peer]);
+
+        // Resumed: the ticket from the full handshake. The new ticket it is confirmed with is cleared above.
+        resumedTime += [self timeToFirstMessageForClient:client keyPair:keyPair peer:peer];
+        XCTAssertTrue([self waitForTicketInCache:clientSessionCache]);
+        XCTAssertTrue([self disconnectClient:client peer:peer]);
+    }
+
+    XCTAssertEqual(server.encryptionSessionCache.resumedCount, BENCHMARK_RECONNECTS);
+
+    NSLog(@"Reconnect to first message, average of %d: full handshake %.2f ms, resumed session %.2f ms",
+          BENCHMARK_RECONNECTS, fullTime * 1000.0 / BENCHMARK_RECONNECTS, resumedTime * 1000.0 / BENCHMARK_RECONNECTS);
+
+    XCTAssertLessThan(resumedTime, fullTime, @"Resuming should skip the key agreement and its round trip");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
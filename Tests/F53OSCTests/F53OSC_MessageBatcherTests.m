@@ -0,0 +1,265 @@
+//
+//  F53OSC_MessageBatcherTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCMessage.h"
+#import "F53OSCMessageBatcher.h"
+#import "F53OSCTimeTag.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - BatcherTestSingleDestination
+
+@interface BatcherTestSingleDestination : NSObject <F53OSCPacketDestination>
+@property (nonatomic, strong) NSMutableArray<F53OSCMessage *> *messages;
+@end
+
+@implementation BatcherTestSingleDestination
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (!self.messages)
+        self.messages = [NSMutableArray array];
+    if (message)
+        [self.messages addObject:message];
+}
+
+@end
+
+
+#pragma mark - BatcherTestDestination
+
+@interface BatcherTestDestination : NSObject <F53OSCPacketDestination>
+@property (nonatomic, strong) NSMutableArray<F53OSCMessage *> *singleMessages;
+@property (nonatomic, strong) NSMutableArray<NSArray<F53OSCMessage *> *> *batches;
+@end
+
+@implementation BatcherTestDestination
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.singleMessages = [NSMutableArray array];
+        self.batches = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (message)
+        [self.singleMessages addObject:message];
+}
+
+- (void)takeMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    [self.batches addObject:messages];
+}
+
+@end
+
+
+#pragma mark - BatcherTestBundleDestination
+
+@interface BatcherTestBundleDestination : BatcherTestDestination
+@property (nonatomic, strong) NSMutableArray<NSArray<F53OSCMessage *> *> *bundles;
+@end
+
+@implementation BatcherTestBundleDestination
+
+- (void)takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    if (!self.bundles)
+        self.bundles = [NSMutableArray array];
+    [self.bundles addObject:messages];
+}
+
+@end
+
+
+#pragma mark - F53OSC_MessageBatcherTests
+
+@interface F53OSC_MessageBatcherTests : XCTestCase
+@end
+
+@implementation F53OSC_MessageBatcherTests
+
+- (F53OSCMessage *)messageWithIndex:(NSUInteger)index
+{
+    return [F53OSCMessage messageWithAddressPattern:@"/batch" arguments:@[@(index)]];
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_batcherHasCorrectDefaults
+{
+    F53OSCMessageBatcher *batcher = [[F53OSCMessageBatcher alloc] init];
+
+    XCTAssertNil(batcher.destination);
+    XCTAssertEqual(batcher.queue, dispatch_get_main_queue(), @"Default queue should be the main queue");
+    XCTAssertEqual(batcher.maxBatchSize, 0, @"Default maxBatchSize should be 0 (no limit)");
+    XCTAssertEqual(batcher.maxLatency, 0, @"Default maxLatency should be 0");
+    XCTAssertEqual(batcher.pendingCount, 0);
+}
+
+
+#pragma mark - Delivery tests
+
+- (void)testThat_batcherDeliversReadInOneBatch
+{
+    BatcherTestDestination *destination = [[BatcherTestDestination alloc] init];
+    F53OSCMessageBatcher *batcher = [[F53OSCMessageBatcher alloc] init];
+    batcher.destination = destination;
+
+    for (NSUInteger i = 0; i < 10; i++)
+        [batcher takeMessage:[self messageWithIndex:i]];
+
+    XCTAssertEqual(destination.batches.count, 0, @"Nothing should be delivered before the read ends");
+    XCTAssertEqual(batcher.pendingCount, 10);
+
+    [batcher endRead];
+
+    XCTAssertEqual(destination.batches.count, 1);
+    XCTAssertEqual(destination.batches.firstObject.count, 10);
+    XCTAssertEqual(destination.singleMessages.count, 0);
+    XCTAssertEqual(batcher.pendingCount, 0);
+    for (NSUInteger i = 0; i < 10; i++)
+        XCTAssertEqualObjects(destination.batches.firstObject[i].arguments.firstObject, @(i), @"Batch should keep message order");
+}
+
+- (void)testThat_batcherIgnoresEmptyReads
+{
+    BatcherTestDestination *destination = [[BatcherTestDestination alloc] init];
+    F53OSCMessageBatcher *batcher = [[F53OSCMessageBatcher alloc] init];
+    batcher.destination = destination;
+
+    [batcher takeMessage:nil];
+    [batcher endRead];
+    [batcher flush];
+
+    XCTAssertEqual(destination.batches.count, 0, @"Empty batches should not be delivered");
+}
+
+- (void)testThat_batcherSplitsAtMaxBatchSize
+{
+    BatcherTestDestination *destination = [[BatcherTestDestination alloc] init];
+    F53OSCMessageBatcher *batcher = [[F53OSCMessageBatcher alloc] init];
+    batcher.destination = destination;
+    batcher.maxBatchSize = 4;
+
+    for (NSUInteger i = 0; i < 10; i++)
+        [batcher takeMessage:[self messageWithIndex:i]];
+    [batcher endRead];
+
+    XCTAssertEqual(destination.batches.count, 3);
+    XCTAssertEqual(destination.batches[0].count, 4);
+    XCTAssertEqual(destination.batches[1].count, 4);
+    XCTAssertEqual(destination.batches[2].count, 2);
+    XCTAssertEqualObjects(destination.batches[2].lastObject.arguments.firstObject, @9);
+}
+
+- (void)testThat_batcherHoldsReadsForMaxLatency
+{
+    BatcherTestDestination *destination = [[BatcherTestDestination alloc] init];
+    F53OSCMessageBatcher *batcher = [[F53OSCMessageBatcher alloc] init];
+    batcher.destination = destination;
+    batcher.maxLatency = 0.1;
+
+    for (NSUInteger read = 0; read < 3; read++)
+    {
+        [batcher takeMessage:[self messageWithIndex:read * 2]];
+        [batcher takeMessage:[self messageWithIndex:read * 2 + 1]];
+        [batcher endRead];
+    }
+
+    XCTAssertEqual(destination.batches.count, 0, @"Reads should be held until maxLatency has elapsed");
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+
+    XCTAssertEqual(destination.batches.count, 1, @"Reads within maxLatency should share a batch");
+    XCTAssertEqual(destination.batches.firstObject.count, 6);
+    XCTAssertEqualObjects(destination.batches.firstObject.lastObject.arguments.firstObject, @5);
+}
+
+- (void)testThat_batcherFallsBackToTakeMessage
+{
+    BatcherTestSingleDestination *destination = [[BatcherTestSingleDestination alloc] init];
+    F53OSCMessageBatcher *batcher = [[F53OSCMessageBatcher alloc] init];
+    batcher.destination = destination;
+
+    for (NSUInteger i = 0; i < 3; i++)
+        [batcher takeMessage:[self messageWithIndex:i]];
+    [batcher endRead];
+
+    XCTAssertEqual(destination.messages.count, 3, @"A destination without takeMessages: should still receive each message");
+    for (NSUInteger i = 0; i < 3; i++)
+        XCTAssertEqualObjects(destination.messages[i].arguments.firstObject, @(i));
+}
+
+- (void)testThat_batcherForwardsBundlesInOrder
+{
+    BatcherTestDestination *destination = [[BatcherTestDestination alloc] init];
+    F53OSCMessageBatcher *batcher = [[F53OSCMessageBatcher alloc] init];
+    batcher.destination = destination;
+
+    XCTAssertFalse([batcher respondsToSelector:@selector(takeBundleMessages:timeTag:)], @"Bundles should only be forwarded to destinations that take them");
+
+    BatcherTestBundleDestination *bundleDestination = [[BatcherTestBundleDestination alloc] init];
+    batcher.destination = bundleDestination;
+    XCTAssertTrue([batcher respondsToSelector:@selector(takeBundleMessages:timeTag:)]);
+
+    [batcher takeMessage:[self messageWithIndex:0]];
+    [batcher takeBundleMessages:@[[self messageWithIndex:1], [self messageWithIndex:2]] timeTag:[F53OSCTimeTag immediateTimeTag]];
+
+    XCTAssertEqual(bundleDestination.batches.count, 1, @"Messages received before a bundle should be delivered first");
+    XCTAssertEqual(bundleDestination.bundles.count, 1);
+    XCTAssertEqual(batcher.pendingCount, 0);
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,445 @@
+//
+//  F53OSC_NativeUdpTransportTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCClient.h"
+#import "F53OSCMessage.h"
+#import "F53OSCNativeUdpTransport.h"
+#import "F53OSCServer.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define PORT_BASE   9900
+
+#pragma mark - TransportBenchmarkReceiver
+
+@interface TransportBenchmarkReceiver : NSObject <F53OSCServerDelegate>
+@property (assign) NSTimeInterval startTime;
+@property (assign) NSUInteger messageCount;
+@property (assign) NSUInteger expectedMessageCount;
+@property (assign) double totalLatency;
+@property (assign) NSTimeInterval lastReceivedTime;
+@property (assign) NSTimeInterval totalWireToHandlerLatency; // from each message's kernel receive timestamp
+@property (assign) NSUInteger timestampedMessageCount;
+@property (strong, nullable) XCTestExpectation *allMessagesExpectation;
+@end
+
+@implementation TransportBenchmarkReceiver
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate] - self.startTime;
+    self.totalLatency += now - [message.arguments.firstObject doubleValue];
+    self.lastReceivedTime = now;
+    if (message.receivedTimestamp > 0)
+    {
+        self.totalWireToHandlerLatency += [NSDate date].timeIntervalSince1970 - message.receivedTimestamp;
+        self.timestampedMessageCount++;
+    }
+    self.messageCount++;
+    if (self.messageCount == self.expectedMessageCount)
+        [self.allMessagesExpectation fulfill];
+}
+
+@end
+
+
+#pragma mark - F53OSC_NativeUdpTransportTests
+
+@interface F53OSC_NativeUdpTransportTests : XCTestCase
+@end
+
+@implementation F53OSC_NativeUdpTransportTests
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_nativeUdpTransportHasCorrectDefaults
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.native.transport.queue", DISPATCH_QUEUE_SERIAL);
+    F53OSCNativeUdpTransport *transport = [[F53OSCNativeUdpTransport alloc] initWithQueue:queue receiveHandler:^(NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp) {}];
+
+    XCTAssertEqual(transport.queue, queue);
+    XCTAssertEqual(transport.maxDatagramsPerWakeup, 64);
+    XCTAssertEqual(transport.receiveBufferCount, 16);
+    XCTAssertEqual(transport.pooledReceiveCount, 0);
+    XCTAssertEqual(transport.copiedReceiveCount, 0);
+    XCTAssertFalse(transport.isListening);
+    XCTAssertEqual(transport.localPort, 0);
+    XCTAssertEqual(transport.receivedDatagramCount, 0);
+    XCTAssertEqual(transport.wakeupCount, 0);
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    XCTAssertEqual(server.udpTransport, F53OSCServerUdpTransportGCDAsyncSocket);
+    XCTAssertNil(server.nativeUdpTransport);
+}
+
+
+#pragma mark - Transport tests
+
+- (void)testThat_nativeUdpTransportReceivesDatagrams
+{
+    NSUInteger datagramCount = 100;
+    dispatch_queue_t queue = dispatch_queue_create("test.native.transport.queue", DISPATCH_QUEUE_SERIAL);
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"All datagrams received"];
+
+    NSMutableArray<NSData *> *received = [NSMutableArray array];
+    F53OSCNativeUdpTransport *transport = [[F53OSCNativeUdpTransport alloc] initWithQueue:queue receiveHandler:^(NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp) {
+        [received addObject:data];
+        if (received.count == datagramCount)
+            [expectation fulfill];
+    }];
+
+    [self addTeardownBlock:^{
+        [transport stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([transport listenOnPort:0 IPv6Enabled:NO error:&error]);
+    XCTAssertNil(error);
+    XCTAssertTrue(transport.isListening);
+    XCTAssertGreaterThan(transport.localPort, 0, @"Port 0 should bind an ephemeral port");
+
+    XCTAssertFalse([transport listenOnPort:0 IPv6Enabled:NO error:&error], @"Listening twice should fail");
+    XCTAssertNotNil(error);
+
+    GCDAsyncUdpSocket *sender = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    for (UInt8 i = 0; i < datagramCount; i++)
+        [sender sendData:[NSData dataWithBytes:&i length:1] toHost:@"127.0.0.1" port:transport.localPort withTimeout:-1 tag:0];
+
+    [self waitForExpectations:@[expectation] timeout:5.0];
+    [sender closeAfterSending];
+
+    dispatch_sync(queue, ^{
+        for (UInt8 i = 0; i < datagramCount; i++)
+            XCTAssertEqual(((const UInt8 *)received[i].bytes)[0], i, @"Each datagram should get its own copy of the bytes");
+    });
+    XCTAssertEqual(transport.receivedDatagramCount, datagramCount);
+    XCTAssertEqual(transport.pooledReceiveCount, transport.receiveBufferCount, @"Held datagrams should keep their pool buffers in use");
+    XCTAssertEqual(transport.copiedReceiveCount, datagramCount - transport.receiveBufferCount, @"Datagrams beyond the pool should be copied");
+    XCTAssertGreaterThan(transport.wakeupCount, 0);
+    XCTAssertLessThanOrEqual(transport.wakeupCount, datagramCount);
+
+    [transport stopListening];
+    XCTAssertFalse(transport.isListening);
+}
+
+- (void)testThat_nativeUdpTransportReusesPoolBuffers
+{
+    NSUInteger datagramCount = 200;
+    dispatch_queue_t queue = dispatch_queue_create("test.native.transport.queue", DISPATCH_QUEUE_SERIAL);
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"All datagrams received"];
+
+    __block NSUInteger receivedCount = 0;
+    __block BOOL bytesMatched = YES;
+    __block NSString *senderHost = nil;
+    __block UInt16 senderPort = 0;
+    F53OSCNativeUdpTransport *transport = [[F53OSCNativeUdpTransport alloc] initWithQueue:queue receiveHandler:^(NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp) {
+        // Nothing keeps the data, so its pool buffer is free again as soon as this returns.
+        UInt8 expected = (UInt8)receivedCount;
+        bytesMatched = bytesMatched && data.length == 1 && ((const UInt8 *)data.bytes)[0] == expected;
+        if (receivedCount == 0)
+        {
+            senderHost = F53OSCSocketAddressHost(address);
+            senderPort = F53OSCSocketAddressPort(address);
+        }
+        receivedCount++;
+        if (receivedCount == datagramCount)
+            [expectation fulfill];
+    }];
+    transport.receiveBufferCount = 4;
+
+    [self addTeardownBlock:^{
+        [transport stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([transport listenOnPort:0 IPv6Enabled:NO error:&error]);
+
+    GCDAsyncUdpSocket *sender = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    for (NSUInteger i = 0; i < datagramCount; i++)
+    {
+        UInt8 byte = (UInt8)i;
+        [sender sendData:[NSData dataWithBytes:&byte length:1] toHost:@"127.0.0.1" port:transport.localPort withTimeout:-1 tag:0];
+    }
+
+    [self waitForExpectations:@[expectation] timeout:5.0];
+    UInt16 senderLocalPort = sender.localPort;
+    [sender closeAfterSending];
+    dispatch_sync(queue, ^{}); // let the last datagram's data go
+
+    XCTAssertTrue(bytesMatched, @"Reused buffers should hold each new datagram");
+    XCTAssertEqual(transport.pooledReceiveCount, datagramCount, @"Released buffers should be reused for every datagram");
+    XCTAssertEqual(transport.copiedReceiveCount, 0);
+    XCTAssertEqual(transport.receiveBufferPool.slabCount, 1, @"One slab allocation should serve every datagram");
+    XCTAssertEqual(transport.receiveBufferPool.buffersInUse, 0);
+    XCTAssertEqualObjects(senderHost, @"127.0.0.1");
+    XCTAssertEqual(senderPort, senderLocalPort);
+}
+
+- (void)testThat_nativeUdpTransportCopiesWithoutPool
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.native.transport.queue", DISPATCH_QUEUE_SERIAL);
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"Datagram received"];
+
+    F53OSCNativeUdpTransport *transport = [[F53OSCNativeUdpTransport alloc] initWithQueue:queue receiveHandler:^(NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp) {
+        [expectation fulfill];
+    }];
+    transport.receiveBufferCount = 0;
+
+    [self addTeardownBlock:^{
+        [transport stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([transport listenOnPort:0 IPv6Enabled:NO error:&error]);
+
+    GCDAsyncUdpSocket *sender = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    [sender sendData:[NSData dataWithBytes:"x" length:1] toHost:@"127.0.0.1" port:transport.localPort withTimeout:-1 tag:0];
+
+    [self waitForExpectations:@[expectation] timeout:5.0];
+    [sender closeAfterSending];
+
+    XCTAssertEqual(transport.pooledReceiveCount, 0);
+    XCTAssertEqual(transport.copiedReceiveCount, 1);
+}
+
+- (void)testThat_nativeUdpTransportReadsReceiveTimestamps
+{
+    dispatch_queue_t queue = dispatch_queue_create("test.native.transport.queue", DISPATCH_QUEUE_SERIAL);
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"Datagram received"];
+
+    __block NSTimeInterval receivedTimestamp = 0;
+    __block NSTimeInterval handledAt = 0;
+    F53OSCNativeUdpTransport *transport = [[F53OSCNativeUdpTransport alloc] initWithQueue:queue receiveHandler:^(NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp) {
+        receivedTimestamp = timestamp;
+        handledAt = [NSDate date].timeIntervalSince1970;
+        [expectation fulfill];
+    }];
+    F53OSCSocketOptions *options = [[F53OSCSocketOptions alloc] init];
+    options.receiveTimestamps = YES;
+    options.receiveBufferSize = 1024 * 1024;
+    transport.socketOptions = options;
+
+    [self addTeardownBlock:^{
+        [transport stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([transport listenOnPort:0 IPv6Enabled:NO error:&error]);
+
+    NSTimeInterval sentAt = [NSDate date].timeIntervalSince1970;
+    GCDAsyncUdpSocket *sender = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    [sender sendData:[NSData dataWithBytes:"t" length:1] toHost:@"127.0.0.1" port:transport.localPort withTimeout:-1 tag:0];
+
+    [self waitForExpectations:@[expectation] timeout:5.0];
+    [sender closeAfterSending];
+
+    dispatch_sync(queue, ^{
+        XCTAssertGreaterThanOrEqual(receivedTimestamp, sentAt - 0.01, @"The kernel timestamp should follow the send");
+        XCTAssertLessThanOrEqual(receivedTimestamp, handledAt + 0.01, @"The kernel timestamp should precede the handler");
+    });
+}
+
+- (void)testThat_serverCarriesReceiveTimestampsToMessages
+{
+    TransportBenchmarkReceiver *receiver = [[TransportBenchmarkReceiver alloc] init];
+    receiver.expectedMessageCount = 20;
+    receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"All messages received"];
+
+    F53OSCSocketOptions *options = [[F53OSCSocketOptions alloc] init];
+    options.receiveTimestamps = YES;
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = receiver;
+    server.port = PORT_BASE + 30;
+    server.udpTransport = F53OSCServerUdpTransportNative;
+    server.socketOptions = options;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"127.0.0.1";
+    client.port = server.port;
+
+    [self addTeardownBlock:^{
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertTrue(server.nativeUdpTransport.socketOptions.receiveTimestamps);
+
+    receiver.startTime = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < receiver.expectedMessageCount; i++)
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/stamped" arguments:@[@0.0]]];
+
+    [self waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:5.0];
+
+    XCTAssertEqual(receiver.timestampedMessageCount, receiver.expectedMessageCount, @"Every message should carry its kernel receive time");
+    NSLog(@"native UDP transport: mean wire-to-handler latency %.1f us over %lu messages",
+          receiver.totalWireToHandlerLatency / MAX(receiver.timestampedMessageCount, (NSUInteger)1) * 1000000.0,
+          (unsigned long)receiver.timestampedMessageCount);
+}
+
+- (void)testThat_serverFallsBackToGCDAsyncUdpSocket
+{
+    F53OSCNativeUdpTransport *blocker = [[F53OSCNativeUdpTransport alloc] initWithQueue:dispatch_get_main_queue() receiveHandler:^(NSData *data, const F53OSCSocketAddress *address, NSTimeInterval timestamp) {}];
+    NSError *error = nil;
+    XCTAssertTrue([blocker listenOnPort:0 IPv6Enabled:NO error:&error]);
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.port = blocker.localPort;
+    server.udpTransport = F53OSCServerUdpTransportNative;
+
+    [self addTeardownBlock:^{
+        [server stopListening];
+        [blocker stopListening];
+    }];
+
+    // Both transports need the port, so the fallback reports the same failure.
+    XCTAssertFalse([server startListening:&error]);
+    XCTAssertNotNil(error);
+    XCTAssertNil(server.nativeUdpTransport);
+}
+
+- (void)testThat_serverReceivesMessagesWithNativeUdpTransport
+{
+    TransportBenchmarkReceiver *receiver = [[TransportBenchmarkReceiver alloc] init];
+    receiver.expectedMessageCount = 10;
+    receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"All messages received"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = receiver;
+    server.port = PORT_BASE + 10;
+    server.udpTransport = F53OSCServerUdpTransportNative;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"127.0.0.1";
+    client.port = server.port;
+
+    [self addTeardownBlock:^{
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+    XCTAssertNotNil(server.nativeUdpTransport);
+    XCTAssertEqual(server.nativeUdpTransport.localPort, server.port);
+
+    for (NSUInteger i = 0; i < receiver.expectedMessageCount; i++)
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/native" arguments:@[@0.0]]];
+
+    [self waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:5.0];
+
+    [server stopListening];
+    XCTAssertNil(server.nativeUdpTransport);
+}
+
+
+#pragma mark - Performance tests
+
+- (void)testThat_nativeUdpTransportCompetesWithGCDAsyncUdpSocket
+{
+    NSUInteger rounds = 50;
+    NSUInteger messagesPerRound = 200;
+    NSArray<NSNumber *> *transports = @[@(F53OSCServerUdpTransportGCDAsyncSocket), @(F53OSCServerUdpTransportNative)];
+    NSArray<NSString *> *names = @[@"GCDAsyncUdpSocket", @"native"];
+
+    for (NSUInteger t = 0; t < transports.count; t++)
+    {
+        TransportBenchmarkReceiver *receiver = [[TransportBenchmarkReceiver alloc] init];
+        receiver.expectedMessageCount = rounds * messagesPerRound;
+        receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:names[t]];
+
+        dispatch_queue_t queue = dispatch_queue_create("test.native.benchmark.queue", DISPATCH_QUEUE_SERIAL);
+        F53OSCServer *server = [[F53OSCServer alloc] initWithDelegateQueue:queue];
+        server.delegate = receiver;
+        server.port = PORT_BASE + 20 + t;
+        server.udpTransport = transports[t].integerValue;
+
+        NSError *error = nil;
+        XCTAssertTrue([server startListening:&error], @"Server should start listening");
+
+        GCDAsyncUdpSocket *sender = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+        receiver.startTime = [NSDate timeIntervalSinceReferenceDate];
+        for (NSUInteger round = 0; round < rounds; round++)
+        {
+            for (NSUInteger i = 0; i < messagesPerRound; i++)
+            {
+                NSTimeInterval sentAt = [NSDate timeIntervalSinceReferenceDate] - receiver.startTime;
+                F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/telemetry" arguments:@[@(sentAt)]];
+                [sender sendData:[message packetData] toHost:@"127.0.0.1" port:server.port withTimeout:-1 tag:0];
+            }
+            [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.002]]; // pace bursts for the loopback receive buffer
+        }
+
+        XCTWaiterResult result = [XCTWaiter waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:10.0];
+        [sender closeAfterSending];
+        F53OSCNativeUdpTransport *nativeTransport = server.nativeUdpTransport;
+        if (nativeTransport)
+        {
+            // Each slab is one malloc, and each copied datagram one more.
+            NSUInteger bufferAllocations = nativeTransport.receiveBufferPool.slabCount + nativeTransport.copiedReceiveCount;
+            NSUInteger datagrams = MAX(nativeTransport.receivedDatagramCount, (NSUInteger)1);
+            NSLog(@"native UDP transport: %lu datagrams in %lu wakeups, %lu parsed in place, %lu copied, %.4f receive buffer mallocs per datagram",
+                  (unsigned long)nativeTransport.receivedDatagramCount, (unsigned long)nativeTransport.wakeupCount,
+                  (unsigned long)nativeTransport.pooledReceiveCount, (unsigned long)nativeTransport.copiedReceiveCount,
+                  (double)bufferAllocations / datagrams);
+        }
+        [server stopListening];
+
+        __block NSUInteger received;
+        __block NSTimeInterval elapsed;
+        __block double meanLatency;
+        dispatch_sync(queue, ^{
+            received = receiver.messageCount;
+            elapsed = receiver.lastReceivedTime;
+            meanLatency = ( received ? receiver.totalLatency / received : 0 );
+        });
+
+        NSLog(@"%@ UDP transport: %lu of %lu messages in %.4f s (%.0f msg/s), mean latency %.1f us",
+              names[t], (unsigned long)received, (unsigned long)receiver.expectedMessageCount, elapsed,
+              ( elapsed > 0 ? received / elapsed : 0 ), meanLatency * 1000000.0);
+        XCTAssertEqual(result, XCTWaiterResultCompleted, @"%@ should deliver every message", names[t]);
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
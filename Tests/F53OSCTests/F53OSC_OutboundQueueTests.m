@@ -0,0 +1,313 @@
+//
+//  F53OSC_OutboundQueueTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCClient.h"
+#import "F53OSCMessage.h"
+#import "F53OSCOutboundQueue.h"
+#import "F53OSCServer.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define PORT_BASE   9800
+
+#pragma mark - OrderedTestReceiver
+
+@interface OrderedTestReceiver : NSObject <F53OSCServerDelegate>
+@property (strong) NSMutableArray<F53OSCMessage *> *messages;
+@property (assign) NSUInteger expectedMessageCount;
+@property (strong, nullable) XCTestExpectation *allMessagesExpectation;
+@end
+
+@implementation OrderedTestReceiver
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+        self.messages = [NSMutableArray array];
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (!message)
+        return;
+
+    [self.messages addObject:(F53OSCMessage * _Nonnull)message];
+    if (self.messages.count == self.expectedMessageCount)
+        [self.allMessagesExpectation fulfill];
+}
+
+@end
+
+
+#pragma mark - F53OSC_OutboundQueueTests
+
+@interface F53OSC_OutboundQueueTests : XCTestCase
+@end
+
+@implementation F53OSC_OutboundQueueTests
+
+- (NSData *)dataWithByte:(UInt8)byte length:(NSUInteger)length
+{
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    memset(data.mutableBytes, byte, length);
+    return data;
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_outboundQueueHasCorrectDefaults
+{
+    F53OSCOutboundQueue *queue = [[F53OSCOutboundQueue alloc] init];
+
+    XCTAssertEqual(queue.maxPacketCount, 256);
+    XCTAssertEqual(queue.maxByteCount, 0);
+    XCTAssertEqual(queue.maxAge, 0);
+    XCTAssertEqual(queue.dropPolicy, F53OSCOutboundQueueDropOldest);
+    XCTAssertEqual(queue.count, 0);
+    XCTAssertEqual(queue.byteCount, 0);
+    XCTAssertEqual(queue.enqueuedCount, 0);
+    XCTAssertEqual(queue.flushedCount, 0);
+    XCTAssertEqual(queue.overflowDropCount, 0);
+    XCTAssertEqual(queue.staleDropCount, 0);
+    XCTAssertNil([queue takeQueuedData]);
+}
+
+
+#pragma mark - Queue tests
+
+- (void)testThat_outboundQueueJoinsEntriesInOrder
+{
+    F53OSCOutboundQueue *queue = [[F53OSCOutboundQueue alloc] init];
+
+    XCTAssertTrue([queue enqueueData:[self dataWithByte:1 length:2]]);
+    XCTAssertTrue([queue enqueueData:[self dataWithByte:2 length:3]]);
+    XCTAssertFalse([queue enqueueData:[NSData data]], @"Empty entries should be refused");
+    XCTAssertEqual(queue.count, 2);
+    XCTAssertEqual(queue.byteCount, 5);
+
+    NSData *data = [queue takeQueuedData];
+    const UInt8 expected[] = { 1, 1, 2, 2, 2 };
+    XCTAssertEqualObjects(data, [NSData dataWithBytes:expected length:sizeof(expected)]);
+    XCTAssertEqual(queue.count, 0);
+    XCTAssertEqual(queue.byteCount, 0);
+    XCTAssertEqual(queue.enqueuedCount, 2);
+    XCTAssertEqual(queue.flushedCount, 2);
+}
+
+- (void)testThat_outboundQueueDropsOldestWhenFull
+{
+    F53OSCOutboundQueue *queue = [[F53OSCOutboundQueue alloc] init];
+    queue.maxPacketCount = 3;
+
+    for (UInt8 i = 1; i <= 5; i++)
+        XCTAssertTrue([queue enqueueData:[self dataWithByte:i length:1]]);
+
+    const UInt8 expected[] = { 3, 4, 5 };
+    XCTAssertEqualObjects([queue takeQueuedData], [NSData dataWithBytes:expected length:sizeof(expected)]);
+    XCTAssertEqual(queue.overflowDropCount, 2);
+}
+
+- (void)testThat_outboundQueueRefusesNewestWhenFull
+{
+    F53OSCOutboundQueue *queue = [[F53OSCOutboundQueue alloc] init];
+    queue.maxPacketCount = 3;
+    queue.dropPolicy = F53OSCOutboundQueueDropNewest;
+
+    for (UInt8 i = 1; i <= 5; i++)
+        XCTAssertEqual([queue enqueueData:[self dataWithByte:i length:1]], i <= 3);
+
+    const UInt8 expected[] = { 1, 2, 3 };
+    XCTAssertEqualObjects([queue takeQueuedData], [NSData dataWithBytes:expected length:sizeof(expected)]);
+    XCTAssertEqual(queue.overflowDropCount, 2);
+}
+
+- (void)testThat_outboundQueueHonorsByteLimit
+{
+    F53OSCOutboundQueue *queue = [[F53OSCOutboundQueue alloc] init];
+    queue.maxByteCount = 10;
+
+    XCTAssertTrue([queue enqueueData:[self dataWithByte:1 length:4]]);
+    XCTAssertTrue([queue enqueueData:[self dataWithByte:2 length:4]]);
+    XCTAssertTrue([queue enqueueData:[self dataWithByte:3 length:4]], @"The oldest entry should make room");
+    XCTAssertEqual(queue.count, 2);
+    XCTAssertEqual(queue.byteCount, 8);
+    XCTAssertFalse([queue enqueueData:[self dataWithByte:4 length:11]], @"An entry larger than the limit can never fit");
+    XCTAssertEqual(queue.overflowDropCount, 2);
+}
+
+- (void)testThat_outboundQueueDropsStaleEntries
+{
+    F53OSCOutboundQueue *queue = [[F53OSCOutboundQueue alloc] init];
+    queue.maxAge = 1.0;
+
+    XCTAssertTrue([queue enqueueData:[self dataWithByte:1 length:1] atTime:10.0]);
+    XCTAssertTrue([queue enqueueData:[self dataWithByte:2 length:1] atTime:10.5]);
+    XCTAssertTrue([queue enqueueData:[self dataWithByte:3 length:1] atTime:11.2]);
+
+    const UInt8 expected[] = { 2, 3 };
+    XCTAssertEqualObjects([queue takeQueuedDataAtTime:11.4], [NSData dataWithBytes:expected length:sizeof(expected)]);
+    XCTAssertEqual(queue.staleDropCount, 1);
+    XCTAssertEqual(queue.flushedCount, 2);
+}
+
+
+#pragma mark - Reconnecting client tests
+
+- (void)testThat_reconnectingClientDeliversPacketsQueuedWhileDown
+{
+    NSUInteger messageCount = 20;
+    UInt16 port = PORT_BASE + 10;
+
+    OrderedTestReceiver *receiver = [[OrderedTestReceiver alloc] init];
+    receiver.expectedMessageCount = messageCount;
+    receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Queued messages delivered"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = receiver;
+    server.port = port;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"127.0.0.1";
+    client.port = port;
+    client.useTcp = YES;
+    client.reconnectsAutomatically = YES;
+    client.reconnectMinimumDelay = 0.05;
+    client.reconnectMaximumDelay = 0.2;
+    client.outboundQueue = [[F53OSCOutboundQueue alloc] init];
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    // Nothing is listening yet, so every send waits in the queue while the client retries.
+    for (NSUInteger i = 0; i < messageCount; i++)
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[@(i)]]];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+    XCTAssertFalse(client.isConnected);
+    XCTAssertEqual(client.outboundQueue.count, messageCount);
+    XCTAssertGreaterThanOrEqual(client.reconnectAttemptCount, 2, @"The client should keep retrying");
+    XCTAssertLessThan(client.reconnectAttemptCount, 10, @"Retries should back off");
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    [self waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:5.0];
+
+    XCTAssertTrue(client.isConnected);
+    XCTAssertEqual(client.reconnectCount, 1);
+    XCTAssertEqual(client.outboundQueue.count, 0);
+    XCTAssertEqual(client.outboundQueue.flushedCount, messageCount);
+    for (NSUInteger i = 0; i < receiver.messages.count; i++)
+        XCTAssertEqualObjects(receiver.messages[i].arguments.firstObject, @(i), @"Queued messages should arrive in order");
+}
+
+- (void)testThat_reconnectingClientDropsStalePackets
+{
+    UInt16 port = PORT_BASE + 11;
+
+    OrderedTestReceiver *receiver = [[OrderedTestReceiver alloc] init];
+    receiver.expectedMessageCount = 1;
+    receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Fresh message delivered"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = receiver;
+    server.port = port;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"127.0.0.1";
+    client.port = port;
+    client.useTcp = YES;
+    client.reconnectsAutomatically = YES;
+    client.reconnectMinimumDelay = 0.05;
+    client.reconnectMaximumDelay = 0.1;
+    client.outboundQueue = [[F53OSCOutboundQueue alloc] init];
+    client.outboundQueue.maxAge = 0.2;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    for (NSUInteger i = 0; i < 5; i++)
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[@"stale"]]];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.4]];
+    [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[@"fresh"]]];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+
+    [self waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:5.0];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+    XCTAssertEqual(receiver.messages.count, 1);
+    XCTAssertEqualObjects(receiver.messages.firstObject.arguments.firstObject, @"fresh");
+    XCTAssertEqual(client.outboundQueue.staleDropCount, 5);
+}
+
+- (void)testThat_disconnectStopsReconnecting
+{
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"127.0.0.1";
+    client.port = PORT_BASE + 12;
+    client.useTcp = YES;
+    client.reconnectsAutomatically = YES;
+    client.reconnectMinimumDelay = 0.05;
+
+    XCTAssertTrue([client connect]);
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertGreaterThan(client.reconnectAttemptCount, 0);
+
+    [client disconnect];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    NSUInteger attempts = client.reconnectAttemptCount;
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    XCTAssertEqual(client.reconnectAttemptCount, attempts, @"No attempts should follow an explicit disconnect");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
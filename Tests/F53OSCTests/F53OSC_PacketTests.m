@@ -73,6 +73,7 @@ NS_ASSUME_NONNULL_BEGIN
 
     XCTAssertNotNil(packet, @"Packet should not be nil");
     XCTAssertNil(packet.replySocket, @"Default replySocket should be nil");
+    XCTAssertEqual(packet.receivedTimestamp, 0, @"Default receivedTimestamp should be 0");
     XCTAssertNil([packet packetData], @"Default packetData should be nil");
     XCTAssertNil([packet asQSC], @"Default asQSC should be nil");
 }
@@ -30,9 +30,11 @@
 
 #import <XCTest/XCTest.h>
 
+#import "F53OSCBundle.h"
 #import "F53OSCMessage.h"
 #import "F53OSCParser.h"
 #import "F53OSCSocket.h"
+#import "F53OSCTimeTag.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -45,6 +47,15 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 
+#pragma mark - MockBundleDestination
+
+@interface MockBundleDestination : MockPacketDestination
+@property (nonatomic) NSUInteger takeBundleMessagesCallCount;
+@property (nonatomic, strong) NSMutableArray<NSArray<F53OSCMessage *> *> *receivedBundles;
+@property (nonatomic, strong) NSMutableArray<F53OSCTimeTag *> *receivedTimeTags;
+@end
+
+
 #pragma mark - MockControlHandler
 
 @interface MockControlHandler : NSObject <F53OSCControlHandler>
@@ -817,6 +828,131 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 
+#pragma mark - Whole-bundle delivery tests
+
+- (NSData *)bundleDataNestedToDepth:(NSUInteger)depth
+{
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/deep" arguments:@[@(depth)]];
+    NSData *packetData = [F53OSCBundle bundleWithTimeTag:[F53OSCTimeTag immediateTimeTag] elements:@[message.packetData]].packetData;
+    for (NSUInteger i = 1; i < depth; i++)
+        packetData = [F53OSCBundle bundleWithTimeTag:[F53OSCTimeTag immediateTimeTag] elements:@[packetData]].packetData;
+    return packetData;
+}
+
+- (void)testThat_processOscDataDeliversWholeBundleInOneCall
+{
+    MockBundleDestination *destination = [[MockBundleDestination alloc] init];
+
+    F53OSCTimeTag *timeTag = [F53OSCTimeTag timeTagWithDate:[NSDate dateWithTimeIntervalSinceNow:1.0]];
+    F53OSCMessage *message1 = [F53OSCMessage messageWithAddressPattern:@"/one" arguments:@[@1]];
+    F53OSCMessage *message2 = [F53OSCMessage messageWithAddressPattern:@"/two" arguments:@[@2]];
+    F53OSCMessage *message3 = [F53OSCMessage messageWithAddressPattern:@"/three" arguments:@[@3]];
+    F53OSCBundle *innerBundle = [F53OSCBundle bundleWithTimeTag:timeTag elements:@[message2.packetData]];
+    F53OSCBundle *bundle = [F53OSCBundle bundleWithTimeTag:timeTag elements:@[message1.packetData, innerBundle.packetData, message3.packetData]];
+
+    [F53OSCParser processOscData:bundle.packetData forDestination:destination replyToSocket:self.mockSocket controlHandler:self.mockControlHandler wasEncrypted:NO];
+
+    XCTAssertEqual(destination.takeBundleMessagesCallCount, 1, @"Bundle should be delivered in a single call");
+    XCTAssertEqual(destination.takeMessageCallCount, 0, @"takeMessage: should not be called for bundled messages");
+
+    NSArray<F53OSCMessage *> *messages = destination.receivedBundles.firstObject;
+    XCTAssertEqual(messages.count, 3, @"Nested bundle messages should be flattened into the delivery");
+    XCTAssertEqualObjects(messages[0].addressPattern, @"/one");
+    XCTAssertEqualObjects(messages[1].addressPattern, @"/two");
+    XCTAssertEqualObjects(messages[2].addressPattern, @"/three");
+    XCTAssertEqual(messages[0].replySocket, self.mockSocket);
+
+    F53OSCTimeTag *receivedTimeTag = destination.receivedTimeTags.firstObject;
+    XCTAssertEqual(receivedTimeTag.seconds, timeTag.seconds);
+    XCTAssertEqual(receivedTimeTag.fraction, timeTag.fraction);
+}
+
+- (void)testThat_processOscDataDeliversSingleMessagesWithoutBundleCall
+{
+    MockBundleDestination *destination = [[MockBundleDestination alloc] init];
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/single" arguments:@[]];
+
+    [F53OSCParser processOscData:message.packetData forDestination:destination replyToSocket:self.mockSocket controlHandler:self.mockControlHandler wasEncrypted:NO];
+
+    XCTAssertEqual(destination.takeBundleMessagesCallCount, 0);
+    XCTAssertEqual(destination.takeMessageCallCount, 1, @"Messages outside of bundles should still use takeMessage:");
+}
+
+- (void)testThat_processOscDataDropsMalformedBundleWhole
+{
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/before" arguments:@[@1]];
+    NSMutableData *bundleData = [[F53OSCBundle bundleWithTimeTag:[F53OSCTimeTag immediateTimeTag] elements:@[message.packetData]].packetData mutableCopy];
+
+    // Append an element that claims to be larger than the rest of the bundle.
+    uint32_t invalidSize = CFSwapInt32HostToBig(1000);
+    [bundleData appendBytes:&invalidSize length:4];
+    [bundleData appendBytes:"/bad" length:4];
+
+    MockBundleDestination *bundleDestination = [[MockBundleDestination alloc] init];
+    [F53OSCParser processOscData:bundleData forDestination:bundleDestination replyToSocket:self.mockSocket controlHandler:self.mockControlHandler wasEncrypted:NO];
+    XCTAssertEqual(bundleDestination.takeBundleMessagesCallCount, 0, @"A malformed bundle should not be partially delivered");
+    XCTAssertEqual(bundleDestination.takeMessageCallCount, 0);
+
+    [F53OSCParser processOscData:bundleData forDestination:self.mockDestination replyToSocket:self.mockSocket controlHandler:self.mockControlHandler wasEncrypted:NO];
+    XCTAssertEqual(self.mockDestination.receivedPackets.count, 1, @"Per-message destinations still receive messages parsed before the error");
+}
+
+- (void)testThat_processOscDataHandlesBundlesUpToMaxDepth
+{
+    MockBundleDestination *destination = [[MockBundleDestination alloc] init];
+    NSData *bundleData = [self bundleDataNestedToDepth:F53OSCParserMaxBundleDepth];
+
+    [F53OSCParser processOscData:bundleData forDestination:destination replyToSocket:self.mockSocket controlHandler:self.mockControlHandler wasEncrypted:NO];
+
+    XCTAssertEqual(destination.takeBundleMessagesCallCount, 1, @"Bundles nested up to the depth limit should be delivered");
+    XCTAssertEqualObjects(destination.receivedBundles.firstObject.firstObject.addressPattern, @"/deep");
+}
+
+- (void)testThat_processOscDataRejectsBundlesBeyondMaxDepth
+{
+    MockBundleDestination *destination = [[MockBundleDestination alloc] init];
+    NSData *bundleData = [self bundleDataNestedToDepth:F53OSCParserMaxBundleDepth + 1];
+
+    XCTAssertNoThrow([F53OSCParser processOscData:bundleData forDestination:destination replyToSocket:self.mockSocket controlHandler:self.mockControlHandler wasEncrypted:NO]);
+    XCTAssertEqual(destination.takeBundleMessagesCallCount, 0, @"Bundles nested beyond the depth limit should be rejected");
+
+    [F53OSCParser processOscData:bundleData forDestination:self.mockDestination replyToSocket:self.mockSocket controlHandler:self.mockControlHandler wasEncrypted:NO];
+    XCTAssertEqual(self.mockDestination.receivedPackets.count, 0);
+}
+
+- (void)testThat_processOscDataBundleDeliveryPerformance
+{
+    NSMutableArray<NSData *> *elements = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 200; i++)
+    {
+        F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:[NSString stringWithFormat:@"/state/%lu/level", (unsigned long)i] arguments:@[@(i * 0.5f)]];
+        [elements addObject:message.packetData];
+    }
+    NSData *bundleData = [F53OSCBundle bundleWithTimeTag:[F53OSCTimeTag immediateTimeTag] elements:elements].packetData;
+
+    NSUInteger iterations = 500;
+    MockBundleDestination *bundleDestination = [[MockBundleDestination alloc] init];
+    MockPacketDestination *messageDestination = [[MockPacketDestination alloc] init];
+
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < iterations; i++)
+        [F53OSCParser processOscData:bundleData forDestination:messageDestination replyToSocket:self.mockSocket controlHandler:nil wasEncrypted:NO];
+    NSTimeInterval messageTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < iterations; i++)
+        [F53OSCParser processOscData:bundleData forDestination:bundleDestination replyToSocket:self.mockSocket controlHandler:nil wasEncrypted:NO];
+    NSTimeInterval bundleTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSLog(@"200-element bundle x %lu:", (unsigned long)iterations);
+    NSLog(@"  takeMessage:             %lu callbacks, %.4f s", (unsigned long)messageDestination.takeMessageCallCount, messageTime);
+    NSLog(@"  takeBundleMessages:...   %lu callbacks, %.4f s", (unsigned long)bundleDestination.takeBundleMessagesCallCount, bundleTime);
+
+    XCTAssertEqual(messageDestination.takeMessageCallCount, 200 * iterations);
+    XCTAssertEqual(bundleDestination.takeBundleMessagesCallCount, iterations, @"Each bundle should cost one callback");
+}
+
+
 #pragma mark - SLIP data translation tests
 
 - (void)testThat_translateSlipDataHandlesNilInputs
@@ -1233,6 +1369,32 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 
+#pragma mark - MockBundleDestination
+
+@implementation MockBundleDestination
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.takeBundleMessagesCallCount = 0;
+        self.receivedBundles = [NSMutableArray array];
+        self.receivedTimeTags = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    self.takeBundleMessagesCallCount++;
+    [self.receivedBundles addObject:messages];
+    [self.receivedTimeTags addObject:timeTag];
+}
+
+@end
+
+
 #pragma mark - MockControlHandler
 
 @implementation MockControlHandler
@@ -0,0 +1,223 @@
+//
+//  F53OSC_PatternCacheTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCPatternCache.h"
+#import "F53OSCServer.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define BENCHMARK_ADDRESSES     2000
+#define BENCHMARK_LOOKUPS       20000
+
+#pragma mark - F53OSC_PatternCacheTests
+
+@interface F53OSC_PatternCacheTests : XCTestCase
+@end
+
+@implementation F53OSC_PatternCacheTests
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_patternCacheHasCorrectDefaults
+{
+    F53OSCPatternCache *cache = [[F53OSCPatternCache alloc] init];
+
+    XCTAssertEqual(cache.capacity, 1024);
+    XCTAssertEqual(cache.maxPatternLength, 1024);
+    XCTAssertEqual(cache.generation, 0);
+    XCTAssertEqual(cache.addressCount, 0);
+    XCTAssertEqual(cache.count, 0);
+    XCTAssertEqual(cache.hitCount, 0);
+    XCTAssertEqual(cache.missCount, 0);
+    XCTAssertEqual(cache.staleCount, 0);
+    XCTAssertEqual(cache.evictionCount, 0);
+    XCTAssertEqual(cache.hitRate, 0);
+}
+
+
+#pragma mark - Resolution tests
+
+- (void)testThat_patternCacheResolvesPatterns
+{
+    F53OSCPatternCache *cache = [[F53OSCPatternCache alloc] init];
+    [cache addTarget:@"mute 2" forAddress:@"/mixer/2/mute"];
+    [cache addTarget:@"mute 1" forAddress:@"/mixer/1/mute"];
+    [cache addTarget:@"mute 3" forAddress:@"/mixer/3/mute"];
+    [cache addTarget:@"solo 1" forAddress:@"/mixer/1/solo"];
+    [cache addTarget:@"also mute 1" forAddress:@"/mixer/1/mute"];
+    XCTAssertEqual(cache.addressCount, 4);
+
+    NSArray *expected = @[@"mute 1", @"also mute 1", @"mute 2", @"mute 3"];
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/mixer/*/mute"], expected, @"Targets should be ordered by address, then by when they were added");
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/mixer/{1,3}/mute"], (@[@"mute 1", @"also mute 1", @"mute 3"]));
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/mixer/[2-3]/mute"], (@[@"mute 2", @"mute 3"]));
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/mixer/1/*"], (@[@"mute 1", @"also mute 1", @"solo 1"]));
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/mixer/1/solo"], @[@"solo 1"]);
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/mixer/*"], @[], @"'*' should not match across a '/'");
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/nothing"], @[]);
+}
+
+- (void)testThat_patternCacheCountsHitsAndMisses
+{
+    F53OSCPatternCache *cache = [[F53OSCPatternCache alloc] init];
+    [cache addTarget:@"go" forAddress:@"/cue/1/go"];
+
+    for (int i = 0; i < 10; i++)
+        XCTAssertEqualObjects([cache targetsMatchingPattern:@"/cue/*/go"], @[@"go"]);
+
+    XCTAssertEqual(cache.missCount, 1);
+    XCTAssertEqual(cache.hitCount, 9);
+    XCTAssertEqual(cache.count, 1);
+    XCTAssertEqualWithAccuracy(cache.hitRate, 0.9, 0.0001);
+
+    [cache resetStatistics];
+    XCTAssertEqual(cache.hitCount, 0);
+    XCTAssertEqual(cache.missCount, 0);
+    XCTAssertEqual(cache.count, 1, @"Resetting statistics should keep cached patterns");
+}
+
+- (void)testThat_patternCacheInvalidatesOnRegistryChanges
+{
+    F53OSCPatternCache *cache = [[F53OSCPatternCache alloc] init];
+    [cache addTarget:@"one" forAddress:@"/cue/1/go"];
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/cue/*/go"], @[@"one"]);
+
+    uint64_t generation = cache.generation;
+    [cache addTarget:@"two" forAddress:@"/cue/2/go"];
+    XCTAssertGreaterThan(cache.generation, generation);
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/cue/*/go"], (@[@"one", @"two"]), @"A new address should be seen after a change");
+    XCTAssertEqual(cache.staleCount, 1);
+
+    [cache removeTarget:@"one" forAddress:@"/cue/1/go"];
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/cue/*/go"], @[@"two"]);
+    XCTAssertEqual(cache.addressCount, 1, @"An address without targets should be removed");
+
+    [cache removeAllTargetsForAddress:@"/cue/2/go"];
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/cue/*/go"], @[]);
+
+    generation = cache.generation;
+    [cache invalidate];
+    XCTAssertGreaterThan(cache.generation, generation);
+    [cache targetsMatchingPattern:@"/cue/*/go"];
+    XCTAssertEqual(cache.staleCount, 4);
+    XCTAssertEqual(cache.hitCount, 0);
+    XCTAssertEqual(cache.count, 1, @"A stale pattern should be resolved again in place");
+}
+
+- (void)testThat_patternCacheEvictsLeastRecentlyUsed
+{
+    F53OSCPatternCache *cache = [[F53OSCPatternCache alloc] initWithCapacity:2];
+    [cache addTarget:@"a" forAddress:@"/a"];
+    [cache addTarget:@"b" forAddress:@"/b"];
+    [cache addTarget:@"c" forAddress:@"/c"];
+
+    [cache targetsMatchingPattern:@"/a"];
+    [cache targetsMatchingPattern:@"/b"];
+    [cache targetsMatchingPattern:@"/a"]; // "/b" is now the least recently used
+    [cache targetsMatchingPattern:@"/c"];
+    XCTAssertEqual(cache.count, 2);
+    XCTAssertEqual(cache.evictionCount, 1);
+
+    [cache resetStatistics];
+    [cache targetsMatchingPattern:@"/a"];
+    [cache targetsMatchingPattern:@"/c"];
+    XCTAssertEqual(cache.hitCount, 2);
+    [cache targetsMatchingPattern:@"/b"];
+    XCTAssertEqual(cache.missCount, 1, @"The least recently used pattern should have been evicted");
+
+    cache.maxPatternLength = 4;
+    [cache removeAllCachedPatterns];
+    XCTAssertEqual(cache.count, 0);
+    XCTAssertEqualObjects([cache targetsMatchingPattern:@"/{a,b}"], (@[@"a", @"b"]));
+    XCTAssertEqual(cache.count, 0, @"A pattern longer than maxPatternLength should not be cached");
+}
+
+
+#pragma mark - Performance tests
+
+- (void)testThat_patternCacheIsFasterThanPredicates
+{
+    F53OSCPatternCache *cache = [[F53OSCPatternCache alloc] init];
+    NSMutableArray<NSDictionary *> *objects = [NSMutableArray arrayWithCapacity:BENCHMARK_ADDRESSES];
+    for (NSUInteger i = 0; i < BENCHMARK_ADDRESSES; i++)
+    {
+        NSString *address = [NSString stringWithFormat:@"/cue/%lu/level", (unsigned long)i];
+        [cache addTarget:@(i) forAddress:address];
+        [objects addObject:@{ @"address" : address }];
+    }
+
+    NSArray<NSString *> *patterns = @[@"/cue/*/level", @"/cue/{1,2,3}/level", @"/cue/1?/level", @"/cue/[5-7]/level"];
+    NSUInteger lookups = BENCHMARK_LOOKUPS;
+
+    // What an application does today for every incoming pattern.
+    NSUInteger predicateLookups = lookups / 100;
+    NSUInteger predicateMatches = 0;
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < predicateLookups; i++)
+    {
+        @autoreleasepool
+        {
+            NSPredicate *predicate = [F53OSCServer predicateForAttribute:@"address" matchingOSCPattern:patterns[i % patterns.count]];
+            predicateMatches += [objects filteredArrayUsingPredicate:predicate].count;
+        }
+    }
+    NSTimeInterval predicateTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSUInteger cachedMatches = 0;
+    start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < lookups; i++)
+        cachedMatches += [cache targetsMatchingPattern:patterns[i % patterns.count]].count;
+    NSTimeInterval cachedTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    XCTAssertEqual(cachedMatches, predicateMatches * 100);
+    XCTAssertEqual(cache.missCount, patterns.count);
+
+    double predicatePerLookup = predicateTime / predicateLookups;
+    double cachedPerLookup = cachedTime / lookups;
+    NSLog(@"Resolving patterns against %d addresses: predicate %.1f us, cache %.3f us per lookup (hit rate %.4f)",
+          BENCHMARK_ADDRESSES, predicatePerLookup * 1e6, cachedPerLookup * 1e6, cache.hitRate);
+
+    XCTAssertLessThan(cachedPerLookup * 100, predicatePerLookup, @"A cached pattern should be far cheaper than matching every address");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
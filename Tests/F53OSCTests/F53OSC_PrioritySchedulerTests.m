@@ -0,0 +1,458 @@
+//
+//  F53OSC_PrioritySchedulerTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCPriorityScheduler.h"
+#import "F53OSCMessage.h"
+#import "F53OSCTimeTag.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - PriorityTestDestination
+
+@interface PriorityTestDestination : NSObject <F53OSCPacketDestination>
+@property (strong) NSMutableArray<F53OSCMessage *> *messages;
+@property (assign) NSUInteger takeMessagesCallCount;
+@property (copy, nullable) void (^deliveryHandler)(NSUInteger callCount); // called after each delivery
+@end
+
+@implementation PriorityTestDestination
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+        self.messages = [NSMutableArray array];
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (message)
+        [self.messages addObject:message];
+}
+
+- (void)takeMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    self.takeMessagesCallCount++;
+    [self.messages addObjectsFromArray:messages];
+
+    if (self.deliveryHandler)
+        self.deliveryHandler(self.takeMessagesCallCount);
+}
+
+@end
+
+
+#pragma mark - PriorityBundleTestDestination
+
+@interface PriorityBundleTestDestination : PriorityTestDestination
+@property (strong) NSMutableArray<NSArray<F53OSCMessage *> *> *bundles;
+@property (strong) NSMutableArray<F53OSCTimeTag *> *bundleTimeTags;
+@property (strong) NSMutableArray<NSNumber *> *messageCountsBeforeBundles; // messages already delivered when each bundle arrived
+@end
+
+@implementation PriorityBundleTestDestination
+
+- (void)takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    if (!self.bundles)
+    {
+        self.bundles = [NSMutableArray array];
+        self.bundleTimeTags = [NSMutableArray array];
+        self.messageCountsBeforeBundles = [NSMutableArray array];
+    }
+    [self.bundles addObject:messages];
+    [self.bundleTimeTags addObject:timeTag];
+    [self.messageCountsBeforeBundles addObject:@(self.messages.count)];
+}
+
+@end
+
+
+#pragma mark - F53OSC_PrioritySchedulerTests
+
+@interface F53OSC_PrioritySchedulerTests : XCTestCase
+@end
+
+@implementation F53OSC_PrioritySchedulerTests
+
+// The scheduler delivers in slices, each dispatched after the last, so keep draining until nothing is pending.
+- (void)drainScheduler:(F53OSCPriorityScheduler *)scheduler queue:(dispatch_queue_t)queue
+{
+    do
+    {
+        dispatch_sync(queue, ^{});
+    } while (scheduler.pendingCount > 0);
+    dispatch_sync(queue, ^{});
+}
+
+- (void)sendCount:(NSUInteger)count toAddress:(NSString *)address scheduler:(F53OSCPriorityScheduler *)scheduler
+{
+    for (NSUInteger i = 0; i < count; i++)
+        [scheduler takeMessage:[F53OSCMessage messageWithAddressPattern:address arguments:@[@(i)]]];
+}
+
+- (NSArray<NSString *> *)addressesOfMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    NSMutableArray<NSString *> *addresses = [NSMutableArray arrayWithCapacity:messages.count];
+    for (F53OSCMessage *message in messages)
+        [addresses addObject:message.addressPattern];
+    return addresses;
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_prioritySchedulerHasCorrectDefaults
+{
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] init];
+
+    XCTAssertNil(scheduler.destination);
+    XCTAssertEqual(scheduler.deliveryQueue, dispatch_get_main_queue(), @"Default deliveryQueue should be the main queue");
+    XCTAssertEqual(scheduler.drainMode, F53OSCPriorityDrainModeStrict);
+    XCTAssertEqual(scheduler.defaultLane, F53OSCPriorityLaneNormal);
+    XCTAssertEqual(scheduler.maxMessagesPerDrain, 64);
+    XCTAssertEqual(scheduler.maxPendingCount, 0);
+    XCTAssertEqual(scheduler.pendingCount, 0);
+    XCTAssertEqual(scheduler.shedCount, 0);
+    XCTAssertEqual(F53OSCPriorityLaneCount, 4);
+
+    XCTAssertEqual([scheduler weightForLane:F53OSCPriorityLaneControl], 8);
+    XCTAssertEqual([scheduler weightForLane:F53OSCPriorityLaneHigh], 4);
+    XCTAssertEqual([scheduler weightForLane:F53OSCPriorityLaneNormal], 2);
+    XCTAssertEqual([scheduler weightForLane:F53OSCPriorityLaneBulk], 1);
+}
+
+- (void)testThat_prioritySchedulerRejectsInvalidConfiguration
+{
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] init];
+
+    [scheduler setWeight:0 forLane:F53OSCPriorityLaneBulk];
+    XCTAssertEqual([scheduler weightForLane:F53OSCPriorityLaneBulk], 1, @"A zero weight would starve the lane");
+
+    [scheduler assignLane:(F53OSCPriorityLane)F53OSCPriorityLaneCount toAddress:@"/nowhere"];
+    XCTAssertEqual([scheduler laneForAddress:@"/nowhere"], F53OSCPriorityLaneNormal);
+
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddressesWithPrefix:@""];
+    XCTAssertEqual([scheduler laneForAddress:@"/anything"], F53OSCPriorityLaneNormal);
+}
+
+
+#pragma mark - Classification tests
+
+- (void)testThat_prioritySchedulerClassifiesAddresses
+{
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] init];
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddressesWithPrefix:@"/cue/"];
+    [scheduler assignLane:F53OSCPriorityLaneControl toAddressesWithPrefix:@"/cue/panic"];
+    [scheduler assignLane:F53OSCPriorityLaneBulk toAddressesWithPrefix:@"/meter"];
+    [scheduler assignLane:F53OSCPriorityLaneNormal toAddress:@"/meter/summary"];
+
+    XCTAssertEqual([scheduler laneForAddress:@"!encrypt/request"], F53OSCPriorityLaneControl, @"F53OSC control messages always use the control lane");
+    XCTAssertEqual([scheduler laneForAddress:@"/cue/1/go"], F53OSCPriorityLaneHigh);
+    XCTAssertEqual([scheduler laneForAddress:@"/cue/panic"], F53OSCPriorityLaneControl, @"The longest matching prefix should win");
+    XCTAssertEqual([scheduler laneForAddress:@"/meter/1"], F53OSCPriorityLaneBulk);
+    XCTAssertEqual([scheduler laneForAddress:@"/meter/summary"], F53OSCPriorityLaneNormal, @"Exact addresses should win over prefixes");
+    XCTAssertEqual([scheduler laneForAddress:@"/other"], F53OSCPriorityLaneNormal);
+
+    scheduler.defaultLane = F53OSCPriorityLaneBulk;
+    XCTAssertEqual([scheduler laneForAddress:@"/other"], F53OSCPriorityLaneBulk);
+
+    [scheduler removeAllLaneAssignments];
+    XCTAssertEqual([scheduler laneForAddress:@"/cue/1/go"], F53OSCPriorityLaneBulk);
+    XCTAssertEqual([scheduler laneForAddress:@"!encrypt/request"], F53OSCPriorityLaneControl);
+}
+
+
+#pragma mark - Drain tests
+
+- (void)testThat_prioritySchedulerDrainsStrictlyByLane
+{
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.PriorityTests", DISPATCH_QUEUE_SERIAL);
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] initWithDeliveryQueue:queue];
+    PriorityTestDestination *destination = [[PriorityTestDestination alloc] init];
+    scheduler.destination = destination;
+    scheduler.defaultLane = F53OSCPriorityLaneBulk;
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddress:@"/cue/go"];
+    [scheduler assignLane:F53OSCPriorityLaneNormal toAddress:@"/status"];
+
+    dispatch_suspend(queue);
+    [self sendCount:500 toAddress:@"/meter" scheduler:scheduler];
+    [self sendCount:3 toAddress:@"/status" scheduler:scheduler];
+    [self sendCount:2 toAddress:@"/cue/go" scheduler:scheduler];
+    XCTAssertEqual(scheduler.pendingCount, 505);
+    XCTAssertEqual([scheduler pendingCountForLane:F53OSCPriorityLaneBulk], 500);
+    dispatch_resume(queue);
+
+    [self drainScheduler:scheduler queue:queue];
+
+    NSArray<NSString *> *addresses = [self addressesOfMessages:destination.messages];
+    XCTAssertEqual(addresses.count, 505);
+    NSArray<NSString *> *expectedHead = @[@"/cue/go", @"/cue/go", @"/status", @"/status", @"/status", @"/meter"];
+    XCTAssertEqualObjects([addresses subarrayWithRange:NSMakeRange(0, expectedHead.count)], expectedHead);
+    XCTAssertEqual(destination.takeMessagesCallCount, 8, @"505 messages should be delivered in slices of at most 64");
+
+    // Order is kept within each lane.
+    NSMutableArray *meterValues = [NSMutableArray array];
+    for (F53OSCMessage *message in destination.messages)
+    {
+        if ([message.addressPattern isEqualToString:@"/meter"])
+            [meterValues addObject:message.arguments.firstObject];
+    }
+    for (NSUInteger i = 0; i < meterValues.count; i++)
+        XCTAssertEqualObjects(meterValues[i], @(i));
+
+    XCTAssertEqual([scheduler deliveredCountForLane:F53OSCPriorityLaneHigh], 2);
+    XCTAssertEqual([scheduler deliveredCountForLane:F53OSCPriorityLaneNormal], 3);
+    XCTAssertEqual([scheduler deliveredCountForLane:F53OSCPriorityLaneBulk], 500);
+}
+
+- (void)testThat_prioritySchedulerForwardsBundlesWholeInTheirHighestLane
+{
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.PriorityTests", DISPATCH_QUEUE_SERIAL);
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] initWithDeliveryQueue:queue];
+    PriorityTestDestination *destination = [[PriorityTestDestination alloc] init];
+    scheduler.destination = destination;
+    scheduler.defaultLane = F53OSCPriorityLaneBulk;
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddress:@"/cue/go"];
+    F53OSCTimeTag *timeTag = [F53OSCTimeTag timeTagWithDate:[NSDate dateWithTimeIntervalSinceNow:1.0]];
+    NSArray<F53OSCMessage *> *bundleMessages = @[[F53OSCMessage messageWithAddressPattern:@"/meter" arguments:@[@100]],
+                                                 [F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[@101]]];
+
+    XCTAssertFalse([scheduler respondsToSelector:@selector(takeBundleMessages:timeTag:)], @"Bundles should only be forwarded to destinations that take them");
+
+    // A destination without takeBundleMessages:timeTag: still gets a bundle's messages together.
+    dispatch_suspend(queue);
+    [self sendCount:2 toAddress:@"/meter" scheduler:scheduler];
+    [scheduler takeBundleMessages:bundleMessages timeTag:timeTag];
+    dispatch_resume(queue);
+    [self drainScheduler:scheduler queue:queue];
+    XCTAssertEqualObjects([self addressesOfMessages:destination.messages], (@[@"/meter", @"/cue/go", @"/meter", @"/meter"]));
+
+    PriorityBundleTestDestination *bundleDestination = [[PriorityBundleTestDestination alloc] init];
+    scheduler.destination = bundleDestination;
+    XCTAssertTrue([scheduler respondsToSelector:@selector(takeBundleMessages:timeTag:)]);
+
+    dispatch_suspend(queue);
+    [self sendCount:3 toAddress:@"/meter" scheduler:scheduler];
+    [scheduler takeBundleMessages:bundleMessages timeTag:timeTag];
+    XCTAssertEqual(scheduler.pendingCount, 4, @"A bundle should wait as a single item");
+    XCTAssertEqual([scheduler pendingCountForLane:F53OSCPriorityLaneHigh], 1, @"A bundle should take the highest lane of its messages");
+    dispatch_resume(queue);
+    [self drainScheduler:scheduler queue:queue];
+
+    XCTAssertEqual(bundleDestination.bundles.count, 1);
+    XCTAssertEqualObjects(bundleDestination.bundles.firstObject, bundleMessages);
+    XCTAssertEqual(bundleDestination.bundleTimeTags.firstObject, timeTag);
+    XCTAssertEqualObjects(bundleDestination.messageCountsBeforeBundles, @[@0], @"The bundle should overtake the pending bulk messages");
+    XCTAssertEqual(bundleDestination.messages.count, 3);
+    XCTAssertEqual([scheduler deliveredCountForLane:F53OSCPriorityLaneHigh], 4, @"Delivered counts should count each message in a bundle");
+}
+
+- (void)testThat_priorityMessageOvertakesPendingBulkBetweenSlices
+{
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.PriorityTests", DISPATCH_QUEUE_SERIAL);
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] initWithDeliveryQueue:queue];
+    scheduler.maxMessagesPerDrain = 10;
+    [scheduler assignLane:F53OSCPriorityLaneBulk toAddressesWithPrefix:@"/meter"];
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddress:@"/cue/go"];
+
+    PriorityTestDestination *destination = [[PriorityTestDestination alloc] init];
+    __weak F53OSCPriorityScheduler *weakScheduler = scheduler;
+    destination.deliveryHandler = ^(NSUInteger callCount) {
+        // A cue trigger arrives while the first slice of a meter flood is being handled.
+        if (callCount == 1)
+            [weakScheduler takeMessage:[F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[]]];
+    };
+    scheduler.destination = destination;
+
+    dispatch_suspend(queue);
+    [self sendCount:1000 toAddress:@"/meter" scheduler:scheduler];
+    dispatch_resume(queue);
+
+    [self drainScheduler:scheduler queue:queue];
+
+    NSArray<NSString *> *addresses = [self addressesOfMessages:destination.messages];
+    XCTAssertEqual(addresses.count, 1001);
+    XCTAssertEqual([addresses indexOfObject:@"/cue/go"], 10, @"The cue trigger should be first in the next slice, ahead of 990 pending meter messages");
+}
+
+- (void)testThat_prioritySchedulerWeightedDrainServesEveryLane
+{
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.PriorityTests", DISPATCH_QUEUE_SERIAL);
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] initWithDeliveryQueue:queue];
+    PriorityTestDestination *destination = [[PriorityTestDestination alloc] init];
+    scheduler.destination = destination;
+    scheduler.drainMode = F53OSCPriorityDrainModeWeighted;
+    scheduler.maxMessagesPerDrain = 0;
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddress:@"/high"];
+    [scheduler assignLane:F53OSCPriorityLaneNormal toAddress:@"/normal"];
+    [scheduler assignLane:F53OSCPriorityLaneBulk toAddress:@"/bulk"];
+
+    dispatch_suspend(queue);
+    [self sendCount:40 toAddress:@"/bulk" scheduler:scheduler];
+    [self sendCount:40 toAddress:@"/normal" scheduler:scheduler];
+    [self sendCount:40 toAddress:@"/high" scheduler:scheduler];
+    dispatch_resume(queue);
+
+    [self drainScheduler:scheduler queue:queue];
+
+    NSArray<NSString *> *addresses = [self addressesOfMessages:destination.messages];
+    XCTAssertEqual(addresses.count, 120);
+    XCTAssertEqual(destination.takeMessagesCallCount, 1, @"A maxMessagesPerDrain of 0 should deliver everything at once");
+
+    // With weights 4, 2, 1 each round serves four high, two normal and one bulk message.
+    NSArray<NSString *> *firstRound = @[@"/high", @"/high", @"/high", @"/high", @"/normal", @"/normal", @"/bulk"];
+    XCTAssertEqualObjects([addresses subarrayWithRange:NSMakeRange(0, 7)], firstRound);
+    XCTAssertEqualObjects([addresses subarrayWithRange:NSMakeRange(7, 7)], firstRound);
+
+    // Once the high lane is empty its share goes to the remaining lanes.
+    XCTAssertEqualObjects(addresses.lastObject, @"/bulk");
+}
+
+- (void)testThat_priorityWeightsCanBeChanged
+{
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.PriorityTests", DISPATCH_QUEUE_SERIAL);
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] initWithDeliveryQueue:queue];
+    PriorityTestDestination *destination = [[PriorityTestDestination alloc] init];
+    scheduler.destination = destination;
+    scheduler.drainMode = F53OSCPriorityDrainModeWeighted;
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddress:@"/high"];
+    [scheduler assignLane:F53OSCPriorityLaneBulk toAddress:@"/bulk"];
+    [scheduler setWeight:1 forLane:F53OSCPriorityLaneHigh];
+    [scheduler setWeight:1 forLane:F53OSCPriorityLaneBulk];
+
+    dispatch_suspend(queue);
+    [self sendCount:3 toAddress:@"/high" scheduler:scheduler];
+    [self sendCount:3 toAddress:@"/bulk" scheduler:scheduler];
+    dispatch_resume(queue);
+
+    [self drainScheduler:scheduler queue:queue];
+
+    NSArray<NSString *> *expected = @[@"/high", @"/bulk", @"/high", @"/bulk", @"/high", @"/bulk"];
+    XCTAssertEqualObjects([self addressesOfMessages:destination.messages], expected);
+}
+
+
+#pragma mark - Shedding tests
+
+- (void)testThat_prioritySchedulerShedsLowestLanesFirst
+{
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.PriorityTests", DISPATCH_QUEUE_SERIAL);
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] initWithDeliveryQueue:queue];
+    PriorityTestDestination *destination = [[PriorityTestDestination alloc] init];
+    scheduler.destination = destination;
+    scheduler.maxPendingCount = 10;
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddress:@"/high"];
+    [scheduler assignLane:F53OSCPriorityLaneBulk toAddress:@"/bulk"];
+
+    dispatch_suspend(queue);
+
+    [self sendCount:10 toAddress:@"/bulk" scheduler:scheduler];
+    [self sendCount:5 toAddress:@"/high" scheduler:scheduler];
+    XCTAssertEqual(scheduler.pendingCount, 10);
+    XCTAssertEqual([scheduler pendingCountForLane:F53OSCPriorityLaneBulk], 5);
+    XCTAssertEqual([scheduler shedCountForLane:F53OSCPriorityLaneBulk], 5, @"Bulk messages should make room for higher lanes");
+
+    // A message for the lowest pending lane replaces the oldest message in that lane.
+    [scheduler takeMessage:[F53OSCMessage messageWithAddressPattern:@"/bulk" arguments:@[@100]]];
+    XCTAssertEqual([scheduler pendingCountForLane:F53OSCPriorityLaneBulk], 5);
+    XCTAssertEqual([scheduler shedCountForLane:F53OSCPriorityLaneBulk], 6);
+
+    [self sendCount:5 toAddress:@"/high" scheduler:scheduler];
+    XCTAssertEqual([scheduler pendingCountForLane:F53OSCPriorityLaneHigh], 10);
+    XCTAssertEqual([scheduler pendingCountForLane:F53OSCPriorityLaneBulk], 0);
+
+    // Now every pending message outranks new normal and bulk messages, so those are dropped on arrival.
+    [self sendCount:2 toAddress:@"/normal" scheduler:scheduler];
+    [self sendCount:1 toAddress:@"/bulk" scheduler:scheduler];
+    XCTAssertEqual([scheduler shedCountForLane:F53OSCPriorityLaneNormal], 2);
+    XCTAssertEqual([scheduler shedCountForLane:F53OSCPriorityLaneBulk], 12);
+    XCTAssertEqual([scheduler shedCountForLane:F53OSCPriorityLaneHigh], 0);
+    XCTAssertEqual(scheduler.shedCount, 14);
+    XCTAssertEqual(scheduler.pendingCount, 10);
+
+    dispatch_resume(queue);
+    [self drainScheduler:scheduler queue:queue];
+
+    XCTAssertEqual(destination.messages.count, 10);
+    for (F53OSCMessage *message in destination.messages)
+        XCTAssertEqualObjects(message.addressPattern, @"/high");
+}
+
+
+#pragma mark - Performance tests
+
+- (void)testThat_priorityMessageLatencyStaysLowUnderFlood
+{
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.PriorityTests", DISPATCH_QUEUE_SERIAL);
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] initWithDeliveryQueue:queue];
+    PriorityTestDestination *destination = [[PriorityTestDestination alloc] init];
+    scheduler.destination = destination;
+    [scheduler assignLane:F53OSCPriorityLaneBulk toAddressesWithPrefix:@"/meter"];
+    [scheduler assignLane:F53OSCPriorityLaneHigh toAddress:@"/cue/go"];
+
+    NSUInteger floodCount = 100000;
+    dispatch_suspend(queue);
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    [self sendCount:floodCount toAddress:@"/meter/1" scheduler:scheduler];
+    [scheduler takeMessage:[F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[]]];
+    NSTimeInterval enqueueTime = [NSDate timeIntervalSinceReferenceDate] - start;
+    dispatch_resume(queue);
+
+    [self drainScheduler:scheduler queue:queue];
+    NSTimeInterval totalTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSUInteger cueIndex = [[self addressesOfMessages:destination.messages] indexOfObject:@"/cue/go"];
+    NSLog(@"Scheduled %lu messages in %.4f s, delivered in %.4f s; cue trigger delivered at position %lu",
+          (unsigned long)(floodCount + 1), enqueueTime, totalTime, (unsigned long)cueIndex);
+
+    XCTAssertEqual(destination.messages.count, floodCount + 1);
+    XCTAssertEqual(cueIndex, 0, @"The cue trigger should not wait behind the meter flood");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,211 @@
+//
+//  F53OSC_RateLimiterTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCRateLimiter.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface F53OSC_RateLimiterTests : XCTestCase
+@end
+
+@implementation F53OSC_RateLimiterTests
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_rateLimiterHasCorrectDefaults
+{
+    F53OSCRateLimiter *limiter = [[F53OSCRateLimiter alloc] init];
+
+    XCTAssertEqual(limiter.packetsPerSecond, 0);
+    XCTAssertEqual(limiter.packetBurst, 0);
+    XCTAssertEqual(limiter.bytesPerSecond, 0);
+    XCTAssertEqual(limiter.byteBurst, 0);
+    XCTAssertEqual(limiter.maxPeerCount, 1024);
+    XCTAssertEqual(limiter.totalDroppedPackets, 0);
+    XCTAssertEqual(limiter.totalDroppedBytes, 0);
+    XCTAssertEqual(limiter.droppedPacketCountsByPeer.count, 0);
+}
+
+- (void)testThat_rateLimiterWithoutLimitsAdmitsEverything
+{
+    F53OSCRateLimiter *limiter = [[F53OSCRateLimiter alloc] init];
+
+    for (NSUInteger i = 0; i < 10000; i++)
+        XCTAssertTrue([limiter admitPacketOfLength:1500 fromPeer:@"10.0.0.1:53000" atTime:0]);
+
+    XCTAssertEqual(limiter.totalDroppedPackets, 0);
+}
+
+
+#pragma mark - Token bucket tests
+
+- (void)testThat_rateLimiterEnforcesPacketBurstAndRate
+{
+    F53OSCRateLimiter *limiter = [[F53OSCRateLimiter alloc] init];
+    limiter.packetsPerSecond = 10;
+    limiter.packetBurst = 5;
+
+    NSString *peer = @"10.0.0.1:53000";
+    for (NSUInteger i = 0; i < 5; i++)
+        XCTAssertTrue([limiter admitPacketOfLength:32 fromPeer:peer atTime:100.0], @"A full bucket should admit a burst");
+    XCTAssertFalse([limiter admitPacketOfLength:32 fromPeer:peer atTime:100.0], @"An empty bucket should drop");
+
+    // 10 packets per second refills one token every 0.1 seconds.
+    XCTAssertTrue([limiter admitPacketOfLength:32 fromPeer:peer atTime:100.1]);
+    XCTAssertFalse([limiter admitPacketOfLength:32 fromPeer:peer atTime:100.1]);
+
+    // Refill never exceeds the burst size.
+    for (NSUInteger i = 0; i < 5; i++)
+        XCTAssertTrue([limiter admitPacketOfLength:32 fromPeer:peer atTime:200.0]);
+    XCTAssertFalse([limiter admitPacketOfLength:32 fromPeer:peer atTime:200.0]);
+
+    XCTAssertEqual(limiter.totalDroppedPackets, 3);
+    XCTAssertEqual(limiter.totalDroppedBytes, 3 * 32);
+}
+
+- (void)testThat_rateLimiterEnforcesByteRate
+{
+    F53OSCRateLimiter *limiter = [[F53OSCRateLimiter alloc] init];
+    limiter.bytesPerSecond = 1000; // burst defaults to one second's worth
+
+    NSString *peer = @"10.0.0.1:53000";
+    XCTAssertTrue([limiter admitPacketOfLength:600 fromPeer:peer atTime:0]);
+    XCTAssertFalse([limiter admitPacketOfLength:600 fromPeer:peer atTime:0], @"Not enough byte tokens should drop");
+    XCTAssertTrue([limiter admitPacketOfLength:400 fromPeer:peer atTime:0], @"A smaller packet that fits should still be admitted");
+    XCTAssertTrue([limiter admitPacketOfLength:600 fromPeer:peer atTime:0.6]);
+
+    XCTAssertEqualObjects(limiter.droppedByteCountsByPeer[peer], @600);
+}
+
+- (void)testThat_rateLimiterTracksPeersSeparately
+{
+    F53OSCRateLimiter *limiter = [[F53OSCRateLimiter alloc] init];
+    limiter.packetsPerSecond = 1;
+
+    NSString *noisyPeer = @"10.0.0.1:53000";
+    NSString *quietPeer = @"10.0.0.2:53000";
+
+    for (NSUInteger i = 0; i < 100; i++)
+        [limiter admitPacketOfLength:32 fromPeer:noisyPeer atTime:0];
+    XCTAssertTrue([limiter admitPacketOfLength:32 fromPeer:quietPeer atTime:0], @"One peer's flood should not affect another peer");
+
+    NSDictionary<NSString *, NSNumber *> *drops = limiter.droppedPacketCountsByPeer;
+    XCTAssertEqualObjects(drops[noisyPeer], @99);
+    XCTAssertEqualObjects(drops[quietPeer], @0);
+
+    [limiter resetPeer:noisyPeer];
+    XCTAssertNil(limiter.droppedPacketCountsByPeer[noisyPeer]);
+    XCTAssertTrue([limiter admitPacketOfLength:32 fromPeer:noisyPeer atTime:0], @"A reset peer should start with a full bucket");
+
+    [limiter reset];
+    XCTAssertEqual(limiter.droppedPacketCountsByPeer.count, 0);
+    XCTAssertEqual(limiter.totalDroppedPackets, 0);
+}
+
+- (void)testThat_rateLimiterForgetsIdlePeersBeyondMaxPeerCount
+{
+    F53OSCRateLimiter *limiter = [[F53OSCRateLimiter alloc] init];
+    limiter.packetsPerSecond = 1;
+    limiter.maxPeerCount = 10;
+
+    for (NSUInteger i = 0; i < 10; i++)
+    {
+        NSString *peer = [NSString stringWithFormat:@"10.0.0.%lu:53000", (unsigned long)i];
+        [limiter admitPacketOfLength:32 fromPeer:peer atTime:0];
+        [limiter admitPacketOfLength:32 fromPeer:peer atTime:0]; // dropped
+    }
+    XCTAssertEqual(limiter.droppedPacketCountsByPeer.count, 10);
+
+    [limiter admitPacketOfLength:32 fromPeer:@"10.0.1.1:53000" atTime:60.0];
+
+    XCTAssertEqual(limiter.droppedPacketCountsByPeer.count, 1, @"Idle peers should be forgotten once the table is full");
+    XCTAssertEqual(limiter.totalDroppedPackets, 10, @"Drops of forgotten peers should still count toward the total");
+}
+
+- (void)testThat_rateLimiterCapsPeersDuringAFlood
+{
+    F53OSCRateLimiter *limiter = [[F53OSCRateLimiter alloc] init];
+    limiter.packetsPerSecond = 1;
+    limiter.maxPeerCount = 10;
+
+    // Every peer is active, so none can be forgotten to make room.
+    NSUInteger peerCount = 10000;
+    for (NSUInteger i = 0; i < peerCount; i++)
+    {
+        NSString *peer = [NSString stringWithFormat:@"10.%lu.%lu.%lu:53000", (unsigned long)(i >> 16), (unsigned long)((i >> 8) & 0xff), (unsigned long)(i & 0xff)];
+        [limiter admitPacketOfLength:32 fromPeer:peer atTime:5.0];
+    }
+
+    XCTAssertEqual(limiter.droppedPacketCountsByPeer.count, 10, @"The peer table should not grow past maxPeerCount");
+    XCTAssertEqual(limiter.totalDroppedPackets, peerCount - 10 - 1, @"Peers beyond maxPeerCount should share one bucket");
+    XCTAssertTrue([limiter admitPacketOfLength:32 fromPeer:@"10.0.0.1:53000" atTime:6.0], @"Peers with their own buckets should be unaffected");
+
+    [limiter reset];
+    XCTAssertEqual(limiter.totalDroppedPackets, 0);
+}
+
+- (void)testThat_rateLimiterAdmissionPerformance
+{
+    F53OSCRateLimiter *limiter = [[F53OSCRateLimiter alloc] init];
+    limiter.packetsPerSecond = 1000;
+    limiter.bytesPerSecond = 1000000;
+
+    NSMutableArray<NSString *> *peers = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 64; i++)
+        [peers addObject:[NSString stringWithFormat:@"10.0.0.%lu:53000", (unsigned long)i]];
+
+    NSUInteger iterations = 1000000;
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < iterations; i++)
+        [limiter admitPacketOfLength:64 fromPeer:peers[i % peers.count]];
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSLog(@"%lu admission checks in %.4f s (%.0f per second)", (unsigned long)iterations, elapsed, iterations / MAX(elapsed, 0.000001));
+    XCTAssertGreaterThan(limiter.totalDroppedPackets, 0);
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
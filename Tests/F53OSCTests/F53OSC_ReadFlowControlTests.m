@@ -0,0 +1,319 @@
+//
+//  F53OSC_ReadFlowControlTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#if !__has_feature(objc_arc)
+#error This file must be compiled with ARC. Use -fobjc-arc flag (or convert project to ARC).
+#endif
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCReadFlowControl.h"
+#import "F53OSCConflationBuffer.h"
+#import "F53OSCMessage.h"
+#import "F53OSCSocket.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - FlowControlTestDestination
+
+@interface FlowControlTestDestination : NSObject <F53OSCPacketDestination>
+@property (strong) NSMutableArray<F53OSCMessage *> *messages;
+@property (strong) NSMutableArray<F53OSCMessage *> *droppedMessages;
+@end
+
+@implementation FlowControlTestDestination
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+    {
+        self.messages = [NSMutableArray array];
+        self.droppedMessages = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (message)
+        [self.messages addObject:message];
+}
+
+- (void)didDropMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    [self.droppedMessages addObjectsFromArray:messages];
+}
+
+@end
+
+
+#pragma mark - F53OSC_ReadFlowControlTests
+
+@interface F53OSC_ReadFlowControlTests : XCTestCase
+@end
+
+@implementation F53OSC_ReadFlowControlTests
+
+- (F53OSCSocket *)tcpSocket
+{
+    GCDAsyncSocket *rawSocket = [[GCDAsyncSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    return [F53OSCSocket socketWithTcpSocket:rawSocket];
+}
+
+- (NSArray<F53OSCMessage *> *)messagesWithCount:(NSUInteger)count address:(NSString *)address replySocket:(F53OSCSocket *)socket
+{
+    NSMutableArray<F53OSCMessage *> *messages = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++)
+        [messages addObject:[F53OSCMessage messageWithAddressPattern:address arguments:@[@(i)] replySocket:socket]];
+    return messages;
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_readFlowControlHasCorrectDefaults
+{
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+
+    XCTAssertEqual(flowControl.highWaterMark, 1024);
+    XCTAssertEqual(flowControl.lowWaterMark, 256);
+    XCTAssertEqual(flowControl.outstandingMessageCount, 0);
+    XCTAssertEqual(flowControl.peakOutstandingMessageCount, 0);
+    XCTAssertEqual(flowControl.pausedConnectionCount, 0);
+    XCTAssertEqual(flowControl.pauseCount, 0);
+    XCTAssertEqual(flowControl.totalPausedTime, 0);
+}
+
+
+#pragma mark - Counting tests
+
+- (void)testThat_readFlowControlCountsMessagesBetweenInletAndOutlet
+{
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+    FlowControlTestDestination *destination = [[FlowControlTestDestination alloc] init];
+    F53OSCSocket *socket = [self tcpSocket];
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:10 address:@"/count" replySocket:socket];
+
+    // Stand in for an asynchronous stage by holding messages between inlet and outlet.
+    id<F53OSCPacketDestination> inlet = [flowControl inletForOwner:self toDestination:nil];
+    for (F53OSCMessage *message in messages)
+        [inlet takeMessage:message];
+
+    XCTAssertEqual([flowControl outstandingMessageCountForSocket:socket], 10);
+    XCTAssertEqual(flowControl.outstandingMessageCount, 10);
+
+    id<F53OSCPacketDestination> outlet = [flowControl outletForOwner:self toDestination:destination];
+    for (NSUInteger i = 0; i < 4; i++)
+        [outlet takeMessage:messages[i]];
+
+    XCTAssertEqual(destination.messages.count, 4, @"The outlet should pass messages on to its destination");
+    XCTAssertEqual([flowControl outstandingMessageCountForSocket:socket], 6);
+    XCTAssertEqual(flowControl.peakOutstandingMessageCount, 10);
+    XCTAssertIdenticalObjects(outlet, [flowControl outletForOwner:self toDestination:destination], @"Taps should be reused between reads");
+}
+
+- (void)testThat_readFlowControlKeepsOwnersTapsApart
+{
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+    NSObject *firstOwner = [[NSObject alloc] init];
+    NSObject *secondOwner = [[NSObject alloc] init];
+    FlowControlTestDestination *firstDestination = [[FlowControlTestDestination alloc] init];
+    FlowControlTestDestination *secondDestination = [[FlowControlTestDestination alloc] init];
+    F53OSCSocket *firstSocket = [self tcpSocket];
+    F53OSCSocket *secondSocket = [self tcpSocket];
+
+    id<F53OSCPacketDestination> firstInlet = [flowControl inletForOwner:firstOwner toDestination:nil];
+    id<F53OSCPacketDestination> firstOutlet = [flowControl outletForOwner:firstOwner toDestination:firstDestination];
+    NSArray<F53OSCMessage *> *firstMessages = [self messagesWithCount:3 address:@"/first" replySocket:firstSocket];
+    for (F53OSCMessage *message in firstMessages)
+        [firstInlet takeMessage:message];
+
+    // The second owner reads while the first owner's messages are still queued.
+    id<F53OSCPacketDestination> secondInlet = [flowControl inletForOwner:secondOwner toDestination:nil];
+    id<F53OSCPacketDestination> secondOutlet = [flowControl outletForOwner:secondOwner toDestination:secondDestination];
+    XCTAssertNotEqual(firstInlet, secondInlet);
+    XCTAssertNotEqual(firstOutlet, secondOutlet);
+    [secondInlet takeMessage:[F53OSCMessage messageWithAddressPattern:@"/second" arguments:@[] replySocket:secondSocket]];
+    XCTAssertEqual(flowControl.outstandingMessageCount, 4, @"Owners sharing a flow control should share its counts");
+
+    for (F53OSCMessage *message in firstMessages)
+        [firstOutlet takeMessage:message];
+
+    XCTAssertEqual(firstDestination.messages.count, 3, @"Queued messages should reach the owner that read them");
+    XCTAssertEqual(secondDestination.messages.count, 0);
+    XCTAssertEqual([flowControl outstandingMessageCountForSocket:firstSocket], 0);
+    XCTAssertEqual([flowControl outstandingMessageCountForSocket:secondSocket], 1);
+}
+
+- (void)testThat_readFlowControlIgnoresUdpMessages
+{
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+    GCDAsyncUdpSocket *rawSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    F53OSCSocket *udpSocket = [F53OSCSocket socketWithUdpSocket:rawSocket];
+
+    id<F53OSCPacketDestination> inlet = [flowControl inletForOwner:self toDestination:nil];
+    for (F53OSCMessage *message in [self messagesWithCount:5 address:@"/udp" replySocket:udpSocket])
+        [inlet takeMessage:message];
+    [inlet takeMessage:[F53OSCMessage messageWithAddressPattern:@"/local" arguments:@[]]];
+
+    XCTAssertEqual(flowControl.outstandingMessageCount, 0, @"Only TCP connections can be paused, so only they are counted");
+}
+
+- (void)testThat_readFlowControlCountsDroppedMessagesAsDelivered
+{
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+    FlowControlTestDestination *destination = [[FlowControlTestDestination alloc] init];
+    F53OSCSocket *socket = [self tcpSocket];
+
+    dispatch_queue_t queue = dispatch_queue_create("com.figure53.F53OSC.FlowControlTests", DISPATCH_QUEUE_SERIAL);
+    F53OSCConflationBuffer *conflation = [[F53OSCConflationBuffer alloc] initWithDeliveryQueue:queue];
+    [conflation conflateAddress:@"/level" keyArgumentCount:0];
+    conflation.destination = [flowControl outletForOwner:self toDestination:destination];
+    id<F53OSCPacketDestination> inlet = [flowControl inletForOwner:self toDestination:conflation];
+
+    dispatch_suspend(queue);
+    for (F53OSCMessage *message in [self messagesWithCount:50 address:@"/level" replySocket:socket])
+        [inlet takeMessage:message];
+
+    XCTAssertEqual([flowControl outstandingMessageCountForSocket:socket], 1, @"Replaced values should no longer count as outstanding");
+    XCTAssertEqual(destination.droppedMessages.count, 49, @"Dropped messages should be passed on to the destination");
+
+    dispatch_resume(queue);
+    dispatch_sync(queue, ^{});
+
+    XCTAssertEqual(destination.messages.count, 1);
+    XCTAssertEqual([flowControl outstandingMessageCountForSocket:socket], 0);
+}
+
+
+#pragma mark - Pause tests
+
+- (void)testThat_readFlowControlPausesAtHighWaterMarkAndResumesAtLowWaterMark
+{
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+    flowControl.highWaterMark = 20;
+    flowControl.lowWaterMark = 5;
+    F53OSCSocket *socket = [self tcpSocket];
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:25 address:@"/pause" replySocket:socket];
+
+    id<F53OSCPacketDestination> inlet = [flowControl inletForOwner:self toDestination:nil];
+    id<F53OSCPacketDestination> outlet = [flowControl outletForOwner:self toDestination:nil];
+    __block NSUInteger resumeCount = 0;
+    dispatch_block_t resumeHandler = ^{
+        resumeCount++;
+    };
+
+    for (NSUInteger i = 0; i < 19; i++)
+        [inlet takeMessage:messages[i]];
+    XCTAssertFalse([flowControl shouldPauseReadsFromSocket:socket resumeHandler:resumeHandler], @"Reads should continue below the high water mark");
+
+    for (NSUInteger i = 19; i < 25; i++)
+        [inlet takeMessage:messages[i]];
+    XCTAssertTrue([flowControl shouldPauseReadsFromSocket:socket resumeHandler:resumeHandler]);
+    XCTAssertTrue([flowControl isPausingReadsFromSocket:socket]);
+    XCTAssertEqual(flowControl.pausedConnectionCount, 1);
+    XCTAssertEqual(flowControl.pauseCount, 1);
+
+    // Dropping below the high water mark is not enough to resume.
+    for (NSUInteger i = 0; i < 19; i++)
+        [outlet takeMessage:messages[i]];
+    XCTAssertEqual([flowControl outstandingMessageCountForSocket:socket], 6);
+    XCTAssertEqual(resumeCount, 0);
+
+    [outlet takeMessage:messages[19]];
+    XCTAssertEqual(resumeCount, 1, @"Reads should resume at the low water mark");
+    XCTAssertFalse([flowControl isPausingReadsFromSocket:socket]);
+    XCTAssertEqual(flowControl.pausedConnectionCount, 0);
+    XCTAssertGreaterThanOrEqual(flowControl.totalPausedTime, 0);
+
+    for (NSUInteger i = 20; i < 25; i++)
+        [outlet takeMessage:messages[i]];
+    XCTAssertEqual(resumeCount, 1, @"The resume handler should run only once per pause");
+    XCTAssertEqual(flowControl.outstandingMessageCount, 0);
+}
+
+- (void)testThat_readFlowControlWithZeroHighWaterMarkNeverPauses
+{
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+    flowControl.highWaterMark = 0;
+    F53OSCSocket *socket = [self tcpSocket];
+
+    id<F53OSCPacketDestination> inlet = [flowControl inletForOwner:self toDestination:nil];
+    for (F53OSCMessage *message in [self messagesWithCount:5000 address:@"/flood" replySocket:socket])
+        [inlet takeMessage:message];
+
+    XCTAssertFalse([flowControl shouldPauseReadsFromSocket:socket resumeHandler:^{}]);
+    XCTAssertEqual(flowControl.outstandingMessageCount, 5000, @"Messages should still be counted for metrics");
+}
+
+- (void)testThat_readFlowControlForgetsRemovedSockets
+{
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+    flowControl.highWaterMark = 2;
+    flowControl.lowWaterMark = 0;
+    F53OSCSocket *socket = [self tcpSocket];
+    F53OSCSocket *otherSocket = [self tcpSocket];
+    NSArray<F53OSCMessage *> *messages = [self messagesWithCount:3 address:@"/gone" replySocket:socket];
+
+    id<F53OSCPacketDestination> inlet = [flowControl inletForOwner:self toDestination:nil];
+    id<F53OSCPacketDestination> outlet = [flowControl outletForOwner:self toDestination:nil];
+    for (F53OSCMessage *message in messages)
+        [inlet takeMessage:message];
+    [inlet takeMessage:[F53OSCMessage messageWithAddressPattern:@"/other" arguments:@[] replySocket:otherSocket]];
+
+    __block BOOL resumed = NO;
+    XCTAssertTrue([flowControl shouldPauseReadsFromSocket:socket resumeHandler:^{
+        resumed = YES;
+    }]);
+    XCTAssertFalse([flowControl shouldPauseReadsFromSocket:otherSocket resumeHandler:^{}], @"Connections should be paused independently");
+
+    [flowControl removeSocket:socket];
+    XCTAssertEqual(flowControl.pausedConnectionCount, 0);
+    XCTAssertEqual(flowControl.outstandingMessageCount, 1);
+
+    for (F53OSCMessage *message in messages)
+        [outlet takeMessage:message];
+    XCTAssertFalse(resumed, @"A closed connection should not be resumed");
+    XCTAssertEqual(flowControl.outstandingMessageCount, 1, @"Late deliveries from a removed connection should be ignored");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
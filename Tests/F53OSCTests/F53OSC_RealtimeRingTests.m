@@ -0,0 +1,367 @@
+//
+//  F53OSC_RealtimeRingTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCBundle.h"
+#import "F53OSCClient.h"
+#import "F53OSCMessage.h"
+#import "F53OSCRealtimeRing.h"
+#import "F53OSCServer.h"
+#import "F53OSCTimeTag.h"
+#import "F53OSCValue.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define PORT_BASE   10000
+
+#define STRESS_PRODUCERS                4
+#define STRESS_RECORDS_PER_PRODUCER     200000
+
+#pragma mark - F53OSC_RealtimeRingTests
+
+@interface F53OSC_RealtimeRingTests : XCTestCase
+@end
+
+@implementation F53OSC_RealtimeRingTests
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_realtimeRingHasCorrectDefaults
+{
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] init];
+
+    XCTAssertEqual(ring.capacity, 1024);
+    XCTAssertEqual(ring.producerMode, F53OSCRealtimeRingMultipleProducers);
+    XCTAssertEqual(ring.maxAddressCount, 256);
+    XCTAssertTrue(ring.ringRef != NULL);
+    XCTAssertEqual(ring.addressCount, 0);
+    XCTAssertEqual(ring.count, 0);
+    XCTAssertEqual(ring.pushedCount, 0);
+    XCTAssertEqual(ring.poppedCount, 0);
+    XCTAssertEqual(ring.overflowCount, 0);
+    XCTAssertEqual(ring.unregisteredCount, 0);
+    XCTAssertEqual(ring.unsupportedCount, 0);
+
+    F53OSCRealtimeRing *oddRing = [[F53OSCRealtimeRing alloc] initWithCapacity:100 producerMode:F53OSCRealtimeRingSingleProducer maxAddressCount:4];
+    XCTAssertEqual(oddRing.capacity, 128, @"Capacity should round up to a power of two");
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    XCTAssertNil(server.realtimeRing);
+}
+
+
+#pragma mark - Address tests
+
+- (void)testThat_realtimeRingRegistersAddresses
+{
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] initWithCapacity:16 producerMode:F53OSCRealtimeRingSingleProducer maxAddressCount:3];
+
+    uint32_t gainID = [ring registerAddress:@"/mixer/gain"];
+    uint32_t panID = [ring registerAddress:@"/mixer/pan"];
+    XCTAssertNotEqual(gainID, 0);
+    XCTAssertNotEqual(panID, 0);
+    XCTAssertNotEqual(gainID, panID);
+    XCTAssertEqual([ring registerAddress:@"/mixer/gain"], gainID, @"Registering an address again should return its existing ID");
+
+    XCTAssertEqualObjects([ring addressForID:gainID], @"/mixer/gain");
+    XCTAssertEqualObjects([ring addressForID:panID], @"/mixer/pan");
+    XCTAssertNil([ring addressForID:0]);
+    XCTAssertNil([ring addressForID:99]);
+
+    XCTAssertEqual(F53OSCRealtimeRingAddressID(ring.ringRef, "/mixer/pan", strlen("/mixer/pan")), panID);
+    XCTAssertEqual(F53OSCRealtimeRingAddressID(ring.ringRef, "/mixer/pa", strlen("/mixer/pa")), 0);
+
+    XCTAssertNotEqual([ring registerAddress:@"/mixer/mute"], 0);
+    XCTAssertEqual([ring registerAddress:@"/mixer/solo"], 0, @"Registration should fail once maxAddressCount addresses are registered");
+    XCTAssertEqual(ring.addressCount, 3);
+}
+
+
+#pragma mark - Push and pop tests
+
+- (void)testThat_realtimeRingCarriesEveryArgumentTypeFromPacketBytes
+{
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] initWithCapacity:16 producerMode:F53OSCRealtimeRingSingleProducer maxAddressCount:4];
+    uint32_t addressID = [ring registerAddress:@"/cue/go"];
+
+    char blobBytes[] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+    NSData *blob = [NSData dataWithBytes:blobBytes length:sizeof(blobBytes)];
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[@42, @0.5f, @"hello", blob, [F53OSCValue oscTrue]]];
+    NSData *packet = [message packetData];
+
+    XCTAssertEqual(F53OSCRealtimeRingPushPacket(ring.ringRef, packet.bytes, packet.length, 12.5), F53OSCRealtimeRingPushed);
+    XCTAssertEqual(ring.count, 1);
+
+    F53OSCRealtimeRecord record;
+    XCTAssertTrue(F53OSCRealtimeRingPop(ring.ringRef, &record));
+    XCTAssertFalse(F53OSCRealtimeRingPop(ring.ringRef, &record), @"The ring should be empty");
+
+    XCTAssertEqual(record.addressID, addressID);
+    XCTAssertEqual(record.argumentCount, 5);
+    XCTAssertEqual(strcmp(record.typeTags, "ifsbT"), 0);
+    XCTAssertEqual(record.timeTag, 1, @"A message on its own should be tagged immediately");
+    XCTAssertEqual(record.receivedTimestamp, 12.5);
+    XCTAssertEqual(record.arguments[0].i, 42);
+    XCTAssertEqual(record.arguments[1].f, 0.5f);
+
+    uint32_t length = 0;
+    const char *string = F53OSCRealtimeRecordBytes(&record, 2, &length);
+    XCTAssertEqual(length, 5);
+    XCTAssertEqual(strcmp(string, "hello"), 0);
+
+    const void *blobData = F53OSCRealtimeRecordBytes(&record, 3, &length);
+    XCTAssertEqual(length, sizeof(blobBytes));
+    XCTAssertEqual(memcmp(blobData, blobBytes, sizeof(blobBytes)), 0);
+
+    XCTAssertTrue(F53OSCRealtimeRecordBytes(&record, 0, NULL) == NULL, @"An int argument has no bytes");
+    XCTAssertEqual(ring.pushedCount, 1);
+    XCTAssertEqual(ring.poppedCount, 1);
+}
+
+- (void)testThat_realtimeRingCarriesBundleTimeTags
+{
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] initWithCapacity:16 producerMode:F53OSCRealtimeRingSingleProducer maxAddressCount:4];
+    uint32_t aID = [ring registerAddress:@"/a"];
+    uint32_t bID = [ring registerAddress:@"/b"];
+
+    F53OSCTimeTag *timeTag = [[F53OSCTimeTag alloc] init];
+    timeTag.seconds = 1000;
+    timeTag.fraction = 7;
+    F53OSCBundle *inner = [F53OSCBundle bundleWithTimeTag:timeTag elements:@[[[F53OSCMessage messageWithAddressPattern:@"/b" arguments:@[@2]] packetData]]];
+    F53OSCBundle *outer = [F53OSCBundle bundleWithTimeTag:timeTag elements:@[[[F53OSCMessage messageWithAddressPattern:@"/a" arguments:@[@1]] packetData],
+                                                                             [inner packetData]]];
+    NSData *packet = [outer packetData];
+    XCTAssertEqual(F53OSCRealtimeRingPushPacket(ring.ringRef, packet.bytes, packet.length, 0), F53OSCRealtimeRingPushed);
+
+    F53OSCRealtimeRecord record;
+    XCTAssertTrue(F53OSCRealtimeRingPop(ring.ringRef, &record));
+    XCTAssertEqual(record.addressID, aID);
+    XCTAssertEqual(record.arguments[0].i, 1);
+    XCTAssertEqual(record.timeTag, ((uint64_t)1000 << 32) | 7);
+    XCTAssertTrue(F53OSCRealtimeRingPop(ring.ringRef, &record));
+    XCTAssertEqual(record.addressID, bID);
+    XCTAssertEqual(record.arguments[0].i, 2);
+
+    // The same messages pushed as objects, as a parser delivers them.
+    [ring takeBundleMessages:@[[F53OSCMessage messageWithAddressPattern:@"/a" arguments:@[@3]]] timeTag:timeTag];
+    XCTAssertTrue(F53OSCRealtimeRingPop(ring.ringRef, &record));
+    XCTAssertEqual(record.addressID, aID);
+    XCTAssertEqual(record.arguments[0].i, 3);
+    XCTAssertEqual(record.timeTag, ((uint64_t)1000 << 32) | 7);
+}
+
+- (void)testThat_realtimeRingSkipsPacketsItCanNotCarry
+{
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] initWithCapacity:16 producerMode:F53OSCRealtimeRingSingleProducer maxAddressCount:4];
+    [ring registerAddress:@"/known"];
+
+    // A bundle with one unregistered message is skipped whole.
+    F53OSCBundle *bundle = [F53OSCBundle bundleWithTimeTag:[F53OSCTimeTag immediateTimeTag]
+                                                  elements:@[[[F53OSCMessage messageWithAddressPattern:@"/known" arguments:@[@1]] packetData],
+                                                             [[F53OSCMessage messageWithAddressPattern:@"/unknown" arguments:@[@1]] packetData]]];
+    NSData *packet = [bundle packetData];
+    XCTAssertEqual(F53OSCRealtimeRingPushPacket(ring.ringRef, packet.bytes, packet.length, 0), F53OSCRealtimeRingPushSkipped);
+    XCTAssertEqual(ring.unregisteredCount, 1);
+
+    NSString *longString = [@"" stringByPaddingToLength:F53OSC_REALTIME_INLINE_BYTES withString:@"x" startingAtIndex:0];
+    packet = [[F53OSCMessage messageWithAddressPattern:@"/known" arguments:@[longString]] packetData];
+    XCTAssertEqual(F53OSCRealtimeRingPushPacket(ring.ringRef, packet.bytes, packet.length, 0), F53OSCRealtimeRingPushSkipped);
+    XCTAssertEqual(ring.unsupportedCount, 1, @"A string that does not fit inline should be unsupported");
+
+    XCTAssertFalse([ring pushMessage:[F53OSCMessage messageWithAddressPattern:@"/known" arguments:@[longString]]]);
+    XCTAssertEqual(ring.unsupportedCount, 2);
+
+    packet = [[F53OSCMessage messageWithAddressPattern:@"/known" arguments:@[@"abc"]] packetData];
+    XCTAssertEqual(F53OSCRealtimeRingPushPacket(ring.ringRef, packet.bytes, packet.length - 4, 0), F53OSCRealtimeRingPushMalformed, @"A truncated string argument should be malformed");
+
+    XCTAssertEqual(ring.pushedCount, 0);
+    XCTAssertEqual(ring.count, 0);
+}
+
+- (void)testThat_realtimeRingCountsOverflow
+{
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] initWithCapacity:4 producerMode:F53OSCRealtimeRingSingleProducer maxAddressCount:4];
+    [ring registerAddress:@"/level"];
+
+    for (int i = 0; i < 6; i++)
+        [ring pushMessage:[F53OSCMessage messageWithAddressPattern:@"/level" arguments:@[@(i)]]];
+
+    XCTAssertEqual(ring.pushedCount, 4);
+    XCTAssertEqual(ring.overflowCount, 2);
+    XCTAssertEqual(ring.count, 4);
+
+    F53OSCRealtimeRecord record;
+    for (int i = 0; i < 4; i++)
+    {
+        XCTAssertTrue(F53OSCRealtimeRingPop(ring.ringRef, &record));
+        XCTAssertEqual(record.arguments[0].i, i, @"The oldest records should be kept and the newest dropped");
+    }
+
+    // Slots are reusable once popped.
+    XCTAssertTrue([ring pushMessage:[F53OSCMessage messageWithAddressPattern:@"/level" arguments:@[@6]]]);
+    XCTAssertTrue(F53OSCRealtimeRingPop(ring.ringRef, &record));
+    XCTAssertEqual(record.arguments[0].i, 6);
+}
+
+- (void)testThat_realtimeRingSurvivesConcurrentProducers
+{
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] initWithCapacity:64 producerMode:F53OSCRealtimeRingMultipleProducers maxAddressCount:STRESS_PRODUCERS];
+    uint32_t addressIDs[STRESS_PRODUCERS];
+    for (int p = 0; p < STRESS_PRODUCERS; p++)
+        addressIDs[p] = [ring registerAddress:[NSString stringWithFormat:@"/producer/%d", p]];
+    const uint32_t *producerIDs = addressIDs; // blocks can not capture arrays
+    F53OSCRealtimeRingRef ringRef = ring.ringRef;
+    const NSUInteger attemptedRecords = STRESS_PRODUCERS * STRESS_RECORDS_PER_PRODUCER;
+
+    __block NSUInteger poppedRecords = 0;
+    __block NSUInteger orderViolations = 0;
+    __block NSUInteger unknownRecords = 0;
+
+    // The consumer pops on its own thread, as an audio thread would, and checks that each producer's records arrive
+    // in order. Every attempted push is either popped eventually or counted as overflow, so it knows when to stop.
+    NSThread *consumer = [[NSThread alloc] initWithBlock:^{
+        int32_t lastValues[STRESS_PRODUCERS];
+        for (int p = 0; p < STRESS_PRODUCERS; p++)
+            lastValues[p] = -1;
+
+        F53OSCRealtimeRecord record;
+        while (poppedRecords + ring.overflowCount < attemptedRecords)
+        {
+            if (!F53OSCRealtimeRingPop(ringRef, &record))
+                continue;
+
+            poppedRecords++;
+            int p = 0;
+            while (p < STRESS_PRODUCERS && producerIDs[p] != record.addressID)
+                p++;
+            if (p == STRESS_PRODUCERS || record.argumentCount != 1 || record.typeTags[0] != 'i')
+            {
+                unknownRecords++;
+                continue;
+            }
+            if (record.arguments[0].i <= lastValues[p])
+                orderViolations++;
+            lastValues[p] = record.arguments[0].i;
+        }
+    }];
+    XCTestExpectation *consumerExpectation = [self expectationForNotification:NSThreadWillExitNotification object:consumer handler:nil];
+
+    NSDate *start = [NSDate date];
+    [consumer start];
+
+    dispatch_apply(STRESS_PRODUCERS, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t p) {
+        F53OSCRealtimeRecord record;
+        memset(&record, 0, sizeof(record));
+        record.addressID = producerIDs[p];
+        record.argumentCount = 1;
+        record.typeTags[0] = 'i';
+        for (int32_t i = 0; i < STRESS_RECORDS_PER_PRODUCER; i++)
+        {
+            record.arguments[0].i = i;
+            F53OSCRealtimeRingPush(ringRef, &record);
+        }
+    });
+
+    [self waitForExpectations:@[consumerExpectation] timeout:30.0];
+    NSTimeInterval elapsed = [[NSDate date] timeIntervalSinceDate:start];
+
+    XCTAssertEqual(unknownRecords, 0, @"Every popped record should be one a producer pushed intact");
+    XCTAssertEqual(orderViolations, 0, @"Each producer's records should be popped in the order they were pushed");
+    XCTAssertEqual(poppedRecords, ring.poppedCount);
+    XCTAssertEqual(ring.pushedCount, ring.poppedCount);
+    XCTAssertEqual(ring.pushedCount + ring.overflowCount, attemptedRecords, @"Every attempted push should be either pushed or counted as overflow");
+    XCTAssertEqual(ring.count, 0);
+
+    NSLog(@"realtime ring: %d producers pushed %lu and dropped %lu of %lu records in %.3f s (%.0f ns per attempt)",
+          STRESS_PRODUCERS, (unsigned long)ring.pushedCount, (unsigned long)ring.overflowCount, (unsigned long)attemptedRecords,
+          elapsed, elapsed / attemptedRecords * 1000000000.0);
+}
+
+
+#pragma mark - Server tests
+
+- (void)testThat_serverDecodesUdpPacketsIntoRealtimeRing
+{
+    F53OSCRealtimeRing *ring = [[F53OSCRealtimeRing alloc] init];
+    uint32_t gainID = [ring registerAddress:@"/mixer/gain"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.port = PORT_BASE;
+    server.realtimeRing = ring;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"127.0.0.1";
+    client.port = server.port;
+    client.useTcp = NO;
+
+    [self addTeardownBlock:^{
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+
+    const NSUInteger messageCount = 10;
+    for (NSUInteger i = 0; i < messageCount; i++)
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/mixer/gain" arguments:@[@((float)i / 10.0f)]]];
+
+    NSMutableArray<NSNumber *> *gains = [NSMutableArray array];
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5.0];
+    F53OSCRealtimeRecord record;
+    while (gains.count < messageCount && [deadline timeIntervalSinceNow] > 0)
+    {
+        if (F53OSCRealtimeRingPop(ring.ringRef, &record))
+        {
+            XCTAssertEqual(record.addressID, gainID);
+            [gains addObject:@(record.arguments[0].f)];
+        }
+        else
+        {
+            [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+        }
+    }
+
+    XCTAssertEqual(gains.count, messageCount, @"Every UDP message should be decoded into the ring");
+    XCTAssertEqualWithAccuracy(gains.lastObject.floatValue, 0.9f, 0.0001f);
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,140 @@
+//
+//  F53OSC_ReceiveBufferPoolTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCReceiveBufferPool.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - F53OSC_ReceiveBufferPoolTests
+
+@interface F53OSC_ReceiveBufferPoolTests : XCTestCase
+@end
+
+@implementation F53OSC_ReceiveBufferPoolTests
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_receiveBufferPoolHasCorrectDefaults
+{
+    F53OSCReceiveBufferPool *pool = [[F53OSCReceiveBufferPool alloc] initWithBufferSize:1024 buffersPerSlab:4 maxBufferCount:10];
+
+    XCTAssertEqual(pool.bufferSize, 1024);
+    XCTAssertEqual(pool.buffersPerSlab, 4);
+    XCTAssertEqual(pool.maxBufferCount, 12, @"The maximum should round up to whole slabs");
+    XCTAssertEqual(pool.slabCount, 0, @"Slabs should not be allocated until a buffer is taken");
+    XCTAssertEqual(pool.buffersInUse, 0);
+    XCTAssertEqual(pool.takeCount, 0);
+    XCTAssertEqual(pool.exhaustedCount, 0);
+}
+
+
+#pragma mark - Pool tests
+
+- (void)testThat_receiveBufferPoolGrowsBySlabsUpToItsLimit
+{
+    F53OSCReceiveBufferPool *pool = [[F53OSCReceiveBufferPool alloc] initWithBufferSize:64 buffersPerSlab:4 maxBufferCount:8];
+
+    NSMutableSet<NSValue *> *buffers = [NSMutableSet set];
+    for (NSUInteger i = 0; i < 8; i++)
+    {
+        void *buffer = [pool takeBuffer];
+        XCTAssertTrue(buffer != NULL);
+        memset(buffer, (int)i, pool.bufferSize); // each buffer should be fully writable
+        [buffers addObject:[NSValue valueWithPointer:buffer]];
+        XCTAssertEqual(pool.slabCount, i / 4 + 1);
+    }
+    XCTAssertEqual(buffers.count, 8, @"Every buffer should be distinct");
+    XCTAssertEqual(pool.buffersInUse, 8);
+
+    XCTAssertTrue([pool takeBuffer] == NULL, @"An exhausted pool should not grow past its limit");
+    XCTAssertEqual(pool.exhaustedCount, 1);
+    XCTAssertEqual(pool.slabCount, 2);
+
+    for (NSValue *buffer in buffers)
+        [pool returnBuffer:buffer.pointerValue];
+    XCTAssertEqual(pool.buffersInUse, 0);
+    XCTAssertEqual(pool.takeCount, 8);
+}
+
+- (void)testThat_receiveBufferPoolReusesBuffersWithoutAllocating
+{
+    F53OSCReceiveBufferPool *pool = [[F53OSCReceiveBufferPool alloc] initWithBufferSize:1500 buffersPerSlab:8 maxBufferCount:32];
+
+    NSUInteger cycles = 100000;
+    for (NSUInteger i = 0; i < cycles; i++)
+    {
+        @autoreleasepool
+        {
+            void *buffer = [pool takeBuffer];
+            NSData *data = [pool dataWithBuffer:buffer length:100];
+            XCTAssertEqual(data.bytes, buffer, @"Wrapping should not copy the buffer");
+            XCTAssertEqual(pool.buffersInUse, 1);
+        }
+    }
+
+    XCTAssertEqual(pool.takeCount, cycles);
+    XCTAssertEqual(pool.slabCount, 1, @"Steady state should allocate no further slabs");
+    XCTAssertEqual(pool.buffersInUse, 0, @"Deallocated data should return its buffer");
+    NSLog(@"receive buffer pool: %lu slab mallocs for %lu buffers (%.6f per buffer)",
+          (unsigned long)pool.slabCount, (unsigned long)pool.takeCount, (double)pool.slabCount / pool.takeCount);
+}
+
+- (void)testThat_receiveBufferPoolBuffersOutliveThePool
+{
+    NSData *data = nil;
+    __weak F53OSCReceiveBufferPool *weakPool = nil;
+    @autoreleasepool
+    {
+        F53OSCReceiveBufferPool *pool = [[F53OSCReceiveBufferPool alloc] initWithBufferSize:16 buffersPerSlab:2 maxBufferCount:2];
+        weakPool = pool;
+        void *buffer = [pool takeBuffer];
+        memcpy(buffer, "outlives", 8);
+        data = [pool dataWithBuffer:buffer length:8];
+    }
+
+    XCTAssertNil(weakPool, @"Wrapped buffers should not keep the pool object alive");
+    XCTAssertEqualObjects(data, [NSData dataWithBytes:"outlives" length:8], @"Wrapped buffers should stay valid after the pool is gone");
+    data = nil; // frees the pool's memory
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,437 @@
+//
+//  F53OSC_SchemaRegistryTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import <stddef.h>
+
+#import "F53OSCBundle.h"
+#import "F53OSCClient.h"
+#import "F53OSCMessage.h"
+#import "F53OSCParser.h"
+#import "F53OSCSchemaRegistry.h"
+#import "F53OSCServer.h"
+#import "F53OSCSocket.h"
+#import "F53OSCTimeTag.h"
+#import "F53OSCValue.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define PORT_BASE   10100
+
+#define BENCHMARK_MESSAGES  100000
+
+typedef struct
+{
+    int32_t             channel;
+    float               level;
+    F53OSCSchemaBytes   name;
+    bool                muted;
+} SchemaTestFader;
+
+static const size_t SchemaTestFaderOffsets[] = {
+    offsetof( SchemaTestFader, channel ),
+    offsetof( SchemaTestFader, level ),
+    offsetof( SchemaTestFader, name ),
+    offsetof( SchemaTestFader, muted ),
+};
+
+@interface SchemaTestDestination : NSObject <F53OSCPacketDestination>
+@property (nonatomic, strong) NSMutableArray<F53OSCMessage *> *receivedMessages;
+@end
+
+@implementation SchemaTestDestination
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+        self.receivedMessages = [NSMutableArray array];
+    return self;
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if (message)
+        [self.receivedMessages addObject:message];
+}
+
+@end
+
+
+#pragma mark - F53OSC_SchemaRegistryTests
+
+@interface F53OSC_SchemaRegistryTests : XCTestCase
+@end
+
+@implementation F53OSC_SchemaRegistryTests
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_schemaRegistryHasCorrectDefaults
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+
+    XCTAssertEqual(registry.schemaCount, 0);
+    XCTAssertEqual(registry.handledCount, 0);
+    XCTAssertEqual(registry.rejectedCount, 0);
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    XCTAssertNil(server.schemaRegistry);
+}
+
+- (void)testThat_schemaRegistryRejectsInvalidSchemas
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+    F53OSCSchemaArgumentHandler handler = ^( const F53OSCWireArgument *arguments, NSUInteger count, const F53OSCSchemaContext *context ) {};
+
+    XCTAssertFalse([registry registerAddress:@"/a" signature:@"iq" handler:handler], @"An unknown type should be rejected");
+    XCTAssertFalse([registry registerAddress:@"/a" signature:@"iiiiiiiiiiiiiiiii" handler:handler], @"Too many arguments should be rejected");
+
+    size_t offsets[] = { 0, 2 };
+    XCTAssertFalse([registry registerAddress:@"/a" signature:@"ii" structSize:4 fieldOffsets:offsets
+                                     handler:^( const void *values, const F53OSCSchemaContext *context ) {}], @"A field past the end of the struct should be rejected");
+
+    XCTAssertEqual(registry.schemaCount, 0);
+
+    XCTAssertTrue([registry registerAddress:@"/a" signature:@"" handler:handler]);
+    XCTAssertTrue([registry registerAddress:@"/a" signature:@"i" handler:handler], @"Registering again should replace the schema");
+    XCTAssertTrue([registry registerAddress:@"/b/*" signature:@"i" handler:handler]);
+    XCTAssertEqual(registry.schemaCount, 2);
+
+    [registry unregisterAddress:@"/a"];
+    XCTAssertEqual(registry.schemaCount, 1);
+    [registry removeAllSchemas];
+    XCTAssertEqual(registry.schemaCount, 0);
+}
+
+
+#pragma mark - Decoding tests
+
+- (void)testThat_schemaRegistryDecodesIntoStructs
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+
+    __block SchemaTestFader fader = { 0 };
+    __block NSString *name = nil;
+    __block NSString *address = nil;
+    __block uint64_t timeTag = 0;
+    XCTAssertTrue([registry registerAddress:@"/mixer/fader" signature:@"ifsT" structSize:sizeof(SchemaTestFader) fieldOffsets:SchemaTestFaderOffsets
+                                    handler:^( const void *values, const F53OSCSchemaContext *context ) {
+        fader = *(const SchemaTestFader *)values;
+        name = [NSString stringWithUTF8String:fader.name.bytes]; // string bytes are only valid during the handler
+        address = [NSString stringWithUTF8String:context->address];
+        timeTag = context->timeTag;
+    }]);
+
+    NSData *packet = [[F53OSCMessage messageWithAddressPattern:@"/mixer/fader" arguments:@[@3, @0.75f, @"Vocals", [F53OSCValue oscFalse]]] packetData];
+    XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaHandled);
+
+    XCTAssertEqual(fader.channel, 3);
+    XCTAssertEqual(fader.level, 0.75f);
+    XCTAssertEqual(fader.name.length, 6);
+    XCTAssertEqualObjects(name, @"Vocals");
+    XCTAssertFalse(fader.muted, @"'T' in a signature should also accept an F argument");
+    XCTAssertEqualObjects(address, @"/mixer/fader");
+    XCTAssertEqual(timeTag, F53OSC_WIRE_IMMEDIATELY);
+
+    packet = [[F53OSCMessage messageWithAddressPattern:@"/mixer/fader" arguments:@[@3, @0.75f, @"Vocals", [F53OSCValue oscTrue]]] packetData];
+    XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaHandled);
+    XCTAssertTrue(fader.muted);
+
+    XCTAssertEqual(registry.handledCount, 2);
+    XCTAssertEqual([registry handledCountForAddress:@"/mixer/fader"], 2);
+}
+
+- (void)testThat_schemaRegistryPassesRawArgumentsToHandlers
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+
+    __block NSUInteger argumentCount = 0;
+    __block char types[4] = { 0 };
+    __block NSData *blob = nil;
+    XCTAssertTrue([registry registerAddress:@"/data" signature:@"bNi" handler:^( const F53OSCWireArgument *arguments, NSUInteger count, const F53OSCSchemaContext *context ) {
+        argumentCount = count;
+        for (NSUInteger i = 0; i < count; i++)
+            types[i] = arguments[i].type;
+        blob = [NSData dataWithBytes:arguments[0].value.data.bytes length:arguments[0].value.data.length];
+    }]);
+
+    char blobBytes[] = { 0x01, 0x02, 0x03 };
+    NSData *blobData = [NSData dataWithBytes:blobBytes length:sizeof(blobBytes)];
+    NSData *packet = [[F53OSCMessage messageWithAddressPattern:@"/data" arguments:@[blobData, [F53OSCValue oscNull], @9]] packetData];
+    XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaHandled);
+
+    XCTAssertEqual(argumentCount, 3);
+    XCTAssertEqual(strcmp(types, "bNi"), 0);
+    XCTAssertEqualObjects(blob, blobData);
+}
+
+- (void)testThat_schemaRegistryRejectsMismatchedMessages
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+
+    __block NSUInteger calls = 0;
+    [registry registerAddress:@"/level" signature:@"if" handler:^( const F53OSCWireArgument *arguments, NSUInteger count, const F53OSCSchemaContext *context ) {
+        calls++;
+    }];
+
+    NSData *packet = [[F53OSCMessage messageWithAddressPattern:@"/level" arguments:@[@1, @2]] packetData];
+    XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaRejected, @"Wrong type tags should be rejected");
+
+    packet = [[F53OSCMessage messageWithAddressPattern:@"/level" arguments:@[@1]] packetData];
+    XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaRejected, @"Too few arguments should be rejected");
+
+    packet = [[F53OSCMessage messageWithAddressPattern:@"/level" arguments:@[@1, @0.5f]] packetData];
+    XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length - 4 timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaRejected, @"Truncated arguments should be rejected");
+
+    packet = [[F53OSCMessage messageWithAddressPattern:@"/other" arguments:@[@1, @0.5f]] packetData];
+    XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaUnregistered);
+
+    XCTAssertEqual(calls, 0);
+    XCTAssertEqual(registry.rejectedCount, 3);
+    XCTAssertEqual([registry rejectedCountForAddress:@"/level"], 3);
+    XCTAssertEqual(registry.handledCount, 0);
+
+    [registry resetCounts];
+    XCTAssertEqual(registry.rejectedCount, 0);
+    XCTAssertEqual([registry rejectedCountForAddress:@"/level"], 0);
+}
+
+- (void)testThat_schemaRegistryMatchesPatterns
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+
+    NSMutableArray<NSString *> *handled = [NSMutableArray array];
+    F53OSCSchemaArgumentHandler handler = ^( const F53OSCWireArgument *arguments, NSUInteger count, const F53OSCSchemaContext *context ) {
+        [handled addObject:[NSString stringWithUTF8String:context->address]];
+    };
+    [registry registerAddress:@"/mixer/*/gain" signature:@"f" handler:handler];
+    [registry registerAddress:@"/cue/{go,stop}" signature:@"" handler:handler];
+    [registry registerAddress:@"/bank/[1-4]" signature:@"" handler:handler];
+
+    NSArray<NSString *> *matching = @[@"/mixer/1/gain", @"/mixer/drums/gain", @"/cue/go", @"/cue/stop", @"/bank/3"];
+    for (NSString *address in matching)
+    {
+        NSArray *arguments = [address hasSuffix:@"gain"] ? @[@0.5f] : @[];
+        NSData *packet = [[F53OSCMessage messageWithAddressPattern:address arguments:arguments] packetData];
+        XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaHandled, @"%@", address);
+    }
+
+    NSArray<NSString *> *notMatching = @[@"/mixer/1/2/gain", @"/cue/pause", @"/bank/5", @"/mixer/gain"];
+    for (NSString *address in notMatching)
+    {
+        NSData *packet = [[F53OSCMessage messageWithAddressPattern:address arguments:@[]] packetData];
+        XCTAssertEqual([registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil], F53OSCSchemaUnregistered, @"%@", address);
+    }
+
+    XCTAssertEqualObjects(handled, matching);
+    XCTAssertEqual([registry handledCountForAddress:@"/mixer/*/gain"], 2);
+}
+
+
+#pragma mark - Parser tests
+
+- (void)testThat_parserSkipsBoxingForRegisteredMessages
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+
+    __block float level = 0;
+    __block uint64_t timeTag = 0;
+    __block F53OSCSocket *replySocket = nil;
+    [registry registerAddress:@"/level" signature:@"f" handler:^( const F53OSCWireArgument *arguments, NSUInteger count, const F53OSCSchemaContext *context ) {
+        level = arguments[0].value.f;
+        timeTag = context->timeTag;
+        replySocket = context->replySocket;
+    }];
+
+    SchemaTestDestination *destination = [[SchemaTestDestination alloc] init];
+    GCDAsyncUdpSocket *rawSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    F53OSCSocket *socket = [F53OSCSocket socketWithUdpSocket:rawSocket];
+
+    F53OSCTimeTag *bundleTimeTag = [F53OSCTimeTag timeTagWithDate:[NSDate dateWithTimeIntervalSinceNow:1]];
+    F53OSCBundle *bundle = [F53OSCBundle bundleWithTimeTag:bundleTimeTag
+                                                  elements:@[[[F53OSCMessage messageWithAddressPattern:@"/level" arguments:@[@0.25f]] packetData],
+                                                             [[F53OSCMessage messageWithAddressPattern:@"/level" arguments:@[@"loud"]] packetData],
+                                                             [[F53OSCMessage messageWithAddressPattern:@"/other" arguments:@[@1]] packetData]]];
+    [F53OSCParser processOscData:[bundle packetData] forDestination:destination replyToSocket:socket controlHandler:nil wasEncrypted:NO receivedTimestamp:0 schemaRegistry:registry];
+
+    XCTAssertEqual(level, 0.25f);
+    XCTAssertEqual(timeTag, bundleTimeTag.wireValue, @"Handlers should see the enclosing bundle's time tag");
+    XCTAssertEqual(replySocket, socket);
+    XCTAssertEqual(registry.handledCount, 1);
+    XCTAssertEqual(registry.rejectedCount, 1);
+    XCTAssertEqual(destination.receivedMessages.count, 1, @"Only the unregistered message should be delivered");
+    XCTAssertEqualObjects(destination.receivedMessages.firstObject.addressPattern, @"/other");
+
+    [F53OSCParser processOscData:[[F53OSCMessage messageWithAddressPattern:@"/level" arguments:@[@0.5f]] packetData] forDestination:destination replyToSocket:socket
+                  controlHandler:nil wasEncrypted:NO receivedTimestamp:0 schemaRegistry:registry];
+    XCTAssertEqual(level, 0.5f);
+    XCTAssertEqual(destination.receivedMessages.count, 1);
+}
+
+
+#pragma mark - Server tests
+
+- (void)testThat_serverDecodesRegisteredMessages
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+    __block NSUInteger handledCount = 0;
+    __block int32_t lastChannel = -1;
+    [registry registerAddress:@"/mixer/fader" signature:@"ifsT" structSize:sizeof(SchemaTestFader) fieldOffsets:SchemaTestFaderOffsets
+                      handler:^( const void *values, const F53OSCSchemaContext *context ) {
+        handledCount++;
+        lastChannel = ((const SchemaTestFader *)values)->channel;
+    }];
+
+    for (NSNumber *useTcp in @[@NO, @YES])
+    {
+        handledCount = 0;
+        [registry resetCounts];
+
+        F53OSCServer *server = [[F53OSCServer alloc] init];
+        server.port = PORT_BASE + (useTcp.boolValue ? 1 : 0);
+        server.schemaRegistry = registry;
+
+        F53OSCClient *client = [[F53OSCClient alloc] init];
+        client.host = @"127.0.0.1";
+        client.port = server.port;
+        client.useTcp = useTcp.boolValue;
+
+        [self addTeardownBlock:^{
+            [client disconnect];
+            [server stopListening];
+        }];
+
+        NSError *error = nil;
+        XCTAssertTrue([server startListening:&error], @"Server should start listening");
+
+        const NSUInteger messageCount = 10;
+        for (NSUInteger i = 0; i < messageCount; i++)
+            [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/mixer/fader" arguments:@[@(i), @0.5f, @"Bass", [F53OSCValue oscTrue]]]];
+
+        NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5.0];
+        while (registry.handledCount < messageCount && [deadline timeIntervalSinceNow] > 0)
+            [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+
+        XCTAssertEqual(registry.handledCount, messageCount, @"Every message should be decoded by the registry over %@", useTcp.boolValue ? @"TCP" : @"UDP");
+        XCTAssertEqual(handledCount, messageCount);
+        XCTAssertEqual(lastChannel, (int32_t)messageCount - 1);
+    }
+}
+
+
+#pragma mark - Performance tests
+
+- (NSData *)benchmarkPacket
+{
+    return [[F53OSCMessage messageWithAddressPattern:@"/mixer/fader" arguments:@[@3, @0.75f, @"Vocals", [F53OSCValue oscTrue]]] packetData];
+}
+
+- (F53OSCSchemaRegistry *)benchmarkRegistryAddingLevelsTo:(double *)levelSum
+{
+    F53OSCSchemaRegistry *registry = [[F53OSCSchemaRegistry alloc] init];
+    [registry registerAddress:@"/mixer/fader" signature:@"ifsT" structSize:sizeof(SchemaTestFader) fieldOffsets:SchemaTestFaderOffsets
+                      handler:^( const void *values, const F53OSCSchemaContext *context ) {
+        *levelSum += ((const SchemaTestFader *)values)->level;
+    }];
+    return registry;
+}
+
+// What an app does today after `takeMessage:`. Returns the level, or NAN if the message is not a fader message.
+- (double)boxedLevelOfPacket:(NSData *)packet
+{
+    @autoreleasepool
+    {
+        F53OSCMessage *message = [F53OSCParser parseOscMessageData:packet];
+        NSArray *arguments = message.arguments;
+        if ( ![message.addressPattern isEqualToString:@"/mixer/fader"] || arguments.count != 4 )
+            return NAN;
+        if ( ![arguments[0] isKindOfClass:[NSNumber class]] || ![arguments[1] isKindOfClass:[NSNumber class]] || ![arguments[2] isKindOfClass:[NSString class]] )
+            return NAN;
+        return [arguments[1] floatValue];
+    }
+}
+
+- (void)testThat_schemaDecodingMatchesBoxedArguments
+{
+    NSUInteger count = 1000;
+    NSData *packet = [self benchmarkPacket];
+
+    double levelSum = 0;
+    F53OSCSchemaRegistry *registry = [self benchmarkRegistryAddingLevelsTo:&levelSum];
+    for (NSUInteger i = 0; i < count; i++)
+        [registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil];
+    XCTAssertEqual(registry.handledCount, count);
+    XCTAssertEqual(registry.rejectedCount, 0);
+
+    double boxedLevelSum = 0;
+    for (NSUInteger i = 0; i < count; i++)
+        boxedLevelSum += [self boxedLevelOfPacket:packet];
+    XCTAssertEqual(boxedLevelSum, levelSum);
+}
+
+- (void)testThat_schemaDecodingPerformance
+{
+    NSData *packet = [self benchmarkPacket];
+    double levelSum = 0;
+    F53OSCSchemaRegistry *registry = [self benchmarkRegistryAddingLevelsTo:&levelSum];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < BENCHMARK_MESSAGES; i++)
+            [registry handleMessageBytes:packet.bytes length:packet.length timeTag:F53OSC_WIRE_IMMEDIATELY receivedTimestamp:0 replySocket:nil];
+    }];
+}
+
+// The baseline for `testThat_schemaDecodingPerformance`.
+- (void)testThat_boxedArgumentDecodingPerformance
+{
+    NSData *packet = [self benchmarkPacket];
+
+    [self measureBlock:^{
+        double levelSum = 0;
+        for (NSUInteger i = 0; i < BENCHMARK_MESSAGES; i++)
+            levelSum += [self boxedLevelOfPacket:packet];
+        XCTAssertGreaterThan(levelSum, 0);
+    }];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -30,7 +30,14 @@
 
 #import <XCTest/XCTest.h>
 
+#import "F53OSCBundle.h"
+#import "F53OSCClient.h"
+#import "F53OSCConflationBuffer.h"
+#import "F53OSCPriorityScheduler.h"
+#import "F53OSCRateLimiter.h"
+#import "F53OSCReadFlowControl.h"
 #import "F53OSCServer.h"
+#import "F53OSCTimeTag.h"
 
 #if __has_include(<F53OSC/F53OSC-Swift.h>) // F53OSC_BUILT_AS_FRAMEWORK
 #import <F53OSC/F53OSC-Swift.h>
@@ -48,9 +55,106 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 
+#pragma mark - BatchingServerDelegate
+
+@interface BatchingServerDelegate : NSObject <F53OSCServerDelegate>
+@property (strong) NSMutableArray<NSArray<F53OSCMessage *> *> *batches;
+@property (assign) NSUInteger takeMessageCallCount;
+@property (assign) NSUInteger expectedMessageCount;
+@property (strong, nullable) XCTestExpectation *allMessagesExpectation;
+@property (readonly) NSUInteger messageCount;
+@end
+
+@implementation BatchingServerDelegate
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self)
+        self.batches = [NSMutableArray array];
+    return self;
+}
+
+- (NSUInteger)messageCount
+{
+    return [[self.batches valueForKeyPath:@"@sum.@count"] unsignedIntegerValue];
+}
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    self.takeMessageCallCount++;
+}
+
+- (void)takeMessages:(NSArray<F53OSCMessage *> *)messages
+{
+    [self.batches addObject:messages];
+    if (self.messageCount == self.expectedMessageCount)
+        [self.allMessagesExpectation fulfill];
+}
+
+@end
+
+
+#pragma mark - BundleServerDelegate
+
+@interface BundleServerDelegate : BatchingServerDelegate
+@property (strong) NSMutableArray<NSArray<F53OSCMessage *> *> *bundles;
+@property (strong) NSMutableArray<F53OSCTimeTag *> *bundleTimeTags;
+@end
+
+@implementation BundleServerDelegate
+
+- (void)takeBundleMessages:(NSArray<F53OSCMessage *> *)messages timeTag:(F53OSCTimeTag *)timeTag
+{
+    if (!self.bundles)
+    {
+        self.bundles = [NSMutableArray array];
+        self.bundleTimeTags = [NSMutableArray array];
+    }
+    [self.bundles addObject:messages];
+    [self.bundleTimeTags addObject:timeTag];
+    if (messages.count == self.expectedMessageCount)
+        [self.allMessagesExpectation fulfill];
+}
+
+@end
+
+
+#pragma mark - AdmissionServerDelegate
+
+@interface AdmissionServerDelegate : NSObject <F53OSCServerDelegate>
+@property (assign) NSUInteger floodMessageCount;
+@property (assign) NSUInteger legitimateMessageCount;
+@property (assign) NSTimeInterval startTime;
+@property (assign) NSTimeInterval maxLegitimateLatency;
+@end
+
+@implementation AdmissionServerDelegate
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    if ([message.addressPattern isEqualToString:@"/flood"])
+    {
+        self.floodMessageCount++;
+    }
+    else if ([message.addressPattern isEqualToString:@"/legitimate"])
+    {
+        self.legitimateMessageCount++;
+
+        NSTimeInterval sentAt = [message.arguments.firstObject doubleValue];
+        NSTimeInterval latency = ([NSDate timeIntervalSinceReferenceDate] - self.startTime) - sentAt;
+        self.maxLegitimateLatency = MAX(self.maxLegitimateLatency, latency);
+    }
+}
+
+@end
+
+
 #pragma - mark
 
 @interface F53OSC_ServerTests : XCTestCase <F53OSCServerDelegate>
+@property (nonatomic, strong, nullable) XCTestExpectation *connectExpectation;
+@property (atomic, assign) BOOL connectCalledOnCallbackQueue;
 @end
 
 @implementation F53OSC_ServerTests
@@ -101,6 +205,13 @@ NS_ASSUME_NONNULL_BEGIN
     XCTAssertEqual(server.udpReplyPort, 0, @"Default udpReplyPort should be 0");
     XCTAssertFalse(server.isIPv6Enabled, @"Default IPv6Enabled should be NO");
     XCTAssertNil(server.keyPair, @"Default keyPair should be nil");
+    XCTAssertEqual(server.delegateCallbackQueue, dispatch_get_main_queue(), @"Default delegateCallbackQueue should be the main queue");
+    XCTAssertEqual(server.maxMessageBatchSize, 0, @"Default maxMessageBatchSize should be 0 (no limit)");
+    XCTAssertEqual(server.messageBatchLatency, 0, @"Default messageBatchLatency should be 0");
+    XCTAssertNil(server.priorityScheduler, @"Default priorityScheduler should be nil");
+    XCTAssertNil(server.readFlowControl, @"Default readFlowControl should be nil");
+    XCTAssertEqual(server.multicastGroups.count, 0, @"Default multicastGroups should be empty");
+    XCTAssertNil(server.socketOptions, @"Default socketOptions should be nil");
 }
 
 - (void)testThat_serverWithDelegateHasCorrectDefaults
@@ -118,6 +229,11 @@ NS_ASSUME_NONNULL_BEGIN
     XCTAssertEqual(server.udpReplyPort, 0, @"Default udpReplyPort should be 0");
     XCTAssertFalse(server.isIPv6Enabled, @"Default IPv6Enabled should be NO");
     XCTAssertNil(server.keyPair, @"Default keyPair should be nil");
+    XCTAssertEqual(server.delegateCallbackQueue, dispatch_get_main_queue(), @"Default delegateCallbackQueue should be the main queue");
+    XCTAssertEqual(server.maxMessageBatchSize, 0, @"Default maxMessageBatchSize should be 0 (no limit)");
+    XCTAssertEqual(server.messageBatchLatency, 0, @"Default messageBatchLatency should be 0");
+    XCTAssertNil(server.priorityScheduler, @"Default priorityScheduler should be nil");
+    XCTAssertNil(server.readFlowControl, @"Default readFlowControl should be nil");
 }
 
 - (void)testThat_serverCanConfigureProperties
@@ -1691,12 +1807,476 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 
+#pragma mark - Batch delivery tests
+
+- (void)testThat_serverDeliversBundleInOneBatch
+{
+    BatchingServerDelegate *delegate = [[BatchingServerDelegate alloc] init];
+    delegate.expectedMessageCount = 20;
+    delegate.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"All messages delivered"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = delegate;
+    server.port = PORT_BASE + 50;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.port = server.port;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    NSMutableArray<NSData *> *elements = [NSMutableArray array];
+    for (NSUInteger i = 0; i < delegate.expectedMessageCount; i++)
+        [elements addObject:[F53OSCMessage messageWithAddressPattern:@"/batch/bundle" arguments:@[@(i)]].packetData];
+    [client sendPacket:[F53OSCBundle bundleWithTimeTag:[F53OSCTimeTag immediateTimeTag] elements:elements]];
+
+    [self waitForExpectations:@[delegate.allMessagesExpectation] timeout:2.0];
+
+    XCTAssertEqual(delegate.takeMessageCallCount, 0, @"takeMessage: should not be called when the delegate implements takeMessages:");
+    XCTAssertEqual(delegate.batches.count, 1, @"A bundle parsed from one datagram should be delivered in one batch");
+    NSArray<F53OSCMessage *> *batch = delegate.batches.firstObject;
+    for (NSUInteger i = 0; i < batch.count; i++)
+        XCTAssertEqualObjects(batch[i].arguments.firstObject, @(i), @"Batch should keep message order");
+}
+
+- (void)testThat_serverKeepsBundlesWholeThroughConflationAndPriorityScheduling
+{
+    BundleServerDelegate *delegate = [[BundleServerDelegate alloc] init];
+    delegate.expectedMessageCount = 20;
+    delegate.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Bundle delivered"];
+
+    F53OSCConflationBuffer *conflation = [[F53OSCConflationBuffer alloc] init];
+    [conflation conflateAddress:@"/batch/bundle" keyArgumentCount:0];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = delegate;
+    server.port = PORT_BASE + 94;
+    server.conflationBuffer = conflation;
+    server.priorityScheduler = [[F53OSCPriorityScheduler alloc] init];
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.port = server.port;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    F53OSCTimeTag *timeTag = [F53OSCTimeTag timeTagWithDate:[NSDate dateWithTimeIntervalSinceNow:1.0]];
+    NSMutableArray<NSData *> *elements = [NSMutableArray array];
+    for (NSUInteger i = 0; i < delegate.expectedMessageCount; i++)
+        [elements addObject:[F53OSCMessage messageWithAddressPattern:@"/batch/bundle" arguments:@[@(i)]].packetData];
+    [client sendPacket:[F53OSCBundle bundleWithTimeTag:timeTag elements:elements]];
+
+    [self waitForExpectations:@[delegate.allMessagesExpectation] timeout:2.0];
+
+    XCTAssertEqual(delegate.bundles.count, 1);
+    XCTAssertEqual(delegate.bundleTimeTags.firstObject.wireValue, timeTag.wireValue, @"The bundle's time tag should reach the delegate");
+    XCTAssertEqual(delegate.batches.count, 0, @"Bundle messages should not be delivered as loose messages");
+    XCTAssertEqual(delegate.takeMessageCallCount, 0);
+    NSArray<F53OSCMessage *> *bundle = delegate.bundles.firstObject;
+    for (NSUInteger i = 0; i < bundle.count; i++)
+        XCTAssertEqualObjects(bundle[i].arguments.firstObject, @(i), @"Messages in a bundle should not be conflated");
+}
+
+- (void)testThat_serverRespectsMaxMessageBatchSize
+{
+    BatchingServerDelegate *delegate = [[BatchingServerDelegate alloc] init];
+    delegate.expectedMessageCount = 20;
+    delegate.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"All messages delivered"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = delegate;
+    server.port = PORT_BASE + 60;
+    server.maxMessageBatchSize = 5;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.port = server.port;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    NSMutableArray<NSData *> *elements = [NSMutableArray array];
+    for (NSUInteger i = 0; i < delegate.expectedMessageCount; i++)
+        [elements addObject:[F53OSCMessage messageWithAddressPattern:@"/batch/size" arguments:@[@(i)]].packetData];
+    [client sendPacket:[F53OSCBundle bundleWithTimeTag:[F53OSCTimeTag immediateTimeTag] elements:elements]];
+
+    [self waitForExpectations:@[delegate.allMessagesExpectation] timeout:2.0];
+
+    XCTAssertEqual(delegate.batches.count, 4, @"Batches should not exceed maxMessageBatchSize");
+    for (NSArray<F53OSCMessage *> *batch in delegate.batches)
+        XCTAssertLessThanOrEqual(batch.count, 5);
+}
+
+- (void)testThat_serverGathersDatagramsWithinMessageBatchLatency
+{
+    BatchingServerDelegate *delegate = [[BatchingServerDelegate alloc] init];
+    delegate.expectedMessageCount = 50;
+    delegate.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"All messages delivered"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = delegate;
+    server.port = PORT_BASE + 70;
+    server.messageBatchLatency = 0.25;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.port = server.port;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    for (NSUInteger i = 0; i < delegate.expectedMessageCount; i++)
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/batch/latency" arguments:@[@(i)]]];
+
+    [self waitForExpectations:@[delegate.allMessagesExpectation] timeout:2.0];
+
+    XCTAssertLessThan(delegate.batches.count, delegate.expectedMessageCount, @"Datagrams received within the latency should share a batch");
+
+    NSArray<F53OSCMessage *> *messages = [delegate.batches valueForKeyPath:@"@unionOfArrays.self"];
+    for (NSUInteger i = 0; i < messages.count; i++)
+        XCTAssertEqualObjects(messages[i].arguments.firstObject, @(i), @"Batches should keep message order");
+}
+
+
+#pragma mark - Delegate callback queue tests
+
+- (void)testThat_serverCallsConnectOnDelegateCallbackQueue
+{
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = self;
+    server.port = PORT_BASE + 80;
+
+    dispatch_queue_t callbackQueue = dispatch_queue_create("test.server.callback.queue", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_set_specific(callbackQueue, (__bridge const void *)self, (void *)1, NULL);
+    server.delegateCallbackQueue = callbackQueue;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.port = server.port;
+    client.useTcp = YES;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+        server.delegate = nil;
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    self.connectExpectation = [[XCTestExpectation alloc] initWithDescription:@"Server accepted connection"];
+    XCTAssertTrue([client connect]);
+    [self waitForExpectations:@[self.connectExpectation] timeout:5.0];
+
+    XCTAssertTrue(self.connectCalledOnCallbackQueue, @"serverDidConnect:toSocket: should be called on delegateCallbackQueue");
+}
+
+
+#pragma mark - Read flow control tests
+
+- (void)testThat_serverPausesTcpReadsForSlowConsumer
+{
+    NSUInteger rounds = 40;
+    NSUInteger messagesPerRound = 500;
+
+    BatchingServerDelegate *delegate = [[BatchingServerDelegate alloc] init];
+    delegate.expectedMessageCount = rounds * messagesPerRound;
+    delegate.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"All messages delivered"];
+
+    // A stalled consumer: nothing leaves the scheduler until its queue is resumed.
+    dispatch_queue_t consumerQueue = dispatch_queue_create("test.server.consumer.queue", DISPATCH_QUEUE_SERIAL);
+    F53OSCPriorityScheduler *scheduler = [[F53OSCPriorityScheduler alloc] initWithDeliveryQueue:consumerQueue];
+
+    F53OSCReadFlowControl *flowControl = [[F53OSCReadFlowControl alloc] init];
+    flowControl.highWaterMark = 500;
+    flowControl.lowWaterMark = 100;
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = delegate;
+    server.port = PORT_BASE + 91;
+    server.priorityScheduler = scheduler;
+    server.readFlowControl = flowControl;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.port = server.port;
+    client.useTcp = YES;
+
+    __block BOOL consumerSuspended = YES;
+    dispatch_suspend(consumerQueue);
+    [self addTeardownBlock:^{
+        if (consumerSuspended)
+            dispatch_resume(consumerQueue);
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+    XCTAssertTrue([client connect]);
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+
+    for (NSUInteger round = 0; round < rounds; round++)
+    {
+        for (NSUInteger i = 0; i < messagesPerRound; i++)
+            [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/flow" arguments:@[@(round * messagesPerRound + i)]]];
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.02]];
+    }
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+    NSUInteger heldWhilePaused = scheduler.pendingCount;
+    NSLog(@"Held %lu of %lu messages while paused; peak outstanding %lu",
+          (unsigned long)heldWhilePaused, (unsigned long)delegate.expectedMessageCount, (unsigned long)flowControl.peakOutstandingMessageCount);
+
+    XCTAssertEqual(flowControl.pausedConnectionCount, 1, @"The connection should be paused while its consumer is stalled");
+    XCTAssertEqual(flowControl.pauseCount, 1);
+    XCTAssertGreaterThanOrEqual(heldWhilePaused, flowControl.highWaterMark);
+    XCTAssertLessThan(heldWhilePaused, delegate.expectedMessageCount, @"Unread messages should be left to TCP rather than queued in memory");
+    XCTAssertEqual(flowControl.outstandingMessageCount, heldWhilePaused);
+
+    consumerSuspended = NO;
+    dispatch_resume(consumerQueue);
+    [self waitForExpectations:@[delegate.allMessagesExpectation] timeout:10.0];
+
+    NSArray<F53OSCMessage *> *messages = [delegate.batches valueForKeyPath:@"@unionOfArrays.self"];
+    XCTAssertEqual(messages.count, delegate.expectedMessageCount);
+    for (NSUInteger i = 0; i < messages.count; i++)
+    {
+        if (![messages[i].arguments.firstObject isEqual:@(i)])
+        {
+            XCTFail(@"Message %lu arrived out of order", (unsigned long)i);
+            break;
+        }
+    }
+    XCTAssertEqual(flowControl.pausedConnectionCount, 0);
+    XCTAssertGreaterThanOrEqual(flowControl.pauseCount, 1);
+}
+
+
+#pragma mark - Multicast tests
+
+- (void)testThat_serverRejectsNonMulticastGroup
+{
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+
+    NSError *error = nil;
+    XCTAssertFalse([server joinMulticastGroup:@"192.168.1.10" onInterface:nil error:&error]);
+    XCTAssertNotNil(error);
+    XCTAssertEqual(server.multicastGroups.count, 0);
+
+    XCTAssertTrue([server joinMulticastGroup:@"239.53.53.53" onInterface:nil error:&error]);
+    XCTAssertTrue([server joinMulticastGroup:@"239.53.53.53" onInterface:nil error:&error], @"Joining twice should succeed");
+    XCTAssertEqualObjects(server.multicastGroups, @[@"239.53.53.53"]);
+
+    XCTAssertTrue([server leaveMulticastGroup:@"239.53.53.53" onInterface:nil error:&error]);
+    XCTAssertEqual(server.multicastGroups.count, 0);
+}
+
+- (void)testThat_serverReceivesMulticastFromClient
+{
+    NSString *group = @"239.53.53.92";
+    NSUInteger messageCount = 10;
+
+    BatchingServerDelegate *delegate = [[BatchingServerDelegate alloc] init];
+    delegate.expectedMessageCount = messageCount;
+    delegate.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Multicast messages delivered"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = delegate;
+    server.port = PORT_BASE + 92;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = group;
+    client.port = server.port;
+    client.interface = @"127.0.0.1";
+    client.multicastLoopback = YES;
+    XCTAssertTrue(client.hostIsMulticast);
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    // Hosts without multicast on the loopback interface can not run this test.
+    GCDAsyncUdpSocket *probe = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    NSError *probeError = nil;
+    BOOL loopbackMulticast = ([probe bindToPort:0 interface:@"127.0.0.1" error:&probeError] &&
+                              [probe joinMulticastGroup:group onInterface:@"127.0.0.1" error:&probeError]);
+    [probe close];
+    if (!loopbackMulticast)
+        XCTSkip(@"Multicast is not available on the loopback interface: %@", probeError.localizedDescription);
+
+    NSError *error = nil;
+    XCTAssertTrue([server joinMulticastGroup:group onInterface:@"127.0.0.1" error:&error]);
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+    XCTAssertTrue(server.udpSocket.reusePort, @"Listening with memberships should allow other receivers on the port");
+
+    for (NSUInteger i = 0; i < messageCount; i++)
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/multicast" arguments:@[@(i)]]];
+
+    [self waitForExpectations:@[delegate.allMessagesExpectation] timeout:5.0];
+    XCTAssertEqual(delegate.messageCount, messageCount);
+}
+
+- (void)testThat_serverJoinsMulticastAfterListeningWithNativeTransport
+{
+    NSString *group = @"239.53.53.93";
+    NSUInteger messageCount = 10;
+
+    BatchingServerDelegate *delegate = [[BatchingServerDelegate alloc] init];
+    delegate.expectedMessageCount = messageCount;
+    delegate.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Multicast messages delivered"];
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = delegate;
+    server.port = PORT_BASE + 93;
+    server.udpTransport = F53OSCServerUdpTransportNative;
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = group;
+    client.port = server.port;
+    client.interface = @"127.0.0.1";
+    client.multicastLoopback = YES;
+
+    [self addTeardownBlock:^{
+        [client disconnect];
+        [server stopListening];
+    }];
+
+    // Hosts without multicast on the loopback interface can not run this test.
+    GCDAsyncUdpSocket *probe = [[GCDAsyncUdpSocket alloc] initWithDelegate:nil delegateQueue:nil];
+    NSError *probeError = nil;
+    BOOL loopbackMulticast = ([probe bindToPort:0 interface:@"127.0.0.1" error:&probeError] &&
+                              [probe joinMulticastGroup:group onInterface:@"127.0.0.1" error:&probeError]);
+    [probe close];
+    if (!loopbackMulticast)
+        XCTSkip(@"Multicast is not available on the loopback interface: %@", probeError.localizedDescription);
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+    XCTAssertNotNil(server.nativeUdpTransport, @"Server should listen with the native transport");
+
+    XCTAssertTrue([server joinMulticastGroup:group onInterface:@"127.0.0.1" error:&error], @"Joining while listening should succeed: %@", error);
+    XCTAssertNil(server.nativeUdpTransport, @"Joining a group should move UDP off the native transport");
+    XCTAssertTrue(server.udpSocket.reusePort, @"The restarted socket should allow other receivers on the port");
+    XCTAssertEqualObjects(server.multicastGroups, @[group]);
+
+    for (NSUInteger i = 0; i < messageCount; i++)
+        [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/multicast" arguments:@[@(i)]]];
+
+    [self waitForExpectations:@[delegate.allMessagesExpectation] timeout:5.0];
+    XCTAssertEqual(delegate.messageCount, messageCount);
+
+    XCTAssertTrue([server leaveMulticastGroup:group onInterface:@"127.0.0.1" error:&error]);
+    XCTAssertEqual(server.multicastGroups.count, 0);
+}
+
+
+#pragma mark - Admission control tests
+
+- (void)testThat_serverRateLimiterProtectsLegitimatePeerUnderFlood
+{
+    AdmissionServerDelegate *delegate = [[AdmissionServerDelegate alloc] init];
+
+    F53OSCRateLimiter *rateLimiter = [[F53OSCRateLimiter alloc] init];
+    rateLimiter.packetsPerSecond = 100;
+    rateLimiter.packetBurst = 20;
+
+    F53OSCServer *server = [[F53OSCServer alloc] init];
+    server.delegate = delegate;
+    server.port = PORT_BASE + 90;
+    server.rateLimiter = rateLimiter;
+
+    F53OSCClient *floodClient = [[F53OSCClient alloc] init];
+    floodClient.port = server.port;
+    F53OSCClient *legitimateClient = [[F53OSCClient alloc] init];
+    legitimateClient.port = server.port;
+
+    [self addTeardownBlock:^{
+        [floodClient disconnect];
+        [legitimateClient disconnect];
+        [server stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening");
+    XCTAssertNil(error);
+
+    F53OSCMessage *floodMessage = [F53OSCMessage messageWithAddressPattern:@"/flood" arguments:@[@"xxxxxxxxxxxxxxxx"]];
+    NSUInteger rounds = 20;
+    NSUInteger floodPerRound = 500;
+    delegate.startTime = [NSDate timeIntervalSinceReferenceDate];
+
+    for (NSUInteger round = 0; round < rounds; round++)
+    {
+        for (NSUInteger i = 0; i < floodPerRound; i++)
+            [floodClient sendPacket:floodMessage];
+
+        // Legitimate traffic stays well under the per-peer limit: one message every 20 ms.
+        NSTimeInterval sentAt = [NSDate timeIntervalSinceReferenceDate] - delegate.startTime;
+        [legitimateClient sendPacket:[F53OSCMessage messageWithAddressPattern:@"/legitimate" arguments:@[@((float)sentAt)]]];
+
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.02]];
+    }
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+    NSDictionary<NSString *, NSNumber *> *drops = rateLimiter.droppedPacketCountsByPeer;
+    NSLog(@"Flood: %lu sent, %lu delivered; legitimate: %lu of %lu delivered, max latency %.4f s; drops by peer: %@",
+          (unsigned long)(rounds * floodPerRound), (unsigned long)delegate.floodMessageCount,
+          (unsigned long)delegate.legitimateMessageCount, (unsigned long)rounds, delegate.maxLegitimateLatency, drops);
+
+    XCTAssertEqual(delegate.legitimateMessageCount, rounds, @"Legitimate peer should not lose messages to another peer's flood");
+    XCTAssertLessThan(delegate.maxLegitimateLatency, 0.25, @"Legitimate peer latency should stay low under a flood");
+    XCTAssertLessThan(delegate.floodMessageCount, rounds * floodPerRound / 4, @"Most of the flood should be rejected");
+    XCTAssertGreaterThan(rateLimiter.totalDroppedPackets, 0);
+
+    NSUInteger peersWithDrops = 0;
+    for (NSNumber *count in drops.allValues)
+    {
+        if (count.unsignedIntegerValue > 0)
+            peersWithDrops++;
+    }
+    XCTAssertEqual(drops.count, 2, @"Each sender should be tracked as its own peer");
+    XCTAssertEqual(peersWithDrops, 1, @"Only the flooding peer should have drops");
+}
+
+
 #pragma mark - F53OSCServerDelegate
 
 - (void)takeMessage:(nullable F53OSCMessage *)message
 {
 }
 
+- (void)serverDidConnect:(F53OSCServer *)server toSocket:(F53OSCSocket *)socket
+{
+    self.connectCalledOnCallbackQueue = ( dispatch_get_specific((__bridge const void *)self) != NULL );
+    [self.connectExpectation fulfill];
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
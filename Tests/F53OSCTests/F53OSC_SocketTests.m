@@ -34,6 +34,9 @@
 #import "F53OSCMessage.h"
 #import "F53OSCServer.h"
 
+#import <netinet/in.h>
+#import <netinet/tcp.h>
+
 #if __has_include(<F53OSC/F53OSC-Swift.h>) // F53OSC_BUILT_AS_FRAMEWORK
 #import <F53OSC/F53OSC-Swift.h>
 #elif __has_include("F53OSC-Swift.h")
@@ -205,6 +208,7 @@ NS_ASSUME_NONNULL_BEGIN
     XCTAssertNil(socket.encrypter, @"Default encrypter should be nil");
     XCTAssertFalse(socket.isEncrypting, @"Default isEncrypting should be NO");
     XCTAssertFalse(socket.isConnected, @"Default isConnected should be NO");
+    XCTAssertNil(socket.options, @"Default options should be nil");
 }
 
 - (void)testThat_socketWithUdpSocketHasCorrectDefaults
@@ -230,6 +234,7 @@ NS_ASSUME_NONNULL_BEGIN
     XCTAssertNil(socket.encrypter, @"Default encrypter should be nil");
     XCTAssertFalse(socket.isEncrypting, @"Default isEncrypting should be NO");
     XCTAssertTrue(socket.isConnected, @"Default isConnected should be YES"); // automatic for UDP sockets
+    XCTAssertNil(socket.options, @"Default options should be nil");
 }
 
 - (void)testThat_socketCanConfigureProperties
@@ -406,6 +411,18 @@ NS_ASSUME_NONNULL_BEGIN
     XCTAssertEqual(socket.tcpDataFraming, F53TCPDataFramingNone, @"UDP socket should still allow TCP framing setting");
 }
 
+- (void)testThat_slipFramedDataEscapesSpecialBytes
+{
+    const Byte clear[] = { 0x2F, 0xC0, 0x41, 0xDB, 0x00 };
+    const Byte expected[] = { 0xC0, 0x2F, 0xDB, 0xDC, 0x41, 0xDB, 0xDD, 0x00, 0xC0 };
+
+    NSData *framed = [F53OSCSocket slipFramedData:[NSData dataWithBytes:clear length:sizeof(clear)]];
+    XCTAssertEqualObjects(framed, [NSData dataWithBytes:expected length:sizeof(expected)], @"END and ESC should be escaped between END delimiters");
+
+    const Byte empty[] = { 0xC0, 0xC0 };
+    XCTAssertEqualObjects([F53OSCSocket slipFramedData:[NSData data]], [NSData dataWithBytes:empty length:sizeof(empty)]);
+}
+
 - (void)testThat_tcpSocketDescriptionIsCorrect
 {
     GCDAsyncSocket *tcpSocket = [[GCDAsyncSocket alloc] initWithDelegate:self delegateQueue:dispatch_get_main_queue()];
@@ -529,6 +546,144 @@ NS_ASSUME_NONNULL_BEGIN
     XCTAssertTrue(socket.hostIsLocal, @"nil host should be detected as local");
 }
 
+- (void)testThat_isMulticastAddressWorks
+{
+    XCTAssertTrue([F53OSCSocket isMulticastAddress:@"224.0.0.1"]);
+    XCTAssertTrue([F53OSCSocket isMulticastAddress:@"239.255.255.250"]);
+    XCTAssertTrue([F53OSCSocket isMulticastAddress:@"ff02::1"]);
+    XCTAssertTrue([F53OSCSocket isMulticastAddress:@"FF15::53"]);
+
+    XCTAssertFalse([F53OSCSocket isMulticastAddress:@"223.255.255.255"]);
+    XCTAssertFalse([F53OSCSocket isMulticastAddress:@"240.0.0.1"]);
+    XCTAssertFalse([F53OSCSocket isMulticastAddress:@"127.0.0.1"]);
+    XCTAssertFalse([F53OSCSocket isMulticastAddress:@"fe80::1"]);
+    XCTAssertFalse([F53OSCSocket isMulticastAddress:@"localhost"]);
+    XCTAssertFalse([F53OSCSocket isMulticastAddress:@""]);
+    XCTAssertFalse([F53OSCSocket isMulticastAddress:nil]);
+
+    GCDAsyncUdpSocket *udpSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:self delegateQueue:dispatch_get_main_queue()];
+    F53OSCSocket *socket = [F53OSCSocket socketWithUdpSocket:udpSocket];
+    XCTAssertFalse(socket.hostIsMulticast);
+    XCTAssertEqual(socket.multicastTTL, 1);
+    XCTAssertTrue(socket.multicastLoopback);
+    XCTAssertFalse(socket.reusePort);
+
+    socket.host = @"239.1.2.3";
+    XCTAssertTrue(socket.hostIsMulticast);
+    XCTAssertFalse(socket.hostIsLocal);
+}
+
+
+#pragma mark - Socket options tests
+
+- (void)testThat_socketOptionsHaveCorrectDefaults
+{
+    F53OSCSocketOptions *options = [[F53OSCSocketOptions alloc] init];
+
+    XCTAssertEqual(options.receiveBufferSize, 0);
+    XCTAssertEqual(options.sendBufferSize, 0);
+    XCTAssertEqual(options.dscp, 0);
+    XCTAssertFalse(options.noDelay);
+    XCTAssertFalse(options.sendMoreAcks);
+    XCTAssertFalse(options.receiveTimestamps);
+
+    options.receiveBufferSize = 1 << 20;
+    options.dscp = 46;
+    options.receiveTimestamps = YES;
+    F53OSCSocketOptions *copy = [options copy];
+    XCTAssertEqual(copy.receiveBufferSize, 1 << 20);
+    XCTAssertEqual(copy.dscp, 46);
+    XCTAssertTrue(copy.receiveTimestamps);
+}
+
+- (void)testThat_socketOptionsApplyToUdpSockets
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    XCTAssertNotEqual(fd, -1);
+    [self addTeardownBlock:^{
+        close(fd);
+    }];
+
+    F53OSCSocketOptions *options = [[F53OSCSocketOptions alloc] init];
+    options.receiveBufferSize = 256 * 1024;
+    options.sendBufferSize = 128 * 1024;
+    options.dscp = 46; // expedited forwarding
+    options.noDelay = YES; // TCP only; skipped
+    options.receiveTimestamps = YES;
+
+    NSError *error = nil;
+    XCTAssertTrue([options applyToSocket:fd error:&error]);
+    XCTAssertNil(error);
+
+    int value = 0;
+    socklen_t length = sizeof(value);
+    getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &value, &length);
+    XCTAssertGreaterThanOrEqual(value, 256 * 1024);
+    getsockopt(fd, SOL_SOCKET, SO_SNDBUF, &value, &length);
+    XCTAssertGreaterThanOrEqual(value, 128 * 1024);
+    getsockopt(fd, IPPROTO_IP, IP_TOS, &value, &length);
+    XCTAssertEqual(value, 46 << 2, @"DSCP should fill the upper six bits of the TOS byte");
+    getsockopt(fd, SOL_SOCKET, SO_TIMESTAMP, &value, &length);
+    XCTAssertNotEqual(value, 0);
+}
+
+- (void)testThat_socketOptionsApplyToTcpSockets
+{
+    int fd = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+    XCTAssertNotEqual(fd, -1);
+    [self addTeardownBlock:^{
+        close(fd);
+    }];
+
+    F53OSCSocketOptions *options = [[F53OSCSocketOptions alloc] init];
+    options.dscp = 34; // AF41
+    options.noDelay = YES;
+    options.sendMoreAcks = YES;
+
+    NSError *error = nil;
+    XCTAssertTrue([options applyToSocket:fd error:&error]);
+    XCTAssertNil(error);
+
+    int value = 0;
+    socklen_t length = sizeof(value);
+    getsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &value, &length);
+    XCTAssertNotEqual(value, 0);
+    getsockopt(fd, IPPROTO_IPV6, IPV6_TCLASS, &value, &length);
+    XCTAssertEqual(value, 34 << 2);
+
+    options.receiveBufferSize = -1; // negative sizes leave the default
+    XCTAssertTrue([options applyToSocket:fd error:&error]);
+    XCTAssertFalse([options applyToSocket:-1 error:&error], @"A bad file descriptor should fail");
+    XCTAssertNotNil(error);
+}
+
+- (void)testThat_socketAppliesOptionsWhenListening
+{
+    GCDAsyncUdpSocket *udpSocket = [[GCDAsyncUdpSocket alloc] initWithDelegate:self delegateQueue:dispatch_get_main_queue()];
+    F53OSCSocket *socket = [F53OSCSocket socketWithUdpSocket:udpSocket];
+    socket.port = 0;
+
+    F53OSCSocketOptions *options = [[F53OSCSocketOptions alloc] init];
+    options.receiveBufferSize = 512 * 1024;
+    socket.options = options;
+    options.receiveBufferSize = 1; // the socket keeps its own copy
+    XCTAssertEqual(socket.options.receiveBufferSize, 512 * 1024);
+
+    [self addTeardownBlock:^{
+        [socket stopListening];
+    }];
+
+    NSError *error = nil;
+    XCTAssertTrue([socket startListening:&error]);
+
+    __block int value = 0;
+    [udpSocket performBlock:^{
+        socklen_t length = sizeof(value);
+        getsockopt([udpSocket socket4FD], SOL_SOCKET, SO_RCVBUF, &value, &length);
+    }];
+    XCTAssertGreaterThanOrEqual(value, 512 * 1024);
+}
+
 
 #pragma mark - Connection tests
 
@@ -0,0 +1,313 @@
+//
+//  F53OSC_TransportEngineTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCClient.h"
+#import "F53OSCMessage.h"
+#import "F53OSCServer.h"
+#import "F53OSCTransportEngine.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define PORT_BASE   9700
+
+@interface F53OSCClient (F53OSC_TransportEngineTestsAccess)
+@property (strong, nullable) F53OSCSocket *socket;
+@end
+
+
+#pragma mark - EngineTestReceiver
+
+@interface EngineTestReceiver : NSObject <F53OSCServerDelegate>
+@property (assign) NSUInteger messageCount;
+@property (assign) NSUInteger expectedMessageCount;
+@property (strong, nullable) XCTestExpectation *allMessagesExpectation;
+@end
+
+@implementation EngineTestReceiver
+
+- (void)takeMessage:(nullable F53OSCMessage *)message
+{
+    @synchronized (self)
+    {
+        self.messageCount++;
+        if (self.messageCount == self.expectedMessageCount)
+            [self.allMessagesExpectation fulfill];
+    }
+}
+
+@end
+
+
+#pragma mark - F53OSC_TransportEngineTests
+
+@interface F53OSC_TransportEngineTests : XCTestCase
+@end
+
+@implementation F53OSC_TransportEngineTests
+
+- (F53OSCServer *)startServerOnPort:(UInt16)port receiver:(EngineTestReceiver *)receiver
+{
+    F53OSCServer *server = [[F53OSCServer alloc] initWithDelegateQueue:dispatch_queue_create("test.engine.server.queue", DISPATCH_QUEUE_SERIAL)];
+    server.delegate = receiver;
+    server.port = port;
+
+    NSError *error = nil;
+    XCTAssertTrue([server startListening:&error], @"Server should start listening on port %hu", port);
+    XCTAssertNil(error);
+
+    [self addTeardownBlock:^{
+        [server stopListening];
+    }];
+    return server;
+}
+
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_transportEngineHasCorrectDefaults
+{
+    F53OSCTransportEngine *engine = [[F53OSCTransportEngine alloc] init];
+
+    XCTAssertGreaterThanOrEqual(engine.tcpWorkerCount, 1);
+    XCTAssertLessThanOrEqual(engine.tcpWorkerCount, 4);
+    XCTAssertEqual(engine.udpSocketCount, 0);
+    XCTAssertEqual(engine.resolvedAddressCount, 0);
+    XCTAssertEqual(engine.datagramCount, 0);
+    XCTAssertEqual(engine.unresolvedSendCount, 0);
+    XCTAssertEqual(engine.addressGeneration, 0);
+
+    XCTAssertEqual([F53OSCTransportEngine sharedEngine], [F53OSCTransportEngine sharedEngine]);
+    XCTAssertEqual([[F53OSCTransportEngine alloc] initWithTcpWorkerCount:0].tcpWorkerCount, 1, @"An engine should have at least one TCP worker");
+}
+
+- (void)testThat_transportEngineHandsOutWorkerQueuesInTurn
+{
+    F53OSCTransportEngine *engine = [[F53OSCTransportEngine alloc] initWithTcpWorkerCount:3];
+
+    dispatch_queue_t first = [engine nextTcpWorkerQueue];
+    dispatch_queue_t second = [engine nextTcpWorkerQueue];
+    dispatch_queue_t third = [engine nextTcpWorkerQueue];
+    XCTAssertNotEqual(first, second);
+    XCTAssertNotEqual(second, third);
+    XCTAssertEqual([engine nextTcpWorkerQueue], first, @"Workers should be reused once each has been handed out");
+}
+
+- (void)testThat_transportEngineSharesResolvedAddresses
+{
+    F53OSCTransportEngine *engine = [[F53OSCTransportEngine alloc] init];
+
+    NSData *first = [engine addressForHost:@"127.0.0.1" port:PORT_BASE preferIPv6:NO];
+    NSData *second = [engine addressForHost:@"127.0.0.1" port:PORT_BASE preferIPv6:NO];
+    XCTAssertNotNil(first);
+    XCTAssertEqual(first, second, @"Clients sending to the same destination should share one address object");
+    XCTAssertEqual(engine.resolvedAddressCount, 1);
+
+    XCTAssertNil([engine addressForHost:@"host.invalid" port:PORT_BASE preferIPv6:NO]);
+    XCTAssertFalse([engine sendDatagram:[NSData dataWithBytes:"x" length:1] toAddress:nil interface:nil]);
+    XCTAssertEqual(engine.unresolvedSendCount, 1);
+
+    [engine invalidateResolvedAddresses];
+    XCTAssertEqual(engine.resolvedAddressCount, 0);
+    XCTAssertEqual(engine.addressGeneration, 1);
+}
+
+- (void)testThat_transportEngineLooksUpFailedHostsAgainAfterRetryInterval
+{
+    F53OSCTransportEngine *engine = [[F53OSCTransportEngine alloc] init];
+    XCTAssertEqual(engine.failedLookupRetryInterval, 5.0);
+    engine.failedLookupRetryInterval = 0.2;
+
+    XCTAssertNil([engine addressForHost:@"host.invalid" port:PORT_BASE preferIPv6:NO]);
+    XCTAssertEqual(engine.lookupCount, 1);
+    XCTAssertNil([engine addressForHost:@"host.invalid" port:PORT_BASE preferIPv6:NO]);
+    XCTAssertEqual(engine.lookupCount, 1, @"A failed lookup should be cached until its retry interval passes");
+    XCTAssertEqual(engine.resolvedAddressCount, 0);
+
+    [NSThread sleepForTimeInterval:0.3];
+    XCTAssertNil([engine addressForHost:@"host.invalid" port:PORT_BASE preferIPv6:NO]);
+    XCTAssertEqual(engine.lookupCount, 2, @"A failed lookup should be retried once its retry interval passes");
+
+    [engine invalidateResolvedAddresses];
+    XCTAssertNil([engine addressForHost:@"host.invalid" port:PORT_BASE preferIPv6:NO]);
+    XCTAssertEqual(engine.lookupCount, 3, @"Invalidating should forget failed lookups too");
+
+    XCTAssertNotNil([engine addressForHost:@"127.0.0.1" port:PORT_BASE preferIPv6:NO]);
+    XCTAssertNotNil([engine addressForHost:@"127.0.0.1" port:PORT_BASE preferIPv6:NO]);
+    XCTAssertEqual(engine.lookupCount, 4, @"A resolved address should be cached");
+}
+
+
+#pragma mark - Client tests
+
+- (void)testThat_udpClientsShareOneEngineSocket
+{
+    NSUInteger clientCount = 500;
+    UInt16 port = PORT_BASE + 10;
+
+    EngineTestReceiver *receiver = [[EngineTestReceiver alloc] init];
+    receiver.expectedMessageCount = clientCount;
+    receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Every client's packet received"];
+    [self startServerOnPort:port receiver:receiver];
+
+    F53OSCTransportEngine *engine = [[F53OSCTransportEngine alloc] init];
+    NSMutableArray<F53OSCClient *> *clients = [NSMutableArray arrayWithCapacity:clientCount];
+
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < clientCount; i++)
+    {
+        F53OSCClient *client = [[F53OSCClient alloc] init];
+        client.host = @"127.0.0.1";
+        client.port = port;
+        client.transportEngine = engine;
+        [clients addObject:client];
+    }
+    for (NSUInteger i = 0; i < clientCount; i++)
+    {
+        [clients[i] sendPacket:[F53OSCMessage messageWithAddressPattern:@"/fixture/level" arguments:@[@(i)]]];
+        if (i % 50 == 49)
+            [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.005]]; // pace the burst for the loopback receive buffer
+    }
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+    NSLog(@"Created and sent from %lu engine clients in %.4f s", (unsigned long)clientCount, elapsed);
+
+    [self waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:5.0];
+
+    XCTAssertEqual(engine.udpSocketCount, 1, @"All clients on the default interface should share one socket");
+    XCTAssertEqual(engine.resolvedAddressCount, 1, @"All clients should share one resolved destination");
+    XCTAssertEqual(engine.datagramCount, clientCount);
+    for (F53OSCClient *client in clients)
+    {
+        XCTAssertNil(client.socket, @"Engine clients should not create sockets of their own");
+        XCTAssertTrue(client.isConnected);
+    }
+}
+
+- (void)testThat_engineKeepsOneUdpSocketPerInterface
+{
+    UInt16 port = PORT_BASE + 11;
+
+    EngineTestReceiver *receiver = [[EngineTestReceiver alloc] init];
+    receiver.expectedMessageCount = 2;
+    receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Both packets received"];
+    [self startServerOnPort:port receiver:receiver];
+
+    F53OSCTransportEngine *engine = [[F53OSCTransportEngine alloc] init];
+
+    F53OSCClient *defaultClient = [[F53OSCClient alloc] init];
+    defaultClient.host = @"127.0.0.1";
+    defaultClient.port = port;
+    defaultClient.transportEngine = engine;
+
+    F53OSCClient *boundClient = [[F53OSCClient alloc] init];
+    boundClient.host = @"127.0.0.1";
+    boundClient.port = port;
+    boundClient.interface = @"127.0.0.1";
+    boundClient.transportEngine = engine;
+
+    [defaultClient sendPacket:[F53OSCMessage messageWithAddressPattern:@"/default" arguments:@[]]];
+    [boundClient sendPacket:[F53OSCMessage messageWithAddressPattern:@"/bound" arguments:@[]]];
+
+    [self waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:5.0];
+    XCTAssertEqual(engine.udpSocketCount, 2);
+    XCTAssertEqual(engine.resolvedAddressCount, 1);
+}
+
+- (void)testThat_tcpClientsRunOnEngineWorkers
+{
+    NSUInteger clientCount = 8;
+    NSUInteger packetCount = 5;
+    UInt16 port = PORT_BASE + 20;
+
+    EngineTestReceiver *receiver = [[EngineTestReceiver alloc] init];
+    receiver.expectedMessageCount = clientCount * packetCount;
+    receiver.allMessagesExpectation = [[XCTestExpectation alloc] initWithDescription:@"Every client's packets received"];
+    [self startServerOnPort:port receiver:receiver];
+
+    F53OSCTransportEngine *engine = [[F53OSCTransportEngine alloc] initWithTcpWorkerCount:2];
+    NSMutableArray<F53OSCClient *> *clients = [NSMutableArray arrayWithCapacity:clientCount];
+    for (NSUInteger i = 0; i < clientCount; i++)
+    {
+        F53OSCClient *client = [[F53OSCClient alloc] init];
+        client.host = @"127.0.0.1";
+        client.port = port;
+        client.useTcp = YES;
+        client.transportEngine = engine;
+        XCTAssertTrue([client connect]);
+        [clients addObject:client];
+    }
+
+    [self addTeardownBlock:^{
+        for (F53OSCClient *client in clients)
+            [client disconnect];
+    }];
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    for (NSUInteger i = 0; i < packetCount; i++)
+    {
+        for (F53OSCClient *client in clients)
+            [client sendPacket:[F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[@(i)]]];
+    }
+
+    [self waitForExpectations:@[(XCTestExpectation * _Nonnull)receiver.allMessagesExpectation] timeout:5.0];
+    XCTAssertEqual(engine.udpSocketCount, 0, @"TCP clients should not open pooled UDP sockets");
+    for (F53OSCClient *client in clients)
+        XCTAssertNotNil(client.socket.tcpSocket);
+}
+
+- (void)testThat_clientLeavesEngineWhenTransportEngineIsCleared
+{
+    F53OSCTransportEngine *engine = [[F53OSCTransportEngine alloc] init];
+
+    F53OSCClient *client = [[F53OSCClient alloc] init];
+    client.host = @"127.0.0.1";
+    client.port = PORT_BASE + 30;
+    client.transportEngine = engine;
+    XCTAssertTrue([client connect]);
+    XCTAssertNil(client.socket);
+
+    client.transportEngine = nil;
+    XCTAssertTrue([client connect]);
+    XCTAssertNotNil(client.socket.udpSocket, @"Without an engine the client should create its own socket again");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
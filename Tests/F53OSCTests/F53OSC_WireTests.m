@@ -0,0 +1,362 @@
+//
+//  F53OSC_WireTests.m
+//  F53OSC
+//
+//  Created by Figure 53 on 10/18/26.
+//  Copyright (c) 2026 Figure 53 LLC, https://figure53.com
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "F53OSCBundle.h"
+#import "F53OSCMessage.h"
+#import "F53OSCParser.h"
+#import "F53OSCTimeTag.h"
+#import "F53OSCValue.h"
+#import "F53OSCWire.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define BENCHMARK_MESSAGES  100000
+
+#pragma mark - F53OSC_WireTests
+
+@interface F53OSC_WireTests : XCTestCase
+@end
+
+@implementation F53OSC_WireTests
+
+#pragma mark - Basic configuration tests
+
+- (void)testThat__setupWorks
+{
+    // given
+    // - state created by `+setUp` and `-setUp`
+
+    // when
+    // - triggered by running this test
+
+    // then
+    XCTAssertTrue(YES);
+}
+
+- (void)testThat_wireSizesArePadded
+{
+    XCTAssertEqual(F53OSCWireStringSize(0), 4);
+    XCTAssertEqual(F53OSCWireStringSize(3), 4);
+    XCTAssertEqual(F53OSCWireStringSize(4), 8, @"A string of four characters still needs a NUL");
+    XCTAssertEqual(F53OSCWireBlobSize(0), 4);
+    XCTAssertEqual(F53OSCWireBlobSize(1), 8);
+    XCTAssertEqual(F53OSCWireBlobSize(4), 8);
+    XCTAssertEqual(F53OSCWireBlobSize(5), 12);
+}
+
+
+#pragma mark - Primitive tests
+
+- (void)testThat_wirePrimitivesRoundTrip
+{
+    uint8_t buffer[64];
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit(&writer, buffer, sizeof(buffer));
+
+    const char blobBytes[] = { 0x01, 0x02, 0x03 };
+    XCTAssertTrue(F53OSCWireWriteInt32(&writer, -42));
+    XCTAssertTrue(F53OSCWireWriteFloat32(&writer, 0.25f));
+    XCTAssertTrue(F53OSCWireWriteTimeTag(&writer, 0x0102030405060708ULL));
+    XCTAssertTrue(F53OSCWireWriteString(&writer, "cue", 3));
+    XCTAssertTrue(F53OSCWireWriteBlob(&writer, blobBytes, sizeof(blobBytes)));
+    XCTAssertFalse(writer.overflowed);
+    XCTAssertEqual(writer.length, 4 + 4 + 8 + 4 + 8);
+
+    // Big-endian on the wire.
+    XCTAssertEqual(buffer[8], 0x01);
+    XCTAssertEqual(buffer[15], 0x08);
+
+    F53OSCWireReader reader;
+    F53OSCWireReaderInit(&reader, buffer, writer.length);
+
+    int32_t i = 0;
+    float f = 0;
+    uint64_t timeTag = 0;
+    const char *string = NULL;
+    size_t stringLength = 0;
+    const void *blob = NULL;
+    size_t blobLength = 0;
+    XCTAssertTrue(F53OSCWireReadInt32(&reader, &i));
+    XCTAssertTrue(F53OSCWireReadFloat32(&reader, &f));
+    XCTAssertTrue(F53OSCWireReadTimeTag(&reader, &timeTag));
+    XCTAssertTrue(F53OSCWireReadString(&reader, &string, &stringLength));
+    XCTAssertTrue(F53OSCWireReadBlob(&reader, &blob, &blobLength));
+    XCTAssertEqual(F53OSCWireReaderRemaining(&reader), 0);
+
+    XCTAssertEqual(i, -42);
+    XCTAssertEqual(f, 0.25f);
+    XCTAssertEqual(timeTag, 0x0102030405060708ULL);
+    XCTAssertEqual(stringLength, 3);
+    XCTAssertEqual(strcmp(string, "cue"), 0);
+    XCTAssertEqual(blobLength, 3);
+    XCTAssertEqual(memcmp(blob, blobBytes, 3), 0);
+}
+
+- (void)testThat_wireReaderRejectsTruncatedInput
+{
+    const uint8_t shortInt[] = { 0x00, 0x00, 0x01 };
+    F53OSCWireReader reader;
+    int32_t i = 0;
+    F53OSCWireReaderInit(&reader, shortInt, sizeof(shortInt));
+    XCTAssertFalse(F53OSCWireReadInt32(&reader, &i));
+    XCTAssertEqual(reader.offset, 0, @"A failed read should not advance the reader");
+
+    const char unterminated[] = { 'a', 'b', 'c', 'd' };
+    const char *string = NULL;
+    size_t length = 0;
+    F53OSCWireReaderInit(&reader, unterminated, sizeof(unterminated));
+    XCTAssertFalse(F53OSCWireReadString(&reader, &string, &length), @"A string without a NUL should be rejected");
+
+    const uint8_t oversizeBlob[] = { 0x00, 0x00, 0x00, 0x10, 0xAA, 0xBB };
+    const void *blob = NULL;
+    F53OSCWireReaderInit(&reader, oversizeBlob, sizeof(oversizeBlob));
+    XCTAssertFalse(F53OSCWireReadBlob(&reader, &blob, &length), @"A blob longer than the remaining bytes should be rejected");
+
+    const uint8_t negativeBlob[] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    F53OSCWireReaderInit(&reader, negativeBlob, sizeof(negativeBlob));
+    XCTAssertFalse(F53OSCWireReadBlob(&reader, &blob, &length));
+
+    F53OSCWireReaderInit(&reader, NULL, 12);
+    XCTAssertEqual(F53OSCWireReaderRemaining(&reader), 0, @"NULL bytes should read as empty");
+}
+
+- (void)testThat_wireWriterOverflowIsSticky
+{
+    uint8_t buffer[8];
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit(&writer, buffer, sizeof(buffer));
+
+    XCTAssertTrue(F53OSCWireWriteInt32(&writer, 1));
+    XCTAssertFalse(F53OSCWireWriteString(&writer, "overflow", 8));
+    XCTAssertTrue(writer.overflowed);
+    XCTAssertEqual(writer.length, 4, @"A write that does not fit should write nothing");
+
+    XCTAssertFalse(F53OSCWireWriteInt32(&writer, 2), @"Writes after an overflow should keep failing");
+    XCTAssertEqual(writer.length, 4);
+}
+
+
+#pragma mark - Message tests
+
+- (void)testThat_wireMessageMatchesF53OSCMessage
+{
+    char blobBytes[] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+    NSData *blobData = [NSData dataWithBytes:blobBytes length:sizeof(blobBytes)];
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/cue/go" arguments:@[@42, @0.5f, @"hello", blobData, [F53OSCValue oscTrue], [F53OSCValue oscNull]]];
+    NSData *packet = [message packetData];
+
+    uint8_t buffer[128];
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit(&writer, buffer, sizeof(buffer));
+    XCTAssertTrue(F53OSCWireWriteMessageHeader(&writer, "/cue/go", 7, "ifsbTN", 6));
+    XCTAssertTrue(F53OSCWireWriteInt32(&writer, 42));
+    XCTAssertTrue(F53OSCWireWriteFloat32(&writer, 0.5f));
+    XCTAssertTrue(F53OSCWireWriteString(&writer, "hello", 5));
+    XCTAssertTrue(F53OSCWireWriteBlob(&writer, blobBytes, sizeof(blobBytes)));
+
+    XCTAssertEqualObjects([NSData dataWithBytes:buffer length:writer.length], packet, @"The C writer should produce the same bytes as F53OSCMessage");
+
+    F53OSCWireMessage wireMessage;
+    XCTAssertTrue(F53OSCWireReadMessage(packet.bytes, packet.length, &wireMessage));
+    XCTAssertEqual(wireMessage.addressLength, 7);
+    XCTAssertEqual(strncmp(wireMessage.address, "/cue/go", 7), 0);
+    XCTAssertEqual(strcmp(wireMessage.typeTags, "ifsbTN"), 0);
+    XCTAssertEqual(wireMessage.argumentCount, 6);
+
+    F53OSCWireArgument argument;
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentRead);
+    XCTAssertEqual(argument.type, 'i');
+    XCTAssertEqual(argument.value.i, 42);
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentRead);
+    XCTAssertEqual(argument.type, 'f');
+    XCTAssertEqual(argument.value.f, 0.5f);
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentRead);
+    XCTAssertEqual(argument.type, 's');
+    XCTAssertEqual(argument.value.data.length, 5);
+    XCTAssertEqual(strcmp(argument.value.data.bytes, "hello"), 0);
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentRead);
+    XCTAssertEqual(argument.type, 'b');
+    XCTAssertEqual(argument.value.data.length, sizeof(blobBytes));
+    XCTAssertEqual(memcmp(argument.value.data.bytes, blobBytes, sizeof(blobBytes)), 0);
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentRead);
+    XCTAssertEqual(argument.type, 'T');
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentRead);
+    XCTAssertEqual(argument.type, 'N');
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentsEnd);
+}
+
+- (void)testThat_wireMessageReportsBadArguments
+{
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/a" arguments:@[@1, @2]];
+    NSData *packet = [message packetData];
+
+    F53OSCWireMessage wireMessage;
+    F53OSCWireArgument argument;
+    XCTAssertTrue(F53OSCWireReadMessage(packet.bytes, packet.length - 4, &wireMessage));
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentRead);
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentTruncated);
+
+    uint8_t buffer[32];
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit(&writer, buffer, sizeof(buffer));
+    F53OSCWireWriteMessageHeader(&writer, "/a", 2, "q", 1);
+    F53OSCWireWriteInt32(&writer, 0);
+    XCTAssertTrue(F53OSCWireReadMessage(buffer, writer.length, &wireMessage));
+    XCTAssertEqual(F53OSCWireMessageNextArgument(&wireMessage, &argument), F53OSCWireArgumentUnknownType);
+
+    const char noTypeTags[] = { '/', 'a', 0, 0 };
+    XCTAssertTrue(F53OSCWireReadMessage(noTypeTags, sizeof(noTypeTags), &wireMessage));
+    XCTAssertEqual(wireMessage.argumentCount, 0, @"A message without a type tag string should have no arguments");
+
+    const char unterminatedAddress[] = { '/', 'a', 'b', 'c' };
+    XCTAssertFalse(F53OSCWireReadMessage(unterminatedAddress, sizeof(unterminatedAddress), &wireMessage), @"An address without a NUL should be rejected");
+}
+
+
+#pragma mark - Bundle tests
+
+- (void)testThat_wireBundleMatchesF53OSCBundle
+{
+    F53OSCMessage *first = [F53OSCMessage messageWithAddressPattern:@"/first" arguments:@[@1]];
+    F53OSCMessage *second = [F53OSCMessage messageWithAddressPattern:@"/second" arguments:@[@"two"]];
+    F53OSCTimeTag *timeTag = [F53OSCTimeTag timeTagWithDate:[NSDate dateWithTimeIntervalSinceNow:10]];
+    F53OSCBundle *bundle = [F53OSCBundle bundleWithTimeTag:timeTag elements:@[[first packetData], [second packetData]]];
+    NSData *packet = [bundle packetData];
+
+    uint8_t buffer[128];
+    F53OSCWireWriter writer;
+    F53OSCWireWriterInit(&writer, buffer, sizeof(buffer));
+    XCTAssertTrue(F53OSCWireWriteBundleHeader(&writer, timeTag.wireValue));
+
+    size_t mark = 0;
+    XCTAssertTrue(F53OSCWireBeginElement(&writer, &mark));
+    F53OSCWireWriteMessageHeader(&writer, "/first", 6, "i", 1);
+    F53OSCWireWriteInt32(&writer, 1);
+    XCTAssertTrue(F53OSCWireEndElement(&writer, mark));
+
+    XCTAssertTrue(F53OSCWireBeginElement(&writer, &mark));
+    F53OSCWireWriteMessageHeader(&writer, "/second", 7, "s", 1);
+    F53OSCWireWriteString(&writer, "two", 3);
+    XCTAssertTrue(F53OSCWireEndElement(&writer, mark));
+
+    XCTAssertEqualObjects([NSData dataWithBytes:buffer length:writer.length], packet, @"The C writer should produce the same bytes as F53OSCBundle");
+
+    F53OSCWireBundle wireBundle;
+    XCTAssertTrue(F53OSCWireReadBundle(packet.bytes, packet.length, &wireBundle));
+    XCTAssertEqual(wireBundle.timeTag, timeTag.wireValue);
+    XCTAssertEqualObjects([F53OSCTimeTag timeTagWithWireValue:wireBundle.timeTag].oscTimeTagData, timeTag.oscTimeTagData);
+
+    const void *element = NULL;
+    size_t elementLength = 0;
+    XCTAssertEqual(F53OSCWireBundleNextElement(&wireBundle, &element, &elementLength), F53OSCWireElementRead);
+    XCTAssertEqualObjects([NSData dataWithBytes:element length:elementLength], [first packetData]);
+    XCTAssertEqual(F53OSCWireBundleNextElement(&wireBundle, &element, &elementLength), F53OSCWireElementRead);
+    XCTAssertEqualObjects([NSData dataWithBytes:element length:elementLength], [second packetData]);
+    XCTAssertEqual(F53OSCWireBundleNextElement(&wireBundle, &element, &elementLength), F53OSCWireElementsEnd);
+
+    XCTAssertTrue(F53OSCWireReadBundle(packet.bytes, packet.length - 2, &wireBundle));
+    XCTAssertEqual(F53OSCWireBundleNextElement(&wireBundle, &element, &elementLength), F53OSCWireElementRead);
+    XCTAssertEqual(F53OSCWireBundleNextElement(&wireBundle, &element, &elementLength), F53OSCWireElementTruncated);
+
+    XCTAssertFalse(F53OSCWireReadBundle([first packetData].bytes, [first packetData].length, &wireBundle), @"A message is not a bundle");
+}
+
+
+#pragma mark - Performance tests
+
+- (void)testThat_wireIsFasterThanObjectEncoding
+{
+    NSUInteger count = BENCHMARK_MESSAGES;
+    NSArray *arguments = @[@"level", @1, @0.5f];
+    F53OSCMessage *message = [F53OSCMessage messageWithAddressPattern:@"/mixer/channel/1/fader" arguments:arguments];
+    NSData *packet = [message packetData];
+
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    NSUInteger objectBytes = 0;
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        @autoreleasepool
+        {
+            objectBytes += [[F53OSCMessage messageWithAddressPattern:@"/mixer/channel/1/fader" arguments:arguments] packetData].length;
+        }
+    }
+    NSTimeInterval objectEncodeTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    uint8_t buffer[64];
+    NSUInteger wireBytes = 0;
+    start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        F53OSCWireWriter writer;
+        F53OSCWireWriterInit(&writer, buffer, sizeof(buffer));
+        F53OSCWireWriteMessageHeader(&writer, "/mixer/channel/1/fader", 22, "sif", 3);
+        F53OSCWireWriteString(&writer, "level", 5);
+        F53OSCWireWriteInt32(&writer, 1);
+        F53OSCWireWriteFloat32(&writer, 0.5f);
+        wireBytes += writer.length;
+    }
+    NSTimeInterval wireEncodeTime = [NSDate timeIntervalSinceReferenceDate] - start;
+    XCTAssertEqual(wireBytes, objectBytes);
+
+    start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        @autoreleasepool
+        {
+            XCTAssertNotNil([F53OSCParser parseOscMessageData:packet]);
+        }
+    }
+    NSTimeInterval objectDecodeTime = [NSDate timeIntervalSinceReferenceDate] - start;
+
+    NSUInteger argumentsRead = 0;
+    start = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        F53OSCWireMessage wireMessage;
+        F53OSCWireArgument argument;
+        if ( !F53OSCWireReadMessage(packet.bytes, packet.length, &wireMessage) )
+            break;
+        while ( F53OSCWireMessageNextArgument(&wireMessage, &argument) == F53OSCWireArgumentRead )
+            argumentsRead++;
+    }
+    NSTimeInterval wireDecodeTime = [NSDate timeIntervalSinceReferenceDate] - start;
+    XCTAssertEqual(argumentsRead, count * arguments.count);
+
+    NSLog(@"Encoding %lu messages: F53OSCMessage %.1f ns, F53OSCWire %.1f ns per message. Decoding: F53OSCParser %.1f ns, F53OSCWire %.1f ns per message",
+          (unsigned long)count,
+          objectEncodeTime * 1e9 / count, wireEncodeTime * 1e9 / count,
+          objectDecodeTime * 1e9 / count, wireDecodeTime * 1e9 / count);
+
+    XCTAssertLessThan(wireEncodeTime, objectEncodeTime, @"Writing straight into a buffer should beat building an F53OSCMessage");
+    XCTAssertLessThan(wireDecodeTime, objectDecodeTime, @"Reading in place should beat building an F53OSCMessage");
+}
+
+@end
+
+NS_ASSUME_NONNULL_END